@@ -0,0 +1,158 @@
+/*
+ * ARRAY FILE BENCHMARKS
+ *
+ * Loading 4M `Vector3f` (48 MB) from the temporary files and summing all
+ * components, so each variant touches the whole payload; reported in vectors
+ * per second. The files are written once and stay in the page cache, so this
+ * measures the cost of the loading itself rather than of the disk.
+ *
+ * The baseline reads the vectors element by element from the stream, the
+ * bulk read copies the payload into the memory in one call, the mapped files
+ * are viewed in place.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/io/ArrayFile.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = std::size_t{1} << 22;
+
+/**
+ * The files of the points in both layouts, removed at the exit.
+ */
+struct Files
+{
+    std::filesystem::path rows = std::filesystem::temp_directory_path() / "gof_bench_points_rows.gof";
+    std::filesystem::path lanes = std::filesystem::temp_directory_path() / "gof_bench_points_lanes.gof";
+
+    Files() {
+        io::ArrayWriter<Vector3f> aos(rows);
+        io::ArrayWriter<Vector3f> soa(lanes, Layout::column_major, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Vector3f p(float(i % 1000), float(i % 777) * 0.5f, float(i % 313) - 100.0f);
+            aos.write(p);
+            soa.write(p);
+        }
+        aos.close();
+        soa.close();
+    }
+
+    ~Files() {
+        std::error_code error;
+        std::filesystem::remove(rows, error);
+        std::filesystem::remove(lanes, error);
+    }
+};
+
+const Files& files() {
+    static const Files result;
+    return result;
+}
+
+float sum(std::span<const float> values) {
+    float result = 0.0f;
+    for (const float v : values) {
+        result += v;
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("array_file/load/element_wise")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        std::ifstream file(f.rows, std::ios::binary);
+        file.seekg(sizeof(io::Header));
+        std::vector<Vector3f> points;
+        points.reserve(count);
+        Vector3f p;
+        while (file.read(reinterpret_cast<char*>(p.data()), 3 * sizeof(float))) {
+            points.push_back(p);
+        }
+        float total = 0.0f;
+        for (const Vector3f& q : points) {
+            total += q[0] + q[1] + q[2];
+        }
+        bench::do_not_optimize(total);
+    }
+}
+
+GOF_BENCHMARK("array_file/load/bulk_read")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        std::ifstream file(f.rows, std::ios::binary);
+        file.seekg(sizeof(io::Header));
+        std::vector<float> values(3 * count);
+        file.read(reinterpret_cast<char*>(values.data()), std::streamsize(values.size() * sizeof(float)));
+        bench::do_not_optimize(sum(values));
+    }
+}
+
+GOF_BENCHMARK("array_file/load/mapped_rows")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const io::MappedArray<Vector3f> points(f.rows);
+        bench::do_not_optimize(sum(points.values()));
+    }
+}
+
+GOF_BENCHMARK("array_file/load/mapped_lanes")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const io::MappedArray<Vector3f> points(f.lanes);
+        bench::do_not_optimize(sum(points.lane(0)) + sum(points.lane(1)) + sum(points.lane(2)));
+    }
+}
+
+GOF_BENCHMARK("array_file/load/mapped_open_only")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const io::MappedArray<Vector3f> points(f.lanes);
+        bench::do_not_optimize(points.size());
+    }
+}
+
+GOF_BENCHMARK("array_file/load/mapped_verify")
+{
+    const auto& f = files();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const io::MappedArray<Vector3f> points(f.lanes);
+        bench::do_not_optimize(points.verify());
+    }
+}
+
+GOF_BENCHMARK("array_file/write/lanes")
+{
+    const auto path = std::filesystem::temp_directory_path() / "gof_bench_points_write.gof";
+    VectorArray3f points(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        bench::do_not_optimize(io::save(path, points));
+    }
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
@@ -0,0 +1,143 @@
+/*
+ * BVH BENCHMARKS
+ *
+ * The build in triangles per second and the queries in queries per second
+ * (both reported as ops/sec) on the synthetic terrain of about 130k
+ * triangles. The rays are shot down at the terrain from random points above
+ * it, the boxes are scattered over it. The harness times the whole body, so
+ * the mesh and the hierarchy of the queries are built once and cached.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/spatial/Bvh.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t side = 256;
+constexpr std::size_t queries = 1 << 14;
+
+struct Mesh
+{
+    std::vector<Vector3f> vertices;
+    std::vector<std::uint32_t> triangles;
+    std::vector<Aabb3f> boxes;
+};
+
+/**
+ * The height field of a few waves over the grid of `side^2` vertices.
+ */
+const Mesh& terrain() {
+    static const Mesh mesh = [] {
+        Mesh result;
+        result.vertices.reserve(side * side);
+        for (std::size_t i = 0; i < side; ++i) {
+            for (std::size_t j = 0; j < side; ++j) {
+                const float x = float(i) / 8.0f;
+                const float z = float(j) / 8.0f;
+                const float y = 4.0f * std::sin(0.3f * x) * std::cos(0.2f * z) + std::sin(1.7f * x + 0.9f * z);
+                result.vertices.emplace_back(x, y, z);
+            }
+        }
+        for (std::size_t i = 0; i + 1 < side; ++i) {
+            for (std::size_t j = 0; j + 1 < side; ++j) {
+                const auto v = static_cast<std::uint32_t>(i * side + j);
+                const auto s = static_cast<std::uint32_t>(side);
+                result.triangles.insert(result.triangles.end(), {v, v + 1, v + s, v + 1, v + s + 1, v + s});
+            }
+        }
+        result.boxes = triangle_boxes(std::span<const Vector3f>(result.vertices),
+                                      std::span<const std::uint32_t>(result.triangles));
+        return result;
+    }();
+    return mesh;
+}
+
+const Bvh<float>& terrain_bvh() {
+    static const Bvh<float> bvh(execution::par, std::span<const Aabb3f>(terrain().boxes));
+    return bvh;
+}
+
+std::vector<Rayf> make_rays() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(0.0f, float(side) / 8.0f);
+    std::uniform_real_distribution<float> slope(-0.5f, 0.5f);
+    std::vector<Rayf> result;
+    for (std::size_t i = 0; i < queries; ++i) {
+        result.emplace_back(Vector3f(position(rng), 20.0f, position(rng)), Vector3f(slope(rng), -1.0f, slope(rng)));
+    }
+    return result;
+}
+
+std::vector<Aabb3f> make_boxes() {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> position(0.0f, float(side) / 8.0f);
+    std::vector<Aabb3f> result;
+    for (std::size_t i = 0; i < queries; ++i) {
+        const Vector3f p(position(rng), -1.0f, position(rng));
+        result.emplace_back(p, p + Vector3f(0.5f, 2.0f, 0.5f));
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("bvh/build/seq")
+{
+    const Mesh& mesh = terrain();
+    state.set_items_per_iteration(mesh.boxes.size());
+    for (auto _ : state) {
+        const Bvh<float> bvh(execution::seq, std::span<const Aabb3f>(mesh.boxes));
+        bench::do_not_optimize(bvh.nodes().data());
+    }
+}
+
+GOF_BENCHMARK("bvh/build/par")
+{
+    const Mesh& mesh = terrain();
+    state.set_items_per_iteration(mesh.boxes.size());
+    for (auto _ : state) {
+        const Bvh<float> bvh(execution::par, std::span<const Aabb3f>(mesh.boxes));
+        bench::do_not_optimize(bvh.nodes().data());
+    }
+}
+
+GOF_BENCHMARK("bvh/intersect/nearest_triangle")
+{
+    const Mesh& mesh = terrain();
+    const Bvh<float>& bvh = terrain_bvh();
+    const auto rays = make_rays();
+    state.set_items_per_iteration(rays.size());
+    for (auto _ : state) {
+        std::uint32_t sum = 0;
+        for (const auto& ray : rays) {
+            sum += bvh.intersect(ray, std::span<const Vector3f>(mesh.vertices),
+                                 std::span<const std::uint32_t>(mesh.triangles)).first;
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+GOF_BENCHMARK("bvh/overlap/box")
+{
+    const Bvh<float>& bvh = terrain_bvh();
+    const auto boxes = make_boxes();
+    state.set_items_per_iteration(boxes.size());
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto& box : boxes) {
+            bvh.overlap(box, [&](std::uint32_t) { ++found; });
+        }
+        bench::do_not_optimize(found);
+    }
+}
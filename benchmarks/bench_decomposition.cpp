@@ -0,0 +1,222 @@
+/*
+ * DECOMPOSITION BENCHMARKS
+ *
+ * The throughput of the small linear systems in systems per second (reported
+ * as ops/sec). The generic Gaussian elimination with the sizes known only at
+ * runtime is the baseline, `Lu` is unrolled for the size and the batched
+ * solves run the SIMD lanes across the systems stored as the arrays.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/matrix/Decomposition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 14;
+
+template <std::size_t N, typename T>
+std::vector<Matrix<N, N, T>> make_matrices() {
+    std::vector<Matrix<N, N, T>> result(count);
+    for (std::size_t m = 0; m < count; ++m) {
+        for (std::size_t i = 0; i < N * N; ++i) {
+            result[m].data()[i] = T(int((m + i * 7) % 13) - 6) / T(8);
+        }
+        // The diagonal dominance keeps both the LU and the LDL^T stable.
+        for (std::size_t i = 0; i < N; ++i) {
+            result[m].data()[i * N + i] = T(N) + T(m % 5);
+        }
+    }
+    return result;
+}
+
+/**
+ * The symmetric positive definite matrices, the lower triangle mirrored.
+ */
+template <std::size_t N, typename T>
+std::vector<Matrix<N, N, T>> make_symmetric() {
+    auto result = make_matrices<N, T>();
+    for (auto& m : result) {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                m.data()[j * N + i] = m.data()[i * N + j];
+            }
+        }
+    }
+    return result;
+}
+
+template <std::size_t N, typename T>
+std::vector<Vector<N, T>> make_vectors() {
+    std::vector<Vector<N, T>> result(count);
+    for (std::size_t m = 0; m < count; ++m) {
+        for (std::size_t i = 0; i < N; ++i) {
+            result[m].data()[i] = T(int((m * 3 + i) % 11) - 5) / T(4);
+        }
+    }
+    return result;
+}
+
+/**
+ * The reference implementation: the Gaussian elimination with the partial
+ * pivoting on the matrix of the runtime size.
+ */
+template <typename T>
+void generic_solve(std::size_t n, std::vector<T>& a, std::vector<T>& b) {
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i < n; ++i) {
+            if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k])) {
+                pivot = i;
+            }
+        }
+        if (pivot != k) {
+            for (std::size_t j = 0; j < n; ++j) {
+                std::swap(a[k * n + j], a[pivot * n + j]);
+            }
+            std::swap(b[k], b[pivot]);
+        }
+        for (std::size_t i = k + 1; i < n; ++i) {
+            const T f = a[i * n + k] / a[k * n + k];
+            for (std::size_t j = k; j < n; ++j) {
+                a[i * n + j] -= f * a[k * n + j];
+            }
+            b[i] -= f * b[k];
+        }
+    }
+    for (std::size_t r = 0; r < n; ++r) {
+        const std::size_t i = n - 1 - r;
+        T s = b[i];
+        for (std::size_t j = i + 1; j < n; ++j) {
+            s -= a[i * n + j] * b[j];
+        }
+        b[i] = s / a[i * n + i];
+    }
+}
+
+template <std::size_t N, typename T>
+void bench_generic(bench::State& state) {
+    const auto matrices = make_matrices<N, T>();
+    const auto vectors = make_vectors<N, T>();
+    std::vector<T> a(N * N);
+    std::vector<T> b(N);
+    std::vector<Vector<N, T>> x(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            std::copy_n(matrices[m].data(), N * N, a.begin());
+            std::copy_n(vectors[m].data(), N, b.begin());
+            generic_solve(N, a, b);
+            std::copy_n(b.begin(), N, x[m].data());
+        }
+        bench::do_not_optimize(x.data());
+    }
+}
+
+template <std::size_t N, typename T>
+void bench_lu(bench::State& state) {
+    const auto matrices = make_matrices<N, T>();
+    const auto vectors = make_vectors<N, T>();
+    std::vector<Vector<N, T>> x(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            x[m] = Lu<N, T>(matrices[m]).solve(vectors[m]);
+        }
+        bench::do_not_optimize(x.data());
+    }
+}
+
+template <std::size_t N, typename T>
+void bench_batched_lu(bench::State& state) {
+    const MatrixArray<N, N, T> a{std::span<const Matrix<N, N, T>>(make_matrices<N, T>())};
+    const VectorArray<N, T> b{std::span<const Vector<N, T>>(make_vectors<N, T>())};
+    VectorArray<N, T> x(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        lu_solve(a, b, x);
+        bench::do_not_optimize(x.lane(0).data());
+    }
+}
+
+template <std::size_t N, typename T>
+void bench_cholesky(bench::State& state) {
+    const auto matrices = make_symmetric<N, T>();
+    const auto vectors = make_vectors<N, T>();
+    std::vector<Vector<N, T>> x(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            x[m] = Cholesky<N, T>(matrices[m]).solve(vectors[m]);
+        }
+        bench::do_not_optimize(x.data());
+    }
+}
+
+template <std::size_t N, typename T>
+void bench_batched_cholesky(bench::State& state) {
+    const MatrixArray<N, N, T> a{std::span<const Matrix<N, N, T>>(make_symmetric<N, T>())};
+    const VectorArray<N, T> b{std::span<const Vector<N, T>>(make_vectors<N, T>())};
+    VectorArray<N, T> x(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        cholesky_solve(a, b, x);
+        bench::do_not_optimize(x.lane(0).data());
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("decomposition/solve/generic/Matrix3f") { bench_generic<3, float>(state); }
+GOF_BENCHMARK("decomposition/solve/lu/Matrix3f") { bench_lu<3, float>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_lu/Matrix3f") { bench_batched_lu<3, float>(state); }
+GOF_BENCHMARK("decomposition/solve/cholesky/Matrix3f") { bench_cholesky<3, float>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_cholesky/Matrix3f") { bench_batched_cholesky<3, float>(state); }
+
+GOF_BENCHMARK("decomposition/solve/generic/Matrix4f") { bench_generic<4, float>(state); }
+GOF_BENCHMARK("decomposition/solve/lu/Matrix4f") { bench_lu<4, float>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_lu/Matrix4f") { bench_batched_lu<4, float>(state); }
+GOF_BENCHMARK("decomposition/solve/cholesky/Matrix4f") { bench_cholesky<4, float>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_cholesky/Matrix4f") { bench_batched_cholesky<4, float>(state); }
+
+GOF_BENCHMARK("decomposition/solve/generic/Matrix6d") { bench_generic<6, double>(state); }
+GOF_BENCHMARK("decomposition/solve/lu/Matrix6d") { bench_lu<6, double>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_lu/Matrix6d") { bench_batched_lu<6, double>(state); }
+GOF_BENCHMARK("decomposition/solve/cholesky/Matrix6d") { bench_cholesky<6, double>(state); }
+GOF_BENCHMARK("decomposition/solve/batched_cholesky/Matrix6d") { bench_batched_cholesky<6, double>(state); }
+
+GOF_BENCHMARK("decomposition/inverse/lu/Matrix4f")
+{
+    const auto matrices = make_matrices<4, float>();
+    std::vector<Matrix4f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            out[m] = Lu<4, float>(matrices[m]).inverse();
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("decomposition/inverse/closed_form/Matrix4f")
+{
+    const auto matrices = make_matrices<4, float>();
+    std::vector<Matrix4f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            out[m] = inverse(matrices[m]);
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * DENSE MATRIX BENCHMARKS
+ *
+ * The matrix product in floating point operations per second (`2 * n^3` per
+ * product, reported as ops/sec, i.e. 1e9 ops/sec is 1 GFLOP/s). The naive
+ * triple loop is the baseline.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/matrix/DenseMatrix.hpp>
+
+#include <cstddef>
+
+using namespace gof;
+
+namespace {
+
+template <typename T>
+DenseMatrix<T> make_matrix(std::size_t n, std::size_t seed) {
+    DenseMatrix<T> result(n, n);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result.data()[i] = T(int((i * 7 + seed) % 13) - 6) / T(8);
+    }
+    return result;
+}
+
+/**
+ * The reference implementation.
+ */
+template <typename T>
+void naive_multiply(const DenseMatrix<T>& a, const DenseMatrix<T>& b, DenseMatrix<T>& c) {
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < b.columns(); ++j) {
+            T sum = T{0};
+            for (std::size_t p = 0; p < a.columns(); ++p) {
+                sum += a(i, p) * b(p, j);
+            }
+            c(i, j) = sum;
+        }
+    }
+}
+
+template <typename T>
+void bench_naive(bench::State& state, std::size_t n) {
+    const auto a = make_matrix<T>(n, 1);
+    const auto b = make_matrix<T>(n, 2);
+    DenseMatrix<T> c(n, n);
+    state.set_items_per_iteration(2 * n * n * n);
+    for (auto _ : state) {
+        naive_multiply(a, b, c);
+        bench::do_not_optimize(c.data());
+    }
+}
+
+template <typename T, typename P>
+void bench_gemm(bench::State& state, const P& policy, std::size_t n) {
+    const auto a = make_matrix<T>(n, 1);
+    const auto b = make_matrix<T>(n, 2);
+    DenseMatrix<T> c(n, n);
+    state.set_items_per_iteration(2 * n * n * n);
+    for (auto _ : state) {
+        gemm(policy, T{1}, a, b, T{0}, c);
+        bench::do_not_optimize(c.data());
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("dense_matrix/gemm/naive/256f") { bench_naive<float>(state, 256); }
+GOF_BENCHMARK("dense_matrix/gemm/seq/256f") { bench_gemm<float>(state, execution::seq, 256); }
+GOF_BENCHMARK("dense_matrix/gemm/par/256f") { bench_gemm<float>(state, execution::par, 256); }
+
+GOF_BENCHMARK("dense_matrix/gemm/naive/1024f") { bench_naive<float>(state, 1024); }
+GOF_BENCHMARK("dense_matrix/gemm/seq/1024f") { bench_gemm<float>(state, execution::seq, 1024); }
+GOF_BENCHMARK("dense_matrix/gemm/par/1024f") { bench_gemm<float>(state, execution::par, 1024); }
+GOF_BENCHMARK("dense_matrix/gemm/par/2048f") { bench_gemm<float>(state, execution::par, 2048); }
+
+GOF_BENCHMARK("dense_matrix/gemm/naive/1024d") { bench_naive<double>(state, 1024); }
+GOF_BENCHMARK("dense_matrix/gemm/seq/1024d") { bench_gemm<double>(state, execution::seq, 1024); }
+GOF_BENCHMARK("dense_matrix/gemm/par/1024d") { bench_gemm<double>(state, execution::par, 1024); }
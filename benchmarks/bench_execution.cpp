@@ -0,0 +1,111 @@
+/*
+ * EXECUTION BENCHMARKS
+ *
+ * The bulk operations with the sequential, the unsequenced and the parallel
+ * policy in vectors per second (reported as ops/sec).
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/execution.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 20;
+
+const Matrix4f projection(1.2f, 0.0f, 0.0f, 0.0f,
+                          0.0f, 1.7f, 0.0f, 0.0f,
+                          0.0f, 0.0f, -1.01f, -0.2f,
+                          0.0f, 0.0f, -1.0f, 0.0f);
+
+std::vector<Vector3f> make_points() {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i % 4096) * 0.01f;
+        result[i] = Vector3f(f, 1.0f - f, -5.0f - f);
+    }
+    return result;
+}
+
+template <typename Policy>
+void bench_transform(bench::State& state, const Policy& policy) {
+    const auto in = make_points();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform_points(policy, projection, std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+template <typename Policy>
+void bench_normalize(bench::State& state, const Policy& policy) {
+    const auto in = make_points();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        normalize(policy, std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+template <typename Policy>
+void bench_bounding_box(bench::State& state, const Policy& policy) {
+    const auto in = make_points();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        auto box = bounding_box(policy, std::span<const Vector3f>(in));
+        bench::do_not_optimize(&box);
+    }
+}
+
+template <typename Policy>
+void bench_sum(bench::State& state, const Policy& policy) {
+    const auto in = make_points();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        auto total = sum(policy, std::span<const Vector3f>(in));
+        bench::do_not_optimize(&total);
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("execution/transform_points/seq") { bench_transform(state, execution::seq); }
+GOF_BENCHMARK("execution/transform_points/par") { bench_transform(state, execution::par); }
+
+GOF_BENCHMARK("execution/normalize/seq") { bench_normalize(state, execution::seq); }
+GOF_BENCHMARK("execution/normalize/par") { bench_normalize(state, execution::par); }
+
+// The baseline: merging the points into the box one by one.
+GOF_BENCHMARK("execution/bounding_box/merge")
+{
+    const auto in = make_points();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        Aabb3f box;
+        for (const auto& p : in) {
+            box = box.merge(p);
+        }
+        bench::do_not_optimize(&box);
+    }
+}
+
+GOF_BENCHMARK("execution/bounding_box/seq") { bench_bounding_box(state, execution::seq); }
+GOF_BENCHMARK("execution/bounding_box/unseq") { bench_bounding_box(state, execution::unseq); }
+GOF_BENCHMARK("execution/bounding_box/par") { bench_bounding_box(state, execution::par); }
+
+GOF_BENCHMARK("execution/sum/seq") { bench_sum(state, execution::seq); }
+GOF_BENCHMARK("execution/sum/unseq") { bench_sum(state, execution::unseq); }
+GOF_BENCHMARK("execution/sum/par") { bench_sum(state, execution::par); }
+GOF_BENCHMARK("execution/sum/par_deterministic")
+{
+    bench_sum(state, execution::parallel_policy{nullptr, 0, true});
+}
@@ -0,0 +1,92 @@
+/*
+ * EXPRESSION TEMPLATE BENCHMARKS
+ *
+ * The same chain of operations evaluated eagerly (one pass and one temporary
+ * per operator) and lazily (a single fused pass).
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 16;
+
+std::vector<Vector3f> make_vectors(float seed) {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = seed + float(i % 1000);
+        result[i] = Vector3f(f, f * 0.5f, -f);
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("expression/eager/Vector3f")
+{
+    const auto a = make_vectors(1.0f);
+    const auto b = make_vectors(2.0f);
+    const auto c = make_vectors(3.0f);
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = a[i] + 0.5f * b[i] - c[i] + 2.0f * (a[i] - b[i]);
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("expression/lazy/Vector3f")
+{
+    const auto a = make_vectors(1.0f);
+    const auto b = make_vectors(2.0f);
+    const auto c = make_vectors(3.0f);
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lazy(a[i]) + 0.5f * lazy(b[i]) - c[i] + 2.0f * (lazy(a[i]) - b[i]);
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("expression/eager/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    const VectorArray3f b(make_vectors(2.0f));
+    const VectorArray3f c(make_vectors(3.0f));
+    VectorArray3f t(count);
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        scale(0.5f, b, out);
+        add(a, out, out);
+        sub(out, c, out);
+        sub(a, b, t);
+        scale(2.0f, t, t);
+        add(out, t, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("expression/lazy/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    const VectorArray3f b(make_vectors(2.0f));
+    const VectorArray3f c(make_vectors(3.0f));
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        out.assign(lazy(a) + 0.5f * lazy(b) - c + 2.0f * (lazy(a) - b));
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * K-D TREE BENCHMARKS
+ *
+ * The queries over the cloud of 1M random points in queries per second and
+ * the build in points per second (both reported as ops/sec). The linear scan
+ * over all points is the baseline. The harness times the whole body, so the
+ * cloud and the tree of the queries are built once and cached.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/spatial/KdTree.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 20;
+constexpr std::size_t queries = 1 << 12;
+
+std::vector<Vector3f> make_points(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<Vector3f> result;
+    result.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        result.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return result;
+}
+
+const std::vector<Vector3f>& cloud() {
+    static const auto points = make_points(count, 1);
+    return points;
+}
+
+const std::vector<Vector3f>& query_points() {
+    static const auto points = make_points(queries, 2);
+    return points;
+}
+
+const KdTree<3, float>& tree() {
+    static const KdTree<3, float> result(execution::par, std::span<const Vector3f>(cloud()));
+    return result;
+}
+
+template <typename Policy>
+void bench_knn(bench::State& state, const Policy& policy, std::size_t k) {
+    const auto& points = query_points();
+    const auto& index = tree();
+    std::vector<Neighbour<float>> out(points.size() * k);
+    state.set_items_per_iteration(points.size());
+    for (auto _ : state) {
+        index.knn(policy, std::span<const Vector3f>(points), k, std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("kd_tree/build/seq")
+{
+    const auto& points = cloud();
+    state.set_items_per_iteration(points.size());
+    for (auto _ : state) {
+        const KdTree<3, float> index(execution::seq, std::span<const Vector3f>(points));
+        bench::do_not_optimize(index.size());
+    }
+}
+
+GOF_BENCHMARK("kd_tree/build/par")
+{
+    const auto& points = cloud();
+    state.set_items_per_iteration(points.size());
+    for (auto _ : state) {
+        const KdTree<3, float> index(execution::par, std::span<const Vector3f>(points));
+        bench::do_not_optimize(index.size());
+    }
+}
+
+GOF_BENCHMARK("kd_tree/nearest/brute_force")
+{
+    const auto& points = cloud();
+    const auto& targets = query_points();
+    constexpr std::size_t sample = 16;
+    state.set_items_per_iteration(sample);
+    for (auto _ : state) {
+        for (std::size_t q = 0; q < sample; ++q) {
+            float best = std::numeric_limits<float>::infinity();
+            for (const auto& p : points) {
+                best = std::min(best, (p - targets[q]).length_squared());
+            }
+            bench::do_not_optimize(best);
+        }
+    }
+}
+
+GOF_BENCHMARK("kd_tree/nearest/seq") { bench_knn(state, execution::seq, 1); }
+GOF_BENCHMARK("kd_tree/nearest/par") { bench_knn(state, execution::par, 1); }
+GOF_BENCHMARK("kd_tree/knn8/seq") { bench_knn(state, execution::seq, 8); }
+GOF_BENCHMARK("kd_tree/knn8/par") { bench_knn(state, execution::par, 8); }
+
+GOF_BENCHMARK("kd_tree/radius/par")
+{
+    const auto& points = query_points();
+    const auto& index = tree();
+    state.set_items_per_iteration(points.size());
+    for (auto _ : state) {
+        const auto found = index.radius_search(execution::par, std::span<const Vector3f>(points), 5.0f);
+        bench::do_not_optimize(found.neighbours.data());
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * MATRIX BENCHMARKS
+ *
+ * Compares the matrix products with the naive triple loop and the element
+ * access through the copies with the access through the views.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1024;
+
+template <std::size_t N, typename T>
+std::vector<Matrix<N, N, T>> make_matrices() {
+    std::vector<Matrix<N, N, T>> result(count);
+    for (std::size_t m = 0; m < count; ++m) {
+        for (std::size_t i = 0; i < N * N; ++i) {
+            result[m].data()[i] = T(int((m + i * 7) % 13) - 6) / T(8);
+        }
+    }
+    return result;
+}
+
+/**
+ * The reference implementation.
+ */
+template <std::size_t N, typename T>
+Matrix<N, N, T> naive_multiply(const Matrix<N, N, T>& a, const Matrix<N, N, T>& b) {
+    Matrix<N, N, T> c;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            T sum = T{0};
+            for (std::size_t k = 0; k < N; ++k) {
+                sum += a(i, k) * b(k, j);
+            }
+            c.data()[i * N + j] = sum;
+        }
+    }
+    return c;
+}
+
+template <std::size_t N, typename T, bool Naive>
+void bench_multiply(bench::State& state) {
+    const auto a = make_matrices<N, T>();
+    const auto b = make_matrices<N, T>();
+    std::vector<Matrix<N, N, T>> c(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            if constexpr(Naive) {
+                c[m] = naive_multiply(a[m], b[(m + 1) % count]);
+            } else {
+                c[m] = a[m] * b[(m + 1) % count];
+            }
+        }
+        bench::do_not_optimize(c.data());
+    }
+}
+
+template <typename T>
+void bench_transform(bench::State& state) {
+    const auto a = make_matrices<4, T>();
+    const std::vector<Vector<4, T>> v(count, Vector<4, T>(T(1), T(2), T(3), T(1)));
+    std::vector<Vector<4, T>> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t m = 0; m < count; ++m) {
+            out[m] = a[m] * v[m];
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+/**
+ * Sum the last column of every matrix, reading the elements from a copy of
+ * the whole matrix (`to_array()`, what `values()` used to return) or from
+ * the view.
+ */
+template <bool Copy>
+void bench_read_column(bench::State& state) {
+    const auto a = make_matrices<4, double>();
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (std::size_t m = 0; m < count; ++m) {
+            if constexpr(Copy) {
+                const auto values = a[m].to_array();
+                for (std::size_t i = 0; i < 4; ++i) {
+                    sum += values[Matrix4d::index(i, 3)];
+                }
+            } else {
+                for (double e : a[m].column_view(3)) {
+                    sum += e;
+                }
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("matrix/multiply/naive/Matrix2f") { bench_multiply<2, float, true>(state); }
+GOF_BENCHMARK("matrix/multiply/Matrix2f") { bench_multiply<2, float, false>(state); }
+GOF_BENCHMARK("matrix/multiply/naive/Matrix3f") { bench_multiply<3, float, true>(state); }
+GOF_BENCHMARK("matrix/multiply/Matrix3f") { bench_multiply<3, float, false>(state); }
+GOF_BENCHMARK("matrix/multiply/naive/Matrix4f") { bench_multiply<4, float, true>(state); }
+GOF_BENCHMARK("matrix/multiply/Matrix4f") { bench_multiply<4, float, false>(state); }
+GOF_BENCHMARK("matrix/multiply/naive/Matrix4d") { bench_multiply<4, double, true>(state); }
+GOF_BENCHMARK("matrix/multiply/Matrix4d") { bench_multiply<4, double, false>(state); }
+GOF_BENCHMARK("matrix/transform/Matrix4f") { bench_transform<float>(state); }
+GOF_BENCHMARK("matrix/transform/Matrix4d") { bench_transform<double>(state); }
+GOF_BENCHMARK("matrix/read_column/copy/Matrix4d") { bench_read_column<true>(state); }
+GOF_BENCHMARK("matrix/read_column/view/Matrix4d") { bench_read_column<false>(state); }
@@ -0,0 +1,80 @@
+/*
+ * MEMORY BENCHMARKS
+ *
+ * The scratch data of a small frame in frames per second (reported as
+ * ops/sec): the points are converted to the lanes, transformed and indexed by
+ * the k-d tree and the spatial hash. The global heap is the baseline, the
+ * `FrameArena` is reset at the start of each frame.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/memory.hpp>
+#include <gof/math/transform.hpp>
+#include <gof/math/spatial/KdTree.hpp>
+#include <gof/math/spatial/SpatialHash.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 12;
+
+const std::vector<Vector3f>& points() {
+    static const auto result = [] {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+        std::vector<Vector3f> vectors(count);
+        for (auto& v : vectors) {
+            v = Vector3f(dist(rng), dist(rng), dist(rng));
+        }
+        return vectors;
+    }();
+    return result;
+}
+
+const Matrix4f m(0.5f, -0.2f, 0.1f, 10.0f,
+                 0.3f, 0.9f, -0.4f, -2.0f,
+                 0.0f, 0.7f, 1.1f, 3.5f,
+                 0.0f, 0.0f, 0.0f, 1.0f);
+
+template <typename A, typename B>
+float frame(const A& lanes, const B& bytes) {
+    const auto input = std::span<const Vector3f>(points());
+    const VectorArray<3, float, A> in(input, lanes);
+    VectorArray<3, float, A> out(in.size(), lanes);
+    transform_points(m, in, out);
+    SpatialHash<3, float, B> unique(0.01f, input.size(), bytes);
+    for (const auto& p : input) {
+        unique.insert(p);
+    }
+    const KdTree<3, float, B> tree(input, bytes);
+    return out[0].x() + float(unique.size()) + tree.nearest(input[1]).distance_squared;
+}
+
+} // namespace
+
+GOF_BENCHMARK("memory/frame/heap")
+{
+    state.set_items_per_iteration(1);
+    for (auto _ : state) {
+        bench::do_not_optimize(frame(aligned_allocator<float>(), std::allocator<std::byte>()));
+    }
+}
+
+GOF_BENCHMARK("memory/frame/arena")
+{
+    FrameArena arena(1 << 20);
+    state.set_items_per_iteration(1);
+    for (auto _ : state) {
+        arena.reset();
+        bench::do_not_optimize(frame(pmr::aligned_allocator<float>(&arena), pmr::aligned_allocator<std::byte>(&arena)));
+    }
+}
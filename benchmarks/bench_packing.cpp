@@ -0,0 +1,151 @@
+/*
+ * PACKING BENCHMARKS
+ *
+ * Encoding and decoding the bulk buffers in vectors per second (reported as
+ * ops/sec). The plain copy of the `Vector3f` buffer is the baseline.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 4096;
+
+std::vector<Vector3f> make_normals() {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float z = 1.0f - float(2 * i + 1) / float(count);
+        const float r = std::sqrt(1.0f - z * z);
+        const float phi = 2.39996323f * float(i);
+        result[i] = Vector3f(r * std::cos(phi), r * std::sin(phi), z);
+    }
+    return result;
+}
+
+std::vector<Vector4f> make_colors() {
+    std::vector<Vector4f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i % 1024) / 1023.0f;
+        result[i] = Vector4f(f, 1.0f - f, 0.5f * f, 1.0f);
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("packing/copy/Vector3f")
+{
+    const auto in = make_normals();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        std::copy(in.begin(), in.end(), out.begin());
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/encode_half/Vector3f")
+{
+    const auto in = make_normals();
+    std::vector<Vector3h> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        convert(std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/decode_half/Vector3f")
+{
+    const auto normals = make_normals();
+    std::vector<Vector3h> in(count);
+    convert(std::span<const Vector3f>(normals), std::span(in));
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        convert(std::span<const Vector3h>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/encode_bfloat16/Vector3f")
+{
+    const auto in = make_normals();
+    std::vector<Vector<3, BFloat16>> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        convert(std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/encode_fixed/Vector3f")
+{
+    const auto in = make_normals();
+    std::vector<Vector<3, Fixed<14, std::int16_t>>> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        convert(std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/encode_octahedral/Vector3f")
+{
+    const auto in = make_normals();
+    std::vector<std::uint32_t> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        encode_octahedral(std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/decode_octahedral/Vector3f")
+{
+    const auto normals = make_normals();
+    std::vector<std::uint32_t> in(count);
+    encode_octahedral(std::span<const Vector3f>(normals), std::span(in));
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        decode_octahedral(std::span<const std::uint32_t>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/pack_unorm_1010102/Vector4f")
+{
+    const auto in = make_colors();
+    std::vector<std::uint32_t> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        pack_unorm_1010102(std::span<const Vector4f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("packing/unpack_unorm_1010102/Vector4f")
+{
+    const auto colors = make_colors();
+    std::vector<std::uint32_t> in(count);
+    pack_unorm_1010102(std::span<const Vector4f>(colors), std::span(in));
+    std::vector<Vector4f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        unpack_unorm_1010102(std::span<const std::uint32_t>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * POINT PARSER BENCHMARKS
+ *
+ * Parsing the generated point clouds of 1M points (about 30 MB of text) from
+ * the temporary files, reported in bytes per second (1e6 ops/sec is 1 MB/s).
+ * The files stay in the page cache, so this measures the parser rather than
+ * the disk. The baseline extracts the numbers by `std::ifstream >> x`.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/io/PointParser.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = std::size_t{1} << 20;
+
+/**
+ * The generated file removed at the exit.
+ */
+struct PointFile
+{
+    std::filesystem::path path;
+    std::size_t bytes = 0;
+
+    PointFile(const std::string& name, const std::string& header, const char* format) {
+        path = std::filesystem::temp_directory_path() / ("gof_bench_points." + name);
+        std::ofstream file(path, std::ios::binary);
+        file << header;
+        char line[128];
+        for (std::size_t i = 0; i < count; ++i) {
+            const double t = double(i) / double(count);
+            const int size = std::snprintf(line, sizeof(line), format, 1000.0 * t, -512.25 + 0.001 * double(i % 100000),
+                                           3.0e-3 * double(i % 4099));
+            file.write(line, size);
+        }
+        file.close();
+        bytes = std::filesystem::file_size(path);
+    }
+
+    ~PointFile() {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+};
+
+const PointFile& xyz() {
+    static const PointFile file("xyz", "", "%.6f %.6f %.6f\n");
+    return file;
+}
+
+const PointFile& csv() {
+    static const PointFile file("csv", "x,y,z\n", "%.6f,%.6f,%.6f\n");
+    return file;
+}
+
+const PointFile& ply() {
+    static const PointFile file("ply", "ply\nformat ascii 1.0\nelement vertex " + std::to_string(count) +
+                                       "\nproperty float x\nproperty float y\nproperty float z\nend_header\n",
+                                "%.6f %.6f %.6f\n");
+    return file;
+}
+
+template <typename T, typename P>
+void bench_parse(bench::State& state, const P& policy, const PointFile& file) {
+    state.set_items_per_iteration(file.bytes);
+    for (auto _ : state) {
+        T sum = T{0};
+        io::parse_points<T>(policy, file.path, [&](std::span<const Vector<3, T>> batch) {
+            for (const auto& p : batch) {
+                sum += p[0];
+            }
+        });
+        bench::do_not_optimize(sum);
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("point_parser/xyz/istream/bytes")
+{
+    const auto& file = xyz();
+    state.set_items_per_iteration(file.bytes);
+    for (auto _ : state) {
+        std::ifstream input(file.path);
+        float x, y, z;
+        float sum = 0.0f;
+        while (input >> x >> y >> z) {
+            sum += x;
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+GOF_BENCHMARK("point_parser/xyz/seq/float/bytes") { bench_parse<float>(state, execution::seq, xyz()); }
+GOF_BENCHMARK("point_parser/xyz/par/float/bytes") { bench_parse<float>(state, execution::par, xyz()); }
+GOF_BENCHMARK("point_parser/xyz/par/double/bytes") { bench_parse<double>(state, execution::par, xyz()); }
+GOF_BENCHMARK("point_parser/csv/par/float/bytes") { bench_parse<float>(state, execution::par, csv()); }
+GOF_BENCHMARK("point_parser/ply/par/float/bytes") { bench_parse<float>(state, execution::par, ply()); }
@@ -0,0 +1,200 @@
+/*
+ * RAY BENCHMARKS
+ *
+ * The intersection tests in rays per second (reported as ops/sec), i.e. the
+ * number of the ray–primitive pairs tested. The single-ray tests are the
+ * baseline of the packet forms, which test 4 or 8 pairs per call.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 14;
+constexpr std::size_t primitives = 64;
+
+std::vector<Rayf> make_rays() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-8.0f, 8.0f);
+    std::vector<Rayf> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector3f origin(dist(rng), dist(rng), dist(rng));
+        result.emplace_back(origin, -origin + Vector3f(0.1f * dist(rng), 0.1f * dist(rng), 0.1f * dist(rng)));
+    }
+    return result;
+}
+
+std::vector<Aabb3f> make_boxes() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<Aabb3f> result;
+    for (std::size_t i = 0; i < primitives; ++i) {
+        const Vector3f p(dist(rng), dist(rng), dist(rng));
+        result.emplace_back(p, p + Vector3f(1.0f, 1.0f, 1.0f));
+    }
+    return result;
+}
+
+std::vector<Vector3f> make_triangles() {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < 3 * primitives; ++i) {
+        result.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return result;
+}
+
+template <std::size_t W>
+void bench_ray_packet_box(bench::State& state) {
+    const auto rays = make_rays();
+    const auto boxes = make_boxes();
+    std::vector<RayPacket<float, W>> packets;
+    for (std::size_t i = 0; i < count; i += W) {
+        packets.emplace_back(std::span<const Rayf, W>(rays.data() + i, W));
+    }
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        std::array<float, W> nearest;
+        nearest.fill(std::numeric_limits<float>::infinity());
+        for (const auto& packet : packets) {
+            for (const auto& box : boxes) {
+                const auto distances = intersect(packet, box);
+                for (std::size_t i = 0; i < W; ++i) {
+                    nearest[i] = distances[i] < nearest[i] ? distances[i] : nearest[i];
+                }
+            }
+        }
+        bench::do_not_optimize(nearest.data());
+    }
+}
+
+template <std::size_t W>
+void bench_box_packet(bench::State& state) {
+    const auto rays = make_rays();
+    const auto boxes = make_boxes();
+    std::vector<BoxPacket<float, W>> packets;
+    for (std::size_t i = 0; i < primitives; i += W) {
+        packets.emplace_back(std::span<const Aabb3f>(boxes.data() + i, W));
+    }
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        std::array<float, W> nearest;
+        nearest.fill(std::numeric_limits<float>::infinity());
+        for (const auto& ray : rays) {
+            for (const auto& packet : packets) {
+                const auto distances = intersect(ray, packet);
+                for (std::size_t i = 0; i < W; ++i) {
+                    nearest[i] = distances[i] < nearest[i] ? distances[i] : nearest[i];
+                }
+            }
+        }
+        bench::do_not_optimize(nearest.data());
+    }
+}
+
+template <std::size_t W>
+void bench_ray_packet_triangle(bench::State& state) {
+    const auto rays = make_rays();
+    const auto triangles = make_triangles();
+    std::vector<RayPacket<float, W>> packets;
+    for (std::size_t i = 0; i < count; i += W) {
+        packets.emplace_back(std::span<const Rayf, W>(rays.data() + i, W));
+    }
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        std::array<float, W> nearest;
+        nearest.fill(std::numeric_limits<float>::infinity());
+        for (const auto& packet : packets) {
+            for (std::size_t j = 0; j < 3 * primitives; j += 3) {
+                const auto hits = intersect(packet, triangles[j], triangles[j + 1], triangles[j + 2]);
+                for (std::size_t i = 0; i < W; ++i) {
+                    nearest[i] = hits.distance[i] < nearest[i] ? hits.distance[i] : nearest[i];
+                }
+            }
+        }
+        bench::do_not_optimize(nearest.data());
+    }
+}
+
+template <std::size_t W>
+void bench_triangle_packet(bench::State& state) {
+    const auto rays = make_rays();
+    const auto triangles = make_triangles();
+    std::vector<TrianglePacket<float, W>> packets;
+    for (std::size_t j = 0; j < 3 * primitives; j += 3 * W) {
+        packets.emplace_back(std::span<const Vector3f>(triangles.data() + j, 3 * W));
+    }
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        std::array<float, W> nearest;
+        nearest.fill(std::numeric_limits<float>::infinity());
+        for (const auto& ray : rays) {
+            for (const auto& packet : packets) {
+                const auto hits = intersect(ray, packet);
+                for (std::size_t i = 0; i < W; ++i) {
+                    nearest[i] = hits.distance[i] < nearest[i] ? hits.distance[i] : nearest[i];
+                }
+            }
+        }
+        bench::do_not_optimize(nearest.data());
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("ray/box/single")
+{
+    const auto rays = make_rays();
+    const auto boxes = make_boxes();
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        float nearest = std::numeric_limits<float>::infinity();
+        for (const auto& ray : rays) {
+            for (const auto& box : boxes) {
+                const float t = intersect(ray, box);
+                nearest = t < nearest ? t : nearest;
+            }
+        }
+        bench::do_not_optimize(nearest);
+    }
+}
+
+GOF_BENCHMARK("ray/box/ray_packet4") { bench_ray_packet_box<4>(state); }
+GOF_BENCHMARK("ray/box/ray_packet8") { bench_ray_packet_box<8>(state); }
+GOF_BENCHMARK("ray/box/box_packet4") { bench_box_packet<4>(state); }
+GOF_BENCHMARK("ray/box/box_packet8") { bench_box_packet<8>(state); }
+
+GOF_BENCHMARK("ray/triangle/single")
+{
+    const auto rays = make_rays();
+    const auto triangles = make_triangles();
+    state.set_items_per_iteration(count * primitives);
+    for (auto _ : state) {
+        float nearest = std::numeric_limits<float>::infinity();
+        for (const auto& ray : rays) {
+            for (std::size_t j = 0; j < 3 * primitives; j += 3) {
+                const float t = intersect(ray, triangles[j], triangles[j + 1], triangles[j + 2]).distance;
+                nearest = t < nearest ? t : nearest;
+            }
+        }
+        bench::do_not_optimize(nearest);
+    }
+}
+
+GOF_BENCHMARK("ray/triangle/ray_packet4") { bench_ray_packet_triangle<4>(state); }
+GOF_BENCHMARK("ray/triangle/ray_packet8") { bench_ray_packet_triangle<8>(state); }
+GOF_BENCHMARK("ray/triangle/triangle_packet4") { bench_triangle_packet<4>(state); }
+GOF_BENCHMARK("ray/triangle/triangle_packet8") { bench_triangle_packet<8>(state); }
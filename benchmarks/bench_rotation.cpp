@@ -0,0 +1,82 @@
+/*
+ * ROTATION BENCHMARKS
+ *
+ * Rotating many vectors by one quaternion (e.g. the vertices skinned to one
+ * bone) in vectors per second (reported as ops/sec).
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 4096;
+
+const Quaternionf bone = Quaternionf::from_axis_angle(Vector3f(0.0f, 0.6f, 0.8f), 1.1f);
+
+std::vector<Vector3f> make_vectors() {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i % 512) * 0.01f;
+        result[i] = Vector3f(f, 1.0f - f, 0.5f * f);
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("rotation/quaternion_rotate/Vector3f")
+{
+    const auto in = make_vectors();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = bone.rotate(in[i]);
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("rotation/matrix_per_vector/Vector3f")
+{
+    const auto in = make_vectors();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = bone.to_matrix3() * in[i];
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("rotation/batched/Vector3f")
+{
+    const auto in = make_vectors();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        rotate(bone, std::span<const Vector3f>(in), std::span(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("rotation/batched/VectorArray3f")
+{
+    const auto vectors = make_vectors();
+    const VectorArray3f in{std::span<const Vector3f>(vectors)};
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        rotate(bone, in, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * SIMD BENCHMARKS
+ *
+ * Compares the hot vector loops through the `Vector` operators (scalar unless
+ * built with `GOF_MATH_SIMD`) with the SIMD kernels called directly.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 4096;
+
+template <typename V>
+std::vector<V> make_vectors(float seed) {
+    std::vector<V> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = seed + float(i);
+        if constexpr(V::size == 3) { result[i] = V(f, f * 0.5f, f * 0.25f); }
+        if constexpr(V::size == 4) { result[i] = V(f, f * 0.5f, f * 0.25f, 1.0f); }
+    }
+    return result;
+}
+
+/**
+ * The `a[i] + s * (b[i] - a[i])` loop, typical for the integration step.
+ */
+template <typename V>
+void bench_axpy(bench::State& state) {
+    auto a = make_vectors<V>(1.0f);
+    const auto b = make_vectors<V>(2.0f);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            a[i] = a[i] + 0.5f * (b[i] - a[i]);
+        }
+        bench::do_not_optimize(a.data());
+    }
+}
+
+template <typename V>
+void bench_length(bench::State& state) {
+    const auto a = make_vectors<V>(1.0f);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += a[i].length();
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+template <typename V>
+void bench_min_max(bench::State& state) {
+    const auto a = make_vectors<V>(1.0f);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        V lo = a[0];
+        V hi = a[0];
+        for (std::size_t i = 1; i < count; ++i) {
+            lo = min(lo, a[i]);
+            hi = max(hi, a[i]);
+        }
+        bench::do_not_optimize(lo);
+        bench::do_not_optimize(hi);
+    }
+}
+
+} // namespace
+
+GOF_BENCHMARK("vector/axpy/Vector3f") { bench_axpy<Vector3f>(state); }
+GOF_BENCHMARK("vector/axpy/Vector4f") { bench_axpy<Vector4f>(state); }
+GOF_BENCHMARK("vector/length/Vector3f") { bench_length<Vector3f>(state); }
+GOF_BENCHMARK("vector/length/Vector4f") { bench_length<Vector4f>(state); }
+GOF_BENCHMARK("vector/min_max/Vector3f") { bench_min_max<Vector3f>(state); }
+GOF_BENCHMARK("vector/min_max/Vector4f") { bench_min_max<Vector4f>(state); }
+
+#if GOF_MATH_HAS_SSE
+
+GOF_BENCHMARK("simd/axpy/float4")
+{
+    struct alignas(16) Lanes { float v[4]; };
+    std::vector<Lanes> a(count), b(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i);
+        a[i] = {{1.0f + f, (1.0f + f) * 0.5f, (1.0f + f) * 0.25f, 1.0f}};
+        b[i] = {{2.0f + f, (2.0f + f) * 0.5f, (2.0f + f) * 0.25f, 1.0f}};
+    }
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            alignas(16) float d[4];
+            simd::sub(b[i].v, a[i].v, d);
+            simd::scale(0.5f, d, d);
+            simd::add(a[i].v, d, a[i].v);
+        }
+        bench::do_not_optimize(a.data());
+    }
+}
+
+GOF_BENCHMARK("simd/length/float4")
+{
+    struct alignas(16) Lanes { float v[4]; };
+    std::vector<Lanes> a(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = 1.0f + float(i);
+        a[i] = {{f, f * 0.5f, f * 0.25f, 1.0f}};
+    }
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += simd::length<4>(a[i].v);
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+#endif // GOF_MATH_HAS_SSE
@@ -0,0 +1,80 @@
+/*
+ * SPATIAL HASH BENCHMARKS
+ *
+ * Welding of the mesh vertices in vertices per second (reported as ops/sec).
+ * Every vertex of the grid is duplicated with a small offset, as the seams
+ * of the imported meshes are. The exact deduplication by `std::unordered_map`
+ * with `std::hash<Vector3f>` is the baseline.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/spatial/SpatialHash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t side = 64;
+constexpr std::size_t count = 2 * side * side * side;
+
+std::vector<Vector3f> make_vertices() {
+    std::vector<Vector3f> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            for (std::size_t k = 0; k < side; ++k) {
+                const auto p = Vector3f(float(i), float(j), float(k));
+                result.push_back(p);
+                result.push_back(p + Vector3f(1e-4f, -1e-4f, 0.0f));
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("spatial_hash/unordered_map/Vector3f")
+{
+    const auto vertices = make_vertices();
+    std::vector<std::uint32_t> remap(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        std::unordered_map<Vector3f, std::uint32_t> unique;
+        unique.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            remap[i] = unique.try_emplace(vertices[i], std::uint32_t(unique.size())).first->second;
+        }
+        bench::do_not_optimize(remap.data());
+    }
+}
+
+GOF_BENCHMARK("spatial_hash/weld_exact/Vector3f")
+{
+    const auto vertices = make_vertices();
+    std::vector<std::uint32_t> remap(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const auto unique = weld(std::span<const Vector3f>(vertices), 0.0f, std::span(remap));
+        bench::do_not_optimize(unique.data());
+    }
+}
+
+GOF_BENCHMARK("spatial_hash/weld/Vector3f")
+{
+    const auto vertices = make_vertices();
+    std::vector<std::uint32_t> remap(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        const auto unique = weld(std::span<const Vector3f>(vertices), 1e-3f, std::span(remap));
+        bench::do_not_optimize(unique.data());
+    }
+}
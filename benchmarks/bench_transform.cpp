@@ -0,0 +1,121 @@
+/*
+ * TRANSFORM BENCHMARKS
+ *
+ * The throughput of the batched transformations in vertices per second
+ * (reported as ops/sec) compared with one matrix-vector product per vertex.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+#include <gof/math/transform.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 20;
+
+const Matrix4f model(0.5f, -0.2f, 0.1f, 10.0f,
+                     0.3f, 0.9f, -0.4f, -2.0f,
+                     0.0f, 0.7f, 1.1f, 3.5f,
+                     0.0f, 0.0f, 0.0f, 1.0f);
+
+const Matrix4f projection(1.2f, 0.0f, 0.0f, 0.0f,
+                          0.0f, 1.7f, 0.0f, 0.0f,
+                          0.0f, 0.0f, -1.01f, -0.2f,
+                          0.0f, 0.0f, -1.0f, 0.0f);
+
+std::vector<Vector3f> make_points() {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i % 4096) * 0.01f;
+        result[i] = Vector3f(f, 1.0f - f, -5.0f - f);
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("transform/per_vertex/Vector3f")
+{
+    const auto in = make_points();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto r = projection * Vector4f(in[i].x(), in[i].y(), in[i].z(), 1.0f);
+            out[i] = Vector3f(r.x() / r.w(), r.y() / r.w(), r.z() / r.w());
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("transform/points/affine/Vector3f")
+{
+    const auto in = make_points();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform_points(model, std::span<const Vector3f>(in), std::span<Vector3f>(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("transform/points/projective/Vector3f")
+{
+    const auto in = make_points();
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform_points(projection, std::span<const Vector3f>(in), std::span<Vector3f>(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("transform/points/affine/VectorArray3f")
+{
+    const VectorArray3f in(make_points());
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform_points(model, in, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("transform/points/projective/VectorArray3f/streaming")
+{
+    const VectorArray3f in(make_points());
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform_points(projection, in, out, Store::streaming);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("transform/homogeneous/Vector4f")
+{
+    const std::vector<Vector4f> in(count, Vector4f(1.0f, 2.0f, 3.0f, 1.0f));
+    std::vector<Vector4f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform(projection, std::span<const Vector4f>(in), std::span<Vector4f>(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("transform/homogeneous/Vector4f/streaming")
+{
+    const std::vector<Vector4f> in(count, Vector4f(1.0f, 2.0f, 3.0f, 1.0f));
+    std::vector<Vector4f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        transform(projection, std::span<const Vector4f>(in), std::span<Vector4f>(out), Store::streaming);
+        bench::do_not_optimize(out.data());
+    }
+}
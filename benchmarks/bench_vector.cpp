@@ -0,0 +1,208 @@
+/*
+ * VECTOR BENCHMARKS
+ *
+ * Every operator and factory of `Vector` and `Matrix` for N = 2, 3, 4 and
+ * float/double. Each benchmark applies the operation to a batch of operands,
+ * so the reported ns/op is the cost of one operation within a loop.
+ *
+ * The benchmarks are named `vector/<operation>/<type>` and `matrix/<operation>/<type>`.
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1024;
+
+/**
+ * The scalar type of the vector or of the matrix.
+ */
+template <typename X>
+using scalar_t = std::remove_cvref_t<decltype(*std::declval<X&>().data())>;
+
+template <typename T>
+const char* suffix() {
+    return std::is_same_v<T, float> ? "f" : "d";
+}
+
+template <typename V>
+std::vector<V> make_vectors(double seed) {
+    using T = scalar_t<V>;
+    std::vector<V> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t k = 0; k < V::size; ++k) {
+            result[i].data()[k] = T(seed + double((i * 7 + k * 3) % 23) * 0.25);
+        }
+    }
+    return result;
+}
+
+template <typename M>
+std::vector<M> make_matrices(double seed) {
+    using T = scalar_t<M>;
+    std::vector<M> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t k = 0; k < M::rows * M::columns; ++k) {
+            result[i].data()[k] = T(seed + double((i * 5 + k * 3) % 17) * 0.125);
+        }
+    }
+    return result;
+}
+
+/**
+ * The benchmark body computing `out[i] = f(a[i], b[i])` over the batch.
+ */
+template <typename Operand, typename F>
+auto elementwise(std::vector<Operand> (*make)(double), F f) {
+    return [make, f](bench::State& state) {
+        const auto a = make(1.0);
+        const auto b = make(2.0);
+        using R = std::invoke_result_t<F, const Operand&, const Operand&>;
+        // `std::vector<bool>` packs the bits, store the bytes instead.
+        std::vector<std::conditional_t<std::is_same_v<R, bool>, unsigned char, R>> out(count);
+        state.set_items_per_iteration(count);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = f(a[i], b[i]);
+            }
+            bench::do_not_optimize(out.data());
+        }
+    };
+}
+
+/**
+ * Construct the vector from its components.
+ */
+template <typename V>
+V construct(const V& a) {
+    if constexpr(V::size == 2) { return V(a.x(), a.y()); }
+    if constexpr(V::size == 3) { return V(a.x(), a.y(), a.z()); }
+    if constexpr(V::size == 4) { return V(a.x(), a.y(), a.z(), a.w()); }
+}
+
+template <std::size_t N, typename T>
+void register_vector() {
+    using V = Vector<N, T>;
+    const std::string type = "Vector" + std::to_string(N) + suffix<T>();
+    const auto add = [&](const std::string& operation, auto f) {
+        bench::registry().push_back({"vector/" + operation + "/" + type, elementwise<V>(&make_vectors<V>, f)});
+    };
+
+    // CONSTRUCTION AND ACCESS
+    add("construct", [](const V& a, const V&) { return construct(a); });
+    add("copy", [](const V& a, const V&) { V copy(a); return copy; });
+    add("values", [](const V& a, const V&) { return a.values().back(); });
+    add("to_array", [](const V& a, const V&) { return a.to_array(); });
+    add("index", [](const V& a, const V&) { return a[N - 1]; });
+    add("x", [](const V& a, const V&) { return a.x(); });
+    add("y", [](const V& a, const V&) { return a.y(); });
+    if constexpr(N >= 3) {
+        add("z", [](const V& a, const V&) { return a.z(); });
+    }
+    if constexpr(N == 4) {
+        add("w", [](const V& a, const V&) { return a.w(); });
+    }
+
+    // FACTORIES
+    add("zero", [](const V&, const V&) { return V::zero(); });
+    add("ones", [](const V&, const V&) { return V::ones(); });
+    add("unit_x", [](const V&, const V&) { return V::unit_x(); });
+    add("unit_y", [](const V&, const V&) { return V::unit_y(); });
+    if constexpr(N >= 3) {
+        add("unit_z", [](const V&, const V&) { return V::unit_z(); });
+    }
+    if constexpr(N == 4) {
+        add("unit_w", [](const V&, const V&) { return V::unit_w(); });
+    }
+
+    // OPERATORS
+    add("add", [](const V& a, const V& b) { return a + b; });
+    add("sub", [](const V& a, const V& b) { return a - b; });
+    add("sub_scalar", [](const V& a, const V& b) { return a - b.x(); });
+    add("negate", [](const V& a, const V&) { return -a; });
+    add("scale", [](const V& a, const V& b) { return b.x() * a; });
+    add("equal", [](const V& a, const V& b) { return a == b; });
+    add("not_equal", [](const V& a, const V& b) { return a != b; });
+    add("min", [](const V& a, const V& b) { return min(a, b); });
+    add("max", [](const V& a, const V& b) { return max(a, b); });
+
+    // METRICS AND PREDICATES
+    add("length", [](const V& a, const V&) { return a.length(); });
+    add("length_squared", [](const V& a, const V&) { return a.length_squared(); });
+    add("is_zero", [](const V& a, const V&) { return a.is_zero(); });
+    add("is_unit", [](const V& a, const V&) { return a.is_unit(); });
+    add("is_opposite", [](const V& a, const V& b) { return a.is_opposite(b); });
+    add("is_close", [](const V& a, const V& b) { return a.is_close(b); });
+    add("is_close_ulps", [](const V& a, const V& b) { return a.is_close(b, tolerance::Ulps<T>{}); });
+
+    // PRODUCTS
+    add("scalar_product", [](const V& a, const V& b) { return scalar_product(a, b); });
+    if constexpr(N == 3) {
+        add("vector_product", [](const V& a, const V& b) { return vector_product(a, b); });
+    }
+}
+
+template <std::size_t N, typename T>
+void register_matrix() {
+    using M = Matrix<N, N, T>;
+    const std::string type = "Matrix" + std::to_string(N) + suffix<T>();
+    const auto add = [&](const std::string& operation, auto f) {
+        bench::registry().push_back({"matrix/" + operation + "/" + type, elementwise<M>(&make_matrices<M>, f)});
+    };
+
+    add("construct", [](const M& a, const M&) {
+        const T* e = a.data();
+        if constexpr(N == 2) { return M(e[0], e[1], e[2], e[3]); }
+        if constexpr(N == 3) { return M(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8]); }
+        if constexpr(N == 4) {
+            return M(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7],
+                     e[8], e[9], e[10], e[11], e[12], e[13], e[14], e[15]);
+        }
+    });
+    add("copy", [](const M& a, const M&) { M copy(a); return copy; });
+    add("values", [](const M& a, const M&) { return a.values().back(); });
+    add("to_array", [](const M& a, const M&) { return a.to_array(); });
+    add("element", [](const M& a, const M&) { return a(N - 1, 0); });
+    add("row", [](const M& a, const M&) { return a.row(N - 1); });
+    add("column", [](const M& a, const M&) { return a.column(N - 1); });
+    add("row_view", [](const M& a, const M&) { return a.row_view(N - 1)[0]; });
+    add("column_view", [](const M& a, const M&) { return a.column_view(N - 1)[0]; });
+    add("index", [](const M& a, const M&) { return a[N - 1][0]; });
+    add("zero", [](const M&, const M&) { return M::zero(); });
+    add("identity", [](const M&, const M&) { return M::identity(); });
+    add("equal", [](const M& a, const M& b) { return a == b; });
+    add("is_close", [](const M& a, const M& b) { return a.is_close(b); });
+    add("product", [](const M& a, const M& b) { return a * b; });
+    add("product_vector", [](const M& a, const M& b) { return a * b.column(0); });
+}
+
+/**
+ * Register all the combinations before `main()` runs.
+ */
+[[maybe_unused]] const bool registered = [] {
+    register_vector<2, float>();
+    register_vector<3, float>();
+    register_vector<4, float>();
+    register_vector<2, double>();
+    register_vector<3, double>();
+    register_vector<4, double>();
+    register_matrix<2, float>();
+    register_matrix<3, float>();
+    register_matrix<4, float>();
+    register_matrix<2, double>();
+    register_matrix<3, double>();
+    register_matrix<4, double>();
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,129 @@
+/*
+ * VECTOR ARRAY BENCHMARKS
+ *
+ * Compares the batched SoA kernels with the same loop over an array of
+ * `Vector3f` (AoS).
+ */
+
+#include "harness.hpp"
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr std::size_t count = 1 << 16;
+
+std::vector<Vector3f> make_vectors(float seed) {
+    std::vector<Vector3f> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = seed + float(i % 1000);
+        result[i] = Vector3f(f, f * 0.5f, -f);
+    }
+    return result;
+}
+
+} // namespace
+
+GOF_BENCHMARK("aos/add/Vector3f")
+{
+    const auto a = make_vectors(1.0f);
+    const auto b = make_vectors(2.0f);
+    std::vector<Vector3f> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = a[i] + b[i];
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("soa/add/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    const VectorArray3f b(make_vectors(2.0f));
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        add(a, b, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("aos/length/Vector3f")
+{
+    const auto a = make_vectors(1.0f);
+    std::vector<float> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = a[i].length();
+        }
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("soa/length/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    std::vector<float> out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        length(a, std::span<float>(out));
+        bench::do_not_optimize(out.data());
+    }
+}
+
+GOF_BENCHMARK("soa/normalize/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        normalize(a, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("soa/cross/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    const VectorArray3f b(make_vectors(2.0f));
+    VectorArray3f out(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        cross(a, b, out);
+        bench::do_not_optimize(out.lane(0).data());
+    }
+}
+
+GOF_BENCHMARK("aos/is_close/Vector3f")
+{
+    const auto a = make_vectors(1.0f);
+    const auto b = make_vectors(1.0f);
+    const auto out = std::make_unique<bool[]>(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        is_close(std::span<const Vector3f>(a), std::span<const Vector3f>(b), std::span<bool>(out.get(), count));
+        bench::do_not_optimize(out.get());
+    }
+}
+
+GOF_BENCHMARK("soa/is_close/VectorArray3f")
+{
+    const VectorArray3f a(make_vectors(1.0f));
+    const VectorArray3f b(make_vectors(1.0f));
+    const auto out = std::make_unique<bool[]>(count);
+    state.set_items_per_iteration(count);
+    for (auto _ : state) {
+        is_close(a, b, std::span<bool>(out.get(), count));
+        bench::do_not_optimize(out.get());
+    }
+}
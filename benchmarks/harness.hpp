@@ -0,0 +1,198 @@
+// -*- c++, utf-8 -*-
+
+/*
+ * Minimal micro-benchmark harness.
+ *
+ * The benchmarks are registered with `GOF_BENCHMARK(name)` and their body
+ * iterates over the `State` in the same way as Google Benchmark does
+ *
+ *     GOF_BENCHMARK("vector/add") {
+ *         for (auto _ : state) { ... }
+ *     }
+ *
+ * The number of iterations is increased until the measurement takes long
+ * enough to be stable.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gof::bench {
+
+/**
+ * Prevent the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * The state of a running benchmark.
+ */
+class State
+{
+  public:
+
+    explicit State(std::size_t iterations) : _iterations(iterations) { }
+
+    /**
+     * The value of the loop variable, of a type marked as possibly unused so
+     * that `for (auto _ : state)` does not warn.
+     */
+    struct [[maybe_unused]] Value {};
+
+    struct Iterator
+    {
+        std::size_t remaining;
+
+        bool operator !=(const Iterator& that) const noexcept { return remaining != that.remaining; }
+        void operator ++() noexcept { --remaining; }
+        Value operator *() const noexcept { return {}; }
+    };
+
+    Iterator begin() noexcept { return {_iterations}; }
+    Iterator end() noexcept { return {0}; }
+
+    std::size_t iterations() const noexcept { return _iterations; }
+
+    /**
+     * Set the number of items (e.g. vectors) processed in one iteration.
+     *
+     * The throughput is then reported in items per second.
+     */
+    void set_items_per_iteration(std::size_t items) noexcept { _items = items; }
+
+    std::size_t items_per_iteration() const noexcept { return _items; }
+
+  private:
+
+    std::size_t _iterations;
+    std::size_t _items = 1;
+};
+
+/**
+ * The registered benchmark.
+ */
+struct Benchmark
+{
+    std::string name;
+    std::function<void(State&)> body;
+};
+
+/**
+ * The measured result of a benchmark.
+ */
+struct Result
+{
+    std::string name;
+    std::size_t iterations;
+    double ns_per_op;
+    double ops_per_sec;
+};
+
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar
+{
+    Registrar(std::string name, std::function<void(State&)> body) {
+        registry().push_back({std::move(name), std::move(body)});
+    }
+};
+
+/**
+ * Run the benchmark with increasing number of iterations until it runs for
+ * at least `min_time`.
+ */
+inline Result run(const Benchmark& benchmark,
+                  std::chrono::nanoseconds min_time = std::chrono::milliseconds(200)) {
+    using clock = std::chrono::steady_clock;
+
+    // The call without iterations builds the cached data of the benchmark
+    // (e.g. a large point cloud) outside of the measurement.
+    State warm_up(0);
+    benchmark.body(warm_up);
+
+    std::size_t iterations = 1;
+    for (;;) {
+        State state(iterations);
+        const auto start = clock::now();
+        benchmark.body(state);
+        const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start);
+
+        if (elapsed >= min_time || iterations >= (std::size_t{1} << 40)) {
+            const double ops = double(iterations) * double(state.items_per_iteration());
+            return {benchmark.name, iterations, elapsed.count() / ops, ops * 1e9 / elapsed.count()};
+        }
+        // Aim a bit over the minimal time so we rarely need another round.
+        const double ratio = elapsed.count() > 0 ? min_time.count() / elapsed.count() : 100.0;
+        iterations = std::size_t(double(iterations) * std::clamp(ratio * 1.4, 2.0, 100.0));
+    }
+}
+
+/**
+ * Write the results as JSON, the format is close to the one of Google
+ * Benchmark so the same tools can compare the releases
+ *
+ *     {"context": {...}, "benchmarks": [{"name": ..., "ns_per_op": ...}, ...]}
+ *
+ * The context is written as given, its values are JSON strings.
+ */
+inline void write_json(std::FILE* out, const std::vector<std::pair<std::string, std::string>>& context,
+                       const std::vector<Result>& results) {
+    const auto quoted = [](const std::string& text) {
+        std::string result = "\"";
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result + "\"";
+    };
+
+    std::fprintf(out, "{\n  \"context\": {");
+    for (std::size_t i = 0; i < context.size(); ++i) {
+        std::fprintf(out, "%s\n    %s: %s", i ? "," : "", quoted(context[i].first).c_str(),
+                     quoted(context[i].second).c_str());
+    }
+    std::fprintf(out, "\n  },\n  \"benchmarks\": [");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::fprintf(out,
+                     "%s\n    {\"name\": %s, \"iterations\": %zu, \"ns_per_op\": %.6g, \"ops_per_sec\": %.6g}",
+                     i ? "," : "", quoted(r.name).c_str(), r.iterations, r.ns_per_op, r.ops_per_sec);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+#define GOF_BENCH_CONCAT_IMPL(a, b) a##b
+#define GOF_BENCH_CONCAT(a, b) GOF_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * Register a benchmark. The body receives `gof::bench::State& state`.
+ */
+#define GOF_BENCHMARK(name)                                                        \
+    static void GOF_BENCH_CONCAT(gof_benchmark_, __LINE__)(gof::bench::State&);    \
+    static const gof::bench::Registrar GOF_BENCH_CONCAT(gof_registrar_, __LINE__)( \
+        name, GOF_BENCH_CONCAT(gof_benchmark_, __LINE__));                         \
+    static void GOF_BENCH_CONCAT(gof_benchmark_, __LINE__)([[maybe_unused]] gof::bench::State& state)
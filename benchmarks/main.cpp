@@ -0,0 +1,99 @@
+/*
+ * BENCHMARK RUNNER
+ *
+ * Usage: vector_bench [--json] [--min-time=<ms>] [filter]
+ *
+ * Runs all registered benchmarks whose name contains `filter` and prints
+ * a table, or with `--json` the JSON document (see `write_json()`) to keep
+ * and compare between releases
+ *
+ *     vector_bench --json > baseline.json
+ */
+
+#include "harness.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Describe the build, so the results of different builds are not mixed up.
+ */
+std::vector<std::pair<std::string, std::string>> context() {
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::gmtime(&now));
+
+#if defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+
+#ifdef NDEBUG
+    const std::string build_type = "release";
+#else
+    const std::string build_type = "debug";
+#endif
+
+#ifdef GOF_MATH_SIMD
+    const std::string simd = "true";
+#else
+    const std::string simd = "false";
+#endif
+
+    return {{"date", date}, {"compiler", compiler}, {"build_type", build_type}, {"simd", simd}};
+}
+
+} // namespace
+
+int main(int argc, char const *argv[])
+{
+    bool json = false;
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(200);
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            min_time = std::chrono::milliseconds(std::stoi(arg.substr(11)));
+        } else if (arg.rfind("--", 0) == 0) {
+            std::fprintf(stderr, "Usage: %s [--json] [--min-time=<ms>] [filter]\n", argv[0]);
+            return 1;
+        } else {
+            filter = arg;
+        }
+    }
+
+    if (!json) {
+        std::printf("%-48s %14s %14s %16s\n", "benchmark", "iterations", "ns/op", "ops/sec");
+    }
+    std::vector<gof::bench::Result> results;
+    for (const auto& benchmark : gof::bench::registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        const auto r = gof::bench::run(benchmark, min_time);
+        if (json) {
+            results.push_back(r);
+        } else {
+            std::printf("%-48s %14zu %14.3f %16.0f\n", r.name.c_str(), r.iterations, r.ns_per_op, r.ops_per_sec);
+        }
+    }
+    if (json) {
+        gof::bench::write_json(stdout, context(), results);
+    }
+
+    return 0;
+}
@@ -1,4 +1,23 @@
+#pragma once
+
+#ifndef COMMON_HEADER_GUARD
+#define COMMON_HEADER_GUARD
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
 #include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// The fused multiply-add instruction is available (`-mfma`, `/arch:AVX2`).
+#if defined(__FMA__) || defined(__AVX2__)
+#define GOF_MATH_HAS_FMA 1
+#else
+#define GOF_MATH_HAS_FMA 0
+#endif
 
 
 namespace gof {
@@ -16,33 +35,400 @@ struct is_complex<std::complex<T>> : std::true_type {};
 template< class T >
 inline constexpr bool is_complex_v = is_complex<T>::value;
 
+/**
+ * Opt-in of the user-defined scalar types (e.g. `Half` or `Fixed`).
+ *
+ * Specialize it as `std::true_type` for the type that provides the arithmetic
+ * operators, the comparison and the construction from the integer literals.
+ */
+template <typename T>
+struct is_custom_number : std::false_type {};
+
+/// Helper variable template
+template< class T >
+inline constexpr bool is_custom_number_v = is_custom_number<T>::value;
+
 /**
  * The concept for numeric types.
  *
  * This is useful for algebraic types such as vector and matrices.
  */
 template <typename T>
-concept Number = std::is_arithmetic_v<T> || is_complex_v<T>;
+concept Number = std::is_arithmetic_v<T> || is_complex_v<T> || is_custom_number_v<T>;
+
+/**
+ * The base of the lazily evaluated expressions (see `Expression.hpp`).
+ */
+struct expression_tag {};
+
+/**
+ * The concept for the expression templates.
+ *
+ * The expression is evaluated component by component through `at(k, i)`,
+ * where `k` is the component and `i` the index of the vector in bulk data.
+ */
+template <typename E>
+concept Expression = std::derived_from<std::remove_cvref_t<E>, expression_tag>;
+
+
+//------ ARITHMETIC ------//
+
+/**
+ * Calculate `a * b + c`.
+ *
+ * When the target has the FMA instruction the result is computed with
+ * a single rounding, otherwise (and in constant expressions) the plain
+ * multiplication and addition are used, since the software `std::fma` is slow.
+ */
+template <Number T>
+constexpr T multiply_add(T const& a, T const& b, T const& c) noexcept {
+    if constexpr(std::is_floating_point_v<T> && GOF_MATH_HAS_FMA) {
+        if (!std::is_constant_evaluated()) {
+            return std::fma(a, b, c);
+        }
+    }
+    return a * b + c;
+}
+
+/**
+ * Calculate `a * b - c * d`.
+ *
+ * With the FMA instruction the rounding errors of both products are recovered
+ * exactly and subtracted separately, so the result stays accurate under the
+ * cancellation. The form is symmetric: the equal products give exactly zero
+ * and swapping the pairs negates the result exactly, which the plain
+ * `multiply_add(a, b, -(c * d))` does not guarantee. The overflowing product
+ * gives NaN rather than the infinity.
+ */
+template <Number T>
+constexpr T difference_of_products(T const& a, T const& b, T const& c, T const& d) noexcept {
+    const T p = a * b;
+    const T q = c * d;
+    const T ep = multiply_add(a, b, -p);
+    const T eq = multiply_add(c, d, -q);
+    return (p - q) + (ep - eq);
+}
+
+namespace detail {
+
+/**
+ * The absolute value, `std::abs()` is not `constexpr`.
+ */
+template <typename T>
+constexpr T absolute(T const& x) noexcept {
+    return x < T{0} ? -x : x;
+}
+
+} // namespace detail
+
+//------ CONSTANT EVALUATION ------//
+
+/**
+ * The elementary functions usable in the constant expressions.
+ *
+ * The `<cmath>` functions are not `constexpr` (before C++26). At run time these
+ * call them, in the constant expressions they evaluate the series in `long
+ * double` instead. The results are within one ulp of `<cmath>` for `float`
+ * and `double`.
+ */
+namespace cmath {
+
+namespace detail {
+
+inline constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+/**
+ * The square root of the non-negative finite number by the Newton's method.
+ */
+constexpr long double sqrt(long double x) noexcept {
+    if (!(x > 0.0L)) {
+        return 0.0L;
+    }
+    // Scale to [1/4, 4) by the powers of four, so a few iterations suffice.
+    long double scale = 1.0L;
+    while (x >= 4.0L) { x *= 0.25L; scale *= 2.0L; }
+    while (x < 0.25L) { x *= 4.0L; scale *= 0.5L; }
+    long double r = 1.0L;
+    for (int i = 0; i < 16; ++i) {
+        const long double next = 0.5L * (r + x / r);
+        if (next == r) {
+            break;
+        }
+        r = next;
+    }
+    return r * scale;
+}
+
+/**
+ * The sine of the finite number by the Taylor series.
+ */
+constexpr long double sin(long double x) noexcept {
+    // Reduce to [-pi, pi].
+    const long double turns = x / (2.0L * pi);
+    x -= 2.0L * pi * static_cast<long double>(static_cast<long long>(turns + (turns < 0.0L ? -0.5L : 0.5L)));
+    long double term = x;
+    long double sum = x;
+    for (int n = 1; n < 40 && term != 0.0L; ++n) {
+        term *= -x * x / static_cast<long double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * The arc tangent of the finite number by the Taylor series.
+ */
+constexpr long double atan(long double x) noexcept {
+    // Halve the angle three times with `atan(x) = 2 atan(x / (1 + sqrt(1 + x^2)))`,
+    // so the series converges quickly.
+    for (int i = 0; i < 3; ++i) {
+        x = x / (1.0L + sqrt(1.0L + x * x));
+    }
+    long double power = x;
+    long double sum = x;
+    for (int n = 1; n < 60; ++n) {
+        power *= -x * x;
+        const long double next = sum + power / static_cast<long double>(2 * n + 1);
+        if (next == sum) {
+            break;
+        }
+        sum = next;
+    }
+    return 8.0L * sum;
+}
+
+} // namespace detail
+
+template <std::floating_point T>
+constexpr T sqrt(T x) noexcept {
+    if (std::is_constant_evaluated()) {
+        if (x < T{0}) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        if (x != x || x == T{0} || x == std::numeric_limits<T>::infinity()) {
+            return x;
+        }
+        return static_cast<T>(detail::sqrt(static_cast<long double>(x)));
+    }
+    return std::sqrt(x);
+}
+
+template <std::floating_point T>
+constexpr T sin(T x) noexcept {
+    if (std::is_constant_evaluated()) {
+        if (x != x || x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity()) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        return static_cast<T>(detail::sin(static_cast<long double>(x)));
+    }
+    return std::sin(x);
+}
 
+template <std::floating_point T>
+constexpr T cos(T x) noexcept {
+    if (std::is_constant_evaluated()) {
+        if (x != x || x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity()) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        return static_cast<T>(detail::sin(detail::pi / 2.0L - static_cast<long double>(x)));
+    }
+    return std::cos(x);
+}
+
+template <std::floating_point T>
+constexpr T acos(T x) noexcept {
+    if (std::is_constant_evaluated()) {
+        if (!(x >= T{-1} && x <= T{1})) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        if (x == T{-1}) {
+            return static_cast<T>(detail::pi);
+        }
+        const long double y = static_cast<long double>(x);
+        return static_cast<T>(2.0L * detail::atan(detail::sqrt((1.0L - y) / (1.0L + y))));
+    }
+    return std::acos(x);
+}
+
+} // namespace cmath
 
 //------ EQUALITY ------//
 
 /**
- * Equality of floating point numbers. It is better to dedicate a strategy how to compare
- * the number to the standalone class.
+ * The strategies comparing the scalars with a tolerance.
+ *
+ * The strategy is a function object, `tolerance(a, b)` is true when `a` and
+ * `b` are considered equal. Its `squared()` is the strategy for the squares of
+ * the compared quantities, so e.g. `is_unit()` compares the squared length
+ * with one and no square root is needed.
+ */
+namespace tolerance {
+
+/**
+ * The exact comparison `a == b`.
+ *
+ * The default of the integers and the complex numbers.
+ */
+struct Exact
+{
+    template <typename T>
+    constexpr bool operator ()(T const& a, T const& b) const noexcept {
+        return a == b;
+    }
+
+    constexpr Exact squared() const noexcept {
+        return *this;
+    }
+};
+
+/**
+ * The comparison `|a - b| <= epsilon`.
+ *
+ * Suitable when the magnitude of the values is known, e.g. the unit vectors.
  */
-// template <typename NumericType>
-// struct equalizer {
-//     /**
-//      * Test whenever two floating point numbers are equal.
-//      */
-//     constexpr bool is_equal() {
-//         return
-//     }
+template <Number T>
+struct Absolute
+{
+    T epsilon = T{4} * std::numeric_limits<T>::epsilon();
 
-//     constexpr bool is_near_equal() {
+    constexpr bool operator ()(T const& a, T const& b) const noexcept {
+        return (a == b) | (detail::absolute(a - b) <= epsilon);
+    }
 
-//     }
-// }
+    constexpr Absolute squared() const noexcept {
+        return {epsilon * (T{2} + epsilon)};
+    }
+};
 
+/**
+ * The comparison `|a - b| <= max(absolute, relative * max(|a|, |b|))`.
+ *
+ * The absolute part applies near zero, where the relative difference of
+ * the rounding errors is arbitrarily large. The default of the floating
+ * point and the custom scalars.
+ */
+template <Number T>
+struct Relative
+{
+    T relative = T{4} * std::numeric_limits<T>::epsilon();
+    T absolute = T{4} * std::numeric_limits<T>::epsilon();
+
+    constexpr bool operator ()(T const& a, T const& b) const noexcept {
+        const T scale = std::max(detail::absolute(a), detail::absolute(b));
+        const T difference = detail::absolute(a - b);
+        // The finite bound excludes the infinities of the opposite signs.
+        // Without the short-circuit evaluation, so the loops are vectorized.
+        return (a == b) | ((difference <= std::max(absolute, relative * scale))
+                           & (difference <= std::numeric_limits<T>::max()));
+    }
+
+    constexpr Relative squared() const noexcept {
+        return {relative * (T{2} + relative), absolute * (T{2} + absolute)};
+    }
+};
+
+/**
+ * The comparison of the distance in the units in the last place, i.e. the
+ * number of representable values between `a` and `b`.
+ *
+ * The zeros of both signs are equal, NaN is not equal to anything.
+ */
+template <std::floating_point T>
+    requires (sizeof(T) == 4 || sizeof(T) == 8)
+struct Ulps
+{
+    std::uint64_t ulps = 4;
+
+    constexpr bool operator ()(T const& a, T const& b) const noexcept {
+        if (a != a || b != b) {
+            return false;
+        }
+        const bits x = ordered(a);
+        const bits y = ordered(b);
+        const std::uint64_t distance = x < y ? std::uint64_t(unsigned_bits(y) - unsigned_bits(x))
+                                             : std::uint64_t(unsigned_bits(x) - unsigned_bits(y));
+        return distance <= ulps;
+    }
+
+    constexpr Ulps squared() const noexcept {
+        return {2 * ulps + 1};
+    }
+
+  private:
+
+    using bits = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+    using unsigned_bits = std::make_unsigned_t<bits>;
+
+    /**
+     * Map the sign and magnitude of `x` to the integers ordered as the values.
+     */
+    static constexpr bits ordered(T x) noexcept {
+        const bits i = std::bit_cast<bits>(x);
+        return i < 0 ? bits(unsigned_bits(std::numeric_limits<bits>::min()) - unsigned_bits(i)) : i;
+    }
+};
+
+/**
+ * The strategy used when none is given.
+ */
+template <typename T>
+using Default = std::conditional_t<
+    std::is_floating_point_v<T> || is_custom_number_v<T>, Relative<T>, Exact>;
+
+} // namespace tolerance
+
+/**
+ * The concept for the comparison strategies of the scalars `T`.
+ */
+template <typename C, typename T>
+concept Tolerance = requires(const C& tolerance, const T& a, const T& b) {
+    { tolerance(a, b) } -> std::convertible_to<bool>;
+    { tolerance.squared() };
+};
+
+//------ HASHING ------//
+
+/**
+ * Mix the bits of the value, so the nearby keys land in distant buckets
+ * (the finalizer of MurmurHash3).
+ */
+constexpr std::uint64_t hash_mix(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Combine the hash of the next element with the hash of the previous ones.
+ */
+constexpr std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t value) noexcept {
+    return hash_mix(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+/**
+ * The bits of the scalar to be hashed, equal scalars have equal bits.
+ *
+ * The zeros of both signs are equal, so `-0` is hashed as `+0`.
+ */
+template <Number T>
+constexpr std::uint64_t hash_bits(T const& x) noexcept {
+    if constexpr(std::is_integral_v<T>) {
+        return static_cast<std::uint64_t>(x);
+    } else if constexpr(std::is_same_v<T, float>) {
+        return std::bit_cast<std::uint32_t>(x == 0.0f ? 0.0f : x);
+    } else if constexpr(std::is_same_v<T, double>) {
+        return std::bit_cast<std::uint64_t>(x == 0.0 ? 0.0 : x);
+    } else if constexpr(is_complex_v<T>) {
+        return hash_combine(hash_bits(x.real()), hash_bits(x.imag()));
+    } else {
+        // The `long double` and the custom scalars are exact in `double`.
+        return hash_bits(static_cast<double>(x));
+    }
 }
+
+}
+
+#endif // guard
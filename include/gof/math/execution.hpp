@@ -0,0 +1,524 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef EXECUTION_HEADER_GUARD
+#define EXECUTION_HEADER_GUARD
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gof/math/common.hpp> // Number
+#include <gof/math/memory.hpp> // cache_line_size
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/spatial/Aabb.hpp>
+#include <gof/math/transform.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * Execution policies for the bulk operations.
+ *
+ * The bulk operations at the end of this file take the policy as their first
+ * argument, in the same way as the standard parallel algorithms
+ *
+ *     transform_points(execution::par, m, in, out);
+ *     auto [lower, upper] = bounding_box(execution::par, points);
+ */
+
+namespace gof {
+
+/*----------------------------------------------------------------------------*/
+/*                                THREAD POOL                                 */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The work-stealing thread pool.
+ *
+ * Each worker owns a queue of chunks. It takes the work from the back of its
+ * own queue and when the queue is empty it steals from the front of the other
+ * queues. The thread calling `parallel_for()` helps with the work until all
+ * chunks are done, so the pool works even without any worker threads.
+ */
+class ThreadPool
+{
+  public:
+
+    /**
+     * Constructor starting `workers` threads (the calling thread is the
+     * additional one).
+     */
+    explicit ThreadPool(std::size_t workers = default_workers()) : _queues(std::max<std::size_t>(workers, 1)) {
+        _threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            _threads.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * The number of threads running the work including the calling thread.
+     */
+    std::size_t concurrency() const noexcept { return _threads.size() + 1; }
+
+    /**
+     * Call `f(first, last)` for the consecutive chunks of `[0, count)` with at
+     * most `grain` elements and wait until all of them finish.
+     *
+     * The function must not throw.
+     */
+    template <typename F>
+    void parallel_for(std::size_t count, std::size_t grain, F&& f) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1 || _threads.empty()) {
+            for (std::size_t first = 0; first < count; first += grain) {
+                f(first, std::min(first + grain, count));
+            }
+            return;
+        }
+
+        using Function = std::remove_reference_t<F>;
+        std::atomic<std::size_t> remaining{chunks};
+        const Task prototype{
+            [](const void* context, std::size_t first, std::size_t last) {
+                (*static_cast<Function*>(const_cast<void*>(context)))(first, last);
+            },
+            &f, 0, 0, &remaining,
+        };
+
+        {
+            std::lock_guard lock(_mutex);
+            _pending += chunks;
+        }
+
+        // Give every queue a contiguous part of the chunks, so the workers
+        // steal only when their own part is done.
+        const std::size_t n = _queues.size();
+        for (std::size_t q = 0; q < n; ++q) {
+            std::lock_guard lock(_queues[q].mutex);
+            for (std::size_t c = q * chunks / n; c < (q + 1) * chunks / n; ++c) {
+                Task task = prototype;
+                task.first = c * grain;
+                task.last = std::min(task.first + grain, count);
+                _queues[q].push(task);
+            }
+        }
+        _wake.notify_all();
+
+        // Help until the chunks of this call are done.
+        std::size_t victim = 0;
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            if (!run_one(victim++ % n)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * The process-wide pool shared by the `execution::par` policy.
+     */
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    static std::size_t default_workers() noexcept {
+        const std::size_t threads = std::thread::hardware_concurrency();
+        return threads > 1 ? threads - 1 : 0;
+    }
+
+  private:
+
+    struct Task
+    {
+        void (*function)(const void*, std::size_t, std::size_t);
+        const void* context;
+        std::size_t first;
+        std::size_t last;
+        std::atomic<std::size_t>* remaining;
+    };
+
+    /**
+     * The ring buffer of tasks. It only grows, so after the warm-up it does
+     * not allocate.
+     */
+    struct Queue
+    {
+        std::mutex mutex;
+        std::vector<Task> ring = std::vector<Task>(64);
+        std::size_t head = 0;
+        std::size_t size = 0;
+
+        void push(const Task& task) {
+            if (size == ring.size()) {
+                std::vector<Task> bigger(2 * ring.size());
+                for (std::size_t i = 0; i < size; ++i) {
+                    bigger[i] = ring[(head + i) % ring.size()];
+                }
+                ring.swap(bigger);
+                head = 0;
+            }
+            ring[(head + size) % ring.size()] = task;
+            ++size;
+        }
+
+        bool pop_back(Task& task) {
+            if (size == 0) return false;
+            --size;
+            task = ring[(head + size) % ring.size()];
+            return true;
+        }
+
+        bool pop_front(Task& task) {
+            if (size == 0) return false;
+            task = ring[head];
+            head = (head + 1) % ring.size();
+            --size;
+            return true;
+        }
+    };
+
+    /**
+     * Run one task from the own queue or steal one. Return false when there
+     * is no work at all.
+     */
+    bool run_one(std::size_t self) {
+        Task task;
+        bool found = false;
+        {
+            std::lock_guard lock(_queues[self].mutex);
+            found = _queues[self].pop_back(task);
+        }
+        for (std::size_t i = 1; !found && i < _queues.size(); ++i) {
+            auto& victim = _queues[(self + i) % _queues.size()];
+            std::lock_guard lock(victim.mutex);
+            found = victim.pop_front(task);
+        }
+        if (!found) {
+            return false;
+        }
+        {
+            std::lock_guard lock(_mutex);
+            --_pending;
+        }
+        task.function(task.context, task.first, task.last);
+        task.remaining->fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void work(std::size_t self) {
+        for (;;) {
+            if (run_one(self)) {
+                continue;
+            }
+            std::unique_lock lock(_mutex);
+            _wake.wait(lock, [this] { return _stop || _pending > 0; });
+            if (_stop) {
+                return;
+            }
+        }
+    }
+
+    std::vector<Queue> _queues;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::size_t _pending = 0;
+    bool _stop = false;
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 POLICIES                                   */
+/*----------------------------------------------------------------------------*/
+
+namespace execution {
+
+/**
+ * Run the operation in the calling thread in the order of the elements.
+ */
+struct sequenced_policy {};
+
+/**
+ * Run the operation in the calling thread, the reductions may use several
+ * independent accumulators so they vectorize (the order of the floating
+ * point operations differs from `seq`).
+ */
+struct unsequenced_policy {};
+
+/**
+ * Run the operation across the threads of the pool.
+ */
+struct parallel_policy
+{
+    /**
+     * The pool, `nullptr` means `ThreadPool::global()`.
+     */
+    ThreadPool* pool = nullptr;
+
+    /**
+     * The number of elements per chunk, zero means the default.
+     */
+    std::size_t grain = 0;
+
+    /**
+     * When set, the chunks do not depend on the number of threads, so the
+     * floating point reductions give the same result on every machine and
+     * in every run. Otherwise the work is split by the number of threads.
+     */
+    bool deterministic = false;
+
+    ThreadPool& thread_pool() const { return pool ? *pool : ThreadPool::global(); }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr unsequenced_policy unseq{};
+inline constexpr parallel_policy par{};
+
+template <typename P>
+concept Policy = std::is_same_v<P, sequenced_policy> || std::is_same_v<P, unsequenced_policy> ||
+                 std::is_same_v<P, parallel_policy>;
+
+} // namespace execution
+
+namespace detail {
+
+/**
+ * The number of elements of type `E` in a chunk.
+ *
+ * The chunks are multiples of whole cache lines (so the threads never write
+ * the same line) and by default about the size of the L1 cache.
+ */
+template <typename E>
+std::size_t chunk_size(const execution::parallel_policy& policy, std::size_t count) {
+    constexpr std::size_t line = std::lcm(sizeof(E), cache_line_size) / sizeof(E);
+    constexpr std::size_t l1 = 32 * 1024;
+    std::size_t grain = policy.grain;
+    if (grain == 0) {
+        if (policy.deterministic) {
+            grain = std::max<std::size_t>(l1 / sizeof(E), 1);
+        } else {
+            // A few chunks per thread so the stealing can balance the load.
+            const std::size_t chunks = 4 * policy.thread_pool().concurrency();
+            grain = std::max<std::size_t>((count + chunks - 1) / chunks, l1 / sizeof(E));
+        }
+    }
+    return (grain + line - 1) / line * line;
+}
+
+/**
+ * Call `f(first, last)` on the chunks of `[0, count)` according to the policy.
+ */
+template <typename E, execution::Policy P, typename F>
+void for_each_chunk(const P& policy, std::size_t count, F&& f) {
+    if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+        policy.thread_pool().parallel_for(count, chunk_size<E>(policy, count), f);
+    } else {
+        if (count > 0) {
+            f(std::size_t{0}, count);
+        }
+    }
+}
+
+/**
+ * Reduce `[0, count)` with `map(i)` and `combine(a, b)` according to the policy.
+ */
+template <typename E, execution::Policy P, typename R, typename Map, typename Combine>
+R reduce(const P& policy, std::size_t count, R identity, Map map, Combine combine) {
+    if constexpr(std::is_same_v<P, execution::sequenced_policy>) {
+        R result = identity;
+        for (std::size_t i = 0; i < count; ++i) {
+            result = combine(result, map(i));
+        }
+        return result;
+    }
+    if constexpr(std::is_same_v<P, execution::unsequenced_policy>) {
+        R partial[4] = {identity, identity, identity, identity};
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            partial[0] = combine(partial[0], map(i));
+            partial[1] = combine(partial[1], map(i + 1));
+            partial[2] = combine(partial[2], map(i + 2));
+            partial[3] = combine(partial[3], map(i + 3));
+        }
+        for (; i < count; ++i) {
+            partial[0] = combine(partial[0], map(i));
+        }
+        return combine(combine(partial[0], partial[1]), combine(partial[2], partial[3]));
+    }
+    if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+        const std::size_t grain = chunk_size<E>(policy, count);
+        const std::size_t chunks = (count + grain - 1) / grain;
+        std::vector<R> partials(chunks, identity);
+        policy.thread_pool().parallel_for(count, grain, [&](std::size_t first, std::size_t last) {
+            R result = identity;
+            for (std::size_t i = first; i < last; ++i) {
+                result = combine(result, map(i));
+            }
+            partials[first / grain] = result;
+        });
+        // The partial results are combined in the order of the chunks.
+        R result = identity;
+        for (const auto& partial : partials) {
+            result = combine(result, partial);
+        }
+        return result;
+    }
+}
+
+} // namespace detail
+
+
+/*----------------------------------------------------------------------------*/
+/*                              BULK OPERATIONS                               */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Transform the points, see `transform_points()` in `transform.hpp`.
+ */
+template <execution::Policy P, Number T, Layout L>
+void transform_points(const P& policy, const Matrix<4, 4, T, L>& m, std::span<const Vector<3, T>> in,
+                      std::span<Vector<3, T>> out) {
+    assert(in.size() == out.size());
+    detail::for_each_chunk<Vector<3, T>>(policy, in.size(), [&](std::size_t first, std::size_t last) {
+        transform_points(m, in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+/**
+ * Transform the directions, see `transform_directions()` in `transform.hpp`.
+ */
+template <execution::Policy P, Number T, Layout L>
+void transform_directions(const P& policy, const Matrix<4, 4, T, L>& m, std::span<const Vector<3, T>> in,
+                          std::span<Vector<3, T>> out) {
+    assert(in.size() == out.size());
+    detail::for_each_chunk<Vector<3, T>>(policy, in.size(), [&](std::size_t first, std::size_t last) {
+        transform_directions(m, in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+/**
+ * Transform the homogeneous vectors, see `transform()` in `transform.hpp`.
+ */
+template <execution::Policy P, Number T, Layout L>
+void transform(const P& policy, const Matrix<4, 4, T, L>& m, std::span<const Vector<4, T>> in,
+               std::span<Vector<4, T>> out, Store store = Store::cached) {
+    assert(in.size() == out.size());
+    detail::for_each_chunk<Vector<4, T>>(policy, in.size(), [&](std::size_t first, std::size_t last) {
+        transform(m, in.subspan(first, last - first), out.subspan(first, last - first), store);
+    });
+}
+
+/**
+ * Normalize the vectors to the unit length. The zero vectors stay zero.
+ */
+template <execution::Policy P, std::size_t N, std::floating_point T>
+void normalize(const P& policy, std::span<const Vector<N, T>> in, std::span<Vector<N, T>> out) {
+    assert(in.size() == out.size());
+    detail::for_each_chunk<Vector<N, T>>(policy, in.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const T length = in[i].length();
+            out[i] = (length > T{0} ? T{1} / length : T{0}) * in[i];
+        }
+    });
+}
+
+/**
+ * The sum of the vectors.
+ */
+template <execution::Policy P, std::size_t N, Number T>
+Vector<N, T> sum(const P& policy, std::span<const Vector<N, T>> vectors) {
+    return detail::reduce<Vector<N, T>>(
+        policy, vectors.size(), Vector<N, T>::zero(),
+        [&](std::size_t i) -> const Vector<N, T>& { return vectors[i]; },
+        [](const Vector<N, T>& a, const Vector<N, T>& b) { return a + b; });
+}
+
+/**
+ * The component-wise minimum of the vectors. It is `+inf` (or the maximal
+ * value) for the empty span.
+ */
+template <execution::Policy P, std::size_t N, Number T>
+Vector<N, T> minimum(const P& policy, std::span<const Vector<N, T>> vectors) {
+    constexpr T limit = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                              : std::numeric_limits<T>::max();
+    Vector<N, T> identity;
+    std::fill_n(identity.data(), N, limit);
+    return detail::reduce<Vector<N, T>>(
+        policy, vectors.size(), identity,
+        [&](std::size_t i) -> const Vector<N, T>& { return vectors[i]; },
+        [](const Vector<N, T>& a, const Vector<N, T>& b) { return min(a, b); });
+}
+
+/**
+ * The component-wise maximum of the vectors. It is `-inf` (or the lowest
+ * value) for the empty span.
+ */
+template <execution::Policy P, std::size_t N, Number T>
+Vector<N, T> maximum(const P& policy, std::span<const Vector<N, T>> vectors) {
+    constexpr T limit = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                              : std::numeric_limits<T>::lowest();
+    Vector<N, T> identity;
+    std::fill_n(identity.data(), N, limit);
+    return detail::reduce<Vector<N, T>>(
+        policy, vectors.size(), identity,
+        [&](std::size_t i) -> const Vector<N, T>& { return vectors[i]; },
+        [](const Vector<N, T>& a, const Vector<N, T>& b) { return max(a, b); });
+}
+
+/**
+ * The axis-aligned box bounding the vectors computed in a single pass, see
+ * `bounding_box()` in `spatial/Aabb.hpp`.
+ *
+ * The parallel policy bounds the chunks in the threads of the pool and merges
+ * their boxes.
+ */
+template <execution::Policy P, std::size_t N, Number T>
+Aabb<N, T> bounding_box(const P& policy, std::span<const Vector<N, T>> vectors) {
+    if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+        const std::size_t grain = detail::chunk_size<Vector<N, T>>(policy, vectors.size());
+        std::vector<Aabb<N, T>> partials((vectors.size() + grain - 1) / grain);
+        policy.thread_pool().parallel_for(vectors.size(), grain, [&](std::size_t first, std::size_t last) {
+            partials[first / grain] = bounding_box(vectors.subspan(first, last - first));
+        });
+        Aabb<N, T> result;
+        for (const auto& partial : partials) {
+            result = result.merge(partial);
+        }
+        return result;
+    } else {
+        return bounding_box(vectors);
+    }
+}
+
+} // namespace
+
+#endif // guard
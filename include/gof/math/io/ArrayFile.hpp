@@ -0,0 +1,903 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef ARRAY_FILE_HEADER_GUARD
+#define ARRAY_FILE_HEADER_GUARD
+
+/*
+ * THE BINARY ARRAY FILES
+ *
+ * The arrays of vectors or matrices are stored in the native representation
+ * of the scalars behind a fixed 64 byte header, so the reader maps the file
+ * and hands out the spans of the mapped memory instead of parsing it
+ *
+ *     offset  size  field
+ *          0     8  magic "GOFARRAY"
+ *          8     4  version (1)
+ *         12     4  byte order marker 0x01020304 written natively
+ *         16     1  scalar type (`ScalarType`)
+ *         17     1  scalar size in bytes
+ *         18     1  layout of the payload (`Layout`)
+ *         19     1  layout of the matrix elements (`Layout`)
+ *         20     4  rows of the element (`N` of the vectors)
+ *         24     4  columns of the element (1 for the vectors)
+ *         28     4  alignment of the payload and of the lanes in bytes
+ *         32     8  count of the elements
+ *         40     8  stride in scalars (see below)
+ *         48     8  checksum of the payload
+ *         56     8  reserved (zero)
+ *
+ * The payload starts on the first multiple of the alignment after the header
+ * and it is either
+ *
+ *   - `Layout::row_major`: the elements one after another (AoS), each one as
+ *     `rows * columns` scalars in the order of its `data()`, the stride is
+ *     `rows * columns`,
+ *   - `Layout::column_major`: one lane per component (SoA) as in
+ *     `VectorArray` and `MatrixArray`, the lane of the component `e` (the
+ *     element `(i, j)` is the component `i * columns + j`) starts at the
+ *     scalar `e * stride` of the payload and each lane starts on the
+ *     alignment.
+ *
+ * The checksum is the XXH64 (seed 0) of the XXH64 digests of the streams
+ * stored as `std::uint64_t`, where the stream is the whole payload of the
+ * row-major file or one lane of the column-major file (without the padding).
+ *
+ * The files are not portable between the byte orders: the reader refuses the
+ * file written with the other byte order, converting it would need a copy.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GOF_MATH_HAS_MMAP
+#endif
+
+#include <gof/math/common.hpp> // Number
+#include <gof/math/memory.hpp>
+#include <gof/math/io/Status.hpp>
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/scalar/Half.hpp>
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+namespace gof::io {
+
+/**
+ * The scalar types of the array files.
+ */
+enum class ScalarType : std::uint8_t
+{
+    int8 = 1,
+    int16,
+    int32,
+    int64,
+    uint8,
+    uint16,
+    uint32,
+    uint64,
+    float16,  ///< `Half`
+    bfloat16, ///< `BFloat16`
+    float32,
+    float64,
+};
+
+/**
+ * Whether the scalars of type `T` can be stored in the array file: the
+ * floating-point types of `ScalarType` and the integers of at most 64 bits.
+ */
+template <typename T>
+struct is_array_scalar
+    : std::bool_constant<std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, Half> ||
+                         std::is_same_v<T, BFloat16> ||
+                         (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8)> {};
+
+/// Helper variable template
+template <class T>
+inline constexpr bool is_array_scalar_v = is_array_scalar<T>::value;
+
+/**
+ * The scalar type code of `T`.
+ */
+template <typename T>
+    requires is_array_scalar_v<T>
+constexpr ScalarType scalar_type_of() noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        return ScalarType::float32;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return ScalarType::float64;
+    } else if constexpr (std::is_same_v<T, Half>) {
+        return ScalarType::float16;
+    } else if constexpr (std::is_same_v<T, BFloat16>) {
+        return ScalarType::bfloat16;
+    } else {
+        constexpr std::size_t index = std::bit_width(sizeof(T)) - 1; // 0, 1, 2, 3
+        return static_cast<ScalarType>((std::is_signed_v<T> ? 1 : 5) + index);
+    }
+}
+
+/**
+ * The header of the array file (see the description of the format above).
+ */
+struct Header
+{
+    static constexpr std::array<char, 8> signature = {'G', 'O', 'F', 'A', 'R', 'R', 'A', 'Y'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t byte_order_marker = 0x01020304;
+
+    std::array<char, 8> magic = {};
+    std::uint32_t version = 0;
+    std::uint32_t byte_order = 0;
+    std::uint8_t scalar = 0;
+    std::uint8_t scalar_size = 0;
+    std::uint8_t layout = 0;
+    std::uint8_t element_layout = 0;
+    std::uint32_t rows = 0;
+    std::uint32_t columns = 0;
+    std::uint32_t alignment = 0;
+    std::uint64_t count = 0;
+    std::uint64_t stride = 0;
+    std::uint64_t checksum = 0;
+    std::uint64_t reserved = 0;
+
+    /**
+     * The offset of the payload from the start of the file.
+     */
+    constexpr std::uint64_t payload_offset() const noexcept {
+        return (sizeof(Header) + alignment - 1) / alignment * alignment;
+    }
+};
+
+static_assert(sizeof(Header) == 64 && std::is_trivially_copyable_v<Header>);
+
+namespace detail {
+
+/**
+ * The XXH64 hash computed incrementally.
+ *
+ * The bytes are read as the little-endian words, so the digest of the same
+ * bytes does not depend on the machine.
+ */
+class Xxh64
+{
+  public:
+
+    explicit Xxh64(std::uint64_t seed = 0) noexcept
+        : _lanes{seed + p1 + p2, seed + p2, seed, seed - p1}, _seed(seed) { }
+
+    void update(const void* data, std::size_t size) noexcept {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        if (size == 0) {
+            return;
+        }
+        _total += size;
+        if (_buffered > 0) {
+            const std::size_t taken = std::min(size, stripe - _buffered);
+            std::memcpy(_buffer.data() + _buffered, bytes, taken);
+            _buffered += taken;
+            bytes += taken;
+            size -= taken;
+            if (_buffered < stripe) {
+                return;
+            }
+            consume(_buffer.data());
+            _buffered = 0;
+        }
+        // Four independent lanes, so the multiplications overlap.
+        std::uint64_t v1 = _lanes[0], v2 = _lanes[1], v3 = _lanes[2], v4 = _lanes[3];
+        for (; size >= stripe; bytes += stripe, size -= stripe) {
+            v1 = round(v1, read64(bytes));
+            v2 = round(v2, read64(bytes + 8));
+            v3 = round(v3, read64(bytes + 16));
+            v4 = round(v4, read64(bytes + 24));
+        }
+        _lanes = {v1, v2, v3, v4};
+        std::memcpy(_buffer.data(), bytes, size);
+        _buffered = size;
+    }
+
+    std::uint64_t digest() const noexcept {
+        std::uint64_t h;
+        if (_total >= stripe) {
+            const auto& [v1, v2, v3, v4] = _lanes;
+            h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            for (const std::uint64_t v : _lanes) {
+                h = (h ^ round(0, v)) * p1 + p4;
+            }
+        } else {
+            h = _seed + p5;
+        }
+        h += _total;
+
+        const std::byte* p = _buffer.data();
+        std::size_t size = _buffered;
+        for (; size >= 8; p += 8, size -= 8) {
+            h = std::rotl(h ^ round(0, read64(p)), 27) * p1 + p4;
+        }
+        if (size >= 4) {
+            h = std::rotl(h ^ std::uint64_t{read32(p)} * p1, 23) * p2 + p3;
+            p += 4;
+            size -= 4;
+        }
+        for (; size > 0; ++p, --size) {
+            h = std::rotl(h ^ std::uint64_t(std::to_integer<std::uint8_t>(*p)) * p5, 11) * p1;
+        }
+
+        h ^= h >> 33;
+        h *= p2;
+        h ^= h >> 29;
+        h *= p3;
+        h ^= h >> 32;
+        return h;
+    }
+
+  private:
+
+    static constexpr std::uint64_t p1 = 0x9E3779B185EBCA87ull;
+    static constexpr std::uint64_t p2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr std::uint64_t p3 = 0x165667B19E3779F9ull;
+    static constexpr std::uint64_t p4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr std::uint64_t p5 = 0x27D4EB2F165667C5ull;
+    static constexpr std::size_t stripe = 32;
+
+    static std::uint64_t round(std::uint64_t accumulator, std::uint64_t input) noexcept {
+        return std::rotl(accumulator + input * p2, 31) * p1;
+    }
+
+    template <std::unsigned_integral U>
+    static U read(const std::byte* p) noexcept {
+        U value;
+        std::memcpy(&value, p, sizeof(U));
+        if constexpr (std::endian::native == std::endian::big) {
+            U swapped = 0;
+            for (std::size_t i = 0; i < sizeof(U); ++i) {
+                swapped = U(swapped << 8) | U((value >> (8 * i)) & 0xFF);
+            }
+            value = swapped;
+        }
+        return value;
+    }
+
+    static std::uint64_t read64(const std::byte* p) noexcept { return read<std::uint64_t>(p); }
+
+    static std::uint32_t read32(const std::byte* p) noexcept { return read<std::uint32_t>(p); }
+
+    void consume(const std::byte* p) noexcept {
+        for (std::size_t k = 0; k < 4; ++k) {
+            _lanes[k] = round(_lanes[k], read64(p + 8 * k));
+        }
+    }
+
+    std::array<std::uint64_t, 4> _lanes;
+    std::array<std::byte, stripe> _buffer = {};
+    std::size_t _buffered = 0;
+    std::uint64_t _total = 0;
+    std::uint64_t _seed;
+};
+
+/**
+ * The XXH64 digest of the bytes.
+ */
+inline std::uint64_t xxh64(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept {
+    Xxh64 hash(seed);
+    hash.update(data, size);
+    return hash.digest();
+}
+
+/**
+ * The description of the elements that can be stored in the array file.
+ *
+ * The component `e` is the element `(e / columns, e % columns)`, i.e. the
+ * lanes are numbered as in `MatrixArray`.
+ */
+template <typename E>
+struct ElementTraits;
+
+template <std::size_t N, Number T>
+struct ElementTraits<Vector<N, T>>
+{
+    using scalar_type = T;
+    static constexpr std::size_t rows = N;
+    static constexpr std::size_t columns = 1;
+    static constexpr Layout layout = Layout::row_major;
+
+    static T get(const Vector<N, T>& vector, std::size_t e) noexcept { return vector.data()[e]; }
+    static void set(Vector<N, T>& vector, std::size_t e, T value) noexcept { vector.data()[e] = value; }
+};
+
+template <std::size_t N, std::size_t M, Number T, Layout L>
+struct ElementTraits<Matrix<N, M, T, L>>
+{
+    using scalar_type = T;
+    static constexpr std::size_t rows = N;
+    static constexpr std::size_t columns = M;
+    static constexpr Layout layout = L;
+
+    static T get(const Matrix<N, M, T, L>& matrix, std::size_t e) noexcept {
+        return matrix.data()[Matrix<N, M, T, L>::index(e / M, e % M)];
+    }
+
+    static void set(Matrix<N, M, T, L>& matrix, std::size_t e, T value) noexcept {
+        matrix.data()[Matrix<N, M, T, L>::index(e / M, e % M)] = value;
+    }
+};
+
+/**
+ * The read-only view of the whole file.
+ *
+ * The file is mapped into the memory where `mmap` is available, otherwise it
+ * is read into a buffer aligned to the cache line.
+ */
+class MappedRegion
+{
+  public:
+
+    MappedRegion() = default;
+
+    explicit MappedRegion(const std::filesystem::path& path) {
+#ifdef GOF_MATH_HAS_MMAP
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(descriptor, &info) == 0) {
+            _size = static_cast<std::size_t>(info.st_size);
+            if (_size == 0) {
+                _open = true;
+            } else {
+                void* address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (address != MAP_FAILED) {
+                    _data = static_cast<const std::byte*>(address);
+                    _open = true;
+                }
+            }
+        }
+        ::close(descriptor);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return;
+        }
+        _size = static_cast<std::size_t>(file.tellg());
+        _buffer.reset(static_cast<std::byte*>(::operator new(std::max<std::size_t>(_size, 1),
+                                                               std::align_val_t{cache_line_size})));
+        file.seekg(0);
+        _open = static_cast<bool>(file.read(reinterpret_cast<char*>(_buffer.get()), std::streamsize(_size)));
+        _data = _buffer.get();
+#endif
+    }
+
+    MappedRegion(MappedRegion&& that) noexcept
+        : _data(std::exchange(that._data, nullptr)), _size(std::exchange(that._size, 0)),
+          _open(std::exchange(that._open, false))
+#ifndef GOF_MATH_HAS_MMAP
+        , _buffer(std::move(that._buffer))
+#endif
+    { }
+
+    MappedRegion& operator =(MappedRegion&& that) noexcept {
+        MappedRegion(std::move(that)).swap(*this);
+        return *this;
+    }
+
+    ~MappedRegion() {
+#ifdef GOF_MATH_HAS_MMAP
+        if (_data != nullptr) {
+            ::munmap(const_cast<std::byte*>(_data), _size);
+        }
+#endif
+    }
+
+    void swap(MappedRegion& that) noexcept {
+        std::swap(_data, that._data);
+        std::swap(_size, that._size);
+        std::swap(_open, that._open);
+#ifndef GOF_MATH_HAS_MMAP
+        std::swap(_buffer, that._buffer);
+#endif
+    }
+
+    bool is_open() const noexcept { return _open; }
+
+    std::span<const std::byte> bytes() const noexcept { return {_data, _size}; }
+
+  private:
+
+    const std::byte* _data = nullptr;
+    std::size_t _size = 0;
+    bool _open = false;
+
+#ifndef GOF_MATH_HAS_MMAP
+    struct Deleter
+    {
+        void operator ()(std::byte* p) const noexcept { ::operator delete(p, std::align_val_t{cache_line_size}); }
+    };
+
+    std::unique_ptr<std::byte[], Deleter> _buffer;
+#endif
+};
+
+} // namespace detail
+
+/**
+ * The elements that can be stored in the array file: `Vector<N, T>` or
+ * `Matrix<N, M, T, L>` with the scalar type satisfying `is_array_scalar`.
+ */
+template <typename E>
+concept ArrayElement = requires {
+    typename detail::ElementTraits<E>::scalar_type;
+} && is_array_scalar_v<typename detail::ElementTraits<E>::scalar_type>;
+
+/*----------------------------------------------------------------------------*/
+/*                                   READER                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The array file mapped into the memory.
+ *
+ * Opening the file reads and validates only the header, the elements are
+ * the views of the mapped pages, so they are loaded by the operating system
+ * on the first access and shared with the page cache. The views are valid
+ * while the `MappedArray` lives.
+ *
+ *     io::MappedArray<Vector3f> points("points.gof");
+ *     if (!points) { ... points.status() ... }
+ *     for (float x : points.lane(0)) { ... }         // column-major file
+ *     for (const Vector3f& p : points.elements()) { } // row-major file
+ *
+ * @tparam E The element, `Vector<N, T>` or `Matrix<N, M, T, L>`.
+ */
+template <ArrayElement E>
+class MappedArray
+{
+    using traits = detail::ElementTraits<E>;
+
+  public:
+
+    using value_type = E;
+    using scalar_type = typename traits::scalar_type;
+
+    /**
+     * The number of the scalars of each element.
+     */
+    static constexpr std::size_t components = traits::rows * traits::columns;
+
+    /**
+     * Constructor creating the closed array.
+     */
+    MappedArray() = default;
+
+    /**
+     * Constructor mapping the file, check `status()` before the access.
+     */
+    explicit MappedArray(const std::filesystem::path& path) : _region(path) {
+        _status = validate();
+        if (_status != Status::ok) {
+            _region = detail::MappedRegion();
+            _header = Header();
+        }
+    }
+
+    // GETTERS
+
+    Status status() const noexcept { return _status; }
+
+    explicit operator bool() const noexcept { return _status == Status::ok; }
+
+    const Header& header() const noexcept { return _header; }
+
+    std::size_t size() const noexcept { return static_cast<std::size_t>(_header.count); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * The layout of the payload, the row-major file stores the elements (AoS)
+     * and the column-major one stores the lanes (SoA).
+     */
+    Layout layout() const noexcept { return Layout(_header.layout); }
+
+    /**
+     * Get the lane of the component `e` of the column-major file.
+     */
+    std::span<const scalar_type> lane(std::size_t e) const noexcept {
+        assert(_status == Status::ok && layout() == Layout::column_major && e < components);
+        return {payload() + e * _header.stride, size()};
+    }
+
+    /**
+     * Get the lane of the element `(row, column)` of the column-major file.
+     */
+    std::span<const scalar_type> lane(std::size_t row, std::size_t column) const noexcept {
+        assert(row < traits::rows && column < traits::columns);
+        return lane(row * traits::columns + column);
+    }
+
+    /**
+     * Get all scalars of the row-major file, element after element.
+     */
+    std::span<const scalar_type> values() const noexcept {
+        assert(_status == Status::ok && layout() == Layout::row_major);
+        return {payload(), size() * components};
+    }
+
+    /**
+     * Get the elements of the row-major file.
+     *
+     * Only the elements without the padding can be viewed in place, e.g. not
+     * the `Vector3f` of the SIMD backend, use `operator []` for them.
+     */
+    std::span<const E> elements() const noexcept
+        requires (sizeof(E) == components * sizeof(scalar_type))
+    {
+        assert(_status == Status::ok && layout() == Layout::row_major);
+        return {reinterpret_cast<const E*>(payload()), size()};
+    }
+
+    /**
+     * Gather the element with specified index from either layout.
+     */
+    E operator [](std::size_t index) const noexcept {
+        assert(index < size());
+        E result;
+        if (layout() == Layout::row_major) {
+            std::memcpy(result.data(), payload() + index * components, components * sizeof(scalar_type));
+        } else {
+            for (std::size_t e = 0; e < components; ++e) {
+                traits::set(result, e, payload()[e * _header.stride + index]);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Compute the checksum of the payload and compare it with the header.
+     *
+     * This reads the whole file, so it is not done when the file is opened.
+     */
+    Status verify() const noexcept {
+        if (_status != Status::ok) {
+            return _status;
+        }
+        std::vector<std::uint64_t> digests;
+        if (layout() == Layout::row_major) {
+            digests.push_back(detail::xxh64(payload(), size() * components * sizeof(scalar_type)));
+        } else {
+            for (std::size_t e = 0; e < components; ++e) {
+                digests.push_back(detail::xxh64(lane(e).data(), size() * sizeof(scalar_type)));
+            }
+        }
+        const auto checksum = detail::xxh64(digests.data(), digests.size() * sizeof(std::uint64_t));
+        return checksum == _header.checksum ? Status::ok : Status::checksum_mismatch;
+    }
+
+  private:
+
+    const scalar_type* payload() const noexcept {
+        return reinterpret_cast<const scalar_type*>(_region.bytes().data() + _header.payload_offset());
+    }
+
+    Status validate() noexcept {
+        if (!_region.is_open()) {
+            return Status::io_error;
+        }
+        const auto bytes = _region.bytes();
+        if (bytes.size() < sizeof(Header)) {
+            return Status::not_an_array;
+        }
+        std::memcpy(&_header, bytes.data(), sizeof(Header));
+        if (_header.magic != Header::signature) {
+            return Status::not_an_array;
+        }
+        if (_header.version == 0 || _header.version > Header::current_version) {
+            return Status::unsupported_version;
+        }
+        if (_header.byte_order != Header::byte_order_marker) {
+            return _header.byte_order == 0x04030201 ? Status::byte_order : Status::not_an_array;
+        }
+        if (_header.alignment < alignof(scalar_type) || !std::has_single_bit(_header.alignment) ||
+            _header.layout > 1 || _header.element_layout > 1) {
+            return Status::not_an_array;
+        }
+        if (_header.scalar != std::uint8_t(scalar_type_of<scalar_type>()) ||
+            _header.scalar_size != sizeof(scalar_type) || _header.rows != traits::rows ||
+            _header.columns != traits::columns || Layout(_header.element_layout) != traits::layout) {
+            return Status::type_mismatch;
+        }
+
+        if (bytes.size() < _header.payload_offset()) {
+            return Status::truncated;
+        }
+        // The payload without the padding after the last lane, compared by
+        // the divisions so the corrupted counts cannot overflow.
+        const std::uint64_t available = (bytes.size() - _header.payload_offset()) / sizeof(scalar_type);
+        if (layout() == Layout::row_major) {
+            if (_header.stride != components) {
+                return Status::not_an_array;
+            }
+            if (_header.count > available / components) {
+                return Status::truncated;
+            }
+        } else {
+            if (_header.stride < _header.count) {
+                return Status::not_an_array;
+            }
+            if ((components > 1 && _header.stride > available / (components - 1)) ||
+                (components - 1) * _header.stride + _header.count > available) {
+                return Status::truncated;
+            }
+        }
+        // The map starts on a page, the payload on the alignment.
+        assert(reinterpret_cast<std::uintptr_t>(payload()) % alignof(E) == 0 || _header.count == 0);
+        return Status::ok;
+    }
+
+    detail::MappedRegion _region;
+    Header _header;
+    Status _status = Status::io_error;
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   WRITER                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The streaming writer of the array file.
+ *
+ * The elements are collected in one block and written when the block is
+ * full, so the memory does not grow with the file. The header with the count
+ * and the checksum is written by `close()` (or the destructor) and until
+ * then the file has no signature, so the interrupted file is never opened.
+ *
+ * The row-major file grows with the elements. The column-major file places
+ * its lanes by the capacity given in advance, the blocks of each lane are
+ * written to their places; fewer elements than the capacity leave the unused
+ * padding at the ends of the lanes.
+ *
+ * @tparam E The element, `Vector<N, T>` or `Matrix<N, M, T, L>`.
+ */
+template <ArrayElement E>
+class ArrayWriter
+{
+    using traits = detail::ElementTraits<E>;
+
+  public:
+
+    using value_type = E;
+    using scalar_type = typename traits::scalar_type;
+
+    static constexpr std::size_t components = traits::rows * traits::columns;
+
+    /**
+     * The number of elements written at once.
+     */
+    static constexpr std::size_t block_size = 16384;
+
+    /**
+     * Constructor creating the file.
+     *
+     * @param path The path of the file, the existing file is replaced.
+     * @param layout The layout of the payload.
+     * @param capacity The maximal number of the elements of the column-major
+     *        file, it is not used for the row-major one.
+     */
+    explicit ArrayWriter(const std::filesystem::path& path, Layout layout = Layout::row_major,
+                         std::size_t capacity = 0)
+        : _file(path, std::ios::binary | std::ios::trunc), _layout(layout),
+          _digests(layout == Layout::row_major ? 1 : components) {
+        _header.magic = {};
+        _header.version = Header::current_version;
+        _header.byte_order = Header::byte_order_marker;
+        _header.scalar = std::uint8_t(scalar_type_of<scalar_type>());
+        _header.scalar_size = sizeof(scalar_type);
+        _header.layout = std::uint8_t(layout);
+        _header.element_layout = std::uint8_t(traits::layout);
+        _header.rows = traits::rows;
+        _header.columns = traits::columns;
+        _header.alignment = cache_line_size;
+        _header.stride = layout == Layout::row_major ? components : round_up_to_cache_line<scalar_type>(capacity);
+        _block.resize(block_size * components);
+
+        // The placeholder of the header and the padding before the payload.
+        const std::vector<char> zeros(_header.payload_offset(), 0);
+        _file.write(zeros.data(), std::streamsize(zeros.size()));
+        _status = _file ? Status::ok : Status::io_error;
+    }
+
+    ArrayWriter(const ArrayWriter&) = delete;
+    ArrayWriter& operator =(const ArrayWriter&) = delete;
+
+    ~ArrayWriter() { close(); }
+
+    Status status() const noexcept { return _status; }
+
+    explicit operator bool() const noexcept { return _status == Status::ok; }
+
+    /**
+     * The number of elements written so far.
+     */
+    std::size_t size() const noexcept { return _written + _buffered; }
+
+    // WRITING
+
+    void write(const E& element) {
+        if (!reserve_one()) {
+            return;
+        }
+        if (_layout == Layout::row_major) {
+            std::memcpy(_block.data() + _buffered * components, element.data(), components * sizeof(scalar_type));
+        } else {
+            for (std::size_t e = 0; e < components; ++e) {
+                _block[e * block_size + _buffered] = traits::get(element, e);
+            }
+        }
+        ++_buffered;
+    }
+
+    void write(std::span<const E> elements) {
+        for (const E& element : elements) {
+            write(element);
+        }
+    }
+
+    /**
+     * Write the vectors from the lanes, block by block.
+     */
+    template <std::size_t N, typename A>
+        requires std::same_as<E, Vector<N, scalar_type>>
+    void write(const VectorArray<N, scalar_type, A>& vectors) {
+        if (_layout == Layout::row_major) {
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                write(vectors[i]);
+            }
+            return;
+        }
+        for (std::size_t first = 0; first < vectors.size();) {
+            if (!reserve_one()) {
+                return;
+            }
+            const std::size_t count = std::min(block_size - _buffered, vectors.size() - first);
+            if (_header.stride - _written - _buffered < count) {
+                _status = Status::capacity_exceeded;
+                return;
+            }
+            for (std::size_t e = 0; e < N; ++e) {
+                std::copy_n(vectors.lane(e).data() + first, count, _block.data() + e * block_size + _buffered);
+            }
+            _buffered += count;
+            first += count;
+        }
+    }
+
+    /**
+     * Write the remaining elements and the header and close the file.
+     */
+    Status close() {
+        if (!_file.is_open()) {
+            return _status;
+        }
+        if (_status == Status::ok) {
+            flush();
+        }
+        if (_status == Status::ok && _layout == Layout::column_major && _written == 0 && components > 1 &&
+            _header.stride > 0) {
+            // No lane was written, the file must still reach the start of the last one.
+            const std::uint64_t end = _header.payload_offset() + (components - 1) * _header.stride * sizeof(scalar_type);
+            _file.seekp(std::streamoff(end - 1));
+            _file.put('\0');
+        }
+        if (_status == Status::ok) {
+            std::vector<std::uint64_t> digests;
+            for (const auto& digest : _digests) {
+                digests.push_back(digest.digest());
+            }
+            _header.magic = Header::signature;
+            _header.count = _written;
+            _header.checksum = detail::xxh64(digests.data(), digests.size() * sizeof(std::uint64_t));
+            _file.seekp(0);
+            _file.write(reinterpret_cast<const char*>(&_header), sizeof(Header));
+        }
+        _file.close();
+        if (_status == Status::ok && !_file) {
+            _status = Status::io_error;
+        }
+        return _status;
+    }
+
+  private:
+
+    /**
+     * Make the room in the block for one more element.
+     */
+    bool reserve_one() {
+        if (_status != Status::ok) {
+            return false;
+        }
+        if (_layout == Layout::column_major && _written + _buffered >= _header.stride) {
+            _status = Status::capacity_exceeded;
+            return false;
+        }
+        if (_buffered == block_size) {
+            flush();
+        }
+        return _status == Status::ok;
+    }
+
+    void flush() {
+        if (_buffered == 0) {
+            return;
+        }
+        const auto write = [&](const scalar_type* data, std::size_t count, detail::Xxh64& digest) {
+            digest.update(data, count * sizeof(scalar_type));
+            _file.write(reinterpret_cast<const char*>(data), std::streamsize(count * sizeof(scalar_type)));
+        };
+        if (_layout == Layout::row_major) {
+            write(_block.data(), _buffered * components, _digests[0]);
+        } else {
+            for (std::size_t e = 0; e < components; ++e) {
+                const std::uint64_t offset = _header.payload_offset() + (e * _header.stride + _written) * sizeof(scalar_type);
+                _file.seekp(std::streamoff(offset));
+                write(_block.data() + e * block_size, _buffered, _digests[e]);
+            }
+        }
+        _written += _buffered;
+        _buffered = 0;
+        if (!_file) {
+            _status = Status::io_error;
+        }
+    }
+
+    std::ofstream _file;
+    Layout _layout;
+    Header _header;
+    std::vector<scalar_type> _block;
+    std::vector<detail::Xxh64> _digests;
+    std::size_t _buffered = 0;
+    std::size_t _written = 0;
+    Status _status = Status::ok;
+};
+
+/**
+ * Write the elements into the array file.
+ */
+template <ArrayElement E>
+Status save(const std::filesystem::path& path, std::span<const E> elements, Layout layout = Layout::row_major) {
+    ArrayWriter<E> writer(path, layout, elements.size());
+    writer.write(elements);
+    return writer.close();
+}
+
+/**
+ * Write the vectors into the array file, by default as the lanes.
+ */
+template <std::size_t N, Number T, typename A>
+Status save(const std::filesystem::path& path, const VectorArray<N, T, A>& vectors,
+            Layout layout = Layout::column_major) {
+    ArrayWriter<Vector<N, T>> writer(path, layout, vectors.size());
+    writer.write(vectors);
+    return writer.close();
+}
+
+} // namespace gof::io
+
+#endif // guard
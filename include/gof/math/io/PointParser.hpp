@@ -0,0 +1,631 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef POINT_PARSER_HEADER_GUARD
+#define POINT_PARSER_HEADER_GUARD
+
+/*
+ * THE TEXT POINT CLOUDS
+ *
+ * The points are parsed from the text files with one point per line
+ *
+ *   - XYZ: the numbers separated by the spaces or tabs,
+ *   - CSV: the numbers separated by the commas (or other `separator`),
+ *   - PLY: the ASCII PLY, the `x`, `y`, `z` properties of the vertices.
+ *
+ * The XYZ and CSV files may start with the line of the column names, when
+ * it names the columns `x`, `y` and `z` they are taken from it, otherwise it
+ * is skipped. The empty lines and the lines starting with `#` are skipped,
+ * the other columns are ignored. The quoted CSV fields are not supported.
+ *
+ * The input is read by the windows of `blocks * block_size` bytes. The window
+ * is cut after its last complete line (the rest is carried to the next one)
+ * and split into the blocks at the line ends, the blocks are parsed in
+ * parallel by `std::from_chars` and passed to the consumer in the order of
+ * the file. With the parallel policy the next window is read while the
+ * current one is parsed.
+ *
+ * So the memory does not depend on the size of the file: two windows of the
+ * text and the points of one window (at most one point per 6 bytes of the
+ * text, "0 0 0\n").
+ */
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gof/math/execution.hpp>
+#include <gof/math/io/Status.hpp>
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+namespace gof::io {
+
+/**
+ * The formats of the text point clouds.
+ */
+enum class PointFormat
+{
+    automatic, ///< PLY by its signature, CSV when the first line has the separator, XYZ otherwise.
+    xyz,
+    csv,
+    ply,
+};
+
+/**
+ * The options of `parse_points()`.
+ */
+struct ParseOptions
+{
+    PointFormat format = PointFormat::automatic;
+
+    /**
+     * The columns of the coordinates (from zero) in the XYZ and CSV files
+     * without the named columns.
+     */
+    std::array<std::size_t, 3> columns = {0, 1, 2};
+
+    /**
+     * The separator of the CSV columns.
+     */
+    char separator = ',';
+
+    /**
+     * The bytes parsed by one task, the longest line must fit into the
+     * window of `blocks * block_size` bytes.
+     */
+    std::size_t block_size = std::size_t{1} << 20;
+
+    /**
+     * The blocks of the window, zero means two per thread of the policy.
+     */
+    std::size_t blocks = 0;
+};
+
+/**
+ * The result of `parse_points()`.
+ */
+struct ParseResult
+{
+    Status status = Status::ok;
+
+    /**
+     * The number of points passed to the consumer.
+     */
+    std::size_t points = 0;
+
+    /**
+     * The number of bytes read from the input.
+     */
+    std::size_t bytes = 0;
+
+    /**
+     * The line (from one) of the `syntax_error`, zero otherwise.
+     */
+    std::size_t line = 0;
+};
+
+namespace detail {
+
+/**
+ * The description of the point lines.
+ */
+struct PointGrammar
+{
+    bool csv = false;
+    char separator = ',';
+
+    /**
+     * The pairs (column, axis) sorted by the column.
+     */
+    std::array<std::pair<std::size_t, std::size_t>, 3> fields = {{{0, 0}, {1, 1}, {2, 2}}};
+
+    /**
+     * The number of points (of the PLY vertices).
+     */
+    std::size_t limit = std::numeric_limits<std::size_t>::max();
+
+    void set_columns(const std::array<std::size_t, 3>& columns) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            fields[axis] = {columns[axis], axis};
+        }
+        std::sort(fields.begin(), fields.end());
+    }
+};
+
+inline bool is_blank(char c) noexcept { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skip_blanks(const char* p, const char* last) noexcept {
+    while (p != last && is_blank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * The position after the end of the line starting at `p`.
+ */
+inline const char* next_line(const char* p, const char* last) noexcept {
+    const auto* end = static_cast<const char*>(std::memchr(p, '\n', std::size_t(last - p)));
+    return end ? end + 1 : last;
+}
+
+enum class LineKind
+{
+    point,
+    skipped,
+    invalid,
+};
+
+/**
+ * Parse the line starting at `p` and return the position of the next line.
+ */
+template <std::floating_point T>
+const char* parse_line(const char* p, const char* last, const PointGrammar& grammar, Vector<3, T>& point,
+                       LineKind& kind) noexcept {
+    p = skip_blanks(p, last);
+    if (p == last || *p == '\n' || *p == '#') {
+        kind = LineKind::skipped;
+        return next_line(p, last);
+    }
+    kind = LineKind::invalid;
+    std::size_t column = 0;
+    for (const auto& [target, axis] : grammar.fields) {
+        for (; column < target; ++column) {
+            if (grammar.csv) {
+                while (p != last && *p != grammar.separator && *p != '\n') {
+                    ++p;
+                }
+                if (p == last || *p == '\n') {
+                    return next_line(p, last);
+                }
+                ++p;
+            } else {
+                while (p != last && !is_blank(*p) && *p != '\n') {
+                    ++p;
+                }
+                p = skip_blanks(p, last);
+                if (p == last || *p == '\n') {
+                    return next_line(p, last);
+                }
+            }
+        }
+        if (grammar.csv) {
+            p = skip_blanks(p, last);
+        }
+        if (p != last && *p == '+') {
+            ++p;
+        }
+        const auto [end, error] = std::from_chars(p, last, point.data()[axis]);
+        if (error != std::errc{}) {
+            return next_line(p, last);
+        }
+        p = skip_blanks(end, last);
+        if (p != last && *p != '\n') {
+            if (grammar.csv ? *p != grammar.separator : p == end) {
+                return next_line(p, last);
+            }
+            if (grammar.csv) {
+                ++p;
+            } else {
+                p = skip_blanks(p, last);
+            }
+        }
+        ++column;
+    }
+    kind = LineKind::point;
+    return next_line(p, last);
+}
+
+/**
+ * The points of one block of the window.
+ */
+template <std::floating_point T>
+struct PointBlock
+{
+    const char* first = nullptr;
+    const char* last = nullptr;
+    std::vector<Vector<3, T>> points;
+
+    /**
+     * The lines parsed (up to the invalid one).
+     */
+    std::size_t lines = 0;
+
+    bool failed = false;
+
+    void parse(const PointGrammar& grammar) {
+        points.clear();
+        lines = 0;
+        failed = false;
+        for (const char* p = first; p != last; ++lines) {
+            Vector<3, T> point;
+            LineKind kind;
+            p = parse_line(p, last, grammar, point, kind);
+            if (kind == LineKind::invalid) {
+                failed = true;
+                return;
+            }
+            if (kind == LineKind::point) {
+                points.push_back(point);
+            }
+        }
+    }
+};
+
+/**
+ * The buffer of the text read from the input.
+ */
+struct TextWindow
+{
+    std::vector<char> data;
+    std::size_t size = 0;
+    bool eof = false;
+    bool bad = false;
+
+    /**
+     * Fill the window by the carried `tail` of the previous one and the input.
+     */
+    void read(std::istream& input, std::string_view tail) {
+        std::copy(tail.begin(), tail.end(), data.begin());
+        input.read(data.data() + tail.size(), std::streamsize(data.size() - tail.size()));
+        size = tail.size() + std::size_t(input.gcount());
+        eof = size < data.size();
+        bad = input.bad();
+    }
+};
+
+inline std::string_view trim(std::string_view text) noexcept {
+    while (!text.empty() && (is_blank(text.front()) || text.front() == '\n')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (is_blank(text.back()) || text.back() == '\n')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+inline bool equal_ignoring_case(std::string_view a, std::string_view b) noexcept {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+/**
+ * Split the line into the fields separated by the separator or the blanks.
+ */
+inline std::vector<std::string_view> split_fields(std::string_view line, const PointGrammar& grammar) {
+    std::vector<std::string_view> result;
+    line = trim(line);
+    while (!line.empty()) {
+        const std::size_t end = grammar.csv ? line.find(grammar.separator) : line.find_first_of(" \t\r");
+        result.push_back(trim(line.substr(0, end)));
+        line = end == std::string_view::npos ? std::string_view() : trim(line.substr(end + 1));
+    }
+    return result;
+}
+
+/**
+ * Read the header of the PLY file from the start of the window.
+ *
+ * @return The offset of the first vertex line in the window.
+ */
+inline Status parse_ply_header(std::string_view text, PointGrammar& grammar, std::size_t& offset,
+                               std::size_t& lines) {
+    grammar.csv = false;
+    std::array<std::size_t, 3> columns = {};
+    std::array<bool, 3> found = {};
+    std::size_t element = 0; // 1 in the vertices, 2 after them
+    std::size_t property = 0;
+    for (offset = 0, lines = 0;; ++lines) {
+        const std::size_t end = text.find('\n', offset);
+        if (end == std::string_view::npos) {
+            return Status::line_too_long;
+        }
+        const auto fields = split_fields(text.substr(offset, end - offset), grammar);
+        offset = end + 1;
+        if (fields.empty()) {
+            continue;
+        }
+        const auto& keyword = fields[0];
+        if (keyword == "format") {
+            if (fields.size() < 2 || fields[1] != "ascii") {
+                return Status::unsupported_format;
+            }
+        } else if (keyword == "element") {
+            if (fields.size() < 3) {
+                return Status::syntax_error;
+            }
+            if (fields[1] == "vertex") {
+                if (element != 0) {
+                    return Status::unsupported_format;
+                }
+                element = 1;
+                const auto [_, error] = std::from_chars(fields[2].data(), fields[2].data() + fields[2].size(),
+                                                        grammar.limit);
+                if (error != std::errc{}) {
+                    return Status::syntax_error;
+                }
+            } else if (element == 0) {
+                // The other elements would be before the vertices.
+                return Status::unsupported_format;
+            } else {
+                element = 2;
+            }
+        } else if (keyword == "property" && element == 1) {
+            if (fields.size() < 3 || fields[1] == "list") {
+                return Status::unsupported_format;
+            }
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                if (fields[2] == std::array<std::string_view, 3>{"x", "y", "z"}[axis]) {
+                    columns[axis] = property;
+                    found[axis] = true;
+                }
+            }
+            ++property;
+        } else if (keyword == "end_header") {
+            ++lines;
+            break;
+        }
+    }
+    if (element == 0 || !(found[0] && found[1] && found[2])) {
+        return Status::unsupported_format;
+    }
+    grammar.set_columns(columns);
+    return Status::ok;
+}
+
+/**
+ * Recognize the format and read the header from the start of the window.
+ *
+ * @param offset The offset of the first point line in the window.
+ * @param lines The number of the header lines.
+ */
+template <std::floating_point T>
+Status prepare_grammar(std::string_view text, const ParseOptions& options, PointGrammar& grammar,
+                       std::size_t& offset, std::size_t& lines) {
+    offset = 0;
+    lines = 0;
+    grammar.separator = options.separator;
+    grammar.set_columns(options.columns);
+
+    PointFormat format = options.format;
+    if (format == PointFormat::automatic || format == PointFormat::ply) {
+        const std::string_view first = text.substr(0, text.find('\n'));
+        if (trim(first) == "ply") {
+            format = PointFormat::ply;
+        } else if (format == PointFormat::ply) {
+            return Status::syntax_error;
+        }
+    }
+    if (format == PointFormat::ply) {
+        return parse_ply_header(text, grammar, offset, lines);
+    }
+
+    // The first line which is not empty or the comment.
+    std::size_t first = 0;
+    for (;; ++lines) {
+        const char* p = skip_blanks(text.data() + first, text.data() + text.size());
+        if (p == text.data() + text.size() || (*p != '\n' && *p != '#')) {
+            break;
+        }
+        first = std::size_t(next_line(p, text.data() + text.size()) - text.data());
+    }
+    const std::size_t end = std::min(text.find('\n', first), text.size());
+    const std::string_view line = text.substr(first, end - first);
+    if (format == PointFormat::automatic) {
+        format = line.find(options.separator) != std::string_view::npos ? PointFormat::csv : PointFormat::xyz;
+    }
+    grammar.csv = format == PointFormat::csv;
+
+    // The line of the column names is not a point.
+    Vector<3, T> point;
+    LineKind kind;
+    parse_line(line.data(), line.data() + line.size(), grammar, point, kind);
+    if (kind == LineKind::invalid) {
+        const auto names = split_fields(line, grammar);
+        std::array<std::size_t, 3> columns = {};
+        std::size_t found = 0;
+        for (std::size_t column = 0; column < names.size(); ++column) {
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                if (equal_ignoring_case(names[column], std::array<std::string_view, 3>{"x", "y", "z"}[axis])) {
+                    columns[axis] = column;
+                    ++found;
+                }
+            }
+        }
+        if (found == 3) {
+            grammar.set_columns(columns);
+        }
+        offset = std::min(end + 1, text.size());
+        ++lines;
+    } else {
+        offset = first;
+    }
+    return Status::ok;
+}
+
+} // namespace detail
+
+/**
+ * Parse the text points and pass them to `consumer(std::span<const Vector<3, T>>)`.
+ *
+ * The batches come in the order of the input from the calling thread, the
+ * span is valid only during the call. The parsing stops on the first error.
+ *
+ *     io::parse_points<float>(execution::par, file, [&](std::span<const Vector3f> batch) {
+ *         ...
+ *     });
+ *
+ * @tparam T The scalar type of the points.
+ */
+template <std::floating_point T, execution::Policy P, typename F>
+ParseResult parse_points(const P& policy, std::istream& input, F&& consumer, const ParseOptions& options = {}) {
+    constexpr bool parallel = std::is_same_v<P, execution::parallel_policy>;
+    std::size_t blocks = options.blocks;
+    if (blocks == 0) {
+        if constexpr (parallel) {
+            blocks = 2 * policy.thread_pool().concurrency();
+        } else {
+            blocks = 2;
+        }
+    }
+    const std::size_t capacity = std::max<std::size_t>(blocks * options.block_size, 64);
+
+    ParseResult result;
+    detail::TextWindow current;
+    detail::TextWindow next;
+    current.data.resize(capacity);
+    next.data.resize(capacity);
+    std::vector<detail::PointBlock<T>> parsed(blocks);
+
+    current.read(input, {});
+    if (current.bad) {
+        result.status = Status::io_error;
+        return result;
+    }
+    detail::PointGrammar grammar;
+    std::size_t start = 0;
+    std::size_t lines = 0;
+    result.status = detail::prepare_grammar<T>({current.data.data(), current.size}, options, grammar, start, lines);
+    if (result.status != Status::ok) {
+        return result;
+    }
+
+    for (;;) {
+        // The window ends after its last complete line.
+        const char* const data = current.data.data();
+        std::size_t end = current.size;
+        if (!current.eof) {
+            const auto last = std::find(std::make_reverse_iterator(data + current.size),
+                                         std::make_reverse_iterator(data + start), '\n');
+            if (last.base() == data + start) {
+                result.status = Status::line_too_long;
+                return result;
+            }
+            end = std::size_t(last.base() - data);
+        }
+        result.bytes += end - start;
+
+        // Read the next window meanwhile (the thread is joined on the return).
+        const std::string_view tail(data + end, current.size - end);
+        std::jthread prefetch;
+        if (!current.eof) {
+            if constexpr (parallel) {
+                prefetch = std::jthread([&input, &next, tail] { next.read(input, tail); });
+            }
+        }
+
+        // Split the window into the blocks at the line ends.
+        std::size_t count = 0;
+        for (std::size_t first = start; first < end; ++count) {
+            std::size_t last = std::max(first + 1, start + (count + 1) * (end - start) / blocks);
+            last = count + 1 == blocks ? end : std::size_t(detail::next_line(data + last - 1, data + end) - data);
+            parsed[count].first = data + first;
+            parsed[count].last = data + last;
+            first = last;
+        }
+        if constexpr (parallel) {
+            policy.thread_pool().parallel_for(count, 1, [&](std::size_t first, std::size_t last) {
+                for (std::size_t b = first; b < last; ++b) {
+                    parsed[b].parse(grammar);
+                }
+            });
+        } else {
+            for (std::size_t b = 0; b < count; ++b) {
+                parsed[b].parse(grammar);
+            }
+        }
+
+        for (std::size_t b = 0; b < count; ++b) {
+            const auto& block = parsed[b];
+            const std::size_t remaining = grammar.limit - result.points;
+            const std::size_t taken = std::min(block.points.size(), remaining);
+            if (taken > 0) {
+                consumer(std::span<const Vector<3, T>>(block.points.data(), taken));
+                result.points += taken;
+            }
+            if (result.points == grammar.limit) {
+                return result;
+            }
+            if (block.failed) {
+                result.status = Status::syntax_error;
+                result.line = lines + block.lines + 1;
+                return result;
+            }
+            lines += block.lines;
+        }
+
+        if (current.eof) {
+            break;
+        }
+        if constexpr (parallel) {
+            prefetch.join();
+        } else {
+            next.read(input, tail);
+        }
+        if (next.bad) {
+            result.status = Status::io_error;
+            return result;
+        }
+        std::swap(current, next);
+        start = 0;
+    }
+    if (grammar.limit != std::numeric_limits<std::size_t>::max() && result.points < grammar.limit) {
+        result.status = Status::truncated;
+    }
+    return result;
+}
+
+/**
+ * Parse the text points of the file.
+ */
+template <std::floating_point T, execution::Policy P, typename F>
+ParseResult parse_points(const P& policy, const std::filesystem::path& path, F&& consumer,
+                         const ParseOptions& options = {}) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return {Status::io_error};
+    }
+    return parse_points<T>(policy, file, std::forward<F>(consumer), options);
+}
+
+template <std::floating_point T, typename F>
+ParseResult parse_points(const std::filesystem::path& path, F&& consumer, const ParseOptions& options = {}) {
+    return parse_points<T>(execution::seq, path, std::forward<F>(consumer), options);
+}
+
+/**
+ * Parse the text points and append them to the vector array.
+ */
+template <execution::Policy P, std::floating_point T, typename A>
+ParseResult read_points(const P& policy, const std::filesystem::path& path, VectorArray<3, T, A>& points,
+                        const ParseOptions& options = {}) {
+    return parse_points<T>(policy, path, [&](std::span<const Vector<3, T>> batch) {
+        std::size_t index = points.size();
+        points.resize(index + batch.size());
+        for (const auto& point : batch) {
+            points.set(index++, point);
+        }
+    }, options);
+}
+
+} // namespace gof::io
+
+#endif // guard
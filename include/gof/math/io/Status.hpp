@@ -0,0 +1,36 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef IO_STATUS_HEADER_GUARD
+#define IO_STATUS_HEADER_GUARD
+
+#include <cstdint>
+
+namespace gof::io {
+
+/**
+ * The result of reading or writing the files.
+ *
+ * The I/O functions do not throw, they return the status (or keep it in the
+ * object, as the standard streams do).
+ */
+enum class Status : std::uint8_t
+{
+    ok,
+    io_error,            ///< The file cannot be opened, mapped, read or written.
+    not_an_array,        ///< The file is not an array file or its header is corrupted.
+    unsupported_version, ///< The file was written by a newer version.
+    byte_order,          ///< The file was written with the other byte order.
+    type_mismatch,       ///< The file stores other elements or scalars.
+    truncated,           ///< The file is shorter than its header says.
+    checksum_mismatch,   ///< The payload does not match the checksum (see `MappedArray::verify()`).
+    capacity_exceeded,   ///< More elements were written than the column-major file can hold.
+    syntax_error,        ///< The text is not a number where the number is expected.
+    line_too_long,       ///< The text line does not fit into the buffer of the parser.
+    unsupported_format,  ///< The format is recognized but not supported (e.g. the binary PLY).
+};
+
+} // namespace gof::io
+
+#endif // guard
@@ -0,0 +1,810 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef DECOMPOSITION_HEADER_GUARD
+#define DECOMPOSITION_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include <gof/math/common.hpp> // multiply_add, difference_of_products, cmath::sqrt
+#include <gof/math/execution.hpp>
+#include <gof/math/memory.hpp>
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/matrix/MatrixArray.hpp>
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+/*
+ * The linear systems of the small matrices.
+ *
+ * The sizes are known at compile time, so the outer loops of the
+ * decompositions are unrolled up to `8 x 8` and the inner ones have constant
+ * bounds. The determinant and the inverse up to `4 x 4` are the closed forms
+ * by the cofactors, the larger matrices use the LU decomposition.
+ *
+ * The batched solves take the systems as the structure of arrays
+ * (`MatrixArray`, `VectorArray`). The innermost loops run across the systems,
+ * so the SIMD lanes solve several systems at once and the pivoting is done by
+ * the selects instead of the branches.
+ */
+
+namespace gof {
+
+namespace detail {
+
+/**
+ * Call `f(i)` for `i = 0 .. Count - 1`, unrolled for the small counts.
+ */
+template <std::size_t Count, typename F>
+constexpr void repeat(F&& f) {
+    if constexpr(Count <= 8) {
+        unroll<Count>(std::forward<F>(f));
+    } else {
+        for (std::size_t i = 0; i < Count; ++i) {
+            f(i);
+        }
+    }
+}
+
+} // namespace detail
+
+
+/*----------------------------------------------------------------------------*/
+/*                              DECOMPOSITIONS                                */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The LU decomposition `P * A = L * U` with the partial pivoting.
+ *
+ * `L` is the unit lower triangle and `U` the upper triangle, both are stored
+ * in one array. The singular matrix is decomposed as well, but its solves
+ * give the non-finite values.
+ *
+ * @tparam N The size of the matrix.
+ * @tparam T The scalar type.
+ */
+template <std::size_t N, std::floating_point T>
+class Lu
+{
+  public:
+
+    template <Layout L>
+    constexpr explicit Lu(const Matrix<N, N, T, L>& m) noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            _permutation[i] = i;
+            for (std::size_t j = 0; j < N; ++j) {
+                _lu[i * N + j] = m(i, j);
+            }
+        }
+        detail::repeat<N>([&](auto k) {
+            std::size_t pivot = k;
+            for (std::size_t i = k + 1; i < N; ++i) {
+                if (detail::absolute(_lu[i * N + k]) > detail::absolute(_lu[pivot * N + k])) {
+                    pivot = i;
+                }
+            }
+            if (pivot != k) {
+                for (std::size_t j = 0; j < N; ++j) {
+                    std::swap(_lu[k * N + j], _lu[pivot * N + j]);
+                }
+                std::swap(_permutation[k], _permutation[pivot]);
+                _sign = -_sign;
+            }
+            if (_lu[k * N + k] == T{0}) {
+                _singular = true;
+                return;
+            }
+            const T inverse = T{1} / _lu[k * N + k];
+            for (std::size_t i = k + 1; i < N; ++i) {
+                const T f = _lu[i * N + k] * inverse;
+                _lu[i * N + k] = f;
+                for (std::size_t j = k + 1; j < N; ++j) {
+                    _lu[i * N + j] = multiply_add(-f, _lu[k * N + j], _lu[i * N + j]);
+                }
+            }
+        });
+    }
+
+    // GETTERS
+
+    /**
+     * Check if a pivot is zero, i.e. the matrix is singular.
+     */
+    constexpr bool is_singular() const noexcept { return _singular; }
+
+    constexpr T determinant() const noexcept {
+        T result = _sign;
+        for (std::size_t i = 0; i < N; ++i) {
+            result *= _lu[i * N + i];
+        }
+        return result;
+    }
+
+    /**
+     * Get the unit lower triangle `L`.
+     */
+    constexpr Matrix<N, N, T> lower() const noexcept {
+        Matrix<N, N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                result.data()[i * N + j] = _lu[i * N + j];
+            }
+            result.data()[i * N + i] = T{1};
+        }
+        return result;
+    }
+
+    /**
+     * Get the upper triangle `U`.
+     */
+    constexpr Matrix<N, N, T> upper() const noexcept {
+        Matrix<N, N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i; j < N; ++j) {
+                result.data()[i * N + j] = _lu[i * N + j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Get the row of `A` in each row of `P * A`.
+     */
+    constexpr std::span<const std::size_t, N> permutation() const noexcept { return _permutation; }
+
+    // SOLVES
+
+    /**
+     * Solve `A * x = b`.
+     */
+    constexpr Vector<N, T> solve(const Vector<N, T>& b) const noexcept {
+        T x[N]{};
+        detail::repeat<N>([&](auto i) {
+            T s = b[_permutation[i]];
+            for (std::size_t k = 0; k < i; ++k) {
+                s = multiply_add(-_lu[i * N + k], x[k], s);
+            }
+            x[i] = s;
+        });
+        detail::repeat<N>([&](auto r) {
+            const std::size_t i = N - 1 - r;
+            T s = x[i];
+            for (std::size_t k = i + 1; k < N; ++k) {
+                s = multiply_add(-_lu[i * N + k], x[k], s);
+            }
+            x[i] = s / _lu[i * N + i];
+        });
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = x[i];
+        }
+        return result;
+    }
+
+    /**
+     * Solve `A * X = B` column by column.
+     */
+    template <std::size_t M, Layout L>
+    constexpr Matrix<N, M, T, L> solve(const Matrix<N, M, T, L>& b) const noexcept {
+        Matrix<N, M, T, L> result;
+        for (std::size_t j = 0; j < M; ++j) {
+            const Vector<N, T> x = solve(b.column(j));
+            for (std::size_t i = 0; i < N; ++i) {
+                result.data()[Matrix<N, M, T, L>::index(i, j)] = x[i];
+            }
+        }
+        return result;
+    }
+
+    template <Layout L = Layout::row_major>
+    constexpr Matrix<N, N, T, L> inverse() const noexcept {
+        return solve(Matrix<N, N, T, L>::identity());
+    }
+
+  private:
+
+    std::array<T, N * N> _lu{};
+    std::array<std::size_t, N> _permutation{};
+    T _sign = T{1};
+    bool _singular = false;
+};
+
+/**
+ * The Cholesky decomposition `A = L * L^T` of the symmetric positive
+ * definite matrix.
+ *
+ * Only the lower triangle of `A` is read. The decomposition stops at the
+ * first pivot which is not positive, the solves of such a matrix give the
+ * non-finite values.
+ *
+ * @tparam N The size of the matrix.
+ * @tparam T The scalar type.
+ */
+template <std::size_t N, std::floating_point T>
+class Cholesky
+{
+  public:
+
+    template <Layout L>
+    constexpr explicit Cholesky(const Matrix<N, N, T, L>& m) noexcept {
+        detail::repeat<N>([&](auto j) {
+            if (!_positive_definite) {
+                return;
+            }
+            T d = m(j, j);
+            for (std::size_t k = 0; k < j; ++k) {
+                d = multiply_add(-_l[j * N + k], _l[j * N + k], d);
+            }
+            if (!(d > T{0})) {
+                _positive_definite = false;
+                return;
+            }
+            const T diagonal = cmath::sqrt(d);
+            const T inverse = T{1} / diagonal;
+            _l[j * N + j] = diagonal;
+            for (std::size_t i = j + 1; i < N; ++i) {
+                T s = m(i, j);
+                for (std::size_t k = 0; k < j; ++k) {
+                    s = multiply_add(-_l[i * N + k], _l[j * N + k], s);
+                }
+                _l[i * N + j] = s * inverse;
+            }
+        });
+    }
+
+    // GETTERS
+
+    constexpr bool is_positive_definite() const noexcept { return _positive_definite; }
+
+    /**
+     * Get the determinant of the positive definite matrix.
+     */
+    constexpr T determinant() const noexcept {
+        T result = T{1};
+        for (std::size_t i = 0; i < N; ++i) {
+            result *= _l[i * N + i] * _l[i * N + i];
+        }
+        return result;
+    }
+
+    /**
+     * Get the lower triangle `L`.
+     */
+    constexpr Matrix<N, N, T> lower() const noexcept {
+        Matrix<N, N, T> result;
+        for (std::size_t i = 0; i < N * N; ++i) {
+            result.data()[i] = _l[i];
+        }
+        return result;
+    }
+
+    // SOLVES
+
+    /**
+     * Solve `A * x = b`.
+     */
+    constexpr Vector<N, T> solve(const Vector<N, T>& b) const noexcept {
+        T x[N]{};
+        detail::repeat<N>([&](auto i) {
+            T s = b[i];
+            for (std::size_t k = 0; k < i; ++k) {
+                s = multiply_add(-_l[i * N + k], x[k], s);
+            }
+            x[i] = s / _l[i * N + i];
+        });
+        detail::repeat<N>([&](auto r) {
+            const std::size_t i = N - 1 - r;
+            T s = x[i];
+            for (std::size_t k = i + 1; k < N; ++k) {
+                s = multiply_add(-_l[k * N + i], x[k], s);
+            }
+            x[i] = s / _l[i * N + i];
+        });
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = x[i];
+        }
+        return result;
+    }
+
+    /**
+     * Solve `A * X = B` column by column.
+     */
+    template <std::size_t M, Layout L>
+    constexpr Matrix<N, M, T, L> solve(const Matrix<N, M, T, L>& b) const noexcept {
+        Matrix<N, M, T, L> result;
+        for (std::size_t j = 0; j < M; ++j) {
+            const Vector<N, T> x = solve(b.column(j));
+            for (std::size_t i = 0; i < N; ++i) {
+                result.data()[Matrix<N, M, T, L>::index(i, j)] = x[i];
+            }
+        }
+        return result;
+    }
+
+    template <Layout L = Layout::row_major>
+    constexpr Matrix<N, N, T, L> inverse() const noexcept {
+        return solve(Matrix<N, N, T, L>::identity());
+    }
+
+  private:
+
+    std::array<T, N * N> _l{};
+    bool _positive_definite = true;
+};
+
+/**
+ * The QR decomposition `A = Q * R` by the Householder reflections.
+ *
+ * `A` has at least as many rows as columns. `solve()` gives the least
+ * squares solution of the overdetermined system without forming the normal
+ * equations, whose condition number is the square of that of `A`.
+ *
+ * @tparam N The number of rows.
+ * @tparam M The number of columns.
+ * @tparam T The scalar type.
+ */
+template <std::size_t N, std::size_t M, std::floating_point T>
+    requires (N >= M)
+class Qr
+{
+  public:
+
+    template <Layout L>
+    constexpr explicit Qr(const Matrix<N, M, T, L>& m) noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                _qr[i * M + j] = m(i, j);
+            }
+        }
+        // The reflection of the column `k` is kept below the diagonal of `R`.
+        detail::repeat<M>([&](auto k) {
+            T norm = T{0};
+            for (std::size_t i = k; i < N; ++i) {
+                norm = multiply_add(_qr[i * M + k], _qr[i * M + k], norm);
+            }
+            norm = cmath::sqrt(norm);
+            if (norm != T{0}) {
+                norm = _qr[k * M + k] < T{0} ? -norm : norm;
+                const T inverse = T{1} / norm;
+                for (std::size_t i = k; i < N; ++i) {
+                    _qr[i * M + k] *= inverse;
+                }
+                _qr[k * M + k] += T{1};
+                for (std::size_t j = k + 1; j < M; ++j) {
+                    T s = T{0};
+                    for (std::size_t i = k; i < N; ++i) {
+                        s = multiply_add(_qr[i * M + k], _qr[i * M + j], s);
+                    }
+                    s = -s / _qr[k * M + k];
+                    for (std::size_t i = k; i < N; ++i) {
+                        _qr[i * M + j] = multiply_add(s, _qr[i * M + k], _qr[i * M + j]);
+                    }
+                }
+            }
+            _diagonal[k] = -norm;
+        });
+    }
+
+    // GETTERS
+
+    /**
+     * Check if the columns of `A` are linearly independent, up to the
+     * rounding errors relative to the largest diagonal element of `R`.
+     */
+    constexpr bool is_full_rank() const noexcept {
+        T largest = T{0};
+        for (std::size_t k = 0; k < M; ++k) {
+            largest = std::max(largest, detail::absolute(_diagonal[k]));
+        }
+        const T threshold = T(N) * std::numeric_limits<T>::epsilon() * largest;
+        for (std::size_t k = 0; k < M; ++k) {
+            if (detail::absolute(_diagonal[k]) <= threshold) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Get the upper triangle `R`.
+     */
+    constexpr Matrix<M, M, T> r() const noexcept {
+        Matrix<M, M, T> result;
+        for (std::size_t i = 0; i < M; ++i) {
+            result.data()[i * M + i] = _diagonal[i];
+            for (std::size_t j = i + 1; j < M; ++j) {
+                result.data()[i * M + j] = _qr[i * M + j];
+            }
+        }
+        return result;
+    }
+
+    // SOLVES
+
+    /**
+     * Find `x` minimizing `|A * x - b|`, i.e. solve `A * x = b` for the
+     * square matrix.
+     */
+    constexpr Vector<M, T> solve(const Vector<N, T>& b) const noexcept {
+        T y[N]{};
+        for (std::size_t i = 0; i < N; ++i) {
+            y[i] = b[i];
+        }
+        // y = Q^T * b
+        detail::repeat<M>([&](auto k) {
+            if (_diagonal[k] == T{0}) {
+                return;
+            }
+            T s = T{0};
+            for (std::size_t i = k; i < N; ++i) {
+                s = multiply_add(_qr[i * M + k], y[i], s);
+            }
+            s = -s / _qr[k * M + k];
+            for (std::size_t i = k; i < N; ++i) {
+                y[i] = multiply_add(s, _qr[i * M + k], y[i]);
+            }
+        });
+        Vector<M, T> result;
+        detail::repeat<M>([&](auto r) {
+            const std::size_t k = M - 1 - r;
+            T s = y[k];
+            for (std::size_t j = k + 1; j < M; ++j) {
+                s = multiply_add(-_qr[k * M + j], result[j], s);
+            }
+            result.data()[k] = s / _diagonal[k];
+        });
+        return result;
+    }
+
+  private:
+
+    std::array<T, N * M> _qr{};
+    std::array<T, M> _diagonal{};
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                          DETERMINANT AND INVERSE                           */
+/*----------------------------------------------------------------------------*/
+
+template <std::size_t N, std::floating_point T, Layout L>
+constexpr T determinant(const Matrix<N, N, T, L>& m) noexcept {
+    if constexpr(N == 1) {
+        return m(0, 0);
+    } else if constexpr(N == 2) {
+        return difference_of_products(m(0, 0), m(1, 1), m(0, 1), m(1, 0));
+    } else if constexpr(N == 3) {
+        const T c0 = difference_of_products(m(1, 1), m(2, 2), m(1, 2), m(2, 1));
+        const T c1 = difference_of_products(m(1, 2), m(2, 0), m(1, 0), m(2, 2));
+        const T c2 = difference_of_products(m(1, 0), m(2, 1), m(1, 1), m(2, 0));
+        return multiply_add(m(0, 0), c0, multiply_add(m(0, 1), c1, m(0, 2) * c2));
+    } else if constexpr(N == 4) {
+        // The 2 x 2 minors of the top rows (s) and of the bottom rows (c).
+        const T s0 = difference_of_products(m(0, 0), m(1, 1), m(1, 0), m(0, 1));
+        const T s1 = difference_of_products(m(0, 0), m(1, 2), m(1, 0), m(0, 2));
+        const T s2 = difference_of_products(m(0, 0), m(1, 3), m(1, 0), m(0, 3));
+        const T s3 = difference_of_products(m(0, 1), m(1, 2), m(1, 1), m(0, 2));
+        const T s4 = difference_of_products(m(0, 1), m(1, 3), m(1, 1), m(0, 3));
+        const T s5 = difference_of_products(m(0, 2), m(1, 3), m(1, 2), m(0, 3));
+        const T c0 = difference_of_products(m(2, 0), m(3, 1), m(3, 0), m(2, 1));
+        const T c1 = difference_of_products(m(2, 0), m(3, 2), m(3, 0), m(2, 2));
+        const T c2 = difference_of_products(m(2, 0), m(3, 3), m(3, 0), m(2, 3));
+        const T c3 = difference_of_products(m(2, 1), m(3, 2), m(3, 1), m(2, 2));
+        const T c4 = difference_of_products(m(2, 1), m(3, 3), m(3, 1), m(2, 3));
+        const T c5 = difference_of_products(m(2, 2), m(3, 3), m(3, 2), m(2, 3));
+        return multiply_add(s0, c5, multiply_add(-s1, c4, multiply_add(s2, c3,
+               multiply_add(s3, c2, multiply_add(-s4, c1, s5 * c0)))));
+    } else {
+        return Lu<N, T>(m).determinant();
+    }
+}
+
+/**
+ * Return the inverse matrix, the singular matrix gives the non-finite
+ * elements.
+ */
+template <std::size_t N, std::floating_point T, Layout L>
+constexpr Matrix<N, N, T, L> inverse(const Matrix<N, N, T, L>& m) noexcept {
+    Matrix<N, N, T, L> result;
+    const auto set = [&](std::size_t i, std::size_t j, T value) {
+        result.data()[Matrix<N, N, T, L>::index(i, j)] = value;
+    };
+    if constexpr(N == 1) {
+        set(0, 0, T{1} / m(0, 0));
+    } else if constexpr(N == 2) {
+        const T r = T{1} / determinant(m);
+        set(0, 0, m(1, 1) * r);
+        set(0, 1, -m(0, 1) * r);
+        set(1, 0, -m(1, 0) * r);
+        set(1, 1, m(0, 0) * r);
+    } else if constexpr(N == 3) {
+        const T c0 = difference_of_products(m(1, 1), m(2, 2), m(1, 2), m(2, 1));
+        const T c1 = difference_of_products(m(1, 2), m(2, 0), m(1, 0), m(2, 2));
+        const T c2 = difference_of_products(m(1, 0), m(2, 1), m(1, 1), m(2, 0));
+        const T r = T{1} / multiply_add(m(0, 0), c0, multiply_add(m(0, 1), c1, m(0, 2) * c2));
+        set(0, 0, c0 * r);
+        set(0, 1, difference_of_products(m(0, 2), m(2, 1), m(0, 1), m(2, 2)) * r);
+        set(0, 2, difference_of_products(m(0, 1), m(1, 2), m(0, 2), m(1, 1)) * r);
+        set(1, 0, c1 * r);
+        set(1, 1, difference_of_products(m(0, 0), m(2, 2), m(0, 2), m(2, 0)) * r);
+        set(1, 2, difference_of_products(m(0, 2), m(1, 0), m(0, 0), m(1, 2)) * r);
+        set(2, 0, c2 * r);
+        set(2, 1, difference_of_products(m(0, 1), m(2, 0), m(0, 0), m(2, 1)) * r);
+        set(2, 2, difference_of_products(m(0, 0), m(1, 1), m(0, 1), m(1, 0)) * r);
+    } else if constexpr(N == 4) {
+        const T s0 = difference_of_products(m(0, 0), m(1, 1), m(1, 0), m(0, 1));
+        const T s1 = difference_of_products(m(0, 0), m(1, 2), m(1, 0), m(0, 2));
+        const T s2 = difference_of_products(m(0, 0), m(1, 3), m(1, 0), m(0, 3));
+        const T s3 = difference_of_products(m(0, 1), m(1, 2), m(1, 1), m(0, 2));
+        const T s4 = difference_of_products(m(0, 1), m(1, 3), m(1, 1), m(0, 3));
+        const T s5 = difference_of_products(m(0, 2), m(1, 3), m(1, 2), m(0, 3));
+        const T c0 = difference_of_products(m(2, 0), m(3, 1), m(3, 0), m(2, 1));
+        const T c1 = difference_of_products(m(2, 0), m(3, 2), m(3, 0), m(2, 2));
+        const T c2 = difference_of_products(m(2, 0), m(3, 3), m(3, 0), m(2, 3));
+        const T c3 = difference_of_products(m(2, 1), m(3, 2), m(3, 1), m(2, 2));
+        const T c4 = difference_of_products(m(2, 1), m(3, 3), m(3, 1), m(2, 3));
+        const T c5 = difference_of_products(m(2, 2), m(3, 3), m(3, 2), m(2, 3));
+        const T r = T{1} / multiply_add(s0, c5, multiply_add(-s1, c4, multiply_add(s2, c3,
+                           multiply_add(s3, c2, multiply_add(-s4, c1, s5 * c0)))));
+        // Each element is the 3 x 3 cofactor expanded along the minors.
+        const auto cofactor = [&](T a, T x, T b, T y, T c, T z) {
+            return multiply_add(a, x, multiply_add(-b, y, c * z)) * r;
+        };
+        set(0, 0, cofactor(m(1, 1), c5, m(1, 2), c4, m(1, 3), c3));
+        set(0, 1, -cofactor(m(0, 1), c5, m(0, 2), c4, m(0, 3), c3));
+        set(0, 2, cofactor(m(3, 1), s5, m(3, 2), s4, m(3, 3), s3));
+        set(0, 3, -cofactor(m(2, 1), s5, m(2, 2), s4, m(2, 3), s3));
+        set(1, 0, -cofactor(m(1, 0), c5, m(1, 2), c2, m(1, 3), c1));
+        set(1, 1, cofactor(m(0, 0), c5, m(0, 2), c2, m(0, 3), c1));
+        set(1, 2, -cofactor(m(3, 0), s5, m(3, 2), s2, m(3, 3), s1));
+        set(1, 3, cofactor(m(2, 0), s5, m(2, 2), s2, m(2, 3), s1));
+        set(2, 0, cofactor(m(1, 0), c4, m(1, 1), c2, m(1, 3), c0));
+        set(2, 1, -cofactor(m(0, 0), c4, m(0, 1), c2, m(0, 3), c0));
+        set(2, 2, cofactor(m(3, 0), s4, m(3, 1), s2, m(3, 3), s0));
+        set(2, 3, -cofactor(m(2, 0), s4, m(2, 1), s2, m(2, 3), s0));
+        set(3, 0, -cofactor(m(1, 0), c3, m(1, 1), c1, m(1, 2), c0));
+        set(3, 1, cofactor(m(0, 0), c3, m(0, 1), c1, m(0, 2), c0));
+        set(3, 2, -cofactor(m(3, 0), s3, m(3, 1), s1, m(3, 2), s0));
+        set(3, 3, cofactor(m(2, 0), s3, m(2, 1), s1, m(2, 2), s0));
+    } else {
+        result = Lu<N, T>(m).template inverse<L>();
+    }
+    return result;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                              BATCHED SOLVES                                */
+/*----------------------------------------------------------------------------*/
+
+namespace detail {
+
+/**
+ * The number of the systems solved together, their copy fits in L1.
+ */
+template <std::size_t N, typename T>
+inline constexpr std::size_t batch_size =
+    std::max<std::size_t>(4, std::min<std::size_t>(64, 16 * 1024 / ((N + 1) * N * sizeof(T)))) / 4 * 4;
+
+/**
+ * The copy of the systems `[first, first + count)`, the element `(i, j)` of
+ * the system `s` is `a[i * N + j][s]`.
+ */
+template <std::size_t N, std::floating_point T>
+struct Batch
+{
+    static constexpr std::size_t width = batch_size<N, T>;
+
+    alignas(cache_line_size) T a[N * N][width];
+    alignas(cache_line_size) T b[N][width];
+    std::size_t count;
+
+    template <typename A>
+    void load(const MatrixArray<N, N, T, A>& matrices, const VectorArray<N, T, A>& vectors,
+              std::size_t first, std::size_t size) noexcept {
+        count = size;
+        for (std::size_t e = 0; e < N * N; ++e) {
+            std::copy_n(matrices.lane(e / N, e % N).data() + first, count, a[e]);
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            std::copy_n(vectors.lane(i).data() + first, count, b[i]);
+        }
+    }
+
+    template <typename A>
+    void store(VectorArray<N, T, A>& vectors, std::size_t first) const noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            std::copy_n(b[i], count, vectors.lane(i).data() + first);
+        }
+    }
+};
+
+/**
+ * The Gaussian elimination with the partial pivoting, the solutions replace
+ * the right-hand sides.
+ */
+template <std::size_t N, std::floating_point T>
+void lu_kernel(Batch<N, T>& batch) noexcept {
+    constexpr std::size_t width = Batch<N, T>::width;
+    const std::size_t n = batch.count;
+    auto& a = batch.a;
+    auto& b = batch.b;
+    repeat<N>([&](auto k) {
+        // The rows are compared with the row `k` one by one and the larger
+        // pivot is selected lane by lane, so the largest ends in the row `k`.
+        for (std::size_t i = k + 1; i < N; ++i) {
+            T pivot[width];
+            T candidate[width];
+            std::copy_n(a[k * N + k], n, pivot);
+            std::copy_n(a[i * N + k], n, candidate);
+            const auto swap = [&](T* lhs, T* rhs) {
+                for (std::size_t s = 0; s < n; ++s) {
+                    const bool larger = absolute(candidate[s]) > absolute(pivot[s]);
+                    const T u = lhs[s];
+                    const T v = rhs[s];
+                    lhs[s] = larger ? v : u;
+                    rhs[s] = larger ? u : v;
+                }
+            };
+            for (std::size_t j = k; j < N; ++j) {
+                swap(a[k * N + j], a[i * N + j]);
+            }
+            swap(b[k], b[i]);
+        }
+        T inverse[width];
+        for (std::size_t s = 0; s < n; ++s) {
+            inverse[s] = T{1} / a[k * N + k][s];
+        }
+        for (std::size_t i = k + 1; i < N; ++i) {
+            T f[width];
+            for (std::size_t s = 0; s < n; ++s) {
+                f[s] = a[i * N + k][s] * inverse[s];
+            }
+            for (std::size_t j = k + 1; j < N; ++j) {
+                for (std::size_t s = 0; s < n; ++s) {
+                    a[i * N + j][s] = multiply_add(-f[s], a[k * N + j][s], a[i * N + j][s]);
+                }
+            }
+            for (std::size_t s = 0; s < n; ++s) {
+                b[i][s] = multiply_add(-f[s], b[k][s], b[i][s]);
+            }
+        }
+    });
+    repeat<N>([&](auto r) {
+        const std::size_t i = N - 1 - r;
+        for (std::size_t j = i + 1; j < N; ++j) {
+            for (std::size_t s = 0; s < n; ++s) {
+                b[i][s] = multiply_add(-a[i * N + j][s], b[j][s], b[i][s]);
+            }
+        }
+        for (std::size_t s = 0; s < n; ++s) {
+            b[i][s] /= a[i * N + i][s];
+        }
+    });
+}
+
+/**
+ * The `L * D * L^T` decomposition of the symmetric systems, i.e. Cholesky
+ * without the square roots. Only the lower triangle is read, `L` replaces it
+ * and `D` the diagonal.
+ */
+template <std::size_t N, std::floating_point T>
+void cholesky_kernel(Batch<N, T>& batch) noexcept {
+    constexpr std::size_t width = Batch<N, T>::width;
+    const std::size_t n = batch.count;
+    auto& a = batch.a;
+    auto& b = batch.b;
+    T w[N][width]; // L(j, k) * D(k)
+    repeat<N>([&](auto j) {
+        for (std::size_t k = 0; k < j; ++k) {
+            for (std::size_t s = 0; s < n; ++s) {
+                w[k][s] = a[j * N + k][s] * a[k * N + k][s];
+            }
+            for (std::size_t s = 0; s < n; ++s) {
+                a[j * N + j][s] = multiply_add(-a[j * N + k][s], w[k][s], a[j * N + j][s]);
+            }
+        }
+        T inverse[width];
+        for (std::size_t s = 0; s < n; ++s) {
+            inverse[s] = T{1} / a[j * N + j][s];
+        }
+        for (std::size_t i = j + 1; i < N; ++i) {
+            for (std::size_t k = 0; k < j; ++k) {
+                for (std::size_t s = 0; s < n; ++s) {
+                    a[i * N + j][s] = multiply_add(-a[i * N + k][s], w[k][s], a[i * N + j][s]);
+                }
+            }
+            for (std::size_t s = 0; s < n; ++s) {
+                a[i * N + j][s] *= inverse[s];
+            }
+        }
+    });
+    repeat<N>([&](auto i) {
+        for (std::size_t k = 0; k < i; ++k) {
+            for (std::size_t s = 0; s < n; ++s) {
+                b[i][s] = multiply_add(-a[i * N + k][s], b[k][s], b[i][s]);
+            }
+        }
+    });
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t s = 0; s < n; ++s) {
+            b[i][s] /= a[i * N + i][s];
+        }
+    }
+    repeat<N>([&](auto r) {
+        const std::size_t i = N - 1 - r;
+        for (std::size_t k = i + 1; k < N; ++k) {
+            for (std::size_t s = 0; s < n; ++s) {
+                b[i][s] = multiply_add(-a[k * N + i][s], b[k][s], b[i][s]);
+            }
+        }
+    });
+}
+
+template <std::size_t N, std::floating_point T, typename A, typename F>
+void solve_batches(const MatrixArray<N, N, T, A>& a, const VectorArray<N, T, A>& b, VectorArray<N, T, A>& x,
+                   std::size_t first, std::size_t last, F kernel) noexcept {
+    Batch<N, T> batch;
+    for (std::size_t i = first; i < last; i += Batch<N, T>::width) {
+        batch.load(a, b, i, std::min(Batch<N, T>::width, last - i));
+        kernel(batch);
+        batch.store(x, i);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Solve the systems `a[i] * x[i] = b[i]` by the LU decomposition with the
+ * partial pivoting.
+ *
+ * The singular systems give the non-finite solutions. The output may be the
+ * right-hand side.
+ */
+template <execution::Policy P, std::size_t N, std::floating_point T, typename A>
+void lu_solve(const P& policy, const MatrixArray<N, N, T, A>& a, const VectorArray<N, T, A>& b,
+              VectorArray<N, T, A>& x) {
+    assert(a.size() == b.size() && b.size() == x.size());
+    detail::for_each_chunk<Matrix<N, N, T>>(policy, a.size(), [&](std::size_t first, std::size_t last) {
+        detail::solve_batches(a, b, x, first, last, [](auto& batch) { detail::lu_kernel(batch); });
+    });
+}
+
+template <std::size_t N, std::floating_point T, typename A>
+void lu_solve(const MatrixArray<N, N, T, A>& a, const VectorArray<N, T, A>& b, VectorArray<N, T, A>& x) {
+    lu_solve(execution::seq, a, b, x);
+}
+
+/**
+ * Solve the symmetric positive definite systems `a[i] * x[i] = b[i]` by the
+ * Cholesky (`L * D * L^T`) decomposition.
+ *
+ * Only the lower triangles of the matrices are read. The output may be the
+ * right-hand side.
+ */
+template <execution::Policy P, std::size_t N, std::floating_point T, typename A>
+void cholesky_solve(const P& policy, const MatrixArray<N, N, T, A>& a, const VectorArray<N, T, A>& b,
+                    VectorArray<N, T, A>& x) {
+    assert(a.size() == b.size() && b.size() == x.size());
+    detail::for_each_chunk<Matrix<N, N, T>>(policy, a.size(), [&](std::size_t first, std::size_t last) {
+        detail::solve_batches(a, b, x, first, last, [](auto& batch) { detail::cholesky_kernel(batch); });
+    });
+}
+
+template <std::size_t N, std::floating_point T, typename A>
+void cholesky_solve(const MatrixArray<N, N, T, A>& a, const VectorArray<N, T, A>& b, VectorArray<N, T, A>& x) {
+    cholesky_solve(execution::seq, a, b, x);
+}
+
+} // namespace
+
+#endif // guard
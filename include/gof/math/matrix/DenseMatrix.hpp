@@ -0,0 +1,353 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef DENSE_MATRIX_HEADER_GUARD
+#define DENSE_MATRIX_HEADER_GUARD
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <gof/math/common.hpp> // Number, multiply_add
+#include <gof/math/execution.hpp>
+#include <gof/math/memory.hpp>
+#include <gof/math/simd.hpp>
+#include <gof/math/matrix/Matrix.hpp>
+
+namespace gof {
+
+/**
+ * The matrix with the size given at runtime.
+ *
+ * This is the counterpart of `Matrix<N, M, T, L>` for the large matrices
+ * (e.g. the thousands of rows), the elements are stored on the heap in one
+ * block aligned to the cache line.
+ *
+ * @tparam T The scalar type.
+ * @tparam L The layout of the elements.
+ * @tparam Allocator The allocator of the elements.
+ */
+template <Number T, Layout L = Layout::row_major, typename Allocator = aligned_allocator<T>>
+class DenseMatrix
+{
+  public:
+
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr Layout layout = L;
+
+    /**
+     * Constructor creating the empty matrix.
+     */
+    explicit DenseMatrix(const Allocator& allocator = Allocator()) : _values(allocator) { }
+
+    /**
+     * Constructor creating the zero matrix.
+     */
+    DenseMatrix(std::size_t rows, std::size_t columns, const Allocator& allocator = Allocator())
+        : _rows(rows), _columns(columns), _values(rows * columns, allocator) { }
+
+    /**
+     * Constructor populating the matrix with the same value.
+     */
+    DenseMatrix(std::size_t rows, std::size_t columns, T value, const Allocator& allocator = Allocator())
+        : _rows(rows), _columns(columns), _values(rows * columns, value, allocator) { }
+
+    /**
+     * Constructor copying the matrix of the fixed size.
+     */
+    template <std::size_t N, std::size_t M, Layout K>
+    explicit DenseMatrix(const Matrix<N, M, T, K>& m, const Allocator& allocator = Allocator())
+        : DenseMatrix(N, M, allocator) {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                (*this)(i, j) = m(i, j);
+            }
+        }
+    }
+
+    // GETTERS
+
+    std::size_t rows() const noexcept { return _rows; }
+
+    std::size_t columns() const noexcept { return _columns; }
+
+    std::size_t size() const noexcept { return _values.size(); }
+
+    bool empty() const noexcept { return _values.empty(); }
+
+    allocator_type get_allocator() const { return _values.get_allocator(); }
+
+    /**
+     * Get the distance of the consecutive rows in the storage.
+     */
+    std::size_t row_stride() const noexcept { return L == Layout::row_major ? _columns : 1; }
+
+    /**
+     * Get the distance of the consecutive columns in the storage.
+     */
+    std::size_t column_stride() const noexcept { return L == Layout::row_major ? 1 : _rows; }
+
+    std::size_t index(std::size_t row, std::size_t column) const noexcept {
+        return row * row_stride() + column * column_stride();
+    }
+
+    T* data() noexcept { return _values.data(); }
+
+    const T* data() const noexcept { return _values.data(); }
+
+    /**
+     * Get the elements stored in the order given by the layout.
+     */
+    std::span<T> values() noexcept { return _values; }
+
+    std::span<const T> values() const noexcept { return _values; }
+
+    T& operator ()(std::size_t row, std::size_t column) noexcept {
+        assert(row < _rows && column < _columns);
+        return _values[index(row, column)];
+    }
+
+    const T& operator ()(std::size_t row, std::size_t column) const noexcept {
+        assert(row < _rows && column < _columns);
+        return _values[index(row, column)];
+    }
+
+    // FACTORIES
+
+    /**
+     * Return the identity matrix of the size `n x n`.
+     */
+    static DenseMatrix identity(std::size_t n, const Allocator& allocator = Allocator()) {
+        DenseMatrix result(n, n, allocator);
+        for (std::size_t i = 0; i < n; ++i) {
+            result(i, i) = T{1};
+        }
+        return result;
+    }
+
+    // OPERATORS
+
+    friend bool operator ==(const DenseMatrix& self, const DenseMatrix& that) noexcept {
+        return self._rows == that._rows && self._columns == that._columns &&
+               std::equal(self._values.begin(), self._values.end(), that._values.begin());
+    }
+
+  private:
+
+    std::size_t _rows = 0;
+    std::size_t _columns = 0;
+    std::vector<T, Allocator> _values;
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                                   GEMM                                     */
+/*----------------------------------------------------------------------------*/
+
+namespace detail {
+
+/**
+ * The blocking of `gemm()` for the cache sizes.
+ *
+ * The panel of `B` (`depth x columns`) is kept in the half of L1, the packed
+ * block of `A` (`row_block x depth`) in the half of L2 and the packed block of
+ * `B` (`depth x column_block`) in the slice of L3.
+ */
+template <typename T>
+struct GemmBlocking
+{
+    static constexpr std::size_t l1 = 32 * 1024;
+    static constexpr std::size_t l2 = 256 * 1024;
+    static constexpr std::size_t l3 = 4 * 1024 * 1024;
+
+    static constexpr std::size_t rows = simd::gemm_rows<T>;
+    static constexpr std::size_t columns = simd::gemm_columns<T>;
+    static constexpr std::size_t depth = std::max<std::size_t>(l1 / 2 / (columns * sizeof(T)), 16);
+    static constexpr std::size_t row_block = std::max<std::size_t>(l2 / 2 / (depth * sizeof(T)) / rows, 1) * rows;
+    static constexpr std::size_t column_block = std::max<std::size_t>(l3 / (depth * sizeof(T)) / columns, 1) * columns;
+};
+
+/**
+ * The read-only operand of `gemm()` given by its strides.
+ */
+template <typename T>
+struct GemmOperand
+{
+    const T* data;
+    std::size_t row_stride;
+    std::size_t column_stride;
+
+    const T& operator ()(std::size_t row, std::size_t column) const noexcept {
+        return data[row * row_stride + column * column_stride];
+    }
+};
+
+/**
+ * Pack the block of `A` into the panels of `rows` rows, each step of the
+ * panel is contiguous. The rows after the end are zero.
+ */
+template <typename T>
+void pack_a(const GemmOperand<T>& a, std::size_t row, std::size_t row_count,
+            std::size_t step, std::size_t depth, T* out) noexcept {
+    constexpr std::size_t rows = GemmBlocking<T>::rows;
+    for (std::size_t i0 = 0; i0 < row_count; i0 += rows) {
+        const std::size_t count = std::min(rows, row_count - i0);
+        for (std::size_t p = 0; p < depth; ++p) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                out[p * rows + i] = i < count ? a(row + i0 + i, step + p) : T{0};
+            }
+        }
+        out += depth * rows;
+    }
+}
+
+/**
+ * Pack the block of `B` into the panels of `columns` columns, each step of
+ * the panel is contiguous. The columns after the end are zero.
+ */
+template <typename T>
+void pack_b(const GemmOperand<T>& b, std::size_t step, std::size_t depth,
+            std::size_t column, std::size_t column_count, T* out) noexcept {
+    constexpr std::size_t columns = GemmBlocking<T>::columns;
+    const std::size_t count = std::min(columns, column_count);
+    for (std::size_t p = 0; p < depth; ++p) {
+        for (std::size_t j = 0; j < columns; ++j) {
+            out[p * columns + j] = j < count ? b(step + p, column + j) : T{0};
+        }
+    }
+}
+
+/**
+ * Call `f(first, last)` on the ranges of `[0, count)` blocks according to the
+ * policy, one block per task of the pool.
+ */
+template <execution::Policy P, typename F>
+void for_each_block(const P& policy, std::size_t count, F&& f) {
+    if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+        policy.thread_pool().parallel_for(count, 1, f);
+    } else {
+        if (count > 0) {
+            f(std::size_t{0}, count);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Calculate `c = alpha * a * b + beta * c`.
+ *
+ * The product is blocked for the caches: the blocks of `a` and `b` are packed
+ * into the contiguous panels which the micro-kernel (`simd::gemm_kernel()`)
+ * multiplies in the registers. The parallel policy splits the rows of `c`
+ * among the threads, the result does not depend on the policy.
+ *
+ * As in BLAS, `c` is not read when `beta` is zero. The matrix `c` must not
+ * overlap `a` or `b`.
+ */
+template <execution::Policy P, std::floating_point T, Layout LA, Layout LB, Layout LC,
+          typename AA, typename AB, typename AC>
+void gemm(const P& policy, T alpha, const DenseMatrix<T, LA, AA>& a, const DenseMatrix<T, LB, AB>& b,
+          T beta, DenseMatrix<T, LC, AC>& c) {
+    using Blocking = detail::GemmBlocking<T>;
+    constexpr std::size_t rows = Blocking::rows;
+    constexpr std::size_t columns = Blocking::columns;
+
+    const std::size_t m = a.rows();
+    const std::size_t n = b.columns();
+    const std::size_t k = a.columns();
+    assert(b.rows() == k && c.rows() == m && c.columns() == n);
+    assert(c.data() != a.data() && c.data() != b.data());
+
+    if (k == 0 || alpha == T{0}) {
+        for (T& e : c.values()) {
+            e = beta == T{0} ? T{0} : beta * e;
+        }
+        return;
+    }
+
+    const detail::GemmOperand<T> lhs{a.data(), a.row_stride(), a.column_stride()};
+    const detail::GemmOperand<T> rhs{b.data(), b.row_stride(), b.column_stride()};
+    const std::size_t row_blocks = (m + Blocking::row_block - 1) / Blocking::row_block;
+
+    // Each block of the rows has its own part of the packed `A`.
+    const std::size_t row_panels = (m + rows - 1) / rows;
+    const std::size_t depth_capacity = std::min(k, Blocking::depth);
+    std::vector<T, aligned_allocator<T>> packed_a(row_panels * rows * depth_capacity);
+    std::vector<T, aligned_allocator<T>> packed_b(
+        (std::min(n, Blocking::column_block) + columns - 1) / columns * columns * depth_capacity);
+
+    for (std::size_t column = 0; column < n; column += Blocking::column_block) {
+        const std::size_t column_count = std::min(Blocking::column_block, n - column);
+        const std::size_t column_panels = (column_count + columns - 1) / columns;
+
+        for (std::size_t step = 0; step < k; step += Blocking::depth) {
+            const std::size_t depth = std::min(Blocking::depth, k - step);
+            const bool first = step == 0;
+
+            detail::for_each_block(policy, column_panels, [&](std::size_t first_panel, std::size_t last_panel) {
+                for (std::size_t q = first_panel; q < last_panel; ++q) {
+                    detail::pack_b(rhs, step, depth, column + q * columns, column_count - q * columns,
+                                   packed_b.data() + q * depth * columns);
+                }
+            });
+
+            detail::for_each_block(policy, row_blocks, [&](std::size_t first_block, std::size_t last_block) {
+                alignas(cache_line_size) T tile[rows * columns];
+                for (std::size_t block = first_block; block < last_block; ++block) {
+                    const std::size_t row = block * Blocking::row_block;
+                    const std::size_t row_count = std::min(Blocking::row_block, m - row);
+                    T* const panels = packed_a.data() + row * depth;
+                    detail::pack_a(lhs, row, row_count, step, depth, panels);
+
+                    for (std::size_t q = 0; q < column_panels; ++q) {
+                        const T* const panel_b = packed_b.data() + q * depth * columns;
+                        const std::size_t j0 = column + q * columns;
+                        const std::size_t width = std::min(columns, n - j0);
+                        for (std::size_t i0 = 0; i0 < row_count; i0 += rows) {
+                            simd::gemm_kernel(depth, panels + i0 * depth, panel_b, tile);
+                            const std::size_t height = std::min(rows, row_count - i0);
+                            for (std::size_t i = 0; i < height; ++i) {
+                                for (std::size_t j = 0; j < width; ++j) {
+                                    T& e = c(row + i0 + i, j0 + j);
+                                    const T base = !first ? e : beta == T{0} ? T{0} : beta * e;
+                                    e = multiply_add(alpha, tile[i * columns + j], base);
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+/**
+ * Calculate `c = alpha * a * b + beta * c` in the calling thread.
+ */
+template <std::floating_point T, Layout LA, Layout LB, Layout LC, typename AA, typename AB, typename AC>
+void gemm(T alpha, const DenseMatrix<T, LA, AA>& a, const DenseMatrix<T, LB, AB>& b,
+          T beta, DenseMatrix<T, LC, AC>& c) {
+    gemm(execution::seq, alpha, a, b, beta, c);
+}
+
+/**
+ * The matrix product, see `gemm()`.
+ */
+template <std::floating_point T, Layout L, typename A>
+DenseMatrix<T, L, A> operator *(const DenseMatrix<T, L, A>& lhs, const DenseMatrix<T, L, A>& rhs) {
+    DenseMatrix<T, L, A> result(lhs.rows(), rhs.columns(), lhs.get_allocator());
+    gemm(T{1}, lhs, rhs, T{0}, result);
+    return result;
+}
+
+} // namespace
+
+#endif // guard
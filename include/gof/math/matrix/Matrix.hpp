@@ -3,69 +3,446 @@
 #ifndef MATRIX_HEADER_GUARD
 #define MATRIX_HEADER_GUARD
 
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // hash
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
 
-#include <valarray>
+#include <gof/math/common.hpp> // Number, multiply_add
+#include <gof/math/simd.hpp>
 #include <gof/math/vector/Vector.hpp>
 
 namespace gof {
 
+/**
+ * The order in which the matrix elements are stored in memory.
+ */
+enum class Layout
+{
+    row_major,    ///< The rows are contiguous (C/C++ convention).
+    column_major, ///< The columns are contiguous (OpenGL/Fortran convention).
+};
+
+namespace detail {
+
+/**
+ * Call `f(std::integral_constant<std::size_t, I>{})` for `I = 0 .. Count - 1`
+ * so the loop is fully unrolled regardless of the optimization level.
+ */
+template <typename F, std::size_t... I>
+constexpr void unroll(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+template <std::size_t Count, typename F>
+constexpr void unroll(F&& f) {
+    unroll(std::forward<F>(f), std::make_index_sequence<Count>{});
+}
+
+} // namespace detail
+
+/**
+ * The view of the matrix elements separated by a constant stride, e.g. the row
+ * or the column of the matrix. The view refers to the matrix, no elements are
+ * copied.
+ *
+ * @tparam T The element type (`const` for the read-only view).
+ * @tparam Extent The number of elements.
+ */
+template <typename T, std::size_t Extent>
+class StridedView
+{
+  public:
+
+    /**
+     * The random access iterator over the view.
+     */
+    class iterator
+    {
+      public:
+
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        constexpr iterator() noexcept = default;
+        constexpr iterator(T* first, std::ptrdiff_t stride, std::ptrdiff_t index) noexcept
+            : _first(first), _stride(stride), _index(index) { }
+
+        constexpr T& operator *() const noexcept { return _first[_index * _stride]; }
+        constexpr T& operator [](difference_type n) const noexcept { return _first[(_index + n) * _stride]; }
+
+        constexpr iterator& operator ++() noexcept { ++_index; return *this; }
+        constexpr iterator& operator --() noexcept { --_index; return *this; }
+        constexpr iterator operator ++(int) noexcept { auto old = *this; ++_index; return old; }
+        constexpr iterator operator --(int) noexcept { auto old = *this; --_index; return old; }
+        constexpr iterator& operator +=(difference_type n) noexcept { _index += n; return *this; }
+        constexpr iterator& operator -=(difference_type n) noexcept { _index -= n; return *this; }
+
+        friend constexpr iterator operator +(iterator it, difference_type n) noexcept { return it += n; }
+        friend constexpr iterator operator +(difference_type n, iterator it) noexcept { return it += n; }
+        friend constexpr iterator operator -(iterator it, difference_type n) noexcept { return it -= n; }
+        friend constexpr difference_type operator -(const iterator& a, const iterator& b) noexcept {
+            return a._index - b._index;
+        }
+        friend constexpr bool operator ==(const iterator& a, const iterator& b) noexcept {
+            return a._index == b._index;
+        }
+        friend constexpr auto operator <=>(const iterator& a, const iterator& b) noexcept {
+            return a._index <=> b._index;
+        }
+
+      private:
+
+        // The position is kept as an index, the pointer past the last element
+        // of a strided view would point outside of the matrix.
+        T* _first = nullptr;
+        std::ptrdiff_t _stride = 1;
+        std::ptrdiff_t _index = 0;
+    };
+
+    constexpr StridedView(T* first, std::size_t stride) noexcept : _first(first), _stride(stride) { }
+
+    static constexpr std::size_t size() noexcept { return Extent; }
+
+    constexpr std::size_t stride() const noexcept { return _stride; }
+
+    /**
+     * Get the element with the specified index.
+     */
+    constexpr T& operator [](std::size_t index) const noexcept {
+        assert(index < Extent);
+        return _first[index * _stride];
+    }
+
+    constexpr iterator begin() const noexcept { return {_first, std::ptrdiff_t(_stride), 0}; }
+
+    constexpr iterator end() const noexcept { return {_first, std::ptrdiff_t(_stride), std::ptrdiff_t(Extent)}; }
+
+  private:
+
+    T* _first;
+    std::size_t _stride;
+};
+
 /**
  * The matrix template class.
  *
+ * The matrix is a trivially copyable value type with its elements stored
+ * inline in the order given by the layout.
+ *
  * @tparam N The number of rows.
  * @tparam M The number of columns.
  * @tparam T The scalar type.
+ * @tparam L The memory layout of the elements.
  */
-template <std::size_t N, std::size_t M, typename T>
+template <std::size_t N, std::size_t M, Number T, Layout L = Layout::row_major>
 class Matrix
 {
+  public:
 
-  const std::array<T, M * N> _values;
+    static constexpr std::size_t rows = N;
+    static constexpr std::size_t columns = M;
+    static constexpr Layout layout = L;
 
-  Matrix() = delete;
+    /**
+     * Default constructor creating the zero matrix.
+     */
+    constexpr Matrix() noexcept : _values{} { }
 
-  public:
     /**
      * Constructor: The row order.
+     *
+     * The values are always given row by row regardless of the layout, missing
+     * values are filled with zeros.
      */
     template <typename... Ts>
-    constexpr Matrix(const Ts&... values) : _values({values...}) { }
+    constexpr Matrix(const Ts&... values) : _values{} {
+        const std::array<T, M * N> row_order{{values...}};
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                _values[index(i, j)] = row_order[i * M + j];
+            }
+        }
+    }
+
+    // GETTERS
 
     /**
-     * Destructor
+     * Get the view of the elements stored in the order given by the layout.
+     *
+     * The view refers to the matrix, no elements are copied.
      */
-    virtual ~Matrix() { }
+    constexpr auto values() const noexcept -> std::span<const T, M * N> {
+        return _values;
+    }
 
-    // GETTERS
+    /**
+     * Get the copy of the elements stored in the order given by the layout.
+     */
+    constexpr auto to_array() const noexcept -> std::array<T, M * N> {
+        return _values;
+    }
+
+    /**
+     * Get the pointer to the elements stored in the order given by the layout.
+     */
+    constexpr const T* data() const noexcept { return _values.data(); }
+
+    constexpr T* data() noexcept { return _values.data(); }
+
+    /**
+     * Get the position of the element in the storage.
+     */
+    static constexpr std::size_t index(std::size_t row, std::size_t column) noexcept {
+        if constexpr(L == Layout::row_major) {
+            return row * M + column;
+        } else {
+            return column * N + row;
+        }
+    }
 
-    constexpr auto values() const noexcept -> decltype(_values) {
-      return _values;
+    /**
+     * Get the element in the specified row and column.
+     */
+    constexpr T operator ()(std::size_t row, std::size_t column) const noexcept {
+        assert(row < N && column < M);
+        return _values[index(row, column)];
     }
 
     /**
      * Get the row with specified index.
      */
     inline constexpr auto row(std::size_t index) const -> Vector<M, T> {
-        // TODO Check the index.
-        return Vector<M, T>::zero(); // TODO
+        assert(index < N);
+        Vector<M, T> result;
+        for (std::size_t j = 0; j < M; ++j) {
+            result.data()[j] = (*this)(index, j);
+        }
+        return result;
     }
 
     /**
      *  Get the column with specified index.
      */
     inline constexpr auto column(std::size_t index) const -> Vector<N, T> {
-        // TODO Check the index.
-        return Vector<N, T>::zero(); // TODO
+        assert(index < M);
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = (*this)(i, index);
+        }
+        return result;
+    }
+
+    /**
+     * Get the view of the row with specified index.
+     */
+    constexpr auto row_view(std::size_t index) const noexcept -> StridedView<const T, M> {
+        assert(index < N);
+        return {_values.data() + this->index(index, 0), L == Layout::row_major ? 1 : N};
+    }
+
+    /**
+     * Get the view of the column with specified index.
+     */
+    constexpr auto column_view(std::size_t index) const noexcept -> StridedView<const T, N> {
+        assert(index < M);
+        return {_values.data() + this->index(0, index), L == Layout::row_major ? M : 1};
+    }
+
+    /**
+     * Get the view of the row with specified index, so `m[i][j]` is the same
+     * as `m(i, j)`.
+     */
+    constexpr auto operator [](std::size_t row) const noexcept -> StridedView<const T, M> {
+        return row_view(row);
     }
 
     // FACTORIES
 
     /**
-     * Constructor
+     * Return the matrix with all elements set to zero.
+     */
+    constexpr static auto zero() -> Matrix<N, M, T, L> {
+        return {};
+    }
+
+    /**
+     * Return the identity matrix.
+     *
+     * This will compile only for square matrices.
+     */
+    constexpr static auto identity() -> Matrix<N, M, T, L> requires (N == M) {
+        Matrix<N, M, T, L> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result._values[index(i, i)] = T{1};
+        }
+        return result;
+    }
+
+    /**
+     * The matrices are equal when all their elements are equal.
      */
-    // static Matrix from_columns() { }
+    friend constexpr bool operator ==(const Matrix& self, const Matrix& that) noexcept = default;
+
+    /**
+     * Check if all elements are close to the elements of `that`.
+     *
+     * @param compare The comparison strategy (see `tolerance`).
+     */
+    template <Tolerance<T> C = tolerance::Default<T>>
+    constexpr bool is_close(const Matrix& that, C const& compare = C{}) const noexcept {
+        for (std::size_t i = 0; i < M * N; ++i) {
+            if (!compare(_values[i], that._values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+
+    std::array<T, M * N> _values;
 };
 
+
+/*----------------------------------------------------------------------------*/
+/*                                 PRODUCTS                                   */
+/*----------------------------------------------------------------------------*/
+
+// Every element of a product is accumulated in the order of the inner index
+// with `multiply_add()`, so the unrolled, the looped and the SIMD kernels give
+// bit-identical results.
+
+namespace detail {
+
+/**
+ * The product of row-major matrices `c = a * b` where `a` is N x K and `b` is
+ * K x M. The column-major product is the same kernel with swapped operands,
+ * because the column-major storage of X is the row-major storage of X^T.
+ */
+template <std::size_t N, std::size_t K, std::size_t M, Number T>
+constexpr void multiply_row_major(const T* a, const T* b, T* c) noexcept {
+    if constexpr(N * K * M <= 64) {
+        unroll<N>([&](auto i) {
+            unroll<M>([&](auto j) { c[i * M + j] = a[i * K] * b[j]; });
+            unroll<K - 1>([&](auto k) {
+                unroll<M>([&](auto j) {
+                    c[i * M + j] = multiply_add(a[i * K + k + 1], b[(k + 1) * M + j], c[i * M + j]);
+                });
+            });
+        });
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                c[i * M + j] = a[i * K] * b[j];
+            }
+            for (std::size_t k = 1; k < K; ++k) {
+                for (std::size_t j = 0; j < M; ++j) {
+                    c[i * M + j] = multiply_add(a[i * K + k], b[k * M + j], c[i * M + j]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * The binary operator `matrix * matrix`.
+ */
+template <std::size_t N, std::size_t K, std::size_t M, Number T, Layout L>
+constexpr Matrix<N, M, T, L> operator *(const Matrix<N, K, T, L>& lhs, const Matrix<K, M, T, L>& rhs) noexcept {
+    Matrix<N, M, T, L> result;
+#if GOF_MATH_HAS_SSE
+    if constexpr(N == 4 && K == 4 && M == 4 && (std::is_same_v<T, float> || std::is_same_v<T, double>)) {
+        if (!std::is_constant_evaluated()) {
+            if constexpr(L == Layout::row_major) {
+                simd::multiply4x4(lhs.data(), rhs.data(), result.data());
+            } else {
+                simd::multiply4x4(rhs.data(), lhs.data(), result.data());
+            }
+            return result;
+        }
+    }
+#endif
+    if constexpr(L == Layout::row_major) {
+        detail::multiply_row_major<N, K, M>(lhs.data(), rhs.data(), result.data());
+    } else {
+        detail::multiply_row_major<M, K, N>(rhs.data(), lhs.data(), result.data());
+    }
+    return result;
+}
+
+/**
+ * The binary operator `matrix * vector` (the vector is a column).
+ */
+template <std::size_t N, std::size_t M, Number T, Layout L>
+constexpr Vector<N, T> operator *(const Matrix<N, M, T, L>& lhs, const Vector<M, T>& rhs) noexcept {
+    Vector<N, T> result;
+#if GOF_MATH_HAS_SSE
+    if constexpr(N == 4 && M == 4 && std::is_same_v<T, float>) {
+        if (!std::is_constant_evaluated()) {
+            if constexpr(L == Layout::column_major) {
+                simd::transform4(lhs.data(), rhs.data(), result.data());
+            } else {
+                alignas(16) float columns[16];
+                simd::transpose4x4(lhs.data(), columns);
+                simd::transform4(columns, rhs.data(), result.data());
+            }
+            return result;
+        }
+    }
+#endif
+    const T* v = rhs.data();
+    T* r = result.data();
+    detail::unroll<N>([&](auto i) {
+        r[i] = lhs(i, 0) * v[0];
+        for (std::size_t k = 1; k < M; ++k) {
+            r[i] = multiply_add(lhs(i, k), v[k], r[i]);
+        }
+    });
+    return result;
+}
+
+/**
+ * Return the transposed matrix (in the same layout).
+ */
+template <std::size_t N, std::size_t M, Number T, Layout L>
+constexpr Matrix<M, N, T, L> transpose(const Matrix<N, M, T, L>& m) noexcept {
+    Matrix<M, N, T, L> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < M; ++j) {
+            result.data()[Matrix<M, N, T, L>::index(j, i)] = m(i, j);
+        }
+    }
+    return result;
+}
+
 } // namespace
 
+/**
+ * The hash of the matrix, consistent with `==`.
+ */
+template <std::size_t N, std::size_t M, gof::Number T, gof::Layout L>
+struct std::hash<gof::Matrix<N, M, T, L>>
+{
+    std::size_t operator ()(const gof::Matrix<N, M, T, L>& m) const noexcept {
+        std::uint64_t h = N * M;
+        for (const T& e : m.values()) {
+            h = gof::hash_combine(h, gof::hash_bits(e));
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
 #endif // guard
@@ -0,0 +1,123 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef MATRIX_ARRAY_HEADER_GUARD
+#define MATRIX_ARRAY_HEADER_GUARD
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+#include <gof/math/common.hpp> // Number
+#include <gof/math/memory.hpp>
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+namespace gof {
+
+/**
+ * The array of matrices stored as a structure of arrays (SoA).
+ *
+ * This is the bulk-data counterpart of `Matrix<N, M, T>`: each element
+ * `(i, j)` has its own lane of `VectorArray`, so the batched kernels (e.g.
+ * the solves in `Decomposition.hpp`) run the SIMD lanes across the matrices.
+ *
+ * @tparam N The number of rows.
+ * @tparam M The number of columns.
+ * @tparam T The scalar type.
+ * @tparam Allocator The allocator of the lanes.
+ */
+template <std::size_t N, std::size_t M, Number T, typename Allocator = aligned_allocator<T>>
+class MatrixArray
+{
+  public:
+
+    using value_type = Matrix<N, M, T>;
+    using allocator_type = Allocator;
+
+    /**
+     * Constructor creating the empty array.
+     */
+    explicit MatrixArray(const Allocator& allocator = Allocator()) : _elements(allocator) { }
+
+    /**
+     * Constructor creating the array of `count` zero matrices.
+     */
+    explicit MatrixArray(std::size_t count, const Allocator& allocator = Allocator())
+        : _elements(count, allocator) { }
+
+    /**
+     * Constructor converting the array of matrices into the lanes.
+     */
+    template <Layout L>
+    explicit MatrixArray(std::span<const Matrix<N, M, T, L>> matrices, const Allocator& allocator = Allocator())
+        : _elements(matrices.size(), allocator) {
+        for (std::size_t i = 0; i < matrices.size(); ++i) {
+            set(i, matrices[i]);
+        }
+    }
+
+    // GETTERS
+
+    constexpr std::size_t size() const noexcept { return _elements.size(); }
+
+    constexpr bool empty() const noexcept { return _elements.empty(); }
+
+    allocator_type get_allocator() const { return _elements.get_allocator(); }
+
+    /**
+     * Get the lane of the element `(row, column)` of all matrices.
+     */
+    std::span<T> lane(std::size_t row, std::size_t column) noexcept {
+        assert(row < N && column < M);
+        return _elements.lane(row * M + column);
+    }
+
+    std::span<const T> lane(std::size_t row, std::size_t column) const noexcept {
+        assert(row < N && column < M);
+        return _elements.lane(row * M + column);
+    }
+
+    /**
+     * Gather the matrix with specified index.
+     */
+    Matrix<N, M, T> operator [](std::size_t index) const noexcept {
+        assert(index < size());
+        Matrix<N, M, T> result;
+        for (std::size_t e = 0; e < N * M; ++e) {
+            result.data()[e] = _elements.lane(e)[index];
+        }
+        return result;
+    }
+
+    // SETTERS
+
+    /**
+     * Scatter the matrix to the lanes at specified index.
+     */
+    template <Layout L>
+    void set(std::size_t index, const Matrix<N, M, T, L>& matrix) noexcept {
+        assert(index < size());
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                _elements.lane(i * M + j)[index] = matrix(i, j);
+            }
+        }
+    }
+
+    void reserve(std::size_t count) { _elements.reserve(count); }
+
+    /**
+     * Resize the array, the new matrices are zero.
+     */
+    void resize(std::size_t count) { _elements.resize(count); }
+
+  private:
+
+    VectorArray<N * M, T, Allocator> _elements;
+};
+
+} // namespace
+
+#endif // guard
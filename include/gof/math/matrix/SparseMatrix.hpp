@@ -0,0 +1,569 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef SPARSE_MATRIX_HEADER_GUARD
+#define SPARSE_MATRIX_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gof/math/common.hpp> // multiply_add
+#include <gof/math/execution.hpp>
+#include <gof/math/memory.hpp>
+#include <gof/math/matrix/Matrix.hpp> // Layout
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+/*
+ * The sparse matrices and the iterative solvers of the large sparse systems.
+ *
+ * The layout selects the compressed format: `Layout::row_major` is CSR (the
+ * non-zeros of each row are contiguous), `Layout::column_major` is CSC. The
+ * matrix is built in bulk from the coordinate list (COO) of the triplets.
+ *
+ * The dense vectors of the solvers are the spans of the scalars, e.g. the
+ * lanes of `VectorArray` (the overloads for the whole array solve the lanes
+ * one by one).
+ */
+
+namespace gof {
+
+/**
+ * The non-zero element of the coordinate list (COO).
+ */
+template <typename T>
+struct Triplet
+{
+    std::size_t row;
+    std::size_t column;
+    T value;
+};
+
+/**
+ * The compressed sparse matrix.
+ *
+ * The non-zeros of each row (CSR) or column (CSC) are sorted by their index,
+ * the duplicates of the triplets are summed and the explicit zeros are kept.
+ *
+ * @tparam T The scalar type.
+ * @tparam L `Layout::row_major` for CSR, `Layout::column_major` for CSC.
+ * @tparam Allocator The allocator of the arrays (rebound to their types).
+ */
+template <std::floating_point T, Layout L = Layout::row_major, typename Allocator = std::allocator<std::byte>>
+class SparseMatrix
+{
+  public:
+
+    using value_type = T;
+    using index_type = std::uint32_t;
+    using allocator_type = Allocator;
+
+    static constexpr Layout layout = L;
+
+    /**
+     * Constructor creating the empty matrix `0 x 0`.
+     */
+    explicit SparseMatrix(const Allocator& allocator = Allocator())
+        : _offsets(1, allocator), _indices(allocator), _values(allocator) { }
+
+    /**
+     * Constructor building the matrix from the triplets in any order.
+     */
+    SparseMatrix(std::size_t rows, std::size_t columns, std::span<const Triplet<T>> triplets,
+                 const Allocator& allocator = Allocator())
+        : _rows(rows), _columns(columns), _offsets(major_size() + 1, allocator), _indices(allocator),
+          _values(allocator) {
+        assert(minor_size() <= std::numeric_limits<index_type>::max());
+        // The counting sort by the major index keeps the order of the
+        // triplets, so the duplicates are summed in that order.
+        for (const auto& t : triplets) {
+            assert(t.row < rows && t.column < columns);
+            ++_offsets[major(t.row, t.column) + 1];
+        }
+        for (std::size_t i = 0; i < major_size(); ++i) {
+            _offsets[i + 1] += _offsets[i];
+        }
+        _indices.resize(triplets.size());
+        _values.resize(triplets.size());
+        {
+            detail::rebind_vector<std::size_t, Allocator> cursor(_offsets.begin(), _offsets.end() - 1, allocator);
+            for (const auto& t : triplets) {
+                const std::size_t position = cursor[major(t.row, t.column)]++;
+                _indices[position] = index_type(minor(t.row, t.column));
+                _values[position] = t.value;
+            }
+        }
+        // The lines are sorted and compacted in place.
+        std::size_t size = 0;
+        std::size_t first = 0;
+        for (std::size_t i = 0; i < major_size(); ++i) {
+            const std::size_t last = _offsets[i + 1];
+            sort_line(first, last);
+            for (std::size_t k = first; k < last; ++k) {
+                if (k > first && _indices[k] == _indices[k - 1]) {
+                    _values[size - 1] += _values[k];
+                } else {
+                    _indices[size] = _indices[k];
+                    _values[size] = _values[k];
+                    ++size;
+                }
+            }
+            first = last;
+            _offsets[i + 1] = size;
+        }
+        _indices.resize(size);
+        _values.resize(size);
+    }
+
+    /**
+     * Constructor converting the matrix between CSR and CSC.
+     */
+    template <Layout K, typename A>
+    explicit SparseMatrix(const SparseMatrix<T, K, A>& that, const Allocator& allocator = Allocator())
+        : _rows(that.rows()), _columns(that.columns()), _offsets(major_size() + 1, allocator),
+          _indices(that.non_zeros(), allocator), _values(that.non_zeros(), allocator) {
+        // The lines of `that` are visited in order, so the indices of the
+        // new lines come sorted.
+        const auto offsets = that.offsets();
+        const auto indices = that.indices();
+        const auto values = that.values();
+        const std::size_t lines = offsets.size() - 1;
+        for (std::size_t line = 0; line < lines; ++line) {
+            for (std::size_t k = offsets[line]; k < offsets[line + 1]; ++k) {
+                ++_offsets[(K == L ? line : indices[k]) + 1];
+            }
+        }
+        for (std::size_t i = 0; i < major_size(); ++i) {
+            _offsets[i + 1] += _offsets[i];
+        }
+        detail::rebind_vector<std::size_t, Allocator> cursor(_offsets.begin(), _offsets.end() - 1, allocator);
+        for (std::size_t line = 0; line < lines; ++line) {
+            for (std::size_t k = offsets[line]; k < offsets[line + 1]; ++k) {
+                const std::size_t i = K == L ? line : indices[k];
+                const std::size_t position = cursor[i]++;
+                _indices[position] = index_type(K == L ? indices[k] : line);
+                _values[position] = values[k];
+            }
+        }
+    }
+
+    // GETTERS
+
+    std::size_t rows() const noexcept { return _rows; }
+
+    std::size_t columns() const noexcept { return _columns; }
+
+    std::size_t non_zeros() const noexcept { return _values.size(); }
+
+    allocator_type get_allocator() const { return Allocator(_values.get_allocator()); }
+
+    /**
+     * Get the positions of the first non-zero of each row (CSR) or column
+     * (CSC) followed by the number of non-zeros.
+     */
+    std::span<const std::size_t> offsets() const noexcept { return _offsets; }
+
+    /**
+     * Get the column (CSR) or row (CSC) index of each non-zero.
+     */
+    std::span<const index_type> indices() const noexcept { return _indices; }
+
+    std::span<T> values() noexcept { return _values; }
+
+    std::span<const T> values() const noexcept { return _values; }
+
+    /**
+     * Get the number of bytes of the stored arrays.
+     */
+    std::size_t memory_footprint() const noexcept {
+        return _offsets.size() * sizeof(std::size_t) + _indices.size() * sizeof(index_type) + _values.size() * sizeof(T);
+    }
+
+    /**
+     * Get the element, the binary search in its row (CSR) or column (CSC).
+     */
+    T operator ()(std::size_t row, std::size_t column) const noexcept {
+        assert(row < _rows && column < _columns);
+        const std::size_t i = major(row, column);
+        const auto first = _indices.begin() + _offsets[i];
+        const auto last = _indices.begin() + _offsets[i + 1];
+        const auto it = std::lower_bound(first, last, index_type(minor(row, column)));
+        return it != last && *it == minor(row, column) ? _values[it - _indices.begin()] : T{0};
+    }
+
+  private:
+
+    /**
+     * Sort the non-zeros `[first, last)` of a line by the index, stable so
+     * the duplicates are summed in the order of the triplets. The typical
+     * lines are short, so they are sorted by the insertion.
+     */
+    void sort_line(std::size_t first, std::size_t last) {
+        if (last - first > 32) {
+            using Entry = std::pair<index_type, T>;
+            detail::rebind_vector<Entry, Allocator> entries(last - first, _values.get_allocator());
+            for (std::size_t k = first; k < last; ++k) {
+                entries[k - first] = {_indices[k], _values[k]};
+            }
+            std::stable_sort(entries.begin(), entries.end(),
+                             [](const Entry& a, const Entry& b) { return a.first < b.first; });
+            for (std::size_t k = first; k < last; ++k) {
+                std::tie(_indices[k], _values[k]) = entries[k - first];
+            }
+            return;
+        }
+        for (std::size_t k = first + 1; k < last; ++k) {
+            const index_type index = _indices[k];
+            const T value = _values[k];
+            std::size_t j = k;
+            for (; j > first && index < _indices[j - 1]; --j) {
+                _indices[j] = _indices[j - 1];
+                _values[j] = _values[j - 1];
+            }
+            _indices[j] = index;
+            _values[j] = value;
+        }
+    }
+
+    std::size_t major_size() const noexcept { return L == Layout::row_major ? _rows : _columns; }
+
+    std::size_t minor_size() const noexcept { return L == Layout::row_major ? _columns : _rows; }
+
+    static std::size_t major(std::size_t row, std::size_t column) noexcept {
+        return L == Layout::row_major ? row : column;
+    }
+
+    static std::size_t minor(std::size_t row, std::size_t column) noexcept {
+        return L == Layout::row_major ? column : row;
+    }
+
+    std::size_t _rows = 0;
+    std::size_t _columns = 0;
+    detail::rebind_vector<std::size_t, Allocator> _offsets;
+    detail::rebind_vector<index_type, Allocator> _indices;
+    detail::rebind_vector<T, Allocator> _values;
+};
+
+namespace pmr {
+
+template <std::floating_point T, Layout L = Layout::row_major>
+using SparseMatrix = gof::SparseMatrix<T, L, aligned_allocator<std::byte>>;
+
+} // namespace pmr
+
+
+/*----------------------------------------------------------------------------*/
+/*                                   SPMV                                     */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Calculate `y = a * x`.
+ *
+ * The rows of CSR are split among the threads of the parallel policy. The
+ * product of CSC scatters to `y`, so it always runs in the calling thread.
+ */
+template <execution::Policy P, std::floating_point T, Layout L, typename A>
+void multiply(const P& policy, const SparseMatrix<T, L, A>& a, std::type_identity_t<std::span<const T>> x,
+              std::type_identity_t<std::span<T>> y) {
+    assert(x.size() == a.columns() && y.size() == a.rows());
+    assert(x.data() != y.data());
+    const auto offsets = a.offsets();
+    const auto indices = a.indices();
+    const auto values = a.values();
+    if constexpr(L == Layout::row_major) {
+        detail::for_each_chunk<T>(policy, a.rows(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                T sum = T{0};
+                for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                    sum = multiply_add(values[k], x[indices[k]], sum);
+                }
+                y[i] = sum;
+            }
+        });
+    } else {
+        std::fill(y.begin(), y.end(), T{0});
+        for (std::size_t j = 0; j < a.columns(); ++j) {
+            for (std::size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                y[indices[k]] = multiply_add(values[k], x[j], y[indices[k]]);
+            }
+        }
+    }
+}
+
+template <std::floating_point T, Layout L, typename A>
+void multiply(const SparseMatrix<T, L, A>& a, std::type_identity_t<std::span<const T>> x,
+              std::type_identity_t<std::span<T>> y) {
+    multiply(execution::seq, a, x, y);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 SOLVERS                                    */
+/*----------------------------------------------------------------------------*/
+
+template <std::floating_point T>
+struct SolverOptions
+{
+    /**
+     * Stop when the residual `|b - A * x|` is within this fraction of `|b|`.
+     */
+    T tolerance = std::is_same_v<T, float> ? T(1e-5) : T(1e-10);
+
+    std::size_t max_iterations = 1000;
+
+    /**
+     * Use the inverse of the diagonal as the preconditioner. The diagonal
+     * must not have zeros.
+     */
+    bool jacobi = true;
+};
+
+template <std::floating_point T>
+struct SolverResult
+{
+    std::size_t iterations = 0;
+
+    /**
+     * The final relative residual `|b - A * x| / |b|`.
+     */
+    T residual = T{0};
+
+    bool converged = false;
+};
+
+namespace detail {
+
+template <std::floating_point T>
+using Workspace = std::vector<T, aligned_allocator<T>>;
+
+/**
+ * The inverse of the diagonal, or the ones without the preconditioner.
+ */
+template <std::floating_point T, Layout L, typename A>
+Workspace<T> jacobi(const SparseMatrix<T, L, A>& a, bool enabled) {
+    Workspace<T> result(a.rows(), T{1});
+    if (enabled) {
+        const auto offsets = a.offsets();
+        const auto indices = a.indices();
+        const auto values = a.values();
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+            for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                if (indices[k] == i) {
+                    result[i] = T{1} / values[k];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+template <execution::Policy P, std::floating_point T>
+T inner_product(const P& policy, std::span<const T> x, std::span<const T> y) {
+    return reduce<T>(policy, x.size(), T{0},
+                     [&](std::size_t i) { return x[i] * y[i]; },
+                     [](T a, T b) { return a + b; });
+}
+
+/**
+ * Calculate `r = b - A * x` and return `|r|^2`.
+ */
+template <execution::Policy P, std::floating_point T, Layout L, typename A>
+T residual(const P& policy, const SparseMatrix<T, L, A>& a, std::span<const T> b, std::span<const T> x,
+           std::span<T> r) {
+    multiply(policy, a, x, r);
+    return reduce<T>(policy, r.size(), T{0},
+                     [&](std::size_t i) { r[i] = b[i] - r[i]; return r[i] * r[i]; },
+                     [](T u, T v) { return u + v; });
+}
+
+} // namespace detail
+
+/**
+ * Solve the symmetric positive definite system `a * x = b` by the
+ * preconditioned conjugate gradient.
+ *
+ * @param x The initial guess replaced by the solution.
+ */
+template <execution::Policy P, std::floating_point T, Layout L, typename A>
+SolverResult<T> conjugate_gradient(const P& policy, const SparseMatrix<T, L, A>& a,
+                                   std::type_identity_t<std::span<const T>> b, std::type_identity_t<std::span<T>> x,
+                                   const SolverOptions<T>& options = {}) {
+    assert(a.rows() == a.columns() && b.size() == a.rows() && x.size() == a.rows());
+    const std::size_t n = b.size();
+    SolverResult<T> result;
+    const T norm_b = std::sqrt(detail::inner_product<P, T>(policy, b, b));
+    if (norm_b == T{0}) {
+        std::fill(x.begin(), x.end(), T{0});
+        result.converged = true;
+        return result;
+    }
+    const auto inverse = detail::jacobi(a, options.jacobi);
+    detail::Workspace<T> r(n), p(n), q(n);
+
+    T rr = detail::residual(policy, a, b, std::span<const T>(x), std::span<T>(r));
+    result.residual = std::sqrt(rr) / norm_b;
+    // z = M^-1 * r is not stored, p starts as z.
+    T rz = detail::reduce<T>(policy, n, T{0},
+                             [&](std::size_t i) { p[i] = inverse[i] * r[i]; return r[i] * p[i]; },
+                             [](T u, T v) { return u + v; });
+    while (result.residual > options.tolerance && result.iterations < options.max_iterations) {
+        multiply(policy, a, std::span<const T>(p), std::span<T>(q));
+        const T alpha = rz / detail::inner_product<P, T>(policy, p, q);
+        // One pass updates x and r and sums |r|^2 and r . z together.
+        const Vector<2, T> sums = detail::reduce<T>(policy, n, Vector<2, T>(T{0}, T{0}),
+            [&](std::size_t i) {
+                x[i] = multiply_add(alpha, p[i], x[i]);
+                r[i] = multiply_add(-alpha, q[i], r[i]);
+                return Vector<2, T>(r[i] * r[i], r[i] * (inverse[i] * r[i]));
+            },
+            [](const Vector<2, T>& u, const Vector<2, T>& v) { return u + v; });
+        ++result.iterations;
+        result.residual = std::sqrt(sums.x()) / norm_b;
+        const T beta = sums.y() / rz;
+        rz = sums.y();
+        detail::for_each_chunk<T>(policy, n, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                p[i] = multiply_add(beta, p[i], inverse[i] * r[i]);
+            }
+        });
+    }
+    result.converged = result.residual <= options.tolerance;
+    return result;
+}
+
+template <std::floating_point T, Layout L, typename A>
+SolverResult<T> conjugate_gradient(const SparseMatrix<T, L, A>& a, std::type_identity_t<std::span<const T>> b,
+                                   std::type_identity_t<std::span<T>> x, const SolverOptions<T>& options = {}) {
+    return conjugate_gradient(execution::seq, a, b, x, options);
+}
+
+/**
+ * Solve the general system `a * x = b` by the BiCGSTAB with the right
+ * preconditioning.
+ *
+ * The method may break down (e.g. for the indefinite systems), then the result
+ * is not converged and `x` is the last iterate.
+ *
+ * @param x The initial guess replaced by the solution.
+ */
+template <execution::Policy P, std::floating_point T, Layout L, typename A>
+SolverResult<T> bicgstab(const P& policy, const SparseMatrix<T, L, A>& a, std::type_identity_t<std::span<const T>> b,
+                         std::type_identity_t<std::span<T>> x, const SolverOptions<T>& options = {}) {
+    assert(a.rows() == a.columns() && b.size() == a.rows() && x.size() == a.rows());
+    const std::size_t n = b.size();
+    SolverResult<T> result;
+    const T norm_b = std::sqrt(detail::inner_product<P, T>(policy, b, b));
+    if (norm_b == T{0}) {
+        std::fill(x.begin(), x.end(), T{0});
+        result.converged = true;
+        return result;
+    }
+    const auto inverse = detail::jacobi(a, options.jacobi);
+    detail::Workspace<T> r(n), shadow(n), p(n, T{0}), v(n, T{0}), preconditioned(n), t(n);
+
+    result.residual = std::sqrt(detail::residual(policy, a, b, std::span<const T>(x), std::span<T>(r))) / norm_b;
+    std::copy(r.begin(), r.end(), shadow.begin());
+    T rho = T{1};
+    T alpha = T{1};
+    T omega = T{1};
+    const auto sum = [](T u, T w) { return u + w; };
+    while (result.residual > options.tolerance && result.iterations < options.max_iterations) {
+        const T rho_next = detail::inner_product<P, T>(policy, shadow, r);
+        if (rho_next == T{0} || omega == T{0}) {
+            break;
+        }
+        const T beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        // p = r + beta * (p - omega * v), p^ = M^-1 * p, v = A * p^
+        detail::for_each_chunk<T>(policy, n, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                p[i] = multiply_add(beta, multiply_add(-omega, v[i], p[i]), r[i]);
+                preconditioned[i] = inverse[i] * p[i];
+            }
+        });
+        multiply(policy, a, std::span<const T>(preconditioned), std::span<T>(v));
+        alpha = rho / detail::inner_product<P, T>(policy, shadow, v);
+        // x += alpha * p^, s = r - alpha * v (in place of r)
+        const T ss = detail::reduce<T>(policy, n, T{0}, [&](std::size_t i) {
+            x[i] = multiply_add(alpha, preconditioned[i], x[i]);
+            r[i] = multiply_add(-alpha, v[i], r[i]);
+            return r[i] * r[i];
+        }, sum);
+        ++result.iterations;
+        result.residual = std::sqrt(ss) / norm_b;
+        if (result.residual <= options.tolerance) {
+            break;
+        }
+        // s^ = M^-1 * s, t = A * s^
+        detail::for_each_chunk<T>(policy, n, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                preconditioned[i] = inverse[i] * r[i];
+            }
+        });
+        multiply(policy, a, std::span<const T>(preconditioned), std::span<T>(t));
+        const Vector<2, T> ts = detail::reduce<T>(policy, n, Vector<2, T>(T{0}, T{0}),
+            [&](std::size_t i) { return Vector<2, T>(t[i] * r[i], t[i] * t[i]); },
+            [](const Vector<2, T>& u, const Vector<2, T>& w) { return u + w; });
+        omega = ts.y() > T{0} ? ts.x() / ts.y() : T{0};
+        // x += omega * s^, r = s - omega * t
+        const T rr = detail::reduce<T>(policy, n, T{0}, [&](std::size_t i) {
+            x[i] = multiply_add(omega, preconditioned[i], x[i]);
+            r[i] = multiply_add(-omega, t[i], r[i]);
+            return r[i] * r[i];
+        }, sum);
+        result.residual = std::sqrt(rr) / norm_b;
+    }
+    result.converged = result.residual <= options.tolerance;
+    return result;
+}
+
+template <std::floating_point T, Layout L, typename A>
+SolverResult<T> bicgstab(const SparseMatrix<T, L, A>& a, std::type_identity_t<std::span<const T>> b,
+                         std::type_identity_t<std::span<T>> x, const SolverOptions<T>& options = {}) {
+    return bicgstab(execution::seq, a, b, x, options);
+}
+
+/**
+ * Solve the systems with the same matrix for each lane of `b`, e.g. the
+ * components of the displacements.
+ */
+template <execution::Policy P, std::floating_point T, Layout L, typename A, std::size_t N, typename VA>
+std::array<SolverResult<T>, N> conjugate_gradient(const P& policy, const SparseMatrix<T, L, A>& a,
+                                                  const VectorArray<N, T, VA>& b, VectorArray<N, T, VA>& x,
+                                                  const SolverOptions<T>& options = {}) {
+    assert(b.size() == x.size());
+    std::array<SolverResult<T>, N> result;
+    for (std::size_t k = 0; k < N; ++k) {
+        result[k] = conjugate_gradient(policy, a, b.lane(k), x.lane(k), options);
+    }
+    return result;
+}
+
+template <execution::Policy P, std::floating_point T, Layout L, typename A, std::size_t N, typename VA>
+std::array<SolverResult<T>, N> bicgstab(const P& policy, const SparseMatrix<T, L, A>& a,
+                                        const VectorArray<N, T, VA>& b, VectorArray<N, T, VA>& x,
+                                        const SolverOptions<T>& options = {}) {
+    assert(b.size() == x.size());
+    std::array<SolverResult<T>, N> result;
+    for (std::size_t k = 0; k < N; ++k) {
+        result[k] = bicgstab(policy, a, b.lane(k), x.lane(k), options);
+    }
+    return result;
+}
+
+} // namespace
+
+#endif // guard
@@ -0,0 +1,344 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef MEMORY_HEADER_GUARD
+#define MEMORY_HEADER_GUARD
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gof {
+
+/**
+ * The alignment of the bulk data.
+ *
+ * This is the size of a cache line and it is also enough for any SIMD
+ * register up to AVX-512.
+ */
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * The allocator returning memory aligned to `Alignment` bytes.
+ *
+ * @tparam T The allocated type.
+ * @tparam Alignment The alignment in bytes (power of two).
+ */
+template <typename T, std::size_t Alignment = cache_line_size>
+struct aligned_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two.");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template <typename U>
+    constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept { }
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    constexpr bool operator ==(const aligned_allocator<U, Alignment>&) const noexcept { return true; }
+};
+
+/**
+ * Round `count` elements of type `T` up to the whole cache lines.
+ */
+template <typename T>
+constexpr std::size_t round_up_to_cache_line(std::size_t count) noexcept {
+    constexpr std::size_t per_line = cache_line_size / sizeof(T) > 0 ? cache_line_size / sizeof(T) : 1;
+    return (count + per_line - 1) / per_line * per_line;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                  ARENA                                     */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The linear arena of the per-frame scratch data.
+ *
+ * The memory is bumped from the blocks taken from the upstream resource,
+ * `deallocate()` does nothing and `reset()` rewinds the arena to its first
+ * block in `O(1)`. The blocks are kept, so once the arena has grown to the
+ * size of a frame the following frames do not touch the upstream at all.
+ * Every allocation is aligned at least to `cache_line_size`, i.e. to the
+ * width of any SIMD register.
+ *
+ * The allocation is lock-free within a block, so the arena may serve the
+ * threads of the pool, but `reset()` and `release()` must not run
+ * concurrently with the allocations.
+ */
+class FrameArena final : public std::pmr::memory_resource
+{
+  public:
+
+    /**
+     * Constructor allocating the first block.
+     *
+     * @param capacity The size of the first block in bytes.
+     * @param upstream The resource of the blocks.
+     */
+    explicit FrameArena(std::size_t capacity,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : _upstream(upstream), _block_size(std::max(capacity, cache_line_size)) {
+        _head = allocate_block(_block_size);
+        _current.store(_head, std::memory_order_relaxed);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+
+    FrameArena& operator =(const FrameArena&) = delete;
+
+    ~FrameArena() override {
+        release();
+    }
+
+    // GETTERS
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return _upstream; }
+
+    /**
+     * Get the total size of the blocks in bytes.
+     */
+    std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * Get the number of bytes bumped since the last reset (with the padding
+     * and the ends of the blocks skipped).
+     */
+    std::size_t used() const noexcept {
+        std::size_t result = 0;
+        const Block* current = _current.load(std::memory_order_acquire);
+        for (const Block* block = _head; block; block = block->next) {
+            if (block == current) {
+                return result + block->used.load(std::memory_order_relaxed);
+            }
+            result += block->size;
+        }
+        return result;
+    }
+
+    // SETTERS
+
+    /**
+     * Free all allocations at once, the blocks are kept for the next frame.
+     */
+    void reset() noexcept {
+        if (_head) {
+            _head->used.store(0, std::memory_order_relaxed);
+        }
+        _current.store(_head, std::memory_order_release);
+    }
+
+    /**
+     * Return all blocks to the upstream resource.
+     */
+    void release() noexcept {
+        for (Block* block = _head; block;) {
+            Block* next = block->next;
+            const std::size_t size = block->size;
+            block->~Block();
+            _upstream->deallocate(block, header + size, cache_line_size);
+            block = next;
+        }
+        _head = nullptr;
+        _tail = nullptr;
+        _capacity = 0;
+        _current.store(nullptr, std::memory_order_release);
+    }
+
+  private:
+
+    struct Block
+    {
+        Block* next = nullptr;
+        std::size_t size = 0;
+        std::atomic<std::size_t> used = 0;
+
+        std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this) + header; }
+    };
+
+    /**
+     * The data of the block starts on the cache line after its header.
+     */
+    static constexpr std::size_t header = (sizeof(Block) + cache_line_size - 1) / cache_line_size * cache_line_size;
+
+    Block* allocate_block(std::size_t size) {
+        void* memory = _upstream->allocate(header + size, cache_line_size);
+        Block* block = ::new (memory) Block;
+        block->size = size;
+        if (_tail) {
+            _tail->next = block;
+        } else {
+            _head = block;
+        }
+        _tail = block;
+        _capacity += size;
+        return block;
+    }
+
+    /**
+     * Bump `bytes` from the block, or return null when they do not fit.
+     */
+    static void* bump(Block* block, std::size_t bytes, std::size_t alignment) noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(block->data());
+        std::size_t used = block->used.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t first = ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+            if (first > block->size || bytes > block->size - first) {
+                return nullptr;
+            }
+            if (block->used.compare_exchange_weak(used, first + bytes, std::memory_order_relaxed)) {
+                return block->data() + first;
+            }
+        }
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        alignment = std::max(alignment, cache_line_size);
+        for (;;) {
+            Block* block = _current.load(std::memory_order_acquire);
+            if (block) {
+                if (void* result = bump(block, bytes, alignment)) {
+                    return result;
+                }
+            }
+            // Move to the next block which is large enough, or add one.
+            std::lock_guard lock(_mutex);
+            if (_current.load(std::memory_order_relaxed) != block) {
+                continue;
+            }
+            Block* next = block ? block->next : _head;
+            while (next && next->size < bytes + alignment) {
+                next = next->next;
+            }
+            if (!next) {
+                _block_size = std::max(2 * _block_size, bytes + alignment);
+                next = allocate_block(_block_size);
+            }
+            next->used.store(0, std::memory_order_relaxed);
+            _current.store(next, std::memory_order_release);
+        }
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override { }
+
+    bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override {
+        return this == &that;
+    }
+
+    std::pmr::memory_resource* _upstream;
+    std::size_t _block_size;
+    std::size_t _capacity = 0;
+    Block* _head = nullptr;
+    Block* _tail = nullptr;
+    std::atomic<Block*> _current = nullptr;
+    std::mutex _mutex;
+};
+
+/*----------------------------------------------------------------------------*/
+/*                          POLYMORPHIC ALLOCATORS                            */
+/*----------------------------------------------------------------------------*/
+
+namespace pmr {
+
+/**
+ * The allocator of the memory resource returning memory aligned to
+ * `Alignment` bytes.
+ *
+ * This is `std::pmr::polymorphic_allocator` which keeps the alignment of
+ * `gof::aligned_allocator`, so the lanes of the bulk containers start on the
+ * cache lines whatever the resource. The nested containers get the same
+ * resource (the uses-allocator construction).
+ *
+ * @tparam T The allocated type.
+ * @tparam Alignment The alignment in bytes (power of two).
+ */
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator
+{
+  public:
+
+    static_assert((Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two.");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+    /**
+     * Default constructor using the default resource.
+     */
+    aligned_allocator() noexcept : _resource(std::pmr::get_default_resource()) { }
+
+    aligned_allocator(std::pmr::memory_resource* resource) noexcept : _resource(resource) { }
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>& that) noexcept : _resource(that.resource()) { }
+
+    std::pmr::memory_resource* resource() const noexcept { return _resource; }
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        return static_cast<T*>(_resource->allocate(n * sizeof(T), alignment));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        _resource->deallocate(p, n * sizeof(T), alignment);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        std::uninitialized_construct_using_allocator(p, *this, std::forward<Args>(args)...);
+    }
+
+    /**
+     * The copied container uses the default resource, as with `std::pmr`.
+     */
+    aligned_allocator select_on_container_copy_construction() const noexcept { return {}; }
+
+    template <typename U>
+    bool operator ==(const aligned_allocator<U, Alignment>& that) const noexcept {
+        return _resource == that.resource() || _resource->is_equal(*that.resource());
+    }
+
+  private:
+
+    static constexpr std::size_t alignment = std::max(Alignment, alignof(T));
+
+    std::pmr::memory_resource* _resource;
+};
+
+} // namespace pmr
+
+namespace detail {
+
+/**
+ * The vector of `T` using the allocator rebound from `Allocator`.
+ */
+template <typename T, typename Allocator>
+using rebind_vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+} // namespace detail
+
+} // namespace
+
+#endif // guard
@@ -0,0 +1,522 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef PACKING_HEADER_GUARD
+#define PACKING_HEADER_GUARD
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // Number, cmath
+#include <gof/math/simd.hpp> // GOF_MATH_HAS_SSE
+#include <gof/math/scalar/Fixed.hpp>
+#include <gof/math/scalar/Half.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * The compact encodings of the vectors for the network snapshots and the GPU
+ * upload buffers.
+ *
+ *  - `Vector<N, Half>`, `Vector<N, BFloat16>` and `Vector<N, Fixed<F, S>>`
+ *    halve (or quarter) the size of the `float` components, see `convert()`;
+ *  - the octahedral encoding stores the unit normal in 32 bits (two 16-bit
+ *    signed normalized coordinates of the unfolded octahedron);
+ *  - the 10:10:10:2 encoding stores the 4-vector in 32 bits, with the unsigned
+ *    (`[0, 1]`) or signed (`[-1, 1]`) normalized components.
+ *
+ * Every encoding has the single-vector `constexpr` function and the bulk
+ * kernel over the spans, vectorized with SSE2. The conversion between `float`
+ * and `Half` uses the F16C instructions when the target has them (`-mf16c`,
+ * `/arch:AVX2`).
+ */
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define GOF_MATH_HAS_F16C 1
+#else
+#define GOF_MATH_HAS_F16C 0
+#endif
+
+namespace gof {
+
+namespace detail {
+
+/**
+ * Clamp `x` to `[lo, hi]`, NaN gives `lo` like the SSE kernels (and does not
+ * reach the undefined conversion to the integer).
+ */
+constexpr float clamp(float x, float lo, float hi) noexcept {
+    return x >= lo ? (x > hi ? hi : x) : lo;
+}
+
+/**
+ * Round half away from zero, `std::lround()` is not `constexpr`.
+ */
+constexpr std::int32_t round_to_int(float x) noexcept {
+    return static_cast<std::int32_t>(x + (x < 0.0f ? -0.5f : 0.5f));
+}
+
+/**
+ * The signed normalized integer of `bits` bits (sign-extended) to `[-1, 1]`.
+ */
+constexpr float snorm_to_float(std::int32_t value, int bits) noexcept {
+    const float v = static_cast<float>(value) / static_cast<float>((1 << (bits - 1)) - 1);
+    return v < -1.0f ? -1.0f : v;
+}
+
+#if GOF_MATH_HAS_SSE
+
+/*----------------------------------------------------------------------------*/
+/*                                  KERNELS                                   */
+/*----------------------------------------------------------------------------*/
+
+// The kernels encode four values at a time with exactly the same operations as
+// the scalar functions, so the bulk results are bit-identical to them.
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) noexcept {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128i select(__m128i mask, __m128i a, __m128i b) noexcept {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128 absolute(__m128 x) noexcept {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+}
+
+/**
+ * The `round_to_int(clamp(x, lo, 1) * scale)` of the four lanes.
+ */
+inline __m128i quantize(__m128 x, float lo, float scale) noexcept {
+    const __m128 c = _mm_mul_ps(_mm_min_ps(_mm_max_ps(x, _mm_set1_ps(lo)), _mm_set1_ps(1.0f)), _mm_set1_ps(scale));
+    const __m128 half = select(_mm_cmplt_ps(c, _mm_setzero_ps()), _mm_set1_ps(-0.5f), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(_mm_add_ps(c, half));
+}
+
+/**
+ * The `snorm_to_float()` of the four sign-extended lanes.
+ */
+inline __m128 dequantize(__m128i value, float scale) noexcept {
+    return _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(scale)), _mm_set1_ps(-1.0f));
+}
+
+/**
+ * Round the four lanes to binary16, the results in the low 64 bits.
+ */
+inline __m128i float_to_half(__m128 f) noexcept {
+#if GOF_MATH_HAS_F16C
+    return _mm_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+    const __m128i x = _mm_castps_si128(f);
+    const __m128i sign = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x8000));
+    const __m128i abs = _mm_and_si128(x, _mm_set1_epi32(0x7fffffff));
+    const __m128i odd = _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(1));
+    const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(abs, _mm_set1_epi32(int(0xc8000fffu))), odd), 13);
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(abs), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+    const __m128i nan = _mm_and_si128(_mm_cmpgt_epi32(abs, _mm_set1_epi32(0x7f800000)),
+                                      _mm_or_si128(_mm_set1_epi32(0x0200), _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(0x03ff))));
+    const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), nan);
+
+    __m128i h = select(_mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000)), subnormal, normal);
+    h = select(_mm_cmpgt_epi32(abs, _mm_set1_epi32(0x477fefff)), special, h);
+    h = _mm_or_si128(h, sign);
+    // Sign-extend the 16-bit values, so the saturating pack keeps them.
+    h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+    return _mm_packs_epi32(h, h);
+#endif
+}
+
+/**
+ * Widen the four binary16 in the low 64 bits to `float`.
+ */
+inline __m128 half_to_float(__m128i h) noexcept {
+#if GOF_MATH_HAS_F16C
+    return _mm_cvtph_ps(h);
+#else
+    const __m128i x = _mm_unpacklo_epi16(h, _mm_setzero_si128());
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(x, _mm_set1_epi32(0x8000)), 16);
+    const __m128i shifted = _mm_slli_epi32(_mm_and_si128(x, _mm_set1_epi32(0x7fff)), 13);
+    // The multiplication by `2^112` rebiases the exponent and normalizes the
+    // subnormal numbers, the infinities and NaNs get the full exponent.
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(shifted), _mm_set1_ps(0x1p112f));
+    const __m128i special = _mm_or_si128(
+        _mm_and_si128(_mm_cmpgt_epi32(shifted, _mm_set1_epi32(0x0f7fffff)), _mm_set1_epi32(0x7f800000)),
+        _mm_and_si128(_mm_cmpgt_epi32(shifted, _mm_set1_epi32(0x0f800000)), _mm_set1_epi32(0x00400000)));
+    return _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(_mm_castps_si128(scaled), special), sign));
+#endif
+}
+
+/**
+ * Load the four vectors as the lanes of their components.
+ */
+template <std::size_t N>
+inline void load_lanes(const Vector<N, float>* v, __m128 (&lanes)[N]) noexcept {
+    if constexpr(sizeof(Vector<N, float>) == 4 * sizeof(float)) {
+        __m128 rows[4] = {_mm_loadu_ps(v[0].data()), _mm_loadu_ps(v[1].data()), _mm_loadu_ps(v[2].data()), _mm_loadu_ps(v[3].data())};
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+        for (std::size_t k = 0; k < N; ++k) {
+            lanes[k] = rows[k];
+        }
+    } else {
+        alignas(16) float soa[N][4];
+        for (std::size_t j = 0; j < 4; ++j) {
+            for (std::size_t k = 0; k < N; ++k) {
+                soa[k][j] = v[j].data()[k];
+            }
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+            lanes[k] = _mm_load_ps(soa[k]);
+        }
+    }
+}
+
+/**
+ * Store the lanes of the components as the four vectors.
+ */
+template <std::size_t N>
+inline void store_lanes(const __m128 (&lanes)[N], Vector<N, float>* v) noexcept {
+    if constexpr(sizeof(Vector<N, float>) == 4 * sizeof(float)) {
+        // The padding lane of `Vector3f` is stored as zero.
+        __m128 rows[4] = {};
+        for (std::size_t k = 0; k < N; ++k) {
+            rows[k] = lanes[k];
+        }
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+        for (std::size_t j = 0; j < 4; ++j) {
+            _mm_storeu_ps(v[j].data(), rows[j]);
+        }
+    } else {
+        alignas(16) float soa[N][4];
+        for (std::size_t k = 0; k < N; ++k) {
+            _mm_store_ps(soa[k], lanes[k]);
+        }
+        for (std::size_t j = 0; j < 4; ++j) {
+            for (std::size_t k = 0; k < N; ++k) {
+                v[j].data()[k] = soa[k][j];
+            }
+        }
+    }
+}
+
+inline __m128i encode_octahedral(__m128 x, __m128 y, __m128 z) noexcept {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 l1 = _mm_add_ps(_mm_add_ps(absolute(x), absolute(y)), absolute(z));
+    const __m128 inv = _mm_div_ps(one, _mm_max_ps(l1, _mm_set1_ps(std::numeric_limits<float>::min())));
+    const __m128 px = _mm_mul_ps(x, inv);
+    const __m128 py = _mm_mul_ps(y, inv);
+    const __m128 sx = select(_mm_cmpge_ps(px, zero), one, _mm_set1_ps(-1.0f));
+    const __m128 sy = select(_mm_cmpge_ps(py, zero), one, _mm_set1_ps(-1.0f));
+    const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, absolute(py)), sx);
+    const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, absolute(px)), sy);
+    const __m128 lower = _mm_cmplt_ps(z, zero);
+    const __m128i qu = quantize(select(lower, fx, px), -1.0f, 32767.0f);
+    const __m128i qv = quantize(select(lower, fy, py), -1.0f, 32767.0f);
+    return _mm_or_si128(_mm_and_si128(qu, _mm_set1_epi32(0xffff)), _mm_slli_epi32(qv, 16));
+}
+
+inline void decode_octahedral(__m128i bits, __m128 (&lanes)[3]) noexcept {
+    const __m128 zero = _mm_setzero_ps();
+    __m128 u = dequantize(_mm_srai_epi32(_mm_slli_epi32(bits, 16), 16), 32767.0f);
+    __m128 v = dequantize(_mm_srai_epi32(bits, 16), 32767.0f);
+    const __m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), absolute(u)), absolute(v));
+    const __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+    u = _mm_add_ps(u, select(_mm_cmpge_ps(u, zero), _mm_sub_ps(zero, t), t));
+    v = _mm_add_ps(v, select(_mm_cmpge_ps(v, zero), _mm_sub_ps(zero, t), t));
+    const __m128 squares = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z));
+    const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(squares));
+    lanes[0] = _mm_mul_ps(u, inv);
+    lanes[1] = _mm_mul_ps(v, inv);
+    lanes[2] = _mm_mul_ps(z, inv);
+}
+
+inline __m128i pack_1010102(const __m128 (&lanes)[4], float lo, float scale, float w_scale) noexcept {
+    const __m128i mask = _mm_set1_epi32(0x3ff);
+    const __m128i x = _mm_and_si128(quantize(lanes[0], lo, scale), mask);
+    const __m128i y = _mm_and_si128(quantize(lanes[1], lo, scale), mask);
+    const __m128i z = _mm_and_si128(quantize(lanes[2], lo, scale), mask);
+    const __m128i w = quantize(lanes[3], lo, w_scale);
+    return _mm_or_si128(_mm_or_si128(x, _mm_slli_epi32(y, 10)), _mm_or_si128(_mm_slli_epi32(z, 20), _mm_slli_epi32(w, 30)));
+}
+
+#endif // GOF_MATH_HAS_SSE
+
+} // namespace detail
+
+/*----------------------------------------------------------------------------*/
+/*                                  SCALARS                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Convert the components between `float` and the storage scalars, e.g.
+ * `Vector3f` to `Vector<3, Half>` and back.
+ *
+ * @param in The source vectors.
+ * @param out The destination of the same size.
+ */
+template <std::size_t N, Number From, Number To>
+void convert(std::span<const Vector<N, From>> in, std::span<Vector<N, To>> out) noexcept {
+    assert(in.size() == out.size());
+    if (in.empty()) {
+        return;
+    }
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<From, float> && std::is_same_v<To, Half>) {
+        auto* dst = reinterpret_cast<unsigned char*>(out.data());
+        if constexpr(sizeof(Vector<N, float>) == N * sizeof(float)) {
+            // The components are contiguous, four at a time.
+            const float* src = in.data()->data();
+            const std::size_t count = N * in.size();
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 2 * i), detail::float_to_half(_mm_loadu_ps(src + i)));
+            }
+            for (; i < count; ++i) {
+                const std::uint16_t h = detail::float_to_half(src[i]);
+                std::memcpy(dst + 2 * i, &h, sizeof(h));
+            }
+        } else {
+            // The padded vectors, one per register.
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                alignas(16) std::uint16_t h[8];
+                _mm_store_si128(reinterpret_cast<__m128i*>(h), detail::float_to_half(_mm_load_ps(in[i].data())));
+                std::memcpy(dst + i * sizeof(Vector<N, Half>), h, sizeof(Vector<N, Half>));
+            }
+        }
+        return;
+    } else if constexpr(std::is_same_v<From, Half> && std::is_same_v<To, float>) {
+        const auto* src = reinterpret_cast<const unsigned char*>(in.data());
+        if constexpr(sizeof(Vector<N, float>) == N * sizeof(float)) {
+            float* dst = out.data()->data();
+            const std::size_t count = N * in.size();
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                _mm_storeu_ps(dst + i, detail::half_to_float(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 2 * i))));
+            }
+            for (; i < count; ++i) {
+                std::uint16_t h;
+                std::memcpy(&h, src + 2 * i, sizeof(h));
+                dst[i] = detail::half_to_float(h);
+            }
+        } else {
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                alignas(16) std::uint16_t h[8] = {};
+                std::memcpy(h, src + i * sizeof(Vector<N, Half>), sizeof(Vector<N, Half>));
+                _mm_store_ps(out[i].data(), detail::half_to_float(_mm_load_si128(reinterpret_cast<const __m128i*>(h))));
+            }
+        }
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const From* src = in[i].data();
+        To* dst = out[i].data();
+        for (std::size_t k = 0; k < N; ++k) {
+            dst[k] = static_cast<To>(src[k]);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 OCTAHEDRAL                                 */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Encode the unit vector as two 16-bit signed normalized coordinates on the
+ * unfolded octahedron, `x` in the low and `y` in the high half.
+ *
+ * The angular error is below `0.0001` radians. The zero vector is encoded as
+ * `+z`.
+ */
+constexpr std::uint32_t encode_octahedral(const Vector<3, float>& n) noexcept {
+    // The zero vector divides by the smallest normal number instead of zero.
+    const float l1 = detail::absolute(n.x()) + detail::absolute(n.y()) + detail::absolute(n.z());
+    const float inv = 1.0f / (l1 > std::numeric_limits<float>::min() ? l1 : std::numeric_limits<float>::min());
+    const float x = n.x() * inv;
+    const float y = n.y() * inv;
+    // Fold the lower hemisphere over the diagonals.
+    const float fx = (1.0f - detail::absolute(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    const float fy = (1.0f - detail::absolute(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    const float u = n.z() < 0.0f ? fx : x;
+    const float v = n.z() < 0.0f ? fy : y;
+    const auto qu = static_cast<std::uint16_t>(detail::round_to_int(detail::clamp(u, -1.0f, 1.0f) * 32767.0f));
+    const auto qv = static_cast<std::uint16_t>(detail::round_to_int(detail::clamp(v, -1.0f, 1.0f) * 32767.0f));
+    return static_cast<std::uint32_t>(qu) | (static_cast<std::uint32_t>(qv) << 16);
+}
+
+/**
+ * Decode the unit vector encoded by `encode_octahedral()`.
+ */
+constexpr Vector<3, float> decode_octahedral(std::uint32_t bits) noexcept {
+    float u = detail::snorm_to_float(static_cast<std::int16_t>(bits & 0xffffu), 16);
+    float v = detail::snorm_to_float(static_cast<std::int16_t>(bits >> 16), 16);
+    const float z = 1.0f - detail::absolute(u) - detail::absolute(v);
+    const float t = z < 0.0f ? -z : 0.0f;
+    u += u >= 0.0f ? -t : t;
+    v += v >= 0.0f ? -t : t;
+    const float inv = 1.0f / cmath::sqrt(u * u + v * v + z * z);
+    return {u * inv, v * inv, z * inv};
+}
+
+inline void encode_octahedral(std::span<const Vector<3, float>> in, std::span<std::uint32_t> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        __m128 lanes[3];
+        detail::load_lanes<3>(in.data() + i, lanes);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), detail::encode_octahedral(lanes[0], lanes[1], lanes[2]));
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = encode_octahedral(in[i]);
+    }
+}
+
+inline void decode_octahedral(std::span<const std::uint32_t> in, std::span<Vector<3, float>> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        __m128 lanes[3];
+        detail::decode_octahedral(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i)), lanes);
+        detail::store_lanes<3>(lanes, out.data() + i);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = decode_octahedral(in[i]);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 10:10:10:2                                 */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Pack the components clamped to `[0, 1]`, `x` in the lowest bits and `w`
+ * in the two highest (the `GL_UNSIGNED_INT_2_10_10_10_REV` layout).
+ */
+constexpr std::uint32_t pack_unorm_1010102(const Vector<4, float>& v) noexcept {
+    const auto x = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.x(), 0.0f, 1.0f) * 1023.0f));
+    const auto y = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.y(), 0.0f, 1.0f) * 1023.0f));
+    const auto z = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.z(), 0.0f, 1.0f) * 1023.0f));
+    const auto w = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.w(), 0.0f, 1.0f) * 3.0f));
+    return x | (y << 10) | (z << 20) | (w << 30);
+}
+
+constexpr Vector<4, float> unpack_unorm_1010102(std::uint32_t bits) noexcept {
+    return {
+        static_cast<float>(bits & 0x3ffu) / 1023.0f,
+        static_cast<float>((bits >> 10) & 0x3ffu) / 1023.0f,
+        static_cast<float>((bits >> 20) & 0x3ffu) / 1023.0f,
+        static_cast<float>(bits >> 30) / 3.0f,
+    };
+}
+
+/**
+ * Pack the components clamped to `[-1, 1]` as the two's complement
+ * integers (the `GL_INT_2_10_10_10_REV` layout), so `w` is one of `-1, 0, 1`.
+ */
+constexpr std::uint32_t pack_snorm_1010102(const Vector<4, float>& v) noexcept {
+    const auto x = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.x(), -1.0f, 1.0f) * 511.0f)) & 0x3ffu;
+    const auto y = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.y(), -1.0f, 1.0f) * 511.0f)) & 0x3ffu;
+    const auto z = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.z(), -1.0f, 1.0f) * 511.0f)) & 0x3ffu;
+    const auto w = static_cast<std::uint32_t>(detail::round_to_int(detail::clamp(v.w(), -1.0f, 1.0f))) & 0x3u;
+    return x | (y << 10) | (z << 20) | (w << 30);
+}
+
+constexpr Vector<4, float> unpack_snorm_1010102(std::uint32_t bits) noexcept {
+    // Sign-extend by the arithmetic shift of the field moved to the top.
+    const auto x = static_cast<std::int32_t>(bits << 22) >> 22;
+    const auto y = static_cast<std::int32_t>(bits << 12) >> 22;
+    const auto z = static_cast<std::int32_t>(bits << 2) >> 22;
+    const auto w = static_cast<std::int32_t>(bits) >> 30;
+    return {
+        detail::snorm_to_float(x, 10),
+        detail::snorm_to_float(y, 10),
+        detail::snorm_to_float(z, 10),
+        detail::snorm_to_float(w, 2),
+    };
+}
+
+inline void pack_unorm_1010102(std::span<const Vector<4, float>> in, std::span<std::uint32_t> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        __m128 lanes[4];
+        detail::load_lanes<4>(in.data() + i, lanes);
+        const __m128i bits = detail::pack_1010102(lanes, 0.0f, 1023.0f, 3.0f);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), bits);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = pack_unorm_1010102(in[i]);
+    }
+}
+
+inline void unpack_unorm_1010102(std::span<const std::uint32_t> in, std::span<Vector<4, float>> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+        const __m128i mask = _mm_set1_epi32(0x3ff);
+        const __m128 lanes[4] = {
+            _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(bits, mask)), _mm_set1_ps(1023.0f)),
+            _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(bits, 10), mask)), _mm_set1_ps(1023.0f)),
+            _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(bits, 20), mask)), _mm_set1_ps(1023.0f)),
+            _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 30)), _mm_set1_ps(3.0f)),
+        };
+        detail::store_lanes<4>(lanes, out.data() + i);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = unpack_unorm_1010102(in[i]);
+    }
+}
+
+inline void pack_snorm_1010102(std::span<const Vector<4, float>> in, std::span<std::uint32_t> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        __m128 lanes[4];
+        detail::load_lanes<4>(in.data() + i, lanes);
+        const __m128i bits = detail::pack_1010102(lanes, -1.0f, 511.0f, 1.0f);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), bits);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = pack_snorm_1010102(in[i]);
+    }
+}
+
+inline void unpack_snorm_1010102(std::span<const std::uint32_t> in, std::span<Vector<4, float>> out) noexcept {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    for (; i + 4 <= in.size(); i += 4) {
+        const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+        const __m128 lanes[4] = {
+            detail::dequantize(_mm_srai_epi32(_mm_slli_epi32(bits, 22), 22), 511.0f),
+            detail::dequantize(_mm_srai_epi32(_mm_slli_epi32(bits, 12), 22), 511.0f),
+            detail::dequantize(_mm_srai_epi32(_mm_slli_epi32(bits, 2), 22), 511.0f),
+            detail::dequantize(_mm_srai_epi32(bits, 30), 1.0f),
+        };
+        detail::store_lanes<4>(lanes, out.data() + i);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = unpack_snorm_1010102(in[i]);
+    }
+}
+
+} // namespace
+
+#endif // guard
@@ -0,0 +1,362 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef QUATERNION_HEADER_GUARD
+#define QUATERNION_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <gof/math/common.hpp> // multiply_add, difference_of_products
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/transform.hpp>
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+/*
+ * Rotations in 3D Euclidean space.
+ *
+ * The unit quaternion `q = (w, x, y, z)` represents the rotation by the angle
+ * `2 acos(w)` around the axis `(x, y, z)`. Rotating a vector by a quaternion
+ * is cheaper than building the rotation matrix for a single vector; to rotate
+ * many vectors by the same quaternion use the batched `rotate()` which builds
+ * the matrix once and runs the SIMD transform kernels.
+ */
+
+namespace gof {
+
+/**
+ * The quaternion template class.
+ *
+ * The components are stored in the order `x, y, z, w`, so the vector part
+ * lies in the same lanes as the components of `Vector<3, T>`.
+ *
+ * @tparam T The scalar type.
+ */
+template <std::floating_point T>
+class Quaternion
+{
+  public:
+
+    /**
+     * Default constructor creating the zero quaternion (see `identity()` for
+     * the rotation doing nothing).
+     */
+    constexpr Quaternion() noexcept : _q{} { }
+
+    /**
+     * Constructor: The scalar part first, then the vector part.
+     */
+    constexpr Quaternion(T w, T x, T y, T z) noexcept : _q{x, y, z, w} { }
+
+    /**
+     * Constructor: The scalar and the vector part.
+     */
+    constexpr Quaternion(T w, const Vector<3, T>& v) noexcept : _q{v.x(), v.y(), v.z(), w} { }
+
+    // GETTERS
+
+    constexpr T w() const noexcept { return _q[3]; }
+    constexpr T x() const noexcept { return _q[0]; }
+    constexpr T y() const noexcept { return _q[1]; }
+    constexpr T z() const noexcept { return _q[2]; }
+
+    /**
+     * Get the vector part `(x, y, z)`.
+     */
+    constexpr Vector<3, T> vector() const noexcept { return {_q[0], _q[1], _q[2]}; }
+
+    /**
+     * Get the view of the components in the order `x, y, z, w`.
+     */
+    constexpr std::span<const T, 4> values() const noexcept { return _q; }
+
+    // NORM
+
+    constexpr T norm_squared() const noexcept {
+        T r = _q[0] * _q[0];
+        r = multiply_add(_q[1], _q[1], r);
+        r = multiply_add(_q[2], _q[2], r);
+        return multiply_add(_q[3], _q[3], r);
+    }
+
+    constexpr T norm() const noexcept { return cmath::sqrt(norm_squared()); }
+
+    /**
+     * Return the quaternion scaled to the unit norm.
+     */
+    constexpr Quaternion normalized() const noexcept {
+        const T n = norm();
+        assert(n > T{0});
+        const T s = T{1} / n;
+        return {s * _q[3], s * _q[0], s * _q[1], s * _q[2]};
+    }
+
+    constexpr Quaternion conjugate() const noexcept { return {_q[3], -_q[0], -_q[1], -_q[2]}; }
+
+    /**
+     * Return the multiplicative inverse, for the unit quaternions this is the
+     * same as `conjugate()`.
+     */
+    constexpr Quaternion inverse() const noexcept {
+        const T n = norm_squared();
+        assert(n > T{0});
+        const T s = T{1} / n;
+        return {s * _q[3], -s * _q[0], -s * _q[1], -s * _q[2]};
+    }
+
+    // ROTATION
+
+    /**
+     * Rotate the vector by this unit quaternion.
+     *
+     * Uses `v' = v + w t + u x t` where `t = 2 u x v` and `u` is the vector
+     * part, which is cheaper than `q v q*` or building the matrix. The
+     * cross products are symmetric (see `difference_of_products()`), so the
+     * vectors parallel to the axis are returned unchanged.
+     */
+    constexpr Vector<3, T> rotate(const Vector<3, T>& v) const noexcept {
+        const T x = _q[0], y = _q[1], z = _q[2], w = _q[3];
+        const T tx = T{2} * difference_of_products(y, v.z(), z, v.y());
+        const T ty = T{2} * difference_of_products(z, v.x(), x, v.z());
+        const T tz = T{2} * difference_of_products(x, v.y(), y, v.x());
+        return {
+            multiply_add(w, tx, v.x()) + difference_of_products(y, tz, z, ty),
+            multiply_add(w, ty, v.y()) + difference_of_products(z, tx, x, tz),
+            multiply_add(w, tz, v.z()) + difference_of_products(x, ty, y, tx),
+        };
+    }
+
+    /**
+     * Get the axis of the rotation, the unit x axis for the identity.
+     */
+    constexpr Vector<3, T> axis() const noexcept {
+        const T s = cmath::sqrt(std::max(T{0}, T{1} - _q[3] * _q[3]));
+        if (s <= T{0}) {
+            return Vector<3, T>::unit_x();
+        }
+        return (T{1} / s) * vector();
+    }
+
+    /**
+     * Get the angle of the rotation in radians within `[0, 2 pi]`.
+     */
+    constexpr T angle() const noexcept {
+        return T{2} * cmath::acos(std::clamp(_q[3], T{-1}, T{1}));
+    }
+
+    /**
+     * Get the rotation matrix of this unit quaternion.
+     */
+    template <Layout L = Layout::row_major>
+    constexpr Matrix<3, 3, T, L> to_matrix3() const noexcept {
+        const T x = _q[0], y = _q[1], z = _q[2], w = _q[3];
+        const T xx = x * x, yy = y * y, zz = z * z;
+        const T xy = x * y, xz = x * z, yz = y * z;
+        const T wx = w * x, wy = w * y, wz = w * z;
+        return {
+            T{1} - T{2} * (yy + zz), T{2} * (xy - wz), T{2} * (xz + wy),
+            T{2} * (xy + wz), T{1} - T{2} * (xx + zz), T{2} * (yz - wx),
+            T{2} * (xz - wy), T{2} * (yz + wx), T{1} - T{2} * (xx + yy),
+        };
+    }
+
+    /**
+     * Get the homogeneous rotation matrix of this unit quaternion.
+     */
+    template <Layout L = Layout::row_major>
+    constexpr Matrix<4, 4, T, L> to_matrix4() const noexcept {
+        const auto m = to_matrix3();
+        return {
+            m(0, 0), m(0, 1), m(0, 2), T{0},
+            m(1, 0), m(1, 1), m(1, 2), T{0},
+            m(2, 0), m(2, 1), m(2, 2), T{0},
+            T{0}, T{0}, T{0}, T{1},
+        };
+    }
+
+    // FACTORIES
+
+    /**
+     * Return the quaternion of the rotation doing nothing.
+     */
+    constexpr static auto identity() -> Quaternion<T> {
+        return {T{1}, T{0}, T{0}, T{0}};
+    }
+
+    /**
+     * Return the rotation by `angle` (in radians, counter-clockwise) around
+     * the unit `axis`.
+     */
+    constexpr static auto from_axis_angle(const Vector<3, T>& axis, T angle) -> Quaternion<T> {
+        const T half = angle / T{2};
+        return {cmath::cos(half), cmath::sin(half) * axis};
+    }
+
+    /**
+     * Return the rotation of the rotation matrix (the upper-left 3x3 block
+     * of the larger matrices).
+     */
+    template <std::size_t N, Layout L>
+        requires (N == 3 || N == 4)
+    constexpr static auto from_matrix(const Matrix<N, N, T, L>& m) -> Quaternion<T> {
+        // Shepperd's method: divide by the largest of the four candidates,
+        // so the result stays accurate for all rotations.
+        const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+        if (trace > T{0}) {
+            const T s = T{2} * cmath::sqrt(trace + T{1});
+            return {s / T{4}, (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s};
+        }
+        if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+            const T s = T{2} * cmath::sqrt(T{1} + m(0, 0) - m(1, 1) - m(2, 2));
+            return {(m(2, 1) - m(1, 2)) / s, s / T{4}, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s};
+        }
+        if (m(1, 1) > m(2, 2)) {
+            const T s = T{2} * cmath::sqrt(T{1} + m(1, 1) - m(0, 0) - m(2, 2));
+            return {(m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, s / T{4}, (m(1, 2) + m(2, 1)) / s};
+        }
+        const T s = T{2} * cmath::sqrt(T{1} + m(2, 2) - m(0, 0) - m(1, 1));
+        return {(m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, s / T{4}};
+    }
+
+    /**
+     * The quaternions are equal when all their components are equal (`q` and
+     * `-q` represent the same rotation but they are not equal).
+     */
+    friend constexpr bool operator ==(const Quaternion& self, const Quaternion& that) noexcept = default;
+
+  private:
+
+    std::array<T, 4> _q;
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 OPERATORS                                  */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The Hamilton product, the rotation `lhs * rhs` applies `rhs` first.
+ */
+template <std::floating_point T>
+constexpr Quaternion<T> operator *(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept {
+    const T aw = lhs.w(), ax = lhs.x(), ay = lhs.y(), az = lhs.z();
+    const T bw = rhs.w(), bx = rhs.x(), by = rhs.y(), bz = rhs.z();
+    return {
+        multiply_add(aw, bw, -multiply_add(ax, bx, multiply_add(ay, by, az * bz))),
+        multiply_add(aw, bx, multiply_add(ax, bw, multiply_add(ay, bz, -(az * by)))),
+        multiply_add(aw, by, multiply_add(-ax, bz, multiply_add(ay, bw, az * bx))),
+        multiply_add(aw, bz, multiply_add(ax, by, multiply_add(-ay, bx, az * bw))),
+    };
+}
+
+template <std::floating_point T>
+constexpr Quaternion<T> operator *(T const& scalar, const Quaternion<T>& self) noexcept {
+    return {scalar * self.w(), scalar * self.x(), scalar * self.y(), scalar * self.z()};
+}
+
+template <std::floating_point T>
+constexpr Quaternion<T> operator +(const Quaternion<T>& self, const Quaternion<T>& that) noexcept {
+    return {self.w() + that.w(), self.x() + that.x(), self.y() + that.y(), self.z() + that.z()};
+}
+
+template <std::floating_point T>
+constexpr Quaternion<T> operator -(const Quaternion<T>& self, const Quaternion<T>& that) noexcept {
+    return {self.w() - that.w(), self.x() - that.x(), self.y() - that.y(), self.z() - that.z()};
+}
+
+template <std::floating_point T>
+constexpr Quaternion<T> operator -(const Quaternion<T>& self) noexcept {
+    return {-self.w(), -self.x(), -self.y(), -self.z()};
+}
+
+/**
+ * The four-dimensional scalar product, `cos` of half the angle between the
+ * unit quaternions.
+ */
+template <std::floating_point T>
+constexpr T scalar_product(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept {
+    T r = lhs.x() * rhs.x();
+    r = multiply_add(lhs.y(), rhs.y(), r);
+    r = multiply_add(lhs.z(), rhs.z(), r);
+    return multiply_add(lhs.w(), rhs.w(), r);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                               INTERPOLATION                                */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The normalized linear interpolation between the unit quaternions along the
+ * shorter arc. It is cheaper than `slerp()` but the angular velocity is not
+ * constant.
+ */
+template <std::floating_point T>
+constexpr Quaternion<T> nlerp(const Quaternion<T>& a, const Quaternion<T>& b, T t) noexcept {
+    const Quaternion<T> c = scalar_product(a, b) < T{0} ? -b : b;
+    return (a + t * (c - a)).normalized();
+}
+
+/**
+ * The spherical linear interpolation between the unit quaternions along the
+ * shorter arc with the constant angular velocity.
+ */
+template <std::floating_point T>
+constexpr Quaternion<T> slerp(const Quaternion<T>& a, const Quaternion<T>& b, T t) noexcept {
+    T d = scalar_product(a, b);
+    const Quaternion<T> c = d < T{0} ? -b : b;
+    d = d < T{0} ? -d : d;
+    // For the nearly equal rotations `sin(theta)` vanishes, there the linear
+    // interpolation is accurate enough.
+    if (d > T{1} - T{16} * std::numeric_limits<T>::epsilon()) {
+        return nlerp(a, c, t);
+    }
+    const T theta = cmath::acos(d);
+    const T s = T{1} / cmath::sin(theta);
+    return (s * cmath::sin((T{1} - t) * theta)) * a + (s * cmath::sin(t * theta)) * c;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 ROTATION                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Rotate the vector by `angle` (in radians, counter-clockwise) around the unit
+ * `axis`.
+ */
+template <std::floating_point T>
+constexpr Vector<3, T> rotate(const Vector<3, T>& v, const Vector<3, T>& axis, T angle) noexcept {
+    return Quaternion<T>::from_axis_angle(axis, angle).rotate(v);
+}
+
+/**
+ * Rotate the vectors `out[i] = q.rotate(in[i])` by the unit quaternion.
+ *
+ * The rotation matrix is built once and the vectors are transformed by the
+ * SIMD kernels of `transform_directions()`. The output may be the input.
+ */
+template <std::floating_point T>
+void rotate(const Quaternion<T>& q, std::span<const Vector<3, T>> in, std::span<Vector<3, T>> out) noexcept {
+    transform_directions(q.to_matrix4(), in, out);
+}
+
+/**
+ * Rotate the vectors stored in lanes, see `rotate()` above.
+ */
+template <std::floating_point T, typename A>
+void rotate(const Quaternion<T>& q, const VectorArray<3, T, A>& in, VectorArray<3, T, A>& out) noexcept {
+    transform_directions(q.to_matrix4(), in, out);
+}
+
+} // namespace
+
+#endif // guard
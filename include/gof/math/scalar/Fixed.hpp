@@ -0,0 +1,156 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef FIXED_HEADER_GUARD
+#define FIXED_HEADER_GUARD
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // is_custom_number, cmath
+
+/*
+ * The fixed-point scalars.
+ *
+ * `Fixed<F, S>` stores the value `x` as the integer `x * 2^F` of the type `S`,
+ * e.g. the quantised positions of the network snapshots
+ *
+ *     using Position = Vector<3, Fixed<8, std::int16_t>>; // 1/256 steps, +-128
+ */
+
+namespace gof {
+
+/**
+ * The signed fixed-point number with `Fraction` fractional bits.
+ *
+ * The addition and subtraction are exact and wrap around on overflow like
+ * the integers; the product is rounded to the nearest step and the quotient
+ * truncated, both computed in the twice as wide integer.
+ *
+ * @tparam Fraction The number of the fractional bits.
+ * @tparam Storage The signed integer of at most 32 bits.
+ */
+template <int Fraction, std::signed_integral Storage = std::int32_t>
+    requires (sizeof(Storage) <= 4 && Fraction >= 0 && Fraction < 8 * int(sizeof(Storage)))
+class Fixed
+{
+    using self = Fixed<Fraction, Storage>;
+    using wide = std::conditional_t<sizeof(Storage) <= 2, std::int32_t, std::int64_t>;
+
+    static constexpr double scale = double(std::uint64_t{1} << Fraction);
+
+  public:
+
+    using storage_type = Storage;
+
+    static constexpr int fraction_bits = Fraction;
+
+    constexpr Fixed() noexcept = default;
+
+    /**
+     * The nearest representable value, saturated to the range of `Storage`.
+     */
+    template <typename A>
+        requires std::is_arithmetic_v<A>
+    constexpr Fixed(A value) noexcept : _raw(from_double(static_cast<double>(value))) { }
+
+    /**
+     * The number with the given integer representation.
+     */
+    static constexpr self from_raw(Storage raw) noexcept {
+        self result;
+        result._raw = raw;
+        return result;
+    }
+
+    constexpr Storage raw() const noexcept { return _raw; }
+
+    explicit constexpr operator float() const noexcept { return static_cast<float>(_raw / scale); }
+
+    explicit constexpr operator double() const noexcept { return _raw / scale; }
+
+    friend constexpr self operator +(self a, self b) noexcept {
+        return from_raw(static_cast<Storage>(wide(a._raw) + b._raw));
+    }
+
+    friend constexpr self operator -(self a, self b) noexcept {
+        return from_raw(static_cast<Storage>(wide(a._raw) - b._raw));
+    }
+
+    friend constexpr self operator *(self a, self b) noexcept {
+        const wide product = wide(a._raw) * b._raw;
+        if constexpr(Fraction == 0) {
+            return from_raw(static_cast<Storage>(product));
+        } else {
+            return from_raw(static_cast<Storage>((product + (wide{1} << (Fraction - 1))) >> Fraction));
+        }
+    }
+
+    friend constexpr self operator /(self a, self b) noexcept {
+        return from_raw(static_cast<Storage>((wide(a._raw) << Fraction) / b._raw));
+    }
+
+    friend constexpr self operator -(self a) noexcept {
+        return from_raw(static_cast<Storage>(-wide(a._raw)));
+    }
+
+    friend constexpr bool operator ==(self a, self b) noexcept = default;
+    friend constexpr std::strong_ordering operator <=>(self a, self b) noexcept = default;
+
+  private:
+
+    static constexpr Storage from_double(double value) noexcept {
+        const double x = value * scale;
+        if (x != x) {
+            return Storage{0};
+        }
+        if (x <= double(std::numeric_limits<Storage>::min())) {
+            return std::numeric_limits<Storage>::min();
+        }
+        if (x >= double(std::numeric_limits<Storage>::max())) {
+            return std::numeric_limits<Storage>::max();
+        }
+        return static_cast<Storage>(static_cast<std::int64_t>(x + (x < 0.0 ? -0.5 : 0.5)));
+    }
+
+    Storage _raw = 0;
+};
+
+template <int F, typename S>
+constexpr Fixed<F, S> abs(Fixed<F, S> x) noexcept {
+    return x < Fixed<F, S>{} ? -x : x;
+}
+
+template <int F, typename S>
+constexpr Fixed<F, S> sqrt(Fixed<F, S> x) noexcept {
+    return Fixed<F, S>(cmath::sqrt(static_cast<double>(x)));
+}
+
+template <int F, typename S>
+struct is_custom_number<Fixed<F, S>> : std::true_type {};
+
+} // namespace
+
+template <int F, typename S>
+struct std::numeric_limits<gof::Fixed<F, S>>
+{
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr int radix = 2;
+    static constexpr int digits = std::numeric_limits<S>::digits;
+
+    static constexpr gof::Fixed<F, S> min() noexcept { return gof::Fixed<F, S>::from_raw(1); }
+    static constexpr gof::Fixed<F, S> max() noexcept { return gof::Fixed<F, S>::from_raw(std::numeric_limits<S>::max()); }
+    static constexpr gof::Fixed<F, S> lowest() noexcept { return gof::Fixed<F, S>::from_raw(std::numeric_limits<S>::min()); }
+    static constexpr gof::Fixed<F, S> epsilon() noexcept { return gof::Fixed<F, S>::from_raw(1); }
+};
+
+#endif // guard
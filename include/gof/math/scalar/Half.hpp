@@ -0,0 +1,262 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef HALF_HEADER_GUARD
+#define HALF_HEADER_GUARD
+
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // is_custom_number, cmath
+
+/*
+ * The 16-bit floating point scalars for the storage.
+ *
+ * `Half` is the IEEE 754 binary16 (the `_Float16` of the GPUs), `BFloat16`
+ * the upper half of `float` (the same range with 8 bits of precision). Both
+ * only store the value, the arithmetic is done in `float` and rounded back,
+ * so `Vector<3, Half>` takes 6 bytes in the network snapshots and the upload
+ * buffers. Convert the bulk data with `convert()` (see `packing.hpp`).
+ */
+
+namespace gof {
+
+namespace detail {
+
+/**
+ * Round the `float` to the nearest binary16 (ties to even).
+ *
+ * All cases are computed and selected without the branches, so the loops over
+ * the bulk data are vectorized.
+ */
+constexpr std::uint16_t float_to_half(float value) noexcept {
+    const std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = (x >> 16) & 0x8000u;
+    const std::uint32_t abs = x & 0x7fffffffu;
+
+    // Rebias the exponent from 127 to 15 and round on the 13 dropped bits,
+    // the carry of the rounding moves into the exponent.
+    const std::uint32_t normal = (abs + 0xc8000fffu + ((abs >> 13) & 1u)) >> 13;
+    // Below `2^-14` the addition of `0.5f` aligns the significand to the units
+    // of `2^-24`, rounded by the FPU.
+    const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(abs) + 0.5f) - 0x3f000000u;
+    // From 65520 up to infinity, or NaN kept quiet with the top bits of the payload.
+    const std::uint32_t special = abs > 0x7f800000u ? 0x7e00u | ((abs >> 13) & 0x03ffu) : 0x7c00u;
+
+    const std::uint32_t h = abs >= 0x477ff000u ? special : (abs < 0x38800000u ? subnormal : normal);
+    return static_cast<std::uint16_t>(sign | h);
+}
+
+/**
+ * Widen the binary16 to `float`, which is exact (the NaNs come back quiet like
+ * from the F16C instructions).
+ */
+constexpr float half_to_float(std::uint16_t bits) noexcept {
+    const std::uint32_t sign = static_cast<std::uint32_t>(bits & 0x8000u) << 16;
+    const std::uint32_t shifted = static_cast<std::uint32_t>(bits & 0x7fffu) << 13;
+    const std::uint32_t exponent = shifted & 0x0f800000u;
+
+    const std::uint32_t normal = shifted + 0x38000000u;
+    const std::uint32_t special = (shifted + 0x70000000u) | (shifted > 0x0f800000u ? 0x00400000u : 0u);
+    // The subnormal `m 2^-24` as `2^-14 (1 + m 2^-10) - 2^-14`.
+    const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(shifted + 0x38800000u) - 0x1p-14f);
+
+    const std::uint32_t f = exponent == 0x0f800000u ? special : (exponent == 0 ? subnormal : normal);
+    return std::bit_cast<float>(sign | f);
+}
+
+/**
+ * Round the `float` to the upper 16 bits (ties to even).
+ */
+constexpr std::uint16_t float_to_bfloat16(float value) noexcept {
+    const std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+        return static_cast<std::uint16_t>((x >> 16) | 0x0040u);
+    }
+    return static_cast<std::uint16_t>((x + 0x7fffu + ((x >> 16) & 1u)) >> 16);
+}
+
+constexpr float bfloat16_to_float(std::uint16_t bits) noexcept {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+}
+
+} // namespace detail
+
+/*----------------------------------------------------------------------------*/
+/*                                    HALF                                    */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The IEEE 754 half precision number.
+ *
+ * Constructed implicitly from any arithmetic value, converted back only
+ * explicitly with `static_cast<float>(h)`, so the mixed expressions such as
+ * `h * 2.0f` stay in `Half`.
+ */
+class Half
+{
+  public:
+
+    constexpr Half() noexcept = default;
+
+    template <typename A>
+        requires std::is_arithmetic_v<A>
+    constexpr Half(A value) noexcept : _bits(detail::float_to_half(static_cast<float>(value))) { }
+
+    /**
+     * The number with the given binary16 representation.
+     */
+    static constexpr Half from_bits(std::uint16_t bits) noexcept {
+        Half result;
+        result._bits = bits;
+        return result;
+    }
+
+    constexpr std::uint16_t bits() const noexcept { return _bits; }
+
+    explicit constexpr operator float() const noexcept { return detail::half_to_float(_bits); }
+
+    explicit constexpr operator double() const noexcept { return detail::half_to_float(_bits); }
+
+    friend constexpr Half operator +(Half a, Half b) noexcept { return Half(float(a) + float(b)); }
+    friend constexpr Half operator -(Half a, Half b) noexcept { return Half(float(a) - float(b)); }
+    friend constexpr Half operator *(Half a, Half b) noexcept { return Half(float(a) * float(b)); }
+    friend constexpr Half operator /(Half a, Half b) noexcept { return Half(float(a) / float(b)); }
+
+    friend constexpr Half operator -(Half a) noexcept { return from_bits(a._bits ^ 0x8000u); }
+
+    /**
+     * Compare the values, so `+0 == -0` and NaN is unordered.
+     */
+    friend constexpr bool operator ==(Half a, Half b) noexcept { return float(a) == float(b); }
+    friend constexpr std::partial_ordering operator <=>(Half a, Half b) noexcept { return float(a) <=> float(b); }
+
+  private:
+
+    std::uint16_t _bits = 0;
+};
+
+constexpr Half abs(Half x) noexcept { return Half::from_bits(x.bits() & 0x7fffu); }
+
+constexpr Half sqrt(Half x) noexcept { return Half(cmath::sqrt(static_cast<float>(x))); }
+
+template <>
+struct is_custom_number<Half> : std::true_type {};
+
+/*----------------------------------------------------------------------------*/
+/*                                  BFLOAT16                                  */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The brain floating point number: the range of `float` with the 8-bit
+ * significand.
+ */
+class BFloat16
+{
+  public:
+
+    constexpr BFloat16() noexcept = default;
+
+    template <typename A>
+        requires std::is_arithmetic_v<A>
+    constexpr BFloat16(A value) noexcept : _bits(detail::float_to_bfloat16(static_cast<float>(value))) { }
+
+    static constexpr BFloat16 from_bits(std::uint16_t bits) noexcept {
+        BFloat16 result;
+        result._bits = bits;
+        return result;
+    }
+
+    constexpr std::uint16_t bits() const noexcept { return _bits; }
+
+    explicit constexpr operator float() const noexcept { return detail::bfloat16_to_float(_bits); }
+
+    explicit constexpr operator double() const noexcept { return detail::bfloat16_to_float(_bits); }
+
+    friend constexpr BFloat16 operator +(BFloat16 a, BFloat16 b) noexcept { return BFloat16(float(a) + float(b)); }
+    friend constexpr BFloat16 operator -(BFloat16 a, BFloat16 b) noexcept { return BFloat16(float(a) - float(b)); }
+    friend constexpr BFloat16 operator *(BFloat16 a, BFloat16 b) noexcept { return BFloat16(float(a) * float(b)); }
+    friend constexpr BFloat16 operator /(BFloat16 a, BFloat16 b) noexcept { return BFloat16(float(a) / float(b)); }
+
+    friend constexpr BFloat16 operator -(BFloat16 a) noexcept { return from_bits(a._bits ^ 0x8000u); }
+
+    friend constexpr bool operator ==(BFloat16 a, BFloat16 b) noexcept { return float(a) == float(b); }
+    friend constexpr std::partial_ordering operator <=>(BFloat16 a, BFloat16 b) noexcept { return float(a) <=> float(b); }
+
+  private:
+
+    std::uint16_t _bits = 0;
+};
+
+constexpr BFloat16 abs(BFloat16 x) noexcept { return BFloat16::from_bits(x.bits() & 0x7fffu); }
+
+constexpr BFloat16 sqrt(BFloat16 x) noexcept { return BFloat16(cmath::sqrt(static_cast<float>(x))); }
+
+template <>
+struct is_custom_number<BFloat16> : std::true_type {};
+
+} // namespace
+
+/*----------------------------------------------------------------------------*/
+/*                                   LIMITS                                   */
+/*----------------------------------------------------------------------------*/
+
+template <>
+struct std::numeric_limits<gof::Half>
+{
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr bool is_iec559 = true;
+    static constexpr int digits = 11;
+    static constexpr int digits10 = 3;
+    static constexpr int max_digits10 = 5;
+    static constexpr int radix = 2;
+    static constexpr int min_exponent = -13;
+    static constexpr int max_exponent = 16;
+
+    static constexpr gof::Half min() noexcept { return gof::Half::from_bits(0x0400u); }
+    static constexpr gof::Half max() noexcept { return gof::Half::from_bits(0x7bffu); }
+    static constexpr gof::Half lowest() noexcept { return gof::Half::from_bits(0xfbffu); }
+    static constexpr gof::Half epsilon() noexcept { return gof::Half::from_bits(0x1400u); }
+    static constexpr gof::Half denorm_min() noexcept { return gof::Half::from_bits(0x0001u); }
+    static constexpr gof::Half infinity() noexcept { return gof::Half::from_bits(0x7c00u); }
+    static constexpr gof::Half quiet_NaN() noexcept { return gof::Half::from_bits(0x7e00u); }
+};
+
+template <>
+struct std::numeric_limits<gof::BFloat16>
+{
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr bool is_iec559 = false;
+    static constexpr int digits = 8;
+    static constexpr int digits10 = 2;
+    static constexpr int max_digits10 = 4;
+    static constexpr int radix = 2;
+    static constexpr int min_exponent = -125;
+    static constexpr int max_exponent = 128;
+
+    static constexpr gof::BFloat16 min() noexcept { return gof::BFloat16::from_bits(0x0080u); }
+    static constexpr gof::BFloat16 max() noexcept { return gof::BFloat16::from_bits(0x7f7fu); }
+    static constexpr gof::BFloat16 lowest() noexcept { return gof::BFloat16::from_bits(0xff7fu); }
+    static constexpr gof::BFloat16 epsilon() noexcept { return gof::BFloat16::from_bits(0x3c00u); }
+    static constexpr gof::BFloat16 denorm_min() noexcept { return gof::BFloat16::from_bits(0x0001u); }
+    static constexpr gof::BFloat16 infinity() noexcept { return gof::BFloat16::from_bits(0x7f80u); }
+    static constexpr gof::BFloat16 quiet_NaN() noexcept { return gof::BFloat16::from_bits(0x7fc0u); }
+};
+
+#endif // guard
@@ -0,0 +1,580 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef SIMD_HEADER_GUARD
+#define SIMD_HEADER_GUARD
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // GOF_MATH_HAS_FMA
+
+/*
+ * The SIMD backend.
+ *
+ * The kernels are compiled whenever the target supports SSE2 (every x86-64
+ * compiler does), but `Vector` only uses them when the backend is requested
+ * with `GOF_MATH_SIMD` (see the `vector_SIMD` CMake option). Without it the
+ * portable scalar implementation is used and the memory layout of the vectors
+ * is exactly `N * sizeof(T)`.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GOF_MATH_HAS_SSE 1
+#include <immintrin.h>
+#else
+#define GOF_MATH_HAS_SSE 0
+#endif
+
+namespace gof::simd {
+
+/**
+ * Whenever the `Vector<N, T>` is backed by the SIMD registers.
+ *
+ * Only `Vector<3, float>` and `Vector<4, float>` are accelerated, because
+ * they fit in a single 128-bit register.
+ *
+ * @tparam N The number of components.
+ * @tparam T The scalar type.
+ */
+template <std::size_t N, typename T>
+inline constexpr bool is_enabled =
+#if defined(GOF_MATH_SIMD) && GOF_MATH_HAS_SSE
+    std::is_same_v<T, float> && (N == 3 || N == 4);
+#else
+    false;
+#endif
+
+/**
+ * The number of stored lanes. The 3-component vectors are padded to four
+ * lanes when the SIMD backend is enabled; the padding lane is ignored.
+ */
+template <std::size_t N, typename T>
+inline constexpr std::size_t lanes = is_enabled<N, T> ? 4 : N;
+
+/**
+ * The alignment of the vector storage.
+ */
+template <std::size_t N, typename T>
+inline constexpr std::size_t alignment = is_enabled<N, T> ? 16 : alignof(T);
+
+#if GOF_MATH_HAS_SSE
+
+/*----------------------------------------------------------------------------*/
+/*                                  KERNELS                                   */
+/*----------------------------------------------------------------------------*/
+
+// All kernels work on four 16-byte aligned lanes. The order of the operands
+// is chosen so that the results are bit-identical to the scalar operators.
+
+inline void add(const float* lhs, const float* rhs, float* out) noexcept {
+    _mm_store_ps(out, _mm_add_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+}
+
+inline void sub(const float* lhs, const float* rhs, float* out) noexcept {
+    _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+}
+
+inline void scale(float scalar, const float* self, float* out) noexcept {
+    _mm_store_ps(out, _mm_mul_ps(_mm_set1_ps(scalar), _mm_load_ps(self)));
+}
+
+inline void negate(const float* self, float* out) noexcept {
+    _mm_store_ps(out, _mm_xor_ps(_mm_load_ps(self), _mm_set1_ps(-0.0f)));
+}
+
+/**
+ * Component-wise minimum with the semantics of `std::min(lhs, rhs)`.
+ */
+inline void min(const float* lhs, const float* rhs, float* out) noexcept {
+    // `minps(a, b)` returns `a < b ? a : b` while `std::min(a, b)` returns
+    // `b < a ? b : a`, hence the swapped operands.
+    _mm_store_ps(out, _mm_min_ps(_mm_load_ps(rhs), _mm_load_ps(lhs)));
+}
+
+/**
+ * Component-wise maximum with the semantics of `std::max(lhs, rhs)`.
+ */
+inline void max(const float* lhs, const float* rhs, float* out) noexcept {
+    _mm_store_ps(out, _mm_max_ps(_mm_load_ps(rhs), _mm_load_ps(lhs)));
+}
+
+/**
+ * Compare the first `N` lanes for equality.
+ */
+template <std::size_t N>
+inline bool equal(const float* lhs, const float* rhs) noexcept {
+    constexpr int mask = (1 << N) - 1;
+    const int bits = _mm_movemask_ps(_mm_cmpeq_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    return (bits & mask) == mask;
+}
+
+/**
+ * Compare the first `N` lanes with `|a - b| <= max(absolute, relative * max(|a|, |b|))`,
+ * the same as `tolerance::Relative`.
+ */
+template <std::size_t N>
+inline bool close(const float* lhs, const float* rhs, float relative, float absolute) noexcept {
+    constexpr int mask = (1 << N) - 1;
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 a = _mm_load_ps(lhs);
+    const __m128 b = _mm_load_ps(rhs);
+    const __m128 difference = _mm_andnot_ps(sign, _mm_sub_ps(a, b));
+    const __m128 scale = _mm_max_ps(_mm_andnot_ps(sign, a), _mm_andnot_ps(sign, b));
+    const __m128 bound = _mm_max_ps(_mm_mul_ps(_mm_set1_ps(relative), scale), _mm_set1_ps(absolute));
+    const __m128 within = _mm_and_ps(_mm_cmple_ps(difference, bound), _mm_cmple_ps(difference, _mm_set1_ps(std::numeric_limits<float>::max())));
+    const int bits = _mm_movemask_ps(_mm_or_ps(_mm_cmpeq_ps(a, b), within));
+    return (bits & mask) == mask;
+}
+
+/**
+ * The sum of squares of the first `N` lanes.
+ *
+ * The lanes are accumulated in the order of the components exactly as
+ * `scalar_product()` does, including the use of FMA.
+ */
+template <std::size_t N>
+inline __m128 sum_of_squares(const float* self) noexcept {
+    const __m128 v  = _mm_load_ps(self);
+#if GOF_MATH_HAS_FMA
+    const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_movehl_ps(v, v);
+    __m128 sum = _mm_fmadd_ss(y, y, _mm_mul_ss(v, v));
+    sum = _mm_fmadd_ss(z, z, sum);
+    if constexpr(N == 4) {
+        const __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        sum = _mm_fmadd_ss(w, w, sum);
+    }
+    return sum;
+#else
+    const __m128 sq = _mm_mul_ps(v, v);
+    __m128 sum = _mm_add_ss(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1)));
+    sum = _mm_add_ss(sum, _mm_movehl_ps(sq, sq));
+    if constexpr(N == 4) {
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    return sum;
+#endif
+}
+
+/**
+ * The Euclidean norm of the first `N` lanes.
+ */
+template <std::size_t N>
+inline float length(const float* self) noexcept {
+    return _mm_cvtss_f32(_mm_sqrt_ss(sum_of_squares<N>(self)));
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               MATRIX KERNELS                               */
+/*----------------------------------------------------------------------------*/
+
+// The matrix kernels use unaligned loads, so they work on any `Matrix` and
+// `Vector` regardless of `GOF_MATH_SIMD`. The results are bit-identical to the
+// scalar products in `Matrix.hpp`.
+
+/**
+ * Calculate `a * b + c` lane by lane, fused when the target has FMA.
+ */
+inline __m128 multiply_add(__m128 a, __m128 b, __m128 c) noexcept {
+#if GOF_MATH_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline __m128d multiply_add(__m128d a, __m128d b, __m128d c) noexcept {
+#if GOF_MATH_HAS_FMA
+    return _mm_fmadd_pd(a, b, c);
+#else
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+}
+
+/**
+ * The product of two row-major 4x4 matrices `c = a * b`.
+ *
+ * Each row of `c` is the linear combination of the rows of `b` with the
+ * weights taken from the row of `a`.
+ */
+inline void multiply4x4(const float* a, const float* b, float* c) noexcept {
+    const __m128 b0 = _mm_loadu_ps(b);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+    for (int i = 0; i < 4; ++i) {
+        const float* row = a + 4 * i;
+        __m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+        r = multiply_add(_mm_set1_ps(row[1]), b1, r);
+        r = multiply_add(_mm_set1_ps(row[2]), b2, r);
+        r = multiply_add(_mm_set1_ps(row[3]), b3, r);
+        _mm_storeu_ps(c + 4 * i, r);
+    }
+}
+
+inline void multiply4x4(const double* a, const double* b, double* c) noexcept {
+#if defined(__AVX__)
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    const __m256d b2 = _mm256_loadu_pd(b + 8);
+    const __m256d b3 = _mm256_loadu_pd(b + 12);
+    for (int i = 0; i < 4; ++i) {
+        const double* row = a + 4 * i;
+        __m256d r = _mm256_mul_pd(_mm256_set1_pd(row[0]), b0);
+#if GOF_MATH_HAS_FMA
+        r = _mm256_fmadd_pd(_mm256_set1_pd(row[1]), b1, r);
+        r = _mm256_fmadd_pd(_mm256_set1_pd(row[2]), b2, r);
+        r = _mm256_fmadd_pd(_mm256_set1_pd(row[3]), b3, r);
+#else
+        r = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[1]), b1), r);
+        r = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[2]), b2), r);
+        r = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[3]), b3), r);
+#endif
+        _mm256_storeu_pd(c + 4 * i, r);
+    }
+#else
+    // Two halves of each row in the 128-bit registers.
+    for (int half = 0; half < 4; half += 2) {
+        const __m128d b0 = _mm_loadu_pd(b + half);
+        const __m128d b1 = _mm_loadu_pd(b + 4 + half);
+        const __m128d b2 = _mm_loadu_pd(b + 8 + half);
+        const __m128d b3 = _mm_loadu_pd(b + 12 + half);
+        for (int i = 0; i < 4; ++i) {
+            const double* row = a + 4 * i;
+            __m128d r = _mm_mul_pd(_mm_set1_pd(row[0]), b0);
+            r = multiply_add(_mm_set1_pd(row[1]), b1, r);
+            r = multiply_add(_mm_set1_pd(row[2]), b2, r);
+            r = multiply_add(_mm_set1_pd(row[3]), b3, r);
+            _mm_storeu_pd(c + 4 * i + half, r);
+        }
+    }
+#endif
+}
+
+/**
+ * Transpose the 4x4 matrix.
+ */
+inline void transpose4x4(const float* in, float* out) noexcept {
+    __m128 r0 = _mm_loadu_ps(in);
+    __m128 r1 = _mm_loadu_ps(in + 4);
+    __m128 r2 = _mm_loadu_ps(in + 8);
+    __m128 r3 = _mm_loadu_ps(in + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(out, r0);
+    _mm_storeu_ps(out + 4, r1);
+    _mm_storeu_ps(out + 8, r2);
+    _mm_storeu_ps(out + 12, r3);
+}
+
+/**
+ * The product of the column-major 4x4 matrix with the vector `out = m * v`.
+ *
+ * The result is the linear combination of the columns weighted by `v`.
+ */
+inline __m128 transform4(__m128 c0, __m128 c1, __m128 c2, __m128 c3, const float* v) noexcept {
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    r = multiply_add(c1, _mm_set1_ps(v[1]), r);
+    r = multiply_add(c2, _mm_set1_ps(v[2]), r);
+    r = multiply_add(c3, _mm_set1_ps(v[3]), r);
+    return r;
+}
+
+inline void transform4(const float* columns, const float* v, float* out) noexcept {
+    _mm_storeu_ps(out, transform4(_mm_loadu_ps(columns), _mm_loadu_ps(columns + 4),
+                                  _mm_loadu_ps(columns + 8), _mm_loadu_ps(columns + 12), v));
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                RAY KERNELS                                 */
+/*----------------------------------------------------------------------------*/
+
+// The kernels of the packets in `Ray.hpp`. Every operand is given by the
+// pointers to its 3 rows of lanes and the lanes `[i, i + 4)` are processed.
+// The operand with `Step == 0` is a single ray or primitive broadcast to the
+// lanes.
+
+template <std::size_t Step>
+inline __m128 load_lanes(const float* row, std::size_t i) noexcept {
+    if constexpr(Step == 0) {
+        return _mm_set1_ps(*row);
+    } else {
+        return _mm_load_ps(row + i);
+    }
+}
+
+/**
+ * The slab test, see `intersect()` of the ray and the box.
+ */
+template <std::size_t RayStep, std::size_t BoxStep>
+inline void slab(const float* const (&origin)[3], const float* const (&inverse)[3],
+                 const float* const (&lower)[3], const float* const (&upper)[3],
+                 std::size_t i, float t_min, float t_max, float* out) noexcept {
+    __m128 near = _mm_set1_ps(t_min);
+    __m128 far = _mm_set1_ps(t_max);
+    for (std::size_t k = 0; k < 3; ++k) {
+        const __m128 o = load_lanes<RayStep>(origin[k], i);
+        const __m128 r = load_lanes<RayStep>(inverse[k], i);
+        const __m128 lo = load_lanes<BoxStep>(lower[k], i);
+        const __m128 hi = load_lanes<BoxStep>(upper[k], i);
+        const __m128 positive = _mm_cmpge_ps(r, _mm_setzero_ps());
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_or_ps(_mm_and_ps(positive, lo), _mm_andnot_ps(positive, hi)), o), r);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_or_ps(_mm_and_ps(positive, hi), _mm_andnot_ps(positive, lo)), o), r);
+        // The `max` and `min` return the second operand for NaN.
+        near = _mm_max_ps(t1, near);
+        far = _mm_min_ps(t2, far);
+    }
+    const __m128 hit = _mm_cmple_ps(near, far);
+    const __m128 miss = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    _mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(hit, near), _mm_andnot_ps(hit, miss)));
+}
+
+/**
+ * The Möller–Trumbore test, see `intersect()` of the ray and the triangle.
+ */
+template <std::size_t RayStep, std::size_t TriangleStep>
+inline void triangle(const float* const (&origin)[3], const float* const (&direction)[3],
+                     const float* const (&vertex)[3], const float* const (&edge1)[3], const float* const (&edge2)[3],
+                     std::size_t i, float t_min, float t_max, float* distance, float* u, float* v) noexcept {
+    __m128 o[3], d[3], e1[3], e2[3], s[3];
+    for (std::size_t k = 0; k < 3; ++k) {
+        o[k] = load_lanes<RayStep>(origin[k], i);
+        d[k] = load_lanes<RayStep>(direction[k], i);
+        e1[k] = load_lanes<TriangleStep>(edge1[k], i);
+        e2[k] = load_lanes<TriangleStep>(edge2[k], i);
+        s[k] = _mm_sub_ps(o[k], load_lanes<TriangleStep>(vertex[k], i));
+    }
+    const auto cross = [](const __m128 (&a)[3], const __m128 (&b)[3], std::size_t k) {
+        const std::size_t k1 = (k + 1) % 3;
+        const std::size_t k2 = (k + 2) % 3;
+        return _mm_sub_ps(_mm_mul_ps(a[k1], b[k2]), _mm_mul_ps(a[k2], b[k1]));
+    };
+    const auto dot = [](const __m128 (&a)[3], const __m128 (&b)[3]) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+    };
+    const __m128 p[3] = {cross(d, e2, 0), cross(d, e2, 1), cross(d, e2, 2)};
+    const __m128 q[3] = {cross(s, e1, 0), cross(s, e1, 1), cross(s, e1, 2)};
+    const __m128 det = dot(e1, p);
+    const __m128 r = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    const __m128 uu = _mm_mul_ps(dot(s, p), r);
+    const __m128 vv = _mm_mul_ps(dot(d, q), r);
+    const __m128 t = _mm_mul_ps(dot(e2, q), r);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 hit = _mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_and_ps(_mm_cmpge_ps(uu, zero), _mm_cmpge_ps(vv, zero)));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(uu, vv), _mm_set1_ps(1.0f)));
+    hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, _mm_set1_ps(t_min)), _mm_cmple_ps(t, _mm_set1_ps(t_max))));
+    const __m128 miss = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    _mm_storeu_ps(distance + i, _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, miss)));
+    _mm_storeu_ps(u + i, uu);
+    _mm_storeu_ps(v + i, vv);
+}
+
+#endif // GOF_MATH_HAS_SSE
+
+/*----------------------------------------------------------------------------*/
+/*                               BULK KERNELS                                 */
+/*----------------------------------------------------------------------------*/
+
+// The bulk kernels do not depend on the layout of `Vector`, so they use the
+// SIMD instructions whenever available.
+
+/**
+ * Replace each of the `count` values by its square root.
+ *
+ * The compilers do not vectorize `std::sqrt` loops unless `errno` handling
+ * is disabled, hence the explicit kernel.
+ */
+template <typename T>
+inline void sqrt(T* values, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(values + i, _mm_sqrt_ps(_mm_loadu_ps(values + i)));
+        }
+    }
+    if constexpr(std::is_same_v<T, double>) {
+        for (; i + 2 <= count; i += 2) {
+            _mm_storeu_pd(values + i, _mm_sqrt_pd(_mm_loadu_pd(values + i)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        values[i] = std::sqrt(values[i]);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               GEMM KERNELS                                 */
+/*----------------------------------------------------------------------------*/
+
+// The micro-kernel of `gemm()` in `DenseMatrix.hpp`. It multiplies the packed
+// panel of `A` (`gemm_rows` values per step) with the packed panel of `B`
+// (`gemm_columns` values per step) and keeps the whole tile of the product in
+// the registers: 12 accumulators with AVX, 8 with SSE.
+
+namespace detail {
+
+/**
+ * The SIMD register of the micro-kernel, not defined for the scalar types
+ * without the SIMD support.
+ */
+template <typename T>
+struct Register;
+
+#if defined(__AVX__)
+
+template <>
+struct Register<float>
+{
+    using type = __m256;
+    static constexpr std::size_t width = 8;
+
+    static type zero() noexcept { return _mm256_setzero_ps(); }
+    static type load(const float* p) noexcept { return _mm256_load_ps(p); }
+    static type broadcast(float x) noexcept { return _mm256_set1_ps(x); }
+    static void store(float* p, type x) noexcept { _mm256_store_ps(p, x); }
+#if GOF_MATH_HAS_FMA
+    static type multiply_add(type a, type b, type c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+#else
+    static type multiply_add(type a, type b, type c) noexcept { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+};
+
+template <>
+struct Register<double>
+{
+    using type = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static type zero() noexcept { return _mm256_setzero_pd(); }
+    static type load(const double* p) noexcept { return _mm256_load_pd(p); }
+    static type broadcast(double x) noexcept { return _mm256_set1_pd(x); }
+    static void store(double* p, type x) noexcept { _mm256_store_pd(p, x); }
+#if GOF_MATH_HAS_FMA
+    static type multiply_add(type a, type b, type c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+#else
+    static type multiply_add(type a, type b, type c) noexcept { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+};
+
+#elif GOF_MATH_HAS_SSE
+
+template <>
+struct Register<float>
+{
+    using type = __m128;
+    static constexpr std::size_t width = 4;
+
+    static type zero() noexcept { return _mm_setzero_ps(); }
+    static type load(const float* p) noexcept { return _mm_load_ps(p); }
+    static type broadcast(float x) noexcept { return _mm_set1_ps(x); }
+    static void store(float* p, type x) noexcept { _mm_store_ps(p, x); }
+    static type multiply_add(type a, type b, type c) noexcept { return simd::multiply_add(a, b, c); }
+};
+
+template <>
+struct Register<double>
+{
+    using type = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static type zero() noexcept { return _mm_setzero_pd(); }
+    static type load(const double* p) noexcept { return _mm_load_pd(p); }
+    static type broadcast(double x) noexcept { return _mm_set1_pd(x); }
+    static void store(double* p, type x) noexcept { _mm_store_pd(p, x); }
+    static type multiply_add(type a, type b, type c) noexcept { return simd::multiply_add(a, b, c); }
+};
+
+#endif
+
+template <typename T>
+concept HasRegister = requires { Register<T>::width; };
+
+} // namespace detail
+
+/**
+ * The number of rows of the tile computed by `gemm_kernel()`.
+ */
+template <typename T>
+inline constexpr std::size_t gemm_rows =
+#if defined(__AVX__)
+    detail::HasRegister<T> ? 6 : 4;
+#else
+    4;
+#endif
+
+/**
+ * The number of columns of the tile computed by `gemm_kernel()`, two
+ * registers wide.
+ */
+template <typename T>
+inline constexpr std::size_t gemm_columns = [] {
+    if constexpr(detail::HasRegister<T>) {
+        return 2 * detail::Register<T>::width;
+    } else {
+        return std::size_t{4};
+    }
+}();
+
+/**
+ * Calculate the tile `c = a * b` of `gemm_rows<T> x gemm_columns<T>` values.
+ *
+ * @param depth The number of steps.
+ * @param a The panel of `A`, the values `a[p * gemm_rows + i]`.
+ * @param b The panel of `B`, the values `b[p * gemm_columns + j]` (aligned
+ *          to the cache line).
+ * @param c The row-major tile (aligned to the cache line).
+ */
+template <typename T>
+inline void gemm_kernel(std::size_t depth, const T* a, const T* b, T* c) noexcept {
+    constexpr std::size_t rows = gemm_rows<T>;
+    constexpr std::size_t columns = gemm_columns<T>;
+    if constexpr(detail::HasRegister<T>) {
+        using R = detail::Register<T>;
+        constexpr std::size_t registers = columns / R::width;
+        typename R::type sum[rows][registers];
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t r = 0; r < registers; ++r) {
+                sum[i][r] = R::zero();
+            }
+        }
+        for (std::size_t p = 0; p < depth; ++p) {
+            typename R::type row[registers];
+            for (std::size_t r = 0; r < registers; ++r) {
+                row[r] = R::load(b + p * columns + r * R::width);
+            }
+            for (std::size_t i = 0; i < rows; ++i) {
+                const auto weight = R::broadcast(a[p * rows + i]);
+                for (std::size_t r = 0; r < registers; ++r) {
+                    sum[i][r] = R::multiply_add(weight, row[r], sum[i][r]);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t r = 0; r < registers; ++r) {
+                R::store(c + i * columns + r * R::width, sum[i][r]);
+            }
+        }
+    } else {
+        T sum[rows][columns] = {};
+        for (std::size_t p = 0; p < depth; ++p) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t j = 0; j < columns; ++j) {
+                    sum[i][j] = gof::multiply_add(a[p * rows + i], b[p * columns + j], sum[i][j]);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < columns; ++j) {
+                c[i * columns + j] = sum[i][j];
+            }
+        }
+    }
+}
+
+} // namespace
+
+#endif // guard
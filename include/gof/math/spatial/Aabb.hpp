@@ -0,0 +1,300 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef AABB_HEADER_GUARD
+#define AABB_HEADER_GUARD
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <tuple>
+
+#include <gof/math/common.hpp> // Number
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * The axis-aligned bounding boxes.
+ *
+ * The box is given by its corners `lower` and `upper`. The empty box has the
+ * corners at `+inf` and `-inf`, so it is the identity of `merge()` and the
+ * reductions over the points need no special case for the empty spans.
+ */
+
+namespace gof {
+
+/**
+ * The axis-aligned bounding box.
+ *
+ * The box is a value object like `Vector`, the operations return new boxes.
+ * The corners can be unpacked with the structured binding
+ *
+ *     auto [lower, upper] = bounding_box(points);
+ *
+ * @tparam N The number of dimensions.
+ * @tparam T The scalar type.
+ */
+template <std::size_t N, Number T>
+    requires std::totally_ordered<T>
+class Aabb
+{
+  public:
+
+    static constexpr std::size_t dimension = N;
+
+    /**
+     * Default constructor creating the empty box.
+     */
+    constexpr Aabb() noexcept {
+        std::fill_n(_lower.data(), N, highest());
+        std::fill_n(_upper.data(), N, lowest());
+    }
+
+    /**
+     * Constructor: The corners.
+     */
+    constexpr Aabb(const Vector<N, T>& lower, const Vector<N, T>& upper) noexcept
+        : _lower(lower), _upper(upper) { }
+
+    /**
+     * Constructor creating the box of the single point.
+     */
+    constexpr explicit Aabb(const Vector<N, T>& point) noexcept : _lower(point), _upper(point) { }
+
+    // GETTERS
+
+    constexpr const Vector<N, T>& lower() const noexcept { return _lower; }
+
+    constexpr const Vector<N, T>& upper() const noexcept { return _upper; }
+
+    /**
+     * Get the corner by its index (for the structured binding).
+     */
+    template <std::size_t I>
+        requires (I < 2)
+    constexpr const Vector<N, T>& get() const noexcept {
+        if constexpr(I == 0) {
+            return _lower;
+        } else {
+            return _upper;
+        }
+    }
+
+    /**
+     * Get the size of the box along each axis.
+     */
+    constexpr Vector<N, T> extent() const noexcept {
+        return _upper - _lower;
+    }
+
+    /**
+     * Get the center of the box.
+     */
+    constexpr Vector<N, T> center() const noexcept requires std::floating_point<T> {
+        return T(0.5) * (_lower + _upper);
+    }
+
+    /**
+     * Get the volume (the area for N == 2), zero for the empty box.
+     */
+    constexpr T volume() const noexcept {
+        if (is_empty()) {
+            return T{0};
+        }
+        const Vector<N, T> e = extent();
+        T result = e[0];
+        for (std::size_t k = 1; k < N; ++k) {
+            result *= e[k];
+        }
+        return result;
+    }
+
+    /**
+     * Get the area of the surface, zero for the empty box.
+     *
+     * This will compile only for N == 3.
+     */
+    constexpr T surface_area() const noexcept requires (N == 3) {
+        if (is_empty()) {
+            return T{0};
+        }
+        const Vector<N, T> e = extent();
+        return T{2} * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+    }
+
+    //{ `is_`methods
+
+    /**
+     * Check if the box contains no point, i.e. `lower > upper` along some axis.
+     */
+    constexpr bool is_empty() const noexcept {
+        for (std::size_t k = 0; k < N; ++k) {
+            if (!(_lower[k] <= _upper[k])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Check if the point lies in the box (including the boundary).
+     */
+    constexpr bool contains(const Vector<N, T>& point) const noexcept {
+        bool result = true;
+        for (std::size_t k = 0; k < N; ++k) {
+            result &= (_lower[k] <= point[k]) & (point[k] <= _upper[k]);
+        }
+        return result;
+    }
+
+    /**
+     * Check if the whole box `that` lies in the box. The empty box lies in
+     * every box.
+     */
+    constexpr bool contains(const Aabb& that) const noexcept {
+        if (that.is_empty()) {
+            return true;
+        }
+        return contains(that._lower) && contains(that._upper);
+    }
+
+    /**
+     * Check if the boxes have a common point (including the touching boxes).
+     */
+    constexpr bool intersects(const Aabb& that) const noexcept {
+        bool result = true;
+        for (std::size_t k = 0; k < N; ++k) {
+            result &= (_lower[k] <= that._upper[k]) & (that._lower[k] <= _upper[k]);
+        }
+        return result;
+    }
+
+    //}
+
+    /**
+     * Get the smallest box containing this box and the point.
+     */
+    constexpr Aabb merge(const Vector<N, T>& point) const noexcept {
+        return {min(_lower, point), max(_upper, point)};
+    }
+
+    /**
+     * Get the smallest box containing both boxes.
+     */
+    constexpr Aabb merge(const Aabb& that) const noexcept {
+        return {min(_lower, that._lower), max(_upper, that._upper)};
+    }
+
+    /**
+     * Get the common part of the boxes, which may be empty.
+     */
+    constexpr Aabb intersection(const Aabb& that) const noexcept {
+        return {max(_lower, that._lower), min(_upper, that._upper)};
+    }
+
+    /**
+     * The boxes are equal when their corners are equal.
+     */
+    friend constexpr bool operator ==(const Aabb& self, const Aabb& that) noexcept = default;
+
+    /**
+     * The corners of the empty box.
+     */
+    static constexpr T highest() noexcept {
+        if constexpr(std::numeric_limits<T>::has_infinity) {
+            return std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::max();
+        }
+    }
+
+    static constexpr T lowest() noexcept {
+        if constexpr(std::numeric_limits<T>::has_infinity) {
+            return -std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::lowest();
+        }
+    }
+
+  private:
+
+    Vector<N, T> _lower;
+    Vector<N, T> _upper;
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 REDUCTION                                  */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Calculate the box bounding the points in a single pass.
+ *
+ * The points are processed as the flat array of their components in blocks
+ * of whole vectors filling a few SIMD registers, so the minima and maxima of
+ * the block are vectorized regardless of `N`. The NaN components are ignored.
+ * See `bounding_box()` in `execution.hpp` for the multi-threaded version.
+ */
+template <std::size_t N, Number T>
+    requires std::totally_ordered<T>
+constexpr Aabb<N, T> bounding_box(std::span<const Vector<N, T>> points) noexcept {
+    using Box = Aabb<N, T>;
+    // The stored lanes of the vector including the padding of the SIMD backend.
+    constexpr std::size_t stride = sizeof(Vector<N, T>) / sizeof(T);
+    static_assert(sizeof(Vector<N, T>) == stride * sizeof(T));
+    constexpr std::size_t block = std::lcm(stride, std::max<std::size_t>(32 / sizeof(T), 1));
+    constexpr std::size_t vectors = block / stride;
+
+    Vector<N, T> lower = Box().lower();
+    Vector<N, T> upper = Box().upper();
+    std::size_t i = 0;
+    // The flat access across the vectors is not allowed in the constant expressions.
+    if (!std::is_constant_evaluated() && points.size() >= 2 * vectors) {
+        T lo[block];
+        T hi[block];
+        std::fill_n(lo, block, Box::highest());
+        std::fill_n(hi, block, Box::lowest());
+        const T* p = points.data()->data();
+        for (; i + vectors <= points.size(); i += vectors) {
+            const T* q = p + i * stride;
+            for (std::size_t j = 0; j < block; ++j) {
+                lo[j] = q[j] < lo[j] ? q[j] : lo[j];
+                hi[j] = hi[j] < q[j] ? q[j] : hi[j];
+            }
+        }
+        for (std::size_t j = 0; j < block; ++j) {
+            const std::size_t k = j % stride;
+            if (k < N) {
+                lower.data()[k] = lo[j] < lower[k] ? lo[j] : lower[k];
+                upper.data()[k] = upper[k] < hi[j] ? hi[j] : upper[k];
+            }
+        }
+    }
+    for (; i < points.size(); ++i) {
+        for (std::size_t k = 0; k < N; ++k) {
+            const T x = points[i][k];
+            lower.data()[k] = x < lower[k] ? x : lower[k];
+            upper.data()[k] = upper[k] < x ? x : upper[k];
+        }
+    }
+    return {lower, upper};
+}
+
+} // namespace
+
+/**
+ * The structured binding of the corners `auto [lower, upper] = box`.
+ */
+template <std::size_t N, typename T>
+struct std::tuple_size<gof::Aabb<N, T>> : std::integral_constant<std::size_t, 2> {};
+
+template <std::size_t I, std::size_t N, typename T>
+struct std::tuple_element<I, gof::Aabb<N, T>>
+{
+    using type = const gof::Vector<N, T>;
+};
+
+#endif // guard
@@ -0,0 +1,585 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef BVH_HEADER_GUARD
+#define BVH_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gof/math/execution.hpp>
+#include <gof/math/memory.hpp>
+#include <gof/math/spatial/Aabb.hpp>
+#include <gof/math/spatial/Ray.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * The bounding volume hierarchy.
+ *
+ * The tree is built over the boxes of the primitives by the surface area
+ * heuristic evaluated at the boundaries of a few bins (the binned SAH). The
+ * nodes are stored in one array in the depth-first order: the left child
+ * follows its parent and the parent stores the index of the right child, so
+ * a node takes 32 bytes for floats and the descent into the nearer child
+ * mostly reads the next cache line.
+ */
+
+namespace gof {
+
+/**
+ * The bounding volume hierarchy of the primitives given by their boxes.
+ *
+ * The hierarchy stores the indices of the primitives only, the queries call
+ * back with these indices, so the same tree serves the triangles, the boxes
+ * or any other primitives.
+ *
+ * @tparam T The scalar type.
+ * @tparam Allocator The allocator of the arrays and of the scratch buffers of
+ *         the build (rebound to their types).
+ */
+template <std::floating_point T, typename Allocator = std::allocator<std::byte>>
+class Bvh
+{
+  public:
+
+    using allocator_type = Allocator;
+
+    /**
+     * The index returned when no primitive is found.
+     */
+    static constexpr std::uint32_t npos = ~std::uint32_t{0};
+
+    /**
+     * The deepest level of the tree, the nodes below are leaves.
+     */
+    static constexpr std::size_t max_depth = 64;
+
+    /**
+     * The node of the flattened tree.
+     *
+     * The leaf has `count > 0` primitives `indices()[first, first + count)`.
+     * The inner node has `count == 0`, its left child is the next node and
+     * `first` is the index of its right child.
+     */
+    struct Node
+    {
+        T lower[3];
+        T upper[3];
+        std::uint32_t first;
+        std::uint32_t count;
+
+        constexpr bool is_leaf() const noexcept { return count > 0; }
+    };
+
+    /**
+     * Default constructor creating the empty hierarchy.
+     */
+    Bvh() noexcept = default;
+
+    explicit Bvh(const Allocator& allocator) noexcept
+        : _nodes(allocator), _indices(allocator), _boxes(allocator) { }
+
+    /**
+     * Constructor building the hierarchy in the calling thread.
+     *
+     * @param boxes The boxes of the primitives.
+     * @param leaf_size The largest number of primitives in a leaf.
+     */
+    explicit Bvh(std::span<const Aabb<3, T>> boxes, std::size_t leaf_size = 4,
+                 const Allocator& allocator = Allocator())
+        : Bvh(execution::seq, boxes, leaf_size, allocator) { }
+
+    /**
+     * Constructor building the hierarchy according to the policy.
+     *
+     * The parallel policy builds the large subtrees in the threads of the
+     * pool. The tree does not depend on the policy.
+     */
+    template <execution::Policy P>
+    Bvh(const P& policy, std::span<const Aabb<3, T>> boxes, std::size_t leaf_size = 4,
+        const Allocator& allocator = Allocator())
+        : Bvh(allocator) {
+        assert(boxes.size() < npos && leaf_size > 0);
+        if (boxes.empty()) {
+            return;
+        }
+        Builder builder{boxes, std::max<std::size_t>(leaf_size, 1), nullptr, Centroids(allocator)};
+        _indices.resize(boxes.size());
+        builder.indices = _indices.data();
+        builder.centroids.resize(boxes.size());
+        Bin root;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            _indices[i] = static_cast<std::uint32_t>(i);
+            builder.centroids[i] = centroid(boxes[i]);
+            root.add(boxes[i], builder.centroids[i]);
+        }
+        if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+            _nodes = builder.build(policy, 0, boxes.size(), root, 0);
+        } else {
+            _nodes.reserve(2 * boxes.size() / builder.leaf_size + 1);
+            builder.build(0, boxes.size(), root, 0, _nodes);
+        }
+        // The boxes in the order of the leaves, so the leaves read them contiguously.
+        _boxes.resize(boxes.size());
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            _boxes[i] = boxes[_indices[i]];
+        }
+    }
+
+    // GETTERS
+
+    /**
+     * Get the number of the primitives.
+     */
+    std::size_t size() const noexcept { return _indices.size(); }
+
+    bool empty() const noexcept { return _indices.empty(); }
+
+    allocator_type get_allocator() const { return allocator_type(_nodes.get_allocator()); }
+
+    std::span<const Node> nodes() const noexcept { return _nodes; }
+
+    /**
+     * Get the indices of the primitives in the order of the leaves.
+     */
+    std::span<const std::uint32_t> indices() const noexcept { return _indices; }
+
+    /**
+     * Get the box of all primitives.
+     */
+    Aabb<3, T> bounds() const noexcept {
+        if (_nodes.empty()) {
+            return {};
+        }
+        return box(_nodes.front());
+    }
+
+    // QUERIES
+
+    /**
+     * Find the nearest primitive hit by the ray.
+     *
+     * The children are visited nearer first and the subtrees behind the
+     * nearest hit so far are skipped.
+     *
+     * @param test The function `T(std::uint32_t primitive, T t_max)` returning
+     *        the distance of the hit in `[t_min, t_max]` or `+inf`.
+     * @return The index of the nearest primitive and its distance, or `npos`
+     *         and `+inf`.
+     */
+    template <typename F>
+    std::pair<std::uint32_t, T> intersect(const Ray<T>& ray, F&& test, T t_min = T{0},
+                                          T t_max = std::numeric_limits<T>::infinity()) const {
+        constexpr T miss = std::numeric_limits<T>::infinity();
+        std::pair<std::uint32_t, T> result{npos, t_max};
+        if (_nodes.empty()) {
+            return {npos, miss};
+        }
+        const T origin[3] = {ray.origin()[0], ray.origin()[1], ray.origin()[2]};
+        const T inverse[3] = {ray.inverse_direction()[0], ray.inverse_direction()[1], ray.inverse_direction()[2]};
+        const auto enter = [&](const Node& node) {
+            return detail::slab(origin, inverse, node.lower, node.upper, t_min, result.second);
+        };
+
+        struct Entry
+        {
+            std::uint32_t node;
+            T distance;
+        };
+        Entry stack[max_depth];
+        std::size_t top = 0;
+        if (enter(_nodes[0]) != miss) {
+            stack[top++] = {0, t_min};
+        }
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.distance > result.second) {
+                continue;
+            }
+            std::uint32_t index = entry.node;
+            for (;;) {
+                const Node& node = _nodes[index];
+                if (node.is_leaf()) {
+                    for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                        const T t = test(_indices[i], result.second);
+                        // The first hit exactly at `t_max` is accepted, the ties keep the earlier hit.
+                        if (t <= result.second && t < miss && (t < result.second || result.first == npos)) {
+                            result = {_indices[i], t};
+                        }
+                    }
+                    break;
+                }
+                const std::uint32_t left = index + 1;
+                const std::uint32_t right = node.first;
+                const T t_left = enter(_nodes[left]);
+                const T t_right = enter(_nodes[right]);
+                if (t_left == miss && t_right == miss) {
+                    break;
+                }
+                if (t_right == miss || (t_left != miss && t_left <= t_right)) {
+                    if (t_right != miss) {
+                        stack[top++] = {right, t_right};
+                    }
+                    index = left;
+                } else {
+                    if (t_left != miss) {
+                        stack[top++] = {left, t_left};
+                    }
+                    index = right;
+                }
+            }
+        }
+        if (result.first == npos) {
+            result.second = miss;
+        }
+        return result;
+    }
+
+    /**
+     * Find the nearest triangle hit by the ray.
+     *
+     * The hierarchy must be built over `triangle_boxes(vertices, triangles)`.
+     *
+     * @param vertices The vertices of the mesh.
+     * @param triangles The three vertex indices of each triangle.
+     * @return The index of the triangle and the hit, or `npos`.
+     */
+    std::pair<std::uint32_t, Hit<T>> intersect(const Ray<T>& ray, std::span<const Vector<3, T>> vertices,
+                                               std::span<const std::uint32_t> triangles, T t_min = T{0},
+                                               T t_max = std::numeric_limits<T>::infinity()) const {
+        assert(triangles.size() == 3 * size());
+        Hit<T> nearest;
+        const auto test = [&](std::uint32_t i, T limit) {
+            const Hit<T> hit = gof::intersect(ray, vertices[triangles[3 * i]], vertices[triangles[3 * i + 1]],
+                                              vertices[triangles[3 * i + 2]], t_min, limit);
+            if (hit.distance < nearest.distance) {
+                nearest = hit;
+            }
+            return hit.distance;
+        };
+        const std::uint32_t index = intersect(ray, test, t_min, t_max).first;
+        return {index, index == npos ? Hit<T>{} : nearest};
+    }
+
+    /**
+     * Call `f(std::uint32_t primitive)` for each primitive whose box has a
+     * common point with the box.
+     */
+    template <typename F>
+    void overlap(const Aabb<3, T>& query, F&& f) const {
+        if (_nodes.empty()) {
+            return;
+        }
+        const auto intersects = [&](const Node& node) {
+            bool result = true;
+            for (std::size_t k = 0; k < 3; ++k) {
+                result &= (node.lower[k] <= query.upper()[k]) & (query.lower()[k] <= node.upper[k]);
+            }
+            return result;
+        };
+        std::uint32_t stack[max_depth];
+        std::size_t top = 0;
+        if (intersects(_nodes[0])) {
+            stack[top++] = 0;
+        }
+        while (top > 0) {
+            const std::uint32_t index = stack[--top];
+            const Node& node = _nodes[index];
+            if (node.is_leaf()) {
+                for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (_boxes[i].intersects(query)) {
+                        f(_indices[i]);
+                    }
+                }
+                continue;
+            }
+            if (intersects(_nodes[node.first])) {
+                stack[top++] = node.first;
+            }
+            if (intersects(_nodes[index + 1])) {
+                stack[top++] = index + 1;
+            }
+        }
+    }
+
+  private:
+
+    static constexpr std::size_t bins = 16;
+
+    /**
+     * The subtrees smaller than this are built in one thread.
+     */
+    static constexpr std::size_t parallel_size = 1 << 14;
+
+    static Vector<3, T> centroid(const Aabb<3, T>& box) noexcept {
+        return T(0.5) * (box.lower() + box.upper());
+    }
+
+    static Aabb<3, T> box(const Node& node) noexcept {
+        return {{node.lower[0], node.lower[1], node.lower[2]}, {node.upper[0], node.upper[1], node.upper[2]}};
+    }
+
+    /**
+     * The primitives of a bin, or of a node.
+     */
+    struct Bin
+    {
+        Aabb<3, T> bounds;
+        Aabb<3, T> centroids;
+        std::size_t count = 0;
+
+        void add(const Aabb<3, T>& box, const Vector<3, T>& centroid) noexcept {
+            bounds = bounds.merge(box);
+            centroids = centroids.merge(centroid);
+            ++count;
+        }
+
+        void add(const Bin& that) noexcept {
+            bounds = bounds.merge(that.bounds);
+            centroids = centroids.merge(that.centroids);
+            count += that.count;
+        }
+    };
+
+    using Bins = std::array<Bin, bins>;
+
+    using Nodes = detail::rebind_vector<Node, Allocator>;
+
+    using Centroids = detail::rebind_vector<Vector<3, T>, Allocator>;
+
+    /**
+     * The split of a node by the binned SAH.
+     */
+    struct Split
+    {
+        std::size_t axis;
+        std::size_t bin; // the first bin of the right child
+        T offset;
+        T scale;
+        Bin left;
+        Bin right;
+
+        std::size_t bin_of(const Vector<3, T>& centroid) const noexcept {
+            return index(centroid[axis], offset, scale);
+        }
+    };
+
+    static std::size_t index(T x, T offset, T scale) noexcept {
+        // The NaN centroids (of the empty boxes) fall into the first bin.
+        const T q = (x - offset) * scale;
+        return q > T{0} ? (q < T(bins - 1) ? static_cast<std::size_t>(q) : bins - 1) : 0;
+    }
+
+    struct Builder
+    {
+        std::span<const Aabb<3, T>> boxes;
+        std::size_t leaf_size;
+        std::uint32_t* indices = nullptr;
+        Centroids centroids;
+
+        /**
+         * Choose the axis of the split, or return false for the leaf.
+         */
+        bool prepare(const Bin& node, std::size_t depth, Split& split) const noexcept {
+            if (node.count <= leaf_size || depth + 1 >= max_depth) {
+                return false;
+            }
+            const Vector<3, T> extent = node.centroids.extent();
+            split.axis = extent[1] > extent[0] ? 1 : 0;
+            split.axis = extent[2] > extent[split.axis] ? 2 : split.axis;
+            // All centroids at one point (or NaN) cannot be split.
+            if (!(extent[split.axis] > T{0})) {
+                return false;
+            }
+            split.offset = node.centroids.lower()[split.axis];
+            split.scale = T(bins) / extent[split.axis];
+            return true;
+        }
+
+        void fill(std::size_t first, std::size_t last, const Split& split, Bins& result) const noexcept {
+            for (std::size_t i = first; i < last; ++i) {
+                const std::uint32_t p = indices[i];
+                result[split.bin_of(centroids[p])].add(boxes[p], centroids[p]);
+            }
+        }
+
+        /**
+         * Evaluate the cost `area * count` of the children at each boundary,
+         * or return false when no boundary has both children non-empty.
+         *
+         * The areas of the huge (or infinite) boxes overflow, while no cost is
+         * finite the boundary balancing the counts is taken instead.
+         */
+        static bool choose(const Bins& filled, Split& split) noexcept {
+            Bin right[bins];
+            right[bins - 1] = filled[bins - 1];
+            for (std::size_t b = bins - 1; b-- > 0;) {
+                right[b] = right[b + 1];
+                right[b].add(filled[b]);
+            }
+            Bin left;
+            T best = std::numeric_limits<T>::infinity();
+            std::size_t balance = std::numeric_limits<std::size_t>::max();
+            bool found = false;
+            for (std::size_t b = 1; b < bins; ++b) {
+                left.add(filled[b - 1]);
+                if (left.count == 0 || right[b].count == 0) {
+                    continue;
+                }
+                const T cost = left.bounds.surface_area() * T(left.count) +
+                               right[b].bounds.surface_area() * T(right[b].count);
+                const std::size_t imbalance = left.count > right[b].count ? left.count - right[b].count
+                                                                          : right[b].count - left.count;
+                if (cost < best || (!(best < std::numeric_limits<T>::infinity()) && imbalance < balance)) {
+                    best = cost < best ? cost : best;
+                    balance = imbalance;
+                    found = true;
+                    split.bin = b;
+                    split.left = left;
+                    split.right = right[b];
+                }
+            }
+            return found;
+        }
+
+        std::size_t partition(std::size_t first, std::size_t last, const Split& split) const noexcept {
+            const auto middle = std::partition(indices + first, indices + last, [&](std::uint32_t p) {
+                return split.bin_of(centroids[p]) < split.bin;
+            });
+            return static_cast<std::size_t>(middle - indices);
+        }
+
+        static Node node(const Bin& bin) noexcept {
+            Node result{};
+            for (std::size_t k = 0; k < 3; ++k) {
+                result.lower[k] = bin.bounds.lower()[k];
+                result.upper[k] = bin.bounds.upper()[k];
+            }
+            return result;
+        }
+
+        /**
+         * Append the subtree of `[first, last)` to the nodes in the depth-first order.
+         */
+        void build(std::size_t first, std::size_t last, const Bin& bin, std::size_t depth,
+                   Nodes& nodes) const {
+            const std::size_t self = nodes.size();
+            nodes.push_back(node(bin));
+            Split split{};
+            if (prepare(bin, depth, split)) {
+                Bins filled{};
+                fill(first, last, split, filled);
+                if (choose(filled, split)) {
+                    const std::size_t middle = partition(first, last, split);
+                    build(first, middle, split.left, depth + 1, nodes);
+                    nodes[self].first = static_cast<std::uint32_t>(nodes.size());
+                    build(middle, last, split.right, depth + 1, nodes);
+                    return;
+                }
+            }
+            nodes[self].first = static_cast<std::uint32_t>(first);
+            nodes[self].count = static_cast<std::uint32_t>(last - first);
+        }
+
+        /**
+         * Build the subtree of `[first, last)` with the indices of the nodes
+         * relative to its root.
+         */
+        Nodes build(const execution::parallel_policy& policy, std::size_t first, std::size_t last,
+                    const Bin& bin, std::size_t depth) const {
+            const auto allocator = centroids.get_allocator();
+            Nodes nodes(allocator);
+            Split split{};
+            if (last - first < parallel_size || !prepare(bin, depth, split)) {
+                build(first, last, bin, depth, nodes);
+                return nodes;
+            }
+
+            // Bin the chunks in parallel, the merge of the bins is exact.
+            const std::size_t count = last - first;
+            const std::size_t grain = detail::chunk_size<std::uint32_t>(policy, count);
+            detail::rebind_vector<Bins, Allocator> partials((count + grain - 1) / grain, Bins{}, allocator);
+            policy.thread_pool().parallel_for(count, grain, [&](std::size_t begin, std::size_t end) {
+                fill(first + begin, first + end, split, partials[begin / grain]);
+            });
+            Bins filled{};
+            for (const auto& partial : partials) {
+                for (std::size_t b = 0; b < bins; ++b) {
+                    filled[b].add(partial[b]);
+                }
+            }
+            if (!choose(filled, split)) {
+                nodes.push_back(node(bin));
+                nodes.front().first = static_cast<std::uint32_t>(first);
+                nodes.front().count = static_cast<std::uint32_t>(last - first);
+                return nodes;
+            }
+            const std::size_t middle = partition(first, last, split);
+
+            Nodes children[2] = {Nodes(allocator), Nodes(allocator)};
+            policy.thread_pool().parallel_for(2, 1, [&](std::size_t child, std::size_t) {
+                children[child] = child == 0 ? build(policy, first, middle, split.left, depth + 1)
+                                             : build(policy, middle, last, split.right, depth + 1);
+            });
+
+            // Join the subtrees and shift the indices of their right children.
+            nodes.reserve(1 + children[0].size() + children[1].size());
+            nodes.push_back(node(bin));
+            nodes.front().first = static_cast<std::uint32_t>(1 + children[0].size());
+            for (std::size_t c = 0; c < 2; ++c) {
+                const auto base = static_cast<std::uint32_t>(nodes.size());
+                for (Node n : children[c]) {
+                    n.first += n.is_leaf() ? 0 : base;
+                    nodes.push_back(n);
+                }
+            }
+            return nodes;
+        }
+    };
+
+    Nodes _nodes;
+    detail::rebind_vector<std::uint32_t, Allocator> _indices;
+    detail::rebind_vector<Aabb<3, T>, Allocator> _boxes;
+};
+
+namespace pmr {
+
+template <std::floating_point T>
+using Bvh = gof::Bvh<T, aligned_allocator<std::byte>>;
+
+} // namespace pmr
+
+/**
+ * Calculate the boxes of the triangles.
+ *
+ * @param vertices The vertices of the mesh.
+ * @param triangles The three vertex indices of each triangle.
+ */
+template <std::floating_point T>
+std::vector<Aabb<3, T>> triangle_boxes(std::span<const Vector<3, T>> vertices,
+                                       std::span<const std::uint32_t> triangles) {
+    assert(triangles.size() % 3 == 0);
+    std::vector<Aabb<3, T>> result(triangles.size() / 3);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        const Vector<3, T>& a = vertices[triangles[3 * i]];
+        const Vector<3, T>& b = vertices[triangles[3 * i + 1]];
+        const Vector<3, T>& c = vertices[triangles[3 * i + 2]];
+        result[i] = {min(min(a, b), c), max(max(a, b), c)};
+    }
+    return result;
+}
+
+} // namespace
+
+#endif // guard
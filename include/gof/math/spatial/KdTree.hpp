@@ -0,0 +1,391 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef KD_TREE_HEADER_GUARD
+#define KD_TREE_HEADER_GUARD
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <gof/math/execution.hpp>
+#include <gof/math/memory.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * The nearest neighbours of the points.
+ *
+ * The k-d tree is implicit: the points are reordered so that the median of
+ * every range `[first, last)` lies at its middle, the smaller coordinates
+ * before it and the larger after it. The tree is then the array of the
+ * points and the array of the split axes, there are no nodes and the build
+ * allocates only these arrays.
+ */
+
+namespace gof {
+
+/**
+ * The point found by the query.
+ */
+template <std::floating_point T>
+struct Neighbour
+{
+    std::uint32_t index;
+    T distance_squared;
+
+    /**
+     * The nearer neighbour goes first, the ties are ordered by the index.
+     */
+    friend constexpr bool operator <(const Neighbour& self, const Neighbour& that) noexcept {
+        return self.distance_squared < that.distance_squared ||
+               (self.distance_squared == that.distance_squared && self.index < that.index);
+    }
+
+    friend constexpr bool operator ==(const Neighbour& self, const Neighbour& that) noexcept = default;
+};
+
+/**
+ * The neighbours of the queries in the compressed form: the neighbours of
+ * the query `i` are `neighbours[offsets[i], offsets[i + 1])`.
+ */
+template <std::floating_point T, typename Allocator = std::allocator<std::byte>>
+struct Neighbourhoods
+{
+    detail::rebind_vector<std::size_t, Allocator> offsets;
+    detail::rebind_vector<Neighbour<T>, Allocator> neighbours;
+
+    std::span<const Neighbour<T>> operator [](std::size_t i) const noexcept {
+        return std::span<const Neighbour<T>>(neighbours).subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+/**
+ * The k-d tree of the points.
+ *
+ * The tree keeps a copy of the points, the queries return the indices into
+ * the span given to the constructor.
+ *
+ * @tparam N The number of components.
+ * @tparam T The scalar type.
+ * @tparam Allocator The allocator of the arrays (rebound to their types).
+ */
+template <std::size_t N, std::floating_point T, typename Allocator = std::allocator<std::byte>>
+class KdTree
+{
+  public:
+
+    using allocator_type = Allocator;
+
+    /**
+     * The index of the missing neighbour.
+     */
+    static constexpr std::uint32_t npos = ~std::uint32_t{0};
+
+    /**
+     * Default constructor creating the empty tree.
+     */
+    KdTree() noexcept = default;
+
+    explicit KdTree(const Allocator& allocator) noexcept
+        : _points(allocator), _indices(allocator), _axes(allocator) { }
+
+    /**
+     * Constructor building the tree in the calling thread.
+     */
+    explicit KdTree(std::span<const Vector<N, T>> points, const Allocator& allocator = Allocator())
+        : KdTree(execution::seq, points, allocator) { }
+
+    /**
+     * Constructor building the tree according to the policy.
+     *
+     * The parallel policy builds the large subtrees in the threads of the
+     * pool. The tree does not depend on the policy.
+     */
+    template <execution::Policy P>
+    KdTree(const P& policy, std::span<const Vector<N, T>> points, const Allocator& allocator = Allocator())
+        : KdTree(allocator) {
+        assert(points.size() < npos);
+        _points.resize(points.size());
+        _indices.resize(points.size());
+        _axes.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            _indices[i] = static_cast<std::uint32_t>(i);
+        }
+        if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+            build(&policy, points, 0, points.size());
+        } else {
+            build(nullptr, points, 0, points.size());
+        }
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            _points[i] = points[_indices[i]];
+        }
+    }
+
+    // GETTERS
+
+    std::size_t size() const noexcept { return _points.size(); }
+
+    bool empty() const noexcept { return _points.empty(); }
+
+    allocator_type get_allocator() const { return allocator_type(_points.get_allocator()); }
+
+    // QUERIES
+
+    /**
+     * Find the nearest point, or `npos` for the empty tree.
+     */
+    Neighbour<T> nearest(const Vector<N, T>& query) const noexcept {
+        Closest visitor;
+        search(query, 0, size(), visitor);
+        return visitor.best;
+    }
+
+    /**
+     * Find the `out.size()` nearest points sorted by their distance.
+     *
+     * @return The number of the found points, the rest of `out` is filled
+     *         with `npos` at the infinite distance.
+     */
+    std::size_t knn(const Vector<N, T>& query, std::span<Neighbour<T>> out) const noexcept {
+        Nearest visitor{out.data(), out.size()};
+        if (!out.empty()) {
+            search(query, 0, size(), visitor);
+        }
+        std::sort_heap(out.data(), out.data() + visitor.count);
+        std::fill(out.begin() + visitor.count, out.end(), Neighbour<T>{npos, std::numeric_limits<T>::infinity()});
+        return visitor.count;
+    }
+
+    /**
+     * Call `f(Neighbour<T>)` for each point within the radius (including
+     * the boundary), in no particular order.
+     */
+    template <typename F>
+    void radius_search(const Vector<N, T>& query, T radius, F&& f) const {
+        Within<F> visitor{radius * radius, f};
+        search(query, 0, size(), visitor);
+    }
+
+    /**
+     * Find the `k` nearest points of each query, see `knn()`.
+     *
+     * @param out The neighbours of the query `i` at `out[i * k, (i + 1) * k)`.
+     */
+    template <execution::Policy P>
+    void knn(const P& policy, std::span<const Vector<N, T>> queries, std::size_t k,
+             std::span<Neighbour<T>> out) const {
+        assert(out.size() == queries.size() * k);
+        detail::for_each_chunk<Vector<N, T>>(policy, queries.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                knn(queries[i], out.subspan(i * k, k));
+            }
+        });
+    }
+
+    /**
+     * Find the points within the radius of each query sorted by their
+     * distance.
+     *
+     * The result and the scratch buffers use the allocator of the tree.
+     */
+    template <execution::Policy P>
+    Neighbourhoods<T, Allocator> radius_search(const P& policy, std::span<const Vector<N, T>> queries,
+                                               T radius) const {
+        const Allocator allocator = get_allocator();
+        Neighbourhoods<T, Allocator> result{decltype(result.offsets)(allocator),
+                                            decltype(result.neighbours)(allocator)};
+        result.offsets.assign(queries.size() + 1, 0);
+        // Each chunk collects its neighbours, they are joined in the order of the queries.
+        detail::rebind_vector<detail::rebind_vector<Neighbour<T>, Allocator>, Allocator> chunks(allocator);
+        std::size_t grain = queries.size();
+        if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+            grain = detail::chunk_size<Vector<N, T>>(policy, queries.size());
+        }
+        chunks.resize(grain > 0 ? (queries.size() + grain - 1) / grain : 0);
+        const auto run = [&](std::size_t first, std::size_t last) {
+            auto& found = chunks[first / grain];
+            for (std::size_t i = first; i < last; ++i) {
+                const std::size_t begin = found.size();
+                radius_search(queries[i], radius, [&](const Neighbour<T>& n) { found.push_back(n); });
+                std::sort(found.begin() + begin, found.end());
+                result.offsets[i + 1] = found.size() - begin;
+            }
+        };
+        if constexpr(std::is_same_v<P, execution::parallel_policy>) {
+            policy.thread_pool().parallel_for(queries.size(), grain, run);
+        } else if (!queries.empty()) {
+            run(0, queries.size());
+        }
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            result.offsets[i + 1] += result.offsets[i];
+        }
+        result.neighbours.reserve(result.offsets.back());
+        for (const auto& found : chunks) {
+            result.neighbours.insert(result.neighbours.end(), found.begin(), found.end());
+        }
+        return result;
+    }
+
+  private:
+
+    /**
+     * The ranges smaller than this are searched linearly.
+     */
+    static constexpr std::size_t leaf_size = 8;
+
+    /**
+     * The subtrees smaller than this are built in one thread.
+     */
+    static constexpr std::size_t parallel_size = 1 << 14;
+
+    /**
+     * Place the median of `[first, last)` along the widest axis in the middle.
+     */
+    void build(const execution::parallel_policy* policy, std::span<const Vector<N, T>> points,
+               std::size_t first, std::size_t last) {
+        if (last - first <= leaf_size) {
+            return;
+        }
+        Vector<N, T> lower = points[_indices[first]];
+        Vector<N, T> upper = lower;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            lower = min(lower, points[_indices[i]]);
+            upper = max(upper, points[_indices[i]]);
+        }
+        const Vector<N, T> extent = upper - lower;
+        std::size_t axis = 0;
+        for (std::size_t k = 1; k < N; ++k) {
+            axis = extent[k] > extent[axis] ? k : axis;
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        std::nth_element(_indices.begin() + first, _indices.begin() + middle, _indices.begin() + last,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return points[a][axis] < points[b][axis] || (points[a][axis] == points[b][axis] && a < b);
+                         });
+        _axes[middle] = static_cast<std::uint8_t>(axis);
+
+        if (policy && last - first >= parallel_size) {
+            policy->thread_pool().parallel_for(2, 1, [&](std::size_t child, std::size_t) {
+                if (child == 0) {
+                    build(policy, points, first, middle);
+                } else {
+                    build(policy, points, middle + 1, last);
+                }
+            });
+        } else {
+            build(policy, points, first, middle);
+            build(policy, points, middle + 1, last);
+        }
+    }
+
+    /**
+     * Keep the `capacity` nearest points in the max-heap.
+     */
+    struct Nearest
+    {
+        Neighbour<T>* heap;
+        std::size_t capacity;
+        std::size_t count = 0;
+
+        T bound() const noexcept {
+            return count < capacity ? std::numeric_limits<T>::infinity() : heap[0].distance_squared;
+        }
+
+        void visit(const Neighbour<T>& n) noexcept {
+            if (count < capacity) {
+                heap[count++] = n;
+                std::push_heap(heap, heap + count);
+            } else if (n < heap[0]) {
+                std::pop_heap(heap, heap + count);
+                heap[count - 1] = n;
+                std::push_heap(heap, heap + count);
+            }
+        }
+    };
+
+    /**
+     * Keep the nearest point, `Nearest` of the capacity one without the heap.
+     */
+    struct Closest
+    {
+        Neighbour<T> best{npos, std::numeric_limits<T>::infinity()};
+
+        T bound() const noexcept { return best.distance_squared; }
+
+        void visit(const Neighbour<T>& n) noexcept {
+            if (best.index == npos || n < best) {
+                best = n;
+            }
+        }
+    };
+
+    template <typename F>
+    struct Within
+    {
+        T limit;
+        F& f;
+
+        T bound() const noexcept { return limit; }
+
+        void visit(const Neighbour<T>& n) {
+            if (n.distance_squared <= limit) {
+                f(n);
+            }
+        }
+    };
+
+    /**
+     * Visit the points of `[first, last)` which may be nearer than the bound
+     * of the visitor, the nearer half first.
+     */
+    template <typename V>
+    void search(const Vector<N, T>& query, std::size_t first, std::size_t last, V& visitor) const {
+        while (last - first > leaf_size) {
+            const std::size_t middle = first + (last - first) / 2;
+            const std::size_t axis = _axes[middle];
+            const T d = query[axis] - _points[middle][axis];
+            visitor.visit({_indices[middle], (query - _points[middle]).length_squared()});
+            // Recurse into the nearer half, continue with the farther one.
+            if (d < T{0}) {
+                search(query, first, middle, visitor);
+                first = middle + 1;
+            } else {
+                search(query, middle + 1, last, visitor);
+                last = middle;
+            }
+            if (!(d * d <= visitor.bound())) {
+                return;
+            }
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            visitor.visit({_indices[i], (query - _points[i]).length_squared()});
+        }
+    }
+
+    detail::rebind_vector<Vector<N, T>, Allocator> _points;
+    detail::rebind_vector<std::uint32_t, Allocator> _indices;
+    detail::rebind_vector<std::uint8_t, Allocator> _axes;
+};
+
+namespace pmr {
+
+template <std::floating_point T>
+using Neighbourhoods = gof::Neighbourhoods<T, aligned_allocator<std::byte>>;
+
+template <std::size_t N, std::floating_point T>
+using KdTree = gof::KdTree<N, T, aligned_allocator<std::byte>>;
+
+} // namespace pmr
+
+} // namespace
+
+#endif // guard
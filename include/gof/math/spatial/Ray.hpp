@@ -0,0 +1,497 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef RAY_HEADER_GUARD
+#define RAY_HEADER_GUARD
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // multiply_add
+#include <gof/math/simd.hpp>
+#include <gof/math/spatial/Aabb.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * Rays and their intersections with the boxes and the triangles.
+ *
+ * Every test has the single-ray form and the packet forms, which store `W`
+ * rays (or `W` primitives) as a structure of arrays. The packets of floats
+ * are tested 4 lanes per instruction by the SSE kernels in `simd.hpp`, the
+ * other packets run the branch-free scalar kernel in each lane.
+ *
+ * A missed intersection has the distance `+inf`, so the nearest hit is the
+ * minimum of the distances.
+ */
+
+namespace gof {
+
+namespace detail {
+
+/**
+ * The `min` and `max` keeping the accumulator `a` when `x` is NaN, which
+ * happens in the slab test when the ray lies in the plane of the slab.
+ */
+template <typename T>
+constexpr T accumulate_min(T a, T x) noexcept { return x < a ? x : a; }
+
+template <typename T>
+constexpr T accumulate_max(T a, T x) noexcept { return a < x ? x : a; }
+
+/**
+ * The inverse of the component of the direction. The division by zero is not
+ * a constant expression, so the zero is mapped to `+inf` explicitly; the sign
+ * of the infinity does not change the result of the slab test.
+ */
+template <typename T>
+constexpr T inverse(T x) noexcept {
+    if (std::is_constant_evaluated() && x == T{0}) {
+        return std::numeric_limits<T>::infinity();
+    }
+    return T{1} / x;
+}
+
+/**
+ * The slab test, shared by all forms.
+ *
+ * The nearer plane of each slab is selected by the sign of the direction, so
+ * the empty box (`lower > upper`) is never hit. The NaN distances (the ray in
+ * the plane of the slab) are ignored.
+ */
+template <typename T>
+constexpr T slab(const T (&origin)[3], const T (&inverse)[3], const T (&lower)[3], const T (&upper)[3],
+                 T t_min, T t_max) noexcept {
+    T near = t_min;
+    T far = t_max;
+    for (std::size_t k = 0; k < 3; ++k) {
+        const bool positive = inverse[k] >= T{0};
+        const T t1 = ((positive ? lower[k] : upper[k]) - origin[k]) * inverse[k];
+        const T t2 = ((positive ? upper[k] : lower[k]) - origin[k]) * inverse[k];
+        near = accumulate_max(near, t1);
+        far = accumulate_min(far, t2);
+    }
+    return near <= far ? near : std::numeric_limits<T>::infinity();
+}
+
+/**
+ * The Möller–Trumbore test, shared by all forms.
+ */
+template <typename T>
+constexpr void triangle(const T (&o)[3], const T (&d)[3], const T (&a)[3], const T (&e1)[3], const T (&e2)[3],
+                        T t_min, T t_max, T& distance, T& u, T& v) noexcept {
+    const T p[3] = {d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0]};
+    const T det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    const T inverse = T{1} / det;
+    const T s[3] = {o[0] - a[0], o[1] - a[1], o[2] - a[2]};
+    const T q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+    u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse;
+    v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inverse;
+    const T t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse;
+    const bool hit = (det != T{0}) & (u >= T{0}) & (v >= T{0}) & (u + v <= T{1}) & (t >= t_min) & (t <= t_max);
+    distance = hit ? t : std::numeric_limits<T>::infinity();
+}
+
+} // namespace detail
+
+/**
+ * The half-line `origin + t * direction` for `t >= 0`.
+ *
+ * The inverse of the direction is computed once by the constructor, so the
+ * slab tests against many boxes need no division. The zero components of the
+ * direction have the infinite inverse.
+ *
+ * @tparam T The scalar type.
+ */
+template <std::floating_point T>
+class Ray
+{
+  public:
+
+    /**
+     * Default constructor creating the ray from the origin along `x`.
+     */
+    constexpr Ray() noexcept : Ray(Vector<3, T>::zero(), Vector<3, T>::unit_x()) { }
+
+    /**
+     * Constructor: The origin and the direction (not necessarily unit).
+     */
+    constexpr Ray(const Vector<3, T>& origin, const Vector<3, T>& direction) noexcept
+        : _origin(origin)
+        , _direction(direction)
+        , _inverse(detail::inverse(direction.x()), detail::inverse(direction.y()), detail::inverse(direction.z())) { }
+
+    // GETTERS
+
+    constexpr const Vector<3, T>& origin() const noexcept { return _origin; }
+
+    constexpr const Vector<3, T>& direction() const noexcept { return _direction; }
+
+    /**
+     * Get the component-wise inverse of the direction.
+     */
+    constexpr const Vector<3, T>& inverse_direction() const noexcept { return _inverse; }
+
+    /**
+     * Get the point at the distance `t` (in the units of the direction).
+     */
+    constexpr Vector<3, T> at(T t) const noexcept {
+        return Vector<3, T>(multiply_add(t, _direction.x(), _origin.x()),
+                            multiply_add(t, _direction.y(), _origin.y()),
+                            multiply_add(t, _direction.z(), _origin.z()));
+    }
+
+    friend constexpr bool operator ==(const Ray& self, const Ray& that) noexcept {
+        return self._origin == that._origin && self._direction == that._direction;
+    }
+
+  private:
+
+    Vector<3, T> _origin;
+    Vector<3, T> _direction;
+    Vector<3, T> _inverse;
+};
+
+/**
+ * The intersection with a triangle `(a, b, c)`.
+ *
+ * The hit point is `(1 - u - v) a + u b + v c`. The barycentric coordinates
+ * are unspecified when the triangle is missed.
+ */
+template <std::floating_point T>
+struct Hit
+{
+    T distance = std::numeric_limits<T>::infinity();
+    T u = T{0};
+    T v = T{0};
+
+    /**
+     * Whenever the triangle was hit.
+     */
+    constexpr explicit operator bool() const noexcept {
+        return distance < std::numeric_limits<T>::infinity();
+    }
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*                                 SINGLE RAY                                 */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Intersect the ray with the box (the slab test).
+ *
+ * @param t_min The nearest accepted distance.
+ * @param t_max The farthest accepted distance.
+ * @return The distance where the ray enters the box (`t_min` when the origin
+ *         is inside), or `+inf` when the ray misses the box in `[t_min, t_max]`.
+ */
+template <std::floating_point T>
+constexpr T intersect(const Ray<T>& ray, const Aabb<3, T>& box, T t_min = T{0},
+                      T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const T origin[3] = {ray.origin()[0], ray.origin()[1], ray.origin()[2]};
+    const T inverse[3] = {ray.inverse_direction()[0], ray.inverse_direction()[1], ray.inverse_direction()[2]};
+    const T lower[3] = {box.lower()[0], box.lower()[1], box.lower()[2]};
+    const T upper[3] = {box.upper()[0], box.upper()[1], box.upper()[2]};
+    return detail::slab(origin, inverse, lower, upper, t_min, t_max);
+}
+
+/**
+ * Intersect the ray with the triangle `(a, b, c)` from both sides (the
+ * Möller–Trumbore algorithm).
+ *
+ * @return The hit in `[t_min, t_max]`, or the hit at `+inf` when missed.
+ */
+template <std::floating_point T>
+constexpr Hit<T> intersect(const Ray<T>& ray, const Vector<3, T>& a, const Vector<3, T>& b, const Vector<3, T>& c,
+                           T t_min = T{0}, T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const T o[3] = {ray.origin()[0], ray.origin()[1], ray.origin()[2]};
+    const T d[3] = {ray.direction()[0], ray.direction()[1], ray.direction()[2]};
+    const T vertex[3] = {a[0], a[1], a[2]};
+    const T e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const T e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    Hit<T> result;
+    detail::triangle(o, d, vertex, e1, e2, t_min, t_max, result.distance, result.u, result.v);
+    return result;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                  PACKETS                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The `W` rays stored as the lanes of their components.
+ *
+ * @tparam T The scalar type.
+ * @tparam W The number of rays, 4 or 8 fill a SIMD register of floats.
+ */
+template <std::floating_point T, std::size_t W>
+struct RayPacket
+{
+    static constexpr std::size_t width = W;
+
+    alignas(W * sizeof(T)) T origin[3][W] = {};
+    alignas(W * sizeof(T)) T direction[3][W] = {};
+    alignas(W * sizeof(T)) T inverse[3][W] = {};
+
+    constexpr RayPacket() noexcept = default;
+
+    /**
+     * Constructor scattering the rays into the lanes.
+     */
+    constexpr explicit RayPacket(std::span<const Ray<T>, W> rays) noexcept {
+        for (std::size_t i = 0; i < W; ++i) {
+            set(i, rays[i]);
+        }
+    }
+
+    /**
+     * Gather the ray with specified index from the lanes.
+     */
+    constexpr Ray<T> operator [](std::size_t i) const noexcept {
+        assert(i < W);
+        return {{origin[0][i], origin[1][i], origin[2][i]}, {direction[0][i], direction[1][i], direction[2][i]}};
+    }
+
+    /**
+     * Scatter the ray into the lanes at the specified index.
+     */
+    constexpr void set(std::size_t i, const Ray<T>& ray) noexcept {
+        assert(i < W);
+        for (std::size_t k = 0; k < 3; ++k) {
+            origin[k][i] = ray.origin()[k];
+            direction[k][i] = ray.direction()[k];
+            inverse[k][i] = ray.inverse_direction()[k];
+        }
+    }
+};
+
+/**
+ * The `W` boxes stored as the lanes of their corners. The unused lanes hold
+ * the empty boxes, which are never hit.
+ */
+template <std::floating_point T, std::size_t W>
+struct BoxPacket
+{
+    static constexpr std::size_t width = W;
+
+    alignas(W * sizeof(T)) T lower[3][W];
+    alignas(W * sizeof(T)) T upper[3][W];
+
+    constexpr BoxPacket() noexcept {
+        for (std::size_t k = 0; k < 3; ++k) {
+            for (std::size_t i = 0; i < W; ++i) {
+                lower[k][i] = Aabb<3, T>::highest();
+                upper[k][i] = Aabb<3, T>::lowest();
+            }
+        }
+    }
+
+    /**
+     * Constructor scattering the boxes into the lanes.
+     */
+    constexpr explicit BoxPacket(std::span<const Aabb<3, T>> boxes) noexcept : BoxPacket() {
+        assert(boxes.size() <= W);
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            set(i, boxes[i]);
+        }
+    }
+
+    constexpr void set(std::size_t i, const Aabb<3, T>& box) noexcept {
+        assert(i < W);
+        for (std::size_t k = 0; k < 3; ++k) {
+            lower[k][i] = box.lower()[k];
+            upper[k][i] = box.upper()[k];
+        }
+    }
+};
+
+/**
+ * The `W` triangles stored as the lanes of the first vertex and the two
+ * edges from it. The unused lanes hold the degenerate triangles, which are
+ * never hit.
+ */
+template <std::floating_point T, std::size_t W>
+struct TrianglePacket
+{
+    static constexpr std::size_t width = W;
+
+    alignas(W * sizeof(T)) T vertex[3][W] = {};
+    alignas(W * sizeof(T)) T edge1[3][W] = {};
+    alignas(W * sizeof(T)) T edge2[3][W] = {};
+
+    constexpr TrianglePacket() noexcept = default;
+
+    /**
+     * Constructor from the vertices `a0, b0, c0, a1, b1, c1, ...` of at most
+     * `W` triangles.
+     */
+    constexpr explicit TrianglePacket(std::span<const Vector<3, T>> vertices) noexcept {
+        assert(vertices.size() % 3 == 0 && vertices.size() <= 3 * W);
+        for (std::size_t i = 0; i < vertices.size() / 3; ++i) {
+            set(i, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]);
+        }
+    }
+
+    constexpr void set(std::size_t i, const Vector<3, T>& a, const Vector<3, T>& b, const Vector<3, T>& c) noexcept {
+        assert(i < W);
+        for (std::size_t k = 0; k < 3; ++k) {
+            vertex[k][i] = a[k];
+            edge1[k][i] = b[k] - a[k];
+            edge2[k][i] = c[k] - a[k];
+        }
+    }
+};
+
+/**
+ * The intersections of the packet, see `Hit`.
+ */
+template <std::floating_point T, std::size_t W>
+struct HitPacket
+{
+    std::array<T, W> distance;
+    std::array<T, W> u;
+    std::array<T, W> v;
+
+    constexpr Hit<T> operator [](std::size_t i) const noexcept {
+        assert(i < W);
+        return {distance[i], u[i], v[i]};
+    }
+};
+
+namespace detail {
+
+/**
+ * Run the slab test of the lanes, see `simd::slab()` for the operands.
+ */
+template <std::size_t RayStep, std::size_t BoxStep, typename T, std::size_t W>
+constexpr std::array<T, W> slab(const T* const (&origin)[3], const T* const (&inverse)[3],
+                                const T* const (&lower)[3], const T* const (&upper)[3], T t_min, T t_max) noexcept {
+    std::array<T, W> result;
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float> && W % 4 == 0) {
+        if (!std::is_constant_evaluated()) {
+            for (; i < W; i += 4) {
+                simd::slab<RayStep, BoxStep>(origin, inverse, lower, upper, i, t_min, t_max, result.data());
+            }
+        }
+    }
+#endif
+    for (; i < W; ++i) {
+        const T o[3] = {origin[0][i * RayStep], origin[1][i * RayStep], origin[2][i * RayStep]};
+        const T r[3] = {inverse[0][i * RayStep], inverse[1][i * RayStep], inverse[2][i * RayStep]};
+        const T lo[3] = {lower[0][i * BoxStep], lower[1][i * BoxStep], lower[2][i * BoxStep]};
+        const T hi[3] = {upper[0][i * BoxStep], upper[1][i * BoxStep], upper[2][i * BoxStep]};
+        result[i] = slab(o, r, lo, hi, t_min, t_max);
+    }
+    return result;
+}
+
+/**
+ * Run the Möller–Trumbore test of the lanes, see `simd::triangle()` for the
+ * operands.
+ */
+template <std::size_t RayStep, std::size_t TriangleStep, typename T, std::size_t W>
+constexpr HitPacket<T, W> triangle(const T* const (&origin)[3], const T* const (&direction)[3],
+                                   const T* const (&vertex)[3], const T* const (&edge1)[3],
+                                   const T* const (&edge2)[3], T t_min, T t_max) noexcept {
+    HitPacket<T, W> result;
+    std::size_t i = 0;
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float> && W % 4 == 0) {
+        if (!std::is_constant_evaluated()) {
+            for (; i < W; i += 4) {
+                simd::triangle<RayStep, TriangleStep>(origin, direction, vertex, edge1, edge2, i, t_min, t_max,
+                                                      result.distance.data(), result.u.data(), result.v.data());
+            }
+        }
+    }
+#endif
+    for (; i < W; ++i) {
+        const T o[3] = {origin[0][i * RayStep], origin[1][i * RayStep], origin[2][i * RayStep]};
+        const T d[3] = {direction[0][i * RayStep], direction[1][i * RayStep], direction[2][i * RayStep]};
+        const T a[3] = {vertex[0][i * TriangleStep], vertex[1][i * TriangleStep], vertex[2][i * TriangleStep]};
+        const T e1[3] = {edge1[0][i * TriangleStep], edge1[1][i * TriangleStep], edge1[2][i * TriangleStep]};
+        const T e2[3] = {edge2[0][i * TriangleStep], edge2[1][i * TriangleStep], edge2[2][i * TriangleStep]};
+        triangle(o, d, a, e1, e2, t_min, t_max, result.distance[i], result.u[i], result.v[i]);
+    }
+    return result;
+}
+
+/**
+ * The rows of a single vector, broadcast to the lanes by the step 0.
+ */
+template <typename T>
+struct Rows
+{
+    T values[3];
+    const T* const rows[3] = {values, values + 1, values + 2};
+};
+
+} // namespace detail
+
+/**
+ * Intersect the `W` rays with one box, see the single-ray `intersect()`.
+ */
+template <std::floating_point T, std::size_t W>
+constexpr std::array<T, W> intersect(const RayPacket<T, W>& rays, const Aabb<3, T>& box, T t_min = T{0},
+                                     T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const detail::Rows<T> lower = {{box.lower()[0], box.lower()[1], box.lower()[2]}};
+    const detail::Rows<T> upper = {{box.upper()[0], box.upper()[1], box.upper()[2]}};
+    const T* const origin[3] = {rays.origin[0], rays.origin[1], rays.origin[2]};
+    const T* const inverse[3] = {rays.inverse[0], rays.inverse[1], rays.inverse[2]};
+    return detail::slab<1, 0, T, W>(origin, inverse, lower.rows, upper.rows, t_min, t_max);
+}
+
+/**
+ * Intersect one ray with the `W` boxes, see the single-ray `intersect()`.
+ */
+template <std::floating_point T, std::size_t W>
+constexpr std::array<T, W> intersect(const Ray<T>& ray, const BoxPacket<T, W>& boxes, T t_min = T{0},
+                                     T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const detail::Rows<T> origin = {{ray.origin()[0], ray.origin()[1], ray.origin()[2]}};
+    const detail::Rows<T> inverse = {{ray.inverse_direction()[0], ray.inverse_direction()[1], ray.inverse_direction()[2]}};
+    const T* const lower[3] = {boxes.lower[0], boxes.lower[1], boxes.lower[2]};
+    const T* const upper[3] = {boxes.upper[0], boxes.upper[1], boxes.upper[2]};
+    return detail::slab<0, 1, T, W>(origin.rows, inverse.rows, lower, upper, t_min, t_max);
+}
+
+/**
+ * Intersect the `W` rays with one triangle, see the single-ray `intersect()`.
+ */
+template <std::floating_point T, std::size_t W>
+constexpr HitPacket<T, W> intersect(const RayPacket<T, W>& rays, const Vector<3, T>& a, const Vector<3, T>& b,
+                                    const Vector<3, T>& c, T t_min = T{0},
+                                    T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const detail::Rows<T> vertex = {{a[0], a[1], a[2]}};
+    const detail::Rows<T> edge1 = {{b[0] - a[0], b[1] - a[1], b[2] - a[2]}};
+    const detail::Rows<T> edge2 = {{c[0] - a[0], c[1] - a[1], c[2] - a[2]}};
+    const T* const origin[3] = {rays.origin[0], rays.origin[1], rays.origin[2]};
+    const T* const direction[3] = {rays.direction[0], rays.direction[1], rays.direction[2]};
+    return detail::triangle<1, 0, T, W>(origin, direction, vertex.rows, edge1.rows, edge2.rows, t_min, t_max);
+}
+
+/**
+ * Intersect one ray with the `W` triangles, see the single-ray `intersect()`.
+ */
+template <std::floating_point T, std::size_t W>
+constexpr HitPacket<T, W> intersect(const Ray<T>& ray, const TrianglePacket<T, W>& triangles, T t_min = T{0},
+                                    T t_max = std::numeric_limits<T>::infinity()) noexcept {
+    const detail::Rows<T> origin = {{ray.origin()[0], ray.origin()[1], ray.origin()[2]}};
+    const detail::Rows<T> direction = {{ray.direction()[0], ray.direction()[1], ray.direction()[2]}};
+    const T* const vertex[3] = {triangles.vertex[0], triangles.vertex[1], triangles.vertex[2]};
+    const T* const edge1[3] = {triangles.edge1[0], triangles.edge1[1], triangles.edge1[2]};
+    const T* const edge2[3] = {triangles.edge2[0], triangles.edge2[1], triangles.edge2[2]};
+    return detail::triangle<0, 1, T, W>(origin.rows, direction.rows, vertex, edge1, edge2, t_min, t_max);
+}
+
+} // namespace
+
+#endif // guard
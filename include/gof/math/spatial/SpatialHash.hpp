@@ -0,0 +1,284 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef SPATIAL_HASH_HEADER_GUARD
+#define SPATIAL_HASH_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gof/math/common.hpp> // hash_combine
+#include <gof/math/memory.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * Welding of the vertices.
+ *
+ * The points are quantised to the cells of a uniform grid and the cells are
+ * stored in the hash table with open addressing. The points of one cell form
+ * a linked list in the flat arrays, so the whole structure is a few
+ * contiguous buffers and the deduplication of `n` points takes `O(n)` time.
+ */
+
+namespace gof {
+
+/**
+ * The set of points where no two points are closer than the tolerance.
+ *
+ * The cell of the grid is larger than twice the tolerance, so the point
+ * within the tolerance lies in the cell of the query or in the neighbour
+ * nearer to it along each axis, i.e. `2^N` cells are searched.
+ *
+ * @tparam N The number of components.
+ * @tparam T The scalar type.
+ * @tparam Allocator The allocator of the buffers (rebound to their types).
+ */
+template <std::size_t N, std::floating_point T, typename Allocator = std::allocator<std::byte>>
+class SpatialHash
+{
+  public:
+
+    using allocator_type = Allocator;
+
+    /**
+     * The index returned when there is no point.
+     */
+    static constexpr std::uint32_t npos = ~std::uint32_t{0};
+
+    /**
+     * Constructor creating the empty set.
+     *
+     * @param tolerance The largest distance of the points welded together,
+     *        zero welds only the equal points.
+     * @param capacity The expected number of the points.
+     */
+    explicit SpatialHash(T tolerance, std::size_t capacity = 0, const Allocator& allocator = Allocator())
+        : _tolerance(tolerance)
+        , _inverse(T{1} / (tolerance > T{0} ? T{3} * tolerance : T{1}))
+        , _slots(allocator)
+        , _points(allocator)
+        , _next(allocator) {
+        assert(tolerance >= T{0});
+        reserve(capacity);
+    }
+
+    // GETTERS
+
+    constexpr T tolerance() const noexcept { return _tolerance; }
+
+    constexpr std::size_t size() const noexcept { return _points.size(); }
+
+    constexpr bool empty() const noexcept { return _points.empty(); }
+
+    allocator_type get_allocator() const { return allocator_type(_points.get_allocator()); }
+
+    /**
+     * Get the view of the stored points in the order of their insertion.
+     */
+    std::span<const Vector<N, T>> points() const noexcept { return _points; }
+
+    /**
+     * Find the first inserted point within the tolerance of `point`.
+     *
+     * @return The index of the point or `npos`.
+     */
+    std::uint32_t find(const Vector<N, T>& point) const noexcept {
+        return find(point, quantize(point));
+    }
+
+    // SETTERS
+
+    /**
+     * Insert the point unless there is a point within the tolerance.
+     *
+     * @return The index of the point found by `find()` and `false`, or the
+     *         index of the inserted point and `true`.
+     */
+    std::pair<std::uint32_t, bool> insert(const Vector<N, T>& point) {
+        const Key key = quantize(point);
+        const std::uint32_t found = find(point, key);
+        if (found != npos) {
+            return {found, false};
+        }
+        if (2 * (_cells + 1) > _slots.size()) {
+            rehash(std::max<std::size_t>(2 * _slots.size(), 16));
+        }
+        Slot& slot = _slots[probe(key.cell)];
+        if (slot.head == npos) {
+            slot.cell = key.cell;
+            ++_cells;
+        }
+        const auto index = static_cast<std::uint32_t>(_points.size());
+        assert(index != npos);
+        _points.push_back(point);
+        _next.push_back(slot.head);
+        slot.head = index;
+        return {index, true};
+    }
+
+    /**
+     * Allocate the storage for `count` points.
+     */
+    void reserve(std::size_t count) {
+        _points.reserve(count);
+        _next.reserve(count);
+        if (2 * count > _slots.size()) {
+            rehash(std::bit_ceil(std::max<std::size_t>(2 * count, 16)));
+        }
+    }
+
+    void clear() noexcept {
+        _points.clear();
+        _next.clear();
+        std::fill(_slots.begin(), _slots.end(), Slot{});
+        _cells = 0;
+    }
+
+    /**
+     * Move the stored points out, the set is left empty.
+     */
+    detail::rebind_vector<Vector<N, T>, Allocator> release() noexcept {
+        detail::rebind_vector<Vector<N, T>, Allocator> result = std::move(_points);
+        clear();
+        return result;
+    }
+
+  private:
+
+    using Cell = std::array<std::int32_t, N>;
+
+    /**
+     * The cell of the point and the direction of the nearer neighbour.
+     */
+    struct Key
+    {
+        Cell cell;
+        Cell side;
+    };
+
+    struct Slot
+    {
+        Cell cell{};
+        std::uint32_t head = npos;
+    };
+
+    Key quantize(const Vector<N, T>& point) const noexcept {
+        // The coordinates far from the origin (and NaN) are clamped, so the
+        // conversion to the integer is always defined.
+        constexpr T limit = T(1 << 30);
+        Key key;
+        for (std::size_t k = 0; k < N; ++k) {
+            T q = point[k] * _inverse;
+            q = q >= limit ? limit : (q > -limit ? q : -limit);
+            const T floor = std::floor(q);
+            key.cell[k] = static_cast<std::int32_t>(floor);
+            key.side[k] = q - floor < T(0.5) ? -1 : 1;
+        }
+        return key;
+    }
+
+    std::uint32_t find(const Vector<N, T>& point, const Key& key) const noexcept {
+        if (_points.empty()) {
+            return npos;
+        }
+        const T limit = _tolerance * _tolerance;
+        // The equal points are always in the same cell.
+        const std::size_t corners = _tolerance > T{0} ? std::size_t{1} << N : 1;
+        std::uint32_t result = npos;
+        for (std::size_t corner = 0; corner < corners; ++corner) {
+            Cell cell = key.cell;
+            for (std::size_t k = 0; k < N; ++k) {
+                if (corner & (std::size_t{1} << k)) {
+                    cell[k] += key.side[k];
+                }
+            }
+            const Slot& slot = _slots[probe(cell)];
+            for (std::uint32_t i = slot.head; i != npos; i = _next[i]) {
+                if (i < result && (point - _points[i]).length_squared() <= limit) {
+                    result = i;
+                }
+            }
+        }
+        return result;
+    }
+
+    static std::uint64_t hash(const Cell& cell) noexcept {
+        std::uint64_t h = 0;
+        for (std::size_t k = 0; k < N; ++k) {
+            h = hash_combine(h, static_cast<std::uint32_t>(cell[k]));
+        }
+        return h;
+    }
+
+    /**
+     * Find the slot of the cell, or the empty slot where it belongs.
+     */
+    std::size_t probe(const Cell& cell) const noexcept {
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t i = hash(cell) & mask;
+        while (_slots[i].head != npos && _slots[i].cell != cell) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(std::size_t count) {
+        detail::rebind_vector<Slot, Allocator> old(count, _slots.get_allocator());
+        old.swap(_slots);
+        for (const Slot& slot : old) {
+            if (slot.head != npos) {
+                _slots[probe(slot.cell)] = slot;
+            }
+        }
+    }
+
+    T _tolerance;
+    T _inverse;
+    detail::rebind_vector<Slot, Allocator> _slots;
+    detail::rebind_vector<Vector<N, T>, Allocator> _points;
+    detail::rebind_vector<std::uint32_t, Allocator> _next;
+    std::size_t _cells = 0;
+};
+
+/**
+ * Weld the vertices closer than the tolerance.
+ *
+ * Each vertex is replaced by the first unique vertex within the tolerance,
+ * so the result does not depend on the hashing.
+ *
+ * @param vertices The vertices of the mesh.
+ * @param tolerance The largest distance of the welded vertices.
+ * @param remap The index of the unique vertex of each vertex.
+ * @return The unique vertices.
+ */
+template <std::size_t N, std::floating_point T>
+std::vector<Vector<N, T>> weld(std::span<const Vector<N, T>> vertices, T tolerance, std::span<std::uint32_t> remap) {
+    assert(vertices.size() == remap.size());
+    SpatialHash<N, T> unique(tolerance, vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        remap[i] = unique.insert(vertices[i]).first;
+    }
+    return unique.release();
+}
+
+namespace pmr {
+
+template <std::size_t N, std::floating_point T>
+using SpatialHash = gof::SpatialHash<N, T, aligned_allocator<std::byte>>;
+
+} // namespace pmr
+
+} // namespace
+
+#endif // guard
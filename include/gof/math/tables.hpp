@@ -0,0 +1,98 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef TABLES_HEADER_GUARD
+#define TABLES_HEADER_GUARD
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+
+#include <gof/math/common.hpp> // cmath
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/rotation/Quaternion.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+/*
+ * Lookup tables generated at compile time.
+ *
+ * All generators are `constexpr`, so the tables can be baked into the binary
+ * instead of computed at startup
+ *
+ *     constexpr auto directions = fibonacci_sphere<256, float>();
+ *     static constexpr auto steps = rotation_table<16, float>(Vector3f::unit_z());
+ */
+
+namespace gof {
+
+/**
+ * The `Count` unit vectors spread evenly over the sphere (the Fibonacci
+ * lattice), e.g. the sample directions for ambient occlusion.
+ */
+template <std::size_t Count, std::floating_point T>
+constexpr auto fibonacci_sphere() -> std::array<Vector<3, T>, Count> {
+    // The golden angle `pi (3 - sqrt(5))` between the consecutive points.
+    constexpr T golden_angle = std::numbers::pi_v<T> * (T{3} - cmath::sqrt(T{5}));
+    std::array<Vector<3, T>, Count> result{};
+    for (std::size_t i = 0; i < Count; ++i) {
+        const T z = T{1} - T(2 * i + 1) / T(Count);
+        const T r = cmath::sqrt(T{1} - z * z);
+        const T phi = golden_angle * T(i);
+        result[i] = Vector<3, T>(r * cmath::cos(phi), r * cmath::sin(phi), z);
+    }
+    return result;
+}
+
+/**
+ * The `Count` unit vectors spread evenly over the hemisphere around the `+z`
+ * axis (the Fibonacci lattice).
+ */
+template <std::size_t Count, std::floating_point T>
+constexpr auto fibonacci_hemisphere() -> std::array<Vector<3, T>, Count> {
+    constexpr T golden_angle = std::numbers::pi_v<T> * (T{3} - cmath::sqrt(T{5}));
+    std::array<Vector<3, T>, Count> result{};
+    for (std::size_t i = 0; i < Count; ++i) {
+        const T z = T{1} - T(2 * i + 1) / T(2 * Count);
+        const T r = cmath::sqrt(T{1} - z * z);
+        const T phi = golden_angle * T(i);
+        result[i] = Vector<3, T>(r * cmath::cos(phi), r * cmath::sin(phi), z);
+    }
+    return result;
+}
+
+/**
+ * The `Count` rotation matrices around the unit `axis` by the angles
+ * `2 pi k / Count` for `k = 0 .. Count - 1`.
+ */
+template <std::size_t Count, std::floating_point T, Layout L = Layout::row_major>
+constexpr auto rotation_table(const Vector<3, T>& axis) -> std::array<Matrix<3, 3, T, L>, Count> {
+    std::array<Matrix<3, 3, T, L>, Count> result{};
+    for (std::size_t k = 0; k < Count; ++k) {
+        const T angle = T{2} * std::numbers::pi_v<T> * T(k) / T(Count);
+        result[k] = Quaternion<T>::from_axis_angle(axis, angle).template to_matrix3<L>();
+    }
+    return result;
+}
+
+/**
+ * The orthonormal basis `(tangent, bitangent, normal)` around the unit normal,
+ * as the rows of the matrix (Frisvad's construction with the branch for the
+ * `-z` normal).
+ */
+template <std::floating_point T, Layout L = Layout::row_major>
+constexpr auto orthonormal_basis(const Vector<3, T>& n) -> Matrix<3, 3, T, L> {
+    const T sign = n.z() < T{0} ? T{-1} : T{1};
+    const T a = T{-1} / (sign + n.z());
+    const T b = n.x() * n.y() * a;
+    return {
+        T{1} + sign * n.x() * n.x() * a, sign * b, -sign * n.x(),
+        b, sign + n.y() * n.y() * a, -n.y(),
+        n.x(), n.y(), n.z(),
+    };
+}
+
+} // namespace
+
+#endif // guard
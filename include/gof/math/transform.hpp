@@ -0,0 +1,351 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef TRANSFORM_HEADER_GUARD
+#define TRANSFORM_HEADER_GUARD
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // Number, multiply_add
+#include <gof/math/matrix/Matrix.hpp>
+#include <gof/math/simd.hpp>
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+/*
+ * Batched transformations.
+ *
+ * Apply one 4x4 matrix to many vectors in a single call. The input and the
+ * output spans must have the same size; the output may be the input.
+ *
+ * The results are bit-identical to `m * Vector4(x, y, z, 1)` (followed by the
+ * homogeneous divide) for the points and `m * Vector4(x, y, z, 0)` without the
+ * last column for the directions.
+ */
+
+namespace gof {
+
+/**
+ * How the results are written to memory.
+ */
+enum class Store
+{
+    cached,    ///< The regular stores, the results stay in the cache.
+    streaming, ///< The non-temporal stores bypassing the cache, for outputs
+               ///< that are not read again soon. Taken by `transform()` of
+               ///< the 4-vectors and by the overloads over the lanes, used
+               ///< where the output is 16-byte aligned, otherwise the regular
+               ///< stores are used.
+};
+
+namespace detail {
+
+/**
+ * Whenever the matrix has the last row `(0, 0, 0, 1)`, so `w` stays one and
+ * the homogeneous divide can be skipped.
+ */
+template <Number T, Layout L>
+constexpr bool is_affine(const Matrix<4, 4, T, L>& m) noexcept {
+    return m(3, 0) == T{0} && m(3, 1) == T{0} && m(3, 2) == T{0} && m(3, 3) == T{1};
+}
+
+template <Number T, Layout L>
+constexpr Vector<4, T> transform_point(const Matrix<4, 4, T, L>& m, const T* p) noexcept {
+    Vector<4, T> r;
+    for (std::size_t i = 0; i < 4; ++i) {
+        T e = m(i, 0) * p[0];
+        e = multiply_add(m(i, 1), p[1], e);
+        e = multiply_add(m(i, 2), p[2], e);
+        r.data()[i] = e + m(i, 3);
+    }
+    return r;
+}
+
+#if GOF_MATH_HAS_SSE
+
+/**
+ * The columns of the matrix in SIMD registers.
+ */
+struct Columns
+{
+    __m128 c0, c1, c2, c3;
+
+    template <Layout L>
+    explicit Columns(const Matrix<4, 4, float, L>& m) noexcept {
+        alignas(16) float columns[16];
+        if constexpr(L == Layout::column_major) {
+            std::copy_n(m.data(), 16, columns);
+        } else {
+            simd::transpose4x4(m.data(), columns);
+        }
+        c0 = _mm_load_ps(columns);
+        c1 = _mm_load_ps(columns + 4);
+        c2 = _mm_load_ps(columns + 8);
+        c3 = _mm_load_ps(columns + 12);
+    }
+};
+
+inline bool is_aligned(const void* p, std::size_t alignment) noexcept {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+inline void store3(float* out, __m128 r) noexcept {
+    _mm_storel_pi(reinterpret_cast<__m64*>(out), r);
+    _mm_store_ss(out + 2, _mm_movehl_ps(r, r));
+}
+
+#endif // GOF_MATH_HAS_SSE
+
+} // namespace detail
+
+
+/*----------------------------------------------------------------------------*/
+/*                             ARRAY OF VECTORS                               */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Transform the points `out[i] = m * in[i]` including the homogeneous divide.
+ *
+ * The divide is skipped for the affine matrices.
+ */
+template <Number T, Layout L>
+void transform_points(const Matrix<4, 4, T, L>& m, std::span<const Vector<3, T>> in,
+                      std::span<Vector<3, T>> out) noexcept {
+    assert(in.size() == out.size());
+    const bool affine = detail::is_affine(m);
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        const detail::Columns c(m);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            const float* p = in[i].data();
+            __m128 r = _mm_mul_ps(c.c0, _mm_set1_ps(p[0]));
+            r = simd::multiply_add(c.c1, _mm_set1_ps(p[1]), r);
+            r = simd::multiply_add(c.c2, _mm_set1_ps(p[2]), r);
+            r = _mm_add_ps(r, c.c3);
+            if (!affine) {
+                r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+            detail::store3(out[i].data(), r);
+        }
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const auto r = detail::transform_point(m, in[i].data());
+        if (affine) {
+            out[i] = {r.x(), r.y(), r.z()};
+        } else {
+            out[i] = {r.x() / r.w(), r.y() / r.w(), r.z() / r.w()};
+        }
+    }
+}
+
+/**
+ * Transform the directions `out[i] = m * in[i]` i.e. without the translation.
+ */
+template <Number T, Layout L>
+void transform_directions(const Matrix<4, 4, T, L>& m, std::span<const Vector<3, T>> in,
+                          std::span<Vector<3, T>> out) noexcept {
+    assert(in.size() == out.size());
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        const detail::Columns c(m);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            const float* p = in[i].data();
+            __m128 r = _mm_mul_ps(c.c0, _mm_set1_ps(p[0]));
+            r = simd::multiply_add(c.c1, _mm_set1_ps(p[1]), r);
+            r = simd::multiply_add(c.c2, _mm_set1_ps(p[2]), r);
+            detail::store3(out[i].data(), r);
+        }
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const T* p = in[i].data();
+        T r[3];
+        for (std::size_t k = 0; k < 3; ++k) {
+            r[k] = multiply_add(m(k, 2), p[2], multiply_add(m(k, 1), p[1], m(k, 0) * p[0]));
+        }
+        out[i] = {r[0], r[1], r[2]};
+    }
+}
+
+/**
+ * Transform the homogeneous vectors `out[i] = m * in[i]`.
+ */
+template <Number T, Layout L>
+void transform(const Matrix<4, 4, T, L>& m, std::span<const Vector<4, T>> in,
+               std::span<Vector<4, T>> out, Store store = Store::cached) noexcept {
+    assert(in.size() == out.size());
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        const detail::Columns c(m);
+        const bool streaming = store == Store::streaming && detail::is_aligned(out.data(), 16) &&
+                               sizeof(Vector<4, float>) == 16;
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            const __m128 r = simd::transform4(c.c0, c.c1, c.c2, c.c3, in[i].data());
+            if (streaming) {
+                _mm_stream_ps(out[i].data(), r);
+            } else {
+                _mm_storeu_ps(out[i].data(), r);
+            }
+        }
+        if (streaming) {
+            _mm_sfence();
+        }
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = m * in[i];
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                              ARRAY OF LANES                                */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Transform the points stored in lanes, see `transform_points()` above.
+ */
+template <Number T, Layout L, typename A>
+void transform_points(const Matrix<4, 4, T, L>& m, const VectorArray<3, T, A>& in,
+                      VectorArray<3, T, A>& out, Store store = Store::cached) noexcept {
+    assert(in.size() == out.size());
+    const bool affine = detail::is_affine(m);
+    const T* x = in.lane(0).data();
+    const T* y = in.lane(1).data();
+    const T* z = in.lane(2).data();
+    T* o[3] = {out.lane(0).data(), out.lane(1).data(), out.lane(2).data()};
+    std::size_t first = 0;
+
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        // The lanes are aligned (see `VectorArray`), so four points are
+        // transformed at once and streamed directly to the output lanes.
+        if (store == Store::streaming && detail::is_aligned(o[0], 16) &&
+            detail::is_aligned(o[1], 16) && detail::is_aligned(o[2], 16)) {
+            __m128 w = _mm_set1_ps(1.0f);
+            for (; first + 4 <= in.size(); first += 4) {
+                const __m128 px = _mm_loadu_ps(x + first);
+                const __m128 py = _mm_loadu_ps(y + first);
+                const __m128 pz = _mm_loadu_ps(z + first);
+                if (!affine) {
+                    w = _mm_mul_ps(_mm_set1_ps(m(3, 0)), px);
+                    w = simd::multiply_add(_mm_set1_ps(m(3, 1)), py, w);
+                    w = simd::multiply_add(_mm_set1_ps(m(3, 2)), pz, w);
+                    w = _mm_add_ps(w, _mm_set1_ps(m(3, 3)));
+                }
+                for (std::size_t k = 0; k < 3; ++k) {
+                    __m128 r = _mm_mul_ps(_mm_set1_ps(m(k, 0)), px);
+                    r = simd::multiply_add(_mm_set1_ps(m(k, 1)), py, r);
+                    r = simd::multiply_add(_mm_set1_ps(m(k, 2)), pz, r);
+                    r = _mm_add_ps(r, _mm_set1_ps(m(k, 3)));
+                    if (!affine) {
+                        r = _mm_div_ps(r, w);
+                    }
+                    _mm_stream_ps(o[k] + first, r);
+                }
+            }
+            _mm_sfence();
+        }
+    }
+#endif
+
+    // The plain loops over the lanes are vectorized by the compiler. They
+    // write one lane after another, so they cannot work in place.
+    if (affine && &in != &out) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            const T m0 = m(k, 0), m1 = m(k, 1), m2 = m(k, 2), m3 = m(k, 3);
+            T* r = o[k];
+            for (std::size_t i = first; i < in.size(); ++i) {
+                r[i] = multiply_add(m2, z[i], multiply_add(m1, y[i], m0 * x[i])) + m3;
+            }
+        }
+    } else {
+        for (std::size_t i = first; i < in.size(); ++i) {
+            const T p[3] = {x[i], y[i], z[i]};
+            const auto r = detail::transform_point(m, p);
+            if (affine) {
+                o[0][i] = r.x();
+                o[1][i] = r.y();
+                o[2][i] = r.z();
+            } else {
+                o[0][i] = r.x() / r.w();
+                o[1][i] = r.y() / r.w();
+                o[2][i] = r.z() / r.w();
+            }
+        }
+    }
+}
+
+/**
+ * Transform the directions stored in lanes, see `transform_directions()` above.
+ */
+template <Number T, Layout L, typename A>
+void transform_directions(const Matrix<4, 4, T, L>& m, const VectorArray<3, T, A>& in,
+                          VectorArray<3, T, A>& out, Store store = Store::cached) noexcept {
+    assert(in.size() == out.size());
+    const T* x = in.lane(0).data();
+    const T* y = in.lane(1).data();
+    const T* z = in.lane(2).data();
+    T* o[3] = {out.lane(0).data(), out.lane(1).data(), out.lane(2).data()};
+    std::size_t first = 0;
+
+#if GOF_MATH_HAS_SSE
+    if constexpr(std::is_same_v<T, float>) {
+        // Four directions are read before their results are streamed, so
+        // this works in place as well.
+        if (store == Store::streaming && detail::is_aligned(o[0], 16) &&
+            detail::is_aligned(o[1], 16) && detail::is_aligned(o[2], 16)) {
+            for (; first + 4 <= in.size(); first += 4) {
+                const __m128 dx = _mm_loadu_ps(x + first);
+                const __m128 dy = _mm_loadu_ps(y + first);
+                const __m128 dz = _mm_loadu_ps(z + first);
+                __m128 r[3];
+                for (std::size_t k = 0; k < 3; ++k) {
+                    r[k] = _mm_mul_ps(_mm_set1_ps(m(k, 0)), dx);
+                    r[k] = simd::multiply_add(_mm_set1_ps(m(k, 1)), dy, r[k]);
+                    r[k] = simd::multiply_add(_mm_set1_ps(m(k, 2)), dz, r[k]);
+                }
+                for (std::size_t k = 0; k < 3; ++k) {
+                    _mm_stream_ps(o[k] + first, r[k]);
+                }
+            }
+            _mm_sfence();
+        }
+    }
+#endif
+
+    // The components are computed into the output one lane after another,
+    // so the input must not be overwritten before it is read.
+    if (&in == &out) {
+        for (std::size_t i = first; i < in.size(); ++i) {
+            const Vector<3, T> d(x[i], y[i], z[i]);
+            T r[3];
+            for (std::size_t k = 0; k < 3; ++k) {
+                r[k] = multiply_add(m(k, 2), d.z(), multiply_add(m(k, 1), d.y(), m(k, 0) * d.x()));
+            }
+            out.set(i, {r[0], r[1], r[2]});
+        }
+        return;
+    }
+    for (std::size_t k = 0; k < 3; ++k) {
+        const T m0 = m(k, 0), m1 = m(k, 1), m2 = m(k, 2);
+        T* r = o[k];
+        for (std::size_t i = first; i < in.size(); ++i) {
+            r[i] = multiply_add(m2, z[i], multiply_add(m1, y[i], m0 * x[i]));
+        }
+    }
+}
+
+} // namespace
+
+#endif // guard
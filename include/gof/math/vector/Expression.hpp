@@ -0,0 +1,233 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef EXPRESSION_HEADER_GUARD
+#define EXPRESSION_HEADER_GUARD
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include <gof/math/common.hpp> // Number, Expression
+#include <gof/math/vector/Vector.hpp>
+#include <gof/math/vector/VectorArray.hpp>
+
+/*
+ * Expression templates.
+ *
+ * The arithmetic on `Vector` is eager: `a + s * b - c` creates a temporary per
+ * operator. Wrapping any operand with `lazy()` turns the whole expression into
+ * a tree of lightweight nodes, which is evaluated component by component when
+ * it is assigned to a `Vector` or to a `VectorArray` (`assign()`)
+ *
+ *     Vector3f r = lazy(a) + s * lazy(b) - c;
+ *     positions.assign(lazy(positions) + dt * lazy(velocities));
+ *
+ * The nodes hold references to their operands, so the expression must be
+ * evaluated within the same full expression (do not store it in `auto`).
+ */
+
+namespace gof {
+
+/*----------------------------------------------------------------------------*/
+/*                                   LEAVES                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The leaf referring to a single vector. It is broadcast over bulk data.
+ */
+template <std::size_t N, Number T>
+struct VectorLeaf : expression_tag
+{
+    using scalar_type = T;
+    static constexpr std::size_t dimension = N;
+
+    const Vector<N, T>& vector;
+
+    constexpr T at(std::size_t k, std::size_t) const noexcept { return vector.data()[k]; }
+    constexpr std::size_t count() const noexcept { return 0; }
+};
+
+/**
+ * The leaf referring to the lanes of a vector array.
+ */
+template <std::size_t N, Number T, typename Allocator>
+struct VectorArrayLeaf : expression_tag
+{
+    using scalar_type = T;
+    static constexpr std::size_t dimension = N;
+
+    const VectorArray<N, T, Allocator>& array;
+
+    constexpr T at(std::size_t k, std::size_t i) const noexcept { return array.lane(k).data()[i]; }
+    constexpr std::size_t count() const noexcept { return array.size(); }
+};
+
+/**
+ * The leaf holding a scalar. Its dimension is zero i.e. it is broadcast to all
+ * components.
+ */
+template <Number T>
+struct ScalarLeaf : expression_tag
+{
+    using scalar_type = T;
+    static constexpr std::size_t dimension = 0;
+
+    T value;
+
+    constexpr T at(std::size_t, std::size_t) const noexcept { return value; }
+    constexpr std::size_t count() const noexcept { return 0; }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   NODES                                    */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The node applying the binary operation component-wise.
+ */
+template <typename Operation, Expression L, Expression R>
+struct BinaryNode : expression_tag
+{
+    static_assert(std::is_same_v<typename L::scalar_type, typename R::scalar_type>,
+                  "The operands must have the same scalar type.");
+    static_assert(L::dimension == R::dimension || L::dimension == 0 || R::dimension == 0,
+                  "The operands must have the same number of components.");
+
+    using scalar_type = typename L::scalar_type;
+    static constexpr std::size_t dimension = std::max(L::dimension, R::dimension);
+
+    L lhs;
+    R rhs;
+
+    constexpr scalar_type at(std::size_t k, std::size_t i) const noexcept {
+        return Operation{}(lhs.at(k, i), rhs.at(k, i));
+    }
+
+    constexpr std::size_t count() const noexcept { return std::max(lhs.count(), rhs.count()); }
+};
+
+/**
+ * The node applying the unary operation component-wise.
+ */
+template <typename Operation, Expression E>
+struct UnaryNode : expression_tag
+{
+    using scalar_type = typename E::scalar_type;
+    static constexpr std::size_t dimension = E::dimension;
+
+    E operand;
+
+    constexpr scalar_type at(std::size_t k, std::size_t i) const noexcept {
+        return Operation{}(operand.at(k, i));
+    }
+
+    constexpr std::size_t count() const noexcept { return operand.count(); }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                  FACTORY                                   */
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Start the lazily evaluated expression with the vector.
+ */
+template <std::size_t N, Number T>
+constexpr auto lazy(const Vector<N, T>& vector) noexcept -> VectorLeaf<N, T> {
+    return {{}, vector};
+}
+
+/**
+ * Start the lazily evaluated expression with the vector array.
+ */
+template <std::size_t N, Number T, typename Allocator>
+constexpr auto lazy(const VectorArray<N, T, Allocator>& array) noexcept -> VectorArrayLeaf<N, T, Allocator> {
+    return {{}, array};
+}
+
+template <Expression E>
+constexpr auto lazy(const E& expression) noexcept -> E {
+    return expression;
+}
+
+template <typename T>
+concept LazyOperand = requires(const T& x) { { lazy(x) } -> Expression; };
+
+/*----------------------------------------------------------------------------*/
+/*                                 OPERATORS                                  */
+/*----------------------------------------------------------------------------*/
+
+// The operators are enabled when at least one operand is an expression, the
+// plain `Vector` operators stay eager.
+
+/**
+ * The binary operator `+` of two expressions.
+ */
+template <LazyOperand L, LazyOperand R>
+    requires (Expression<L> || Expression<R>)
+constexpr auto operator +(const L& lhs, const R& rhs) noexcept {
+    using Left = decltype(lazy(lhs));
+    using Right = decltype(lazy(rhs));
+    return BinaryNode<std::plus<>, Left, Right>{{}, lazy(lhs), lazy(rhs)};
+}
+
+/**
+ * The binary operator `-` of two expressions.
+ */
+template <LazyOperand L, LazyOperand R>
+    requires (Expression<L> || Expression<R>)
+constexpr auto operator -(const L& lhs, const R& rhs) noexcept {
+    using Left = decltype(lazy(lhs));
+    using Right = decltype(lazy(rhs));
+    return BinaryNode<std::minus<>, Left, Right>{{}, lazy(lhs), lazy(rhs)};
+}
+
+/**
+ * The unary operator `- expression`.
+ */
+template <Expression E>
+constexpr auto operator -(const E& self) noexcept {
+    return UnaryNode<std::negate<>, E>{{}, self};
+}
+
+/**
+ * The binary operator `scalar * expression`.
+ */
+template <Expression E>
+constexpr auto operator *(typename E::scalar_type const& scalar, const E& self) noexcept {
+    using S = ScalarLeaf<typename E::scalar_type>;
+    return BinaryNode<std::multiplies<>, S, E>{{}, S{{}, scalar}, self};
+}
+
+/**
+ * The binary operator `expression * scalar`.
+ */
+template <Expression E>
+constexpr auto operator *(const E& self, typename E::scalar_type const& scalar) noexcept {
+    using S = ScalarLeaf<typename E::scalar_type>;
+    return BinaryNode<std::multiplies<>, E, S>{{}, self, S{{}, scalar}};
+}
+
+/**
+ * The binary operator `expression / scalar`.
+ */
+template <Expression E>
+constexpr auto operator /(const E& self, typename E::scalar_type const& scalar) noexcept {
+    using S = ScalarLeaf<typename E::scalar_type>;
+    return BinaryNode<std::divides<>, E, S>{{}, self, S{{}, scalar}};
+}
+
+/**
+ * Evaluate the expression into a new vector.
+ */
+template <Expression E>
+    requires (E::dimension > 0)
+constexpr auto eval(const E& expression) -> Vector<E::dimension, typename E::scalar_type> {
+    return expression;
+}
+
+} // namespace
+
+#endif // guard
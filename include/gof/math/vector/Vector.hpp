@@ -22,11 +22,17 @@
 
 #include <array>
 #include <algorithm> // min/max
+#include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <functional> // hash
+#include <span>
 #include <type_traits>
 #include <complex>
 
 #include <gof/math/common.hpp> // Number
+#include <gof/math/simd.hpp>
 
 namespace gof {
 
@@ -48,29 +54,50 @@ class Vector
 {
     using self = Vector<N, T>;
 
-    Vector() = delete;
-
   public:
 
     static constexpr std::size_t size = N;
 
+    /**
+     * Default constructor creating the zero vector.
+     *
+     * This allows the vector to be stored in bulk containers such as
+     * `std::vector` which value-initialize their elements.
+     */
+    constexpr Vector() noexcept : _v{} { }
+
     /**
      * Constructor initializing all components to a single value of type `T`.
      *
-     * Missing values will be filled with zeros.
+     * Missing values will be filled with zeros. More than `N` values are
+     * refused, also when the SIMD storage has the padding lane.
      */
     template <typename... Ts>
+        requires (sizeof...(Ts) <= N)
     constexpr Vector(const Ts &... xs) : _v({{xs...}}) { }
 
     /**
-     *  Copy constructor.
+     * Constructor evaluating the expression template (see `lazy()`).
+     *
+     * All operations of the expression are fused into a single pass over
+     * the components, no intermediate vectors are created.
      */
-    constexpr explicit Vector(const Vector<N, T>& that) : _v({that.values()}) { }
+    template <Expression E>
+        requires (E::dimension == N)
+    constexpr Vector(const E& expression) : _v{} {
+        for (std::size_t k = 0; k < N; ++k) {
+            _v[k] = expression.at(k, 0);
+        }
+    }
 
     /**
-     * Destructor accessible in derived classes.
+     * Copy and move operations are trivial, so arrays of vectors can be
+     * copied with `std::memcpy` and relocated without calling constructors.
      */
-    virtual ~Vector() { }
+    constexpr Vector(const Vector<N, T>& that) noexcept = default;
+    constexpr Vector(Vector<N, T>&& that) noexcept = default;
+    constexpr Vector& operator =(const Vector<N, T>& that) noexcept = default;
+    constexpr Vector& operator =(Vector<N, T>&& that) noexcept = default;
 
     /**
      * Get the value of component #1.
@@ -104,36 +131,114 @@ class Vector
     template <std::size_t Q = N, typename = std::enable_if_t<Q == 4>>
     constexpr T w() const noexcept { return _v[3]; }
 
-    constexpr std::array<T, N> values() const noexcept {
-        return _v;
+    /**
+     * Get the view of the components.
+     *
+     * The view refers to the vector, no components are copied.
+     */
+    constexpr std::span<const T, N> values() const noexcept {
+        return std::span<const T, N>(_v.data(), N);
+    }
+
+    /**
+     * Get the copy of the components.
+     */
+    constexpr std::array<T, N> to_array() const noexcept {
+        std::array<T, N> result{};
+        std::copy_n(_v.begin(), N, result.begin());
+        return result;
+    }
+
+    /**
+     * Get the value of the component with the specified index.
+     */
+    constexpr T operator [](std::size_t index) const noexcept {
+        assert(index < N);
+        return _v[index];
     }
 
+    /**
+     * Iterate over the components (without the padding lanes).
+     */
+    constexpr const T* begin() const noexcept { return _v.data(); }
+
+    constexpr const T* end() const noexcept { return _v.data() + N; }
+
+    /**
+     * Get the pointer to the contiguous storage of the components.
+     *
+     * When the SIMD backend is enabled the storage may contain padding lanes
+     * behind the `N` components.
+     */
+    constexpr const T* data() const noexcept { return _v.data(); }
+
+    constexpr T* data() noexcept { return _v.data(); }
+
     //{ `is_`methods
 
     /**
-     * Check if this is a zero vector.
+     * Check if this is a zero vector, i.e. all components are close to zero.
+     *
+     * @param compare The comparison strategy (see `tolerance`).
      */
-    constexpr bool is_zero() const noexcept {
-        for (const auto &e : values()) {
-            if (e != T{0}) { // TODO Compare with tolerance.
+    template <Tolerance<T> C = tolerance::Default<T>>
+    constexpr bool is_zero(C const& compare = C{}) const noexcept {
+        for (const T& e : *this) {
+            if (!compare(e, T{0})) {
                 return false;
             }
         }
         return true;
     }
 
-    constexpr bool is_unit() const noexcept {
-        return length() == T{1};
-     }
+    /**
+     * Check if this is a unit vector.
+     *
+     * The squared length is compared with one (by `compare.squared()`), so no
+     * square root is computed.
+     */
+    template <Tolerance<T> C = tolerance::Default<T>>
+    constexpr bool is_unit(C const& compare = C{}) const noexcept {
+        return compare.squared()(length_squared(), T{1});
+    }
 
-    constexpr bool is_opposite(Vector<N, T> const& that) const noexcept {
-        for (int i = 0; i < values().size(); ++i) {
-            if (values()[i] != -that.values()[i]) {
+    /**
+     * Check if the vector is close to `-that`.
+     */
+    template <Tolerance<T> C = tolerance::Default<T>>
+    constexpr bool is_opposite(Vector<N, T> const& that, C const& compare = C{}) const noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (!compare(_v[i], -that._v[i])) {
                 return false;
             }
         }
         return true;
-     }
+    }
+
+    /**
+     * Check if all components are close to the components of `that`.
+     *
+     * Unlike `==` this is not transitive, so it is not used for hashing.
+     */
+    template <Tolerance<T> C = tolerance::Default<T>>
+    constexpr bool is_close(Vector<N, T> const& that, C const& compare = C{}) const noexcept {
+        if constexpr(simd::is_enabled<N, T>) {
+            if (!std::is_constant_evaluated()) {
+                if constexpr(std::is_same_v<C, tolerance::Relative<T>>) {
+                    return simd::close<N>(data(), that.data(), compare.relative, compare.absolute);
+                }
+                if constexpr(std::is_same_v<C, tolerance::Absolute<T>>) {
+                    return simd::close<N>(data(), that.data(), T{0}, compare.epsilon);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            if (!compare(_v[i], that._v[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
 
     // constexpr bool is_parallel(that) const noexcept {
         // When scalar product is one the they are parallel.
@@ -152,11 +257,27 @@ class Vector
      * Also known as _length_ or _magnitude_.
      */
     constexpr T length() const noexcept {
-        T result = T{0};
-        for (const auto &e : this->values()) {
-            result += (e * e);
+        if constexpr(simd::is_enabled<N, T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd::length<N>(data());
+            }
+        }
+        if constexpr(std::is_floating_point_v<T>) {
+            return cmath::sqrt(length_squared());
+        } else {
+            // The custom scalar types provide their `sqrt()` found by ADL.
+            using std::sqrt;
+            return sqrt(length_squared());
         }
-        return std::sqrt(result);
+    }
+
+    /**
+     * Calculate the square of the Euclidean norm.
+     *
+     * This is cheaper than `length()`, prefer it when comparing lengths.
+     */
+    constexpr T length_squared() const noexcept {
+        return scalar_product(*this, *this);
     }
 
     /**
@@ -172,7 +293,7 @@ class Vector
 
     // flip
 
-    // rotate(axis, angle) { }
+    // rotate(axis, angle) see `rotate()` in `rotation/Quaternion.hpp`
 
     // rotate_90_cc(axis) {  }
 
@@ -199,20 +320,26 @@ class Vector
      */
     // constexpr is_uniform(T tolerance) { }
 
+    /**
+     * Get the largest component.
+     */
     constexpr T max_value() const noexcept {
-        return std::max(values());
-     }
+        return std::ranges::max(values());
+    }
 
+    /**
+     * Get the smallest component.
+     */
     constexpr T min_value() const noexcept {
-        return std::min(values());
-     }
+        return std::ranges::min(values());
+    }
 
     /**
      * Scale the vector by factor (scalar).
      *
      * This is the same as multiplying vector by scalar with `*` operator.
      */
-    Vector<N, T> scale(T const& scalar) {
+    constexpr Vector<N, T> scale(T const& scalar) const {
         return scalar * (*this);
     }
 
@@ -268,11 +395,17 @@ class Vector
         if constexpr(N == 1) { return { T{1}}; }
         if constexpr(N == 2) { return { T{1}, T{1}}; }
         if constexpr(N == 3) { return { T{1}, T{1}, T{1}}; }
+        if constexpr(N == 4) { return { T{1}, T{1}, T{1}, T{1}}; }
     }
 
   protected:
 
-    const std::array<T, N> _v;
+    /**
+     * The components are stored inline without any vtable so the vector is
+     * trivially copyable and has a standard layout. The storage is padded and
+     * aligned only when the SIMD backend is enabled (see `simd::is_enabled`).
+     */
+    alignas(simd::alignment<N, T>) std::array<T, simd::lanes<N, T>> _v;
 };
 
 
@@ -283,23 +416,93 @@ class Vector
 /**
  * Calculate the scalar product of two vectors.
  *
+ * The products are accumulated in the order of the components with
+ * `multiply_add()`, so the FMA instruction is used when available.
+ *
  * @tparam N
  * @tparam T
  */
 template <std::size_t N, Number T = float>
-constexpr T scalar_product(const Vector<N, T>& lhs, const Vector<N, T>& rhs) {
-    return nullptr;
+constexpr T scalar_product(const Vector<N, T>& lhs, const Vector<N, T>& rhs) noexcept {
+    const T* a = lhs.data();
+    const T* b = rhs.data();
+    if constexpr(N == 1) {
+        return a[0] * b[0];
+    }
+    if constexpr(N == 2) {
+        return multiply_add(a[1], b[1], a[0] * b[0]);
+    }
+    if constexpr(N == 3) {
+        return multiply_add(a[2], b[2], multiply_add(a[1], b[1], a[0] * b[0]));
+    }
+    if constexpr(N == 4) {
+        return multiply_add(a[3], b[3], multiply_add(a[2], b[2], multiply_add(a[1], b[1], a[0] * b[0])));
+    }
+    if constexpr(N > 4) {
+        T result = a[0] * b[0];
+        for (std::size_t i = 1; i < N; ++i) {
+            result = multiply_add(a[i], b[i], result);
+        }
+        return result;
+    }
 }
 
 /**
  * Calculate the vector product of two vectors.
  *
+ * This will compile only for N == 3.
+ *
  * @tparam N
  * @tparam T
  */
 template <std::size_t N, Number T = float>
-constexpr Vector<N, T> vector_product(const Vector<N, T>& lhs, const Vector<N, T>& rhs) {
-    return nullptr;
+    requires (N == 3)
+constexpr Vector<N, T> vector_product(const Vector<N, T>& lhs, const Vector<N, T>& rhs) noexcept {
+    const T* a = lhs.data();
+    const T* b = rhs.data();
+    return {
+        difference_of_products(a[1], b[2], a[2], b[1]),
+        difference_of_products(a[2], b[0], a[0], b[2]),
+        difference_of_products(a[0], b[1], a[1], b[0]),
+    };
+}
+
+/**
+ * Calculate the scalar products of many pairs `out[i] = lhs[i] . rhs[i]`.
+ */
+template <std::size_t N, Number T>
+constexpr void scalar_product(std::span<const Vector<N, T>> lhs, std::span<const Vector<N, T>> rhs,
+                              std::span<T> out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = scalar_product(lhs[i], rhs[i]);
+    }
+}
+
+/**
+ * Calculate the vector products of many pairs `out[i] = lhs[i] x rhs[i]`.
+ */
+template <std::size_t N, Number T>
+    requires (N == 3)
+constexpr void vector_product(std::span<const Vector<N, T>> lhs, std::span<const Vector<N, T>> rhs,
+                              std::span<Vector<N, T>> out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = vector_product(lhs[i], rhs[i]);
+    }
+}
+
+/**
+ * Compare many pairs `out[i] = lhs[i].is_close(rhs[i])`, e.g. to find the
+ * vertices to be welded.
+ */
+template <std::size_t N, Number T, Tolerance<T> C = tolerance::Default<T>>
+constexpr void is_close(std::span<const Vector<N, T>> lhs, std::span<const Vector<N, T>> rhs,
+                        std::span<bool> out, C const& compare = C{}) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = lhs[i].is_close(rhs[i], compare);
+    }
 }
 
 constexpr auto plus(int a, int b) -> decltype(a) {
@@ -315,6 +518,13 @@ constexpr auto plus(int a, int b) -> decltype(a) {
  */
 template <std::size_t N, Number T>
 constexpr Vector<N, T> operator *(T const& scalar, Vector<N, T> const& self) {
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            Vector<N, T> result;
+            simd::scale(scalar, self.data(), result.data());
+            return result;
+        }
+    }
    // Conditional compilation with `constexpr if`.
     if constexpr(N == 1) {
         return {scalar * self.x()};
@@ -328,6 +538,13 @@ constexpr Vector<N, T> operator *(T const& scalar, Vector<N, T> const& self) {
     if constexpr(N == 4) {
         return {scalar * self.x(), scalar * self.y(), scalar * self.z(), scalar * self.w()};
     }
+    if constexpr(N > 4) {
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = scalar * self.data()[i];
+        }
+        return result;
+    }
 }
 
 /**
@@ -335,6 +552,11 @@ constexpr Vector<N, T> operator *(T const& scalar, Vector<N, T> const& self) {
  */
 template <std::size_t N, Number T>
 constexpr bool operator ==(const Vector<N, T>& self, const Vector<N, T>& that) noexcept {
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            return simd::equal<N>(self.data(), that.data());
+        }
+    }
     if constexpr(N == 1) {
         return self.x() == that.x();
     }
@@ -347,6 +569,14 @@ constexpr bool operator ==(const Vector<N, T>& self, const Vector<N, T>& that) n
     if constexpr(N == 4) {
         return self.x() == that.x() && self.y() == that.y() && self.z() == that.z() && self.w() == that.w();
     }
+    if constexpr(N > 4) {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (self.data()[i] != that.data()[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 /**
@@ -362,7 +592,32 @@ constexpr  bool operator !=(const Vector<N, T>& self, const Vector<N, T>& that)
  */
 template <std::size_t N, Number T>
 constexpr Vector<N, T> operator -(Vector<N, T> const& self) {
-    return (-T{1}) * self;
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            Vector<N, T> result;
+            simd::negate(self.data(), result.data());
+            return result;
+        }
+    }
+    if constexpr(N == 1) {
+        return {-self.x()};
+    }
+    if constexpr(N == 2) {
+        return {-self.x(), -self.y()};
+    }
+    if constexpr(N == 3) {
+        return {-self.x(), -self.y(), -self.z()};
+    }
+    if constexpr(N == 4) {
+        return {-self.x(), -self.y(), -self.z(), -self.w()};
+    }
+    if constexpr(N > 4) {
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = -self.data()[i];
+        }
+        return result;
+    }
 }
 
 /**
@@ -370,6 +625,13 @@ constexpr Vector<N, T> operator -(Vector<N, T> const& self) {
  */
 template <std::size_t N, Number T>
 constexpr Vector<N, T> operator +(Vector<N, T> const& self, Vector<N, T> const& that) {
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            Vector<N, T> result;
+            simd::add(self.data(), that.data(), result.data());
+            return result;
+        }
+    }
     if constexpr(N == 1) {
         return {self.x() + that.x()};
     }
@@ -382,6 +644,13 @@ constexpr Vector<N, T> operator +(Vector<N, T> const& self, Vector<N, T> const&
     if constexpr(N == 4) {
         return {self.x() + that.x(), self.y() + that.y(), self.z() + that.z(), self.w() + that.w()};
     }
+    if constexpr(N > 4) {
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = self.data()[i] + that.data()[i];
+        }
+        return result;
+    }
 }
 
 /**
@@ -389,7 +658,32 @@ constexpr Vector<N, T> operator +(Vector<N, T> const& self, Vector<N, T> const&
  */
 template <std::size_t N, Number T>
 constexpr Vector<N, T> operator -(Vector<N, T> const& self, Vector<N, T> const& that) {
-    return self + ( (-T{1}) * that );
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            Vector<N, T> result;
+            simd::sub(self.data(), that.data(), result.data());
+            return result;
+        }
+    }
+    if constexpr(N == 1) {
+        return {self.x() - that.x()};
+    }
+    if constexpr(N == 2) {
+        return {self.x() - that.x(), self.y() - that.y()};
+    }
+    if constexpr(N == 3) {
+        return {self.x() - that.x(), self.y() - that.y(), self.z() - that.z()};
+    }
+    if constexpr(N == 4) {
+        return {self.x() - that.x(), self.y() - that.y(), self.z() - that.z(), self.w() - that.w()};
+    }
+    if constexpr(N > 4) {
+        Vector<N, T> result;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.data()[i] = self.data()[i] - that.data()[i];
+        }
+        return result;
+    }
 }
 
 /**
@@ -400,7 +694,58 @@ constexpr Vector<N, T> operator -(Vector<N, T> const& self, T const& bias) {
     return self - (bias * Vector<N, T>::ones());
 }
 
+/**
+ * The component-wise minimum of two vectors.
+ */
+template <std::size_t N, Number T>
+constexpr Vector<N, T> min(Vector<N, T> const& self, Vector<N, T> const& that) {
+    Vector<N, T> result;
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            simd::min(self.data(), that.data(), result.data());
+            return result;
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        result.data()[i] = std::min(self.data()[i], that.data()[i]);
+    }
+    return result;
+}
+
+/**
+ * The component-wise maximum of two vectors.
+ */
+template <std::size_t N, Number T>
+constexpr Vector<N, T> max(Vector<N, T> const& self, Vector<N, T> const& that) {
+    Vector<N, T> result;
+    if constexpr(simd::is_enabled<N, T>) {
+        if (!std::is_constant_evaluated()) {
+            simd::max(self.data(), that.data(), result.data());
+            return result;
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        result.data()[i] = std::max(self.data()[i], that.data()[i]);
+    }
+    return result;
+}
+
 
 } // namespace
 
+/**
+ * The hash of the vector, consistent with `==`.
+ */
+template <std::size_t N, gof::Number T>
+struct std::hash<gof::Vector<N, T>>
+{
+    std::size_t operator ()(const gof::Vector<N, T>& v) const noexcept {
+        std::uint64_t h = N;
+        for (const T& e : v) {
+            h = gof::hash_combine(h, gof::hash_bits(e));
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
 #endif // guard
@@ -0,0 +1,437 @@
+// -*- c++, utf-8 -*-
+
+#pragma once
+
+#ifndef VECTOR_ARRAY_HEADER_GUARD
+#define VECTOR_ARRAY_HEADER_GUARD
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <gof/math/common.hpp> // Number
+#include <gof/math/memory.hpp>
+#include <gof/math/simd.hpp>
+#include <gof/math/vector/Vector.hpp>
+
+namespace gof {
+
+/**
+ * The array of vectors stored as a structure of arrays (SoA).
+ *
+ * This is the bulk-data counterpart of `Vector<N, T>`. Each component has its
+ * own contiguous lane starting on a cache line, so the batched kernels below
+ * process the lanes with unit stride and the compiler can vectorize them.
+ *
+ * @tparam N The number of components of each vector.
+ * @tparam T The scalar type.
+ * @tparam Allocator The allocator of the lanes.
+ */
+template <std::size_t N, Number T, typename Allocator = aligned_allocator<T>>
+class VectorArray
+{
+  public:
+
+    using value_type = Vector<N, T>;
+    using allocator_type = Allocator;
+
+    /**
+     * The number of components of each vector.
+     */
+    static constexpr std::size_t dimension = N;
+
+    /**
+     * Constructor creating the empty array.
+     */
+    explicit VectorArray(const Allocator& allocator = Allocator()) : _buffer(allocator) { }
+
+    /**
+     * Constructor creating the array of `count` zero vectors.
+     */
+    explicit VectorArray(std::size_t count, const Allocator& allocator = Allocator())
+        : _buffer(allocator) {
+        resize(count);
+    }
+
+    /**
+     * Constructor converting the array of vectors (AoS) into the lanes (SoA).
+     */
+    explicit VectorArray(std::span<const Vector<N, T>> vectors, const Allocator& allocator = Allocator())
+        : _buffer(allocator) {
+        resize(vectors.size());
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            set(i, vectors[i]);
+        }
+    }
+
+    // GETTERS
+
+    constexpr std::size_t size() const noexcept { return _size; }
+
+    constexpr std::size_t capacity() const noexcept { return _stride; }
+
+    constexpr bool empty() const noexcept { return _size == 0; }
+
+    allocator_type get_allocator() const { return _buffer.get_allocator(); }
+
+    /**
+     * Get the contiguous lane of the component `axis` (0 for `x`, 1 for `y`...).
+     */
+    std::span<T> lane(std::size_t axis) noexcept {
+        assert(axis < N);
+        return {_buffer.data() + axis * _stride, _size};
+    }
+
+    std::span<const T> lane(std::size_t axis) const noexcept {
+        assert(axis < N);
+        return {_buffer.data() + axis * _stride, _size};
+    }
+
+    /**
+     * Gather the vector with specified index from the lanes.
+     */
+    Vector<N, T> operator [](std::size_t index) const noexcept {
+        assert(index < _size);
+        Vector<N, T> result;
+        for (std::size_t k = 0; k < N; ++k) {
+            result.data()[k] = _buffer[k * _stride + index];
+        }
+        return result;
+    }
+
+    // SETTERS
+
+    /**
+     * Scatter the vector into the lanes at the specified index.
+     */
+    void set(std::size_t index, const Vector<N, T>& vector) noexcept {
+        assert(index < _size);
+        for (std::size_t k = 0; k < N; ++k) {
+            _buffer[k * _stride + index] = vector.data()[k];
+        }
+    }
+
+    void push_back(const Vector<N, T>& vector) {
+        if (_size == _stride) {
+            reserve(std::max<std::size_t>(2 * _stride, 16));
+        }
+        ++_size;
+        set(_size - 1, vector);
+    }
+
+    /**
+     * Reserve the lanes for at least `count` vectors.
+     */
+    void reserve(std::size_t count) {
+        if (count <= _stride) {
+            return;
+        }
+        const std::size_t stride = round_up_to_cache_line<T>(count);
+        std::vector<T, Allocator> buffer(N * stride, T{0}, _buffer.get_allocator());
+        for (std::size_t k = 0; k < N; ++k) {
+            std::copy_n(_buffer.data() + k * _stride, _size, buffer.data() + k * stride);
+        }
+        _buffer.swap(buffer);
+        _stride = stride;
+    }
+
+    /**
+     * Resize the array, the new vectors are zero.
+     */
+    void resize(std::size_t count) {
+        reserve(count);
+        for (std::size_t k = 0; k < N && count > _size; ++k) {
+            std::fill_n(_buffer.data() + k * _stride + _size, count - _size, T{0});
+        }
+        _size = count;
+    }
+
+    void clear() noexcept { _size = 0; }
+
+    /**
+     * Evaluate the expression template (see `lazy()`) into this array.
+     *
+     * The whole expression is computed in a single pass over each lane, so a
+     * chain of operations costs one read of every input and one write.
+     */
+    template <Expression E>
+        requires (E::dimension == N)
+    VectorArray& assign(const E& expression) noexcept {
+        assert(expression.count() == 0 || expression.count() == _size);
+        for (std::size_t k = 0; k < N; ++k) {
+            T* o = _buffer.data() + k * _stride;
+            for (std::size_t i = 0; i < _size; ++i) {
+                o[i] = expression.at(k, i);
+            }
+        }
+        return *this;
+    }
+
+    // CONVERSIONS
+
+    /**
+     * Convert the lanes (SoA) back into the array of vectors (AoS).
+     */
+    void to_vectors(std::span<Vector<N, T>> vectors) const noexcept {
+        assert(vectors.size() == _size);
+        for (std::size_t i = 0; i < _size; ++i) {
+            vectors[i] = (*this)[i];
+        }
+    }
+
+    std::vector<Vector<N, T>> to_vectors() const {
+        std::vector<Vector<N, T>> result(_size);
+        to_vectors(result);
+        return result;
+    }
+
+  private:
+
+    std::vector<T, Allocator> _buffer;
+    std::size_t _size = 0;
+    std::size_t _stride = 0;
+};
+
+namespace pmr {
+
+/**
+ * The array of vectors in the memory resource, e.g. in the `FrameArena`.
+ */
+template <std::size_t N, Number T>
+using VectorArray = gof::VectorArray<N, T, aligned_allocator<T>>;
+
+} // namespace pmr
+
+
+/*----------------------------------------------------------------------------*/
+/*                              BATCHED KERNELS                               */
+/*----------------------------------------------------------------------------*/
+
+// The output may be one of the inputs; each element depends only on the
+// elements with the same index.
+
+/**
+ * Component-wise `out[i] = lhs[i] + rhs[i]`.
+ */
+template <std::size_t N, Number T, typename A>
+void add(const VectorArray<N, T, A>& lhs, const VectorArray<N, T, A>& rhs, VectorArray<N, T, A>& out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t k = 0; k < N; ++k) {
+        const T* x = lhs.lane(k).data();
+        const T* y = rhs.lane(k).data();
+        T* o = out.lane(k).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            o[i] = x[i] + y[i];
+        }
+    }
+}
+
+/**
+ * Component-wise `out[i] = lhs[i] - rhs[i]`.
+ */
+template <std::size_t N, Number T, typename A>
+void sub(const VectorArray<N, T, A>& lhs, const VectorArray<N, T, A>& rhs, VectorArray<N, T, A>& out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t k = 0; k < N; ++k) {
+        const T* x = lhs.lane(k).data();
+        const T* y = rhs.lane(k).data();
+        T* o = out.lane(k).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            o[i] = x[i] - y[i];
+        }
+    }
+}
+
+/**
+ * Scale all vectors `out[i] = scalar * self[i]`.
+ */
+template <std::size_t N, Number T, typename A>
+void scale(T const& scalar, const VectorArray<N, T, A>& self, VectorArray<N, T, A>& out) noexcept {
+    assert(self.size() == out.size());
+    for (std::size_t k = 0; k < N; ++k) {
+        const T* x = self.lane(k).data();
+        T* o = out.lane(k).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            o[i] = scalar * x[i];
+        }
+    }
+}
+
+/**
+ * The scalar products `out[i] = lhs[i] . rhs[i]`.
+ *
+ * The results are identical to `scalar_product()` of the single vectors.
+ */
+template <std::size_t N, Number T, typename A>
+void dot(const VectorArray<N, T, A>& lhs, const VectorArray<N, T, A>& rhs, std::span<T> out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    {
+        const T* x = lhs.lane(0).data();
+        const T* y = rhs.lane(0).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = x[i] * y[i];
+        }
+    }
+    for (std::size_t k = 1; k < N; ++k) {
+        const T* x = lhs.lane(k).data();
+        const T* y = rhs.lane(k).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = multiply_add(x[i], y[i], out[i]);
+        }
+    }
+}
+
+/**
+ * The vector products `out[i] = lhs[i] x rhs[i]`.
+ *
+ * The results are identical to `vector_product()` of the single vectors.
+ */
+template <Number T, typename A>
+void cross(const VectorArray<3, T, A>& lhs, const VectorArray<3, T, A>& rhs, VectorArray<3, T, A>& out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    const T* ax = lhs.lane(0).data(); const T* ay = lhs.lane(1).data(); const T* az = lhs.lane(2).data();
+    const T* bx = rhs.lane(0).data(); const T* by = rhs.lane(1).data(); const T* bz = rhs.lane(2).data();
+    T* ox = out.lane(0).data(); T* oy = out.lane(1).data(); T* oz = out.lane(2).data();
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const T x = difference_of_products(ay[i], bz[i], az[i], by[i]);
+        const T y = difference_of_products(az[i], bx[i], ax[i], bz[i]);
+        const T z = difference_of_products(ax[i], by[i], ay[i], bx[i]);
+        ox[i] = x;
+        oy[i] = y;
+        oz[i] = z;
+    }
+}
+
+/**
+ * The Euclidean norms `out[i] = |self[i]|`.
+ */
+template <std::size_t N, std::floating_point T, typename A>
+void length(const VectorArray<N, T, A>& self, std::span<T> out) noexcept {
+    dot(self, self, out);
+    simd::sqrt(out.data(), out.size());
+}
+
+/**
+ * Normalize all vectors to the unit length. The zero vectors stay zero.
+ */
+template <std::size_t N, std::floating_point T, typename A>
+void normalize(const VectorArray<N, T, A>& self, VectorArray<N, T, A>& out) noexcept {
+    assert(self.size() == out.size());
+    // The lengths of one block are kept on the stack, so the square roots
+    // can be computed by the bulk kernel.
+    constexpr std::size_t block = 256;
+    T inverse[block];
+
+    for (std::size_t first = 0; first < out.size(); first += block) {
+        const std::size_t count = std::min(block, out.size() - first);
+        {
+            const T* x = self.lane(0).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                inverse[i] = x[i] * x[i];
+            }
+        }
+        for (std::size_t k = 1; k < N; ++k) {
+            const T* x = self.lane(k).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                inverse[i] = multiply_add(x[i], x[i], inverse[i]);
+            }
+        }
+        simd::sqrt(inverse, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            inverse[i] = inverse[i] > T{0} ? T{1} / inverse[i] : T{0};
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+            const T* x = self.lane(k).data() + first;
+            T* o = out.lane(k).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                o[i] = x[i] * inverse[i];
+            }
+        }
+    }
+}
+
+/**
+ * Compare the vectors `out[i] = lhs[i].is_close(rhs[i])`.
+ *
+ * The results of one block are combined as the integers of the lane width
+ * on the stack, so the comparisons of the lanes are vectorized.
+ */
+template <std::size_t N, Number T, typename A, Tolerance<T> C = tolerance::Default<T>>
+void is_close(const VectorArray<N, T, A>& lhs, const VectorArray<N, T, A>& rhs, std::span<bool> out,
+              C const& compare = C{}) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    using flag = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+    constexpr std::size_t block = 256;
+    flag flags[block];
+
+    for (std::size_t first = 0; first < out.size(); first += block) {
+        const std::size_t count = std::min(block, out.size() - first);
+        std::fill_n(flags, count, flag{1});
+        for (std::size_t k = 0; k < N; ++k) {
+            const T* x = lhs.lane(k).data() + first;
+            const T* y = rhs.lane(k).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                flags[i] &= flag(compare(x[i], y[i]));
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[first + i] = flags[i] != 0;
+        }
+    }
+}
+
+/**
+ * Check the unit vectors `out[i] = self[i].is_unit()`.
+ */
+template <std::size_t N, Number T, typename A, Tolerance<T> C = tolerance::Default<T>>
+void is_unit(const VectorArray<N, T, A>& self, std::span<bool> out, C const& compare = C{}) noexcept {
+    assert(self.size() == out.size());
+    const auto squared = compare.squared();
+    constexpr std::size_t block = 256;
+    T lengths[block];
+    for (std::size_t first = 0; first < out.size(); first += block) {
+        const std::size_t count = std::min(block, out.size() - first);
+        {
+            const T* x = self.lane(0).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                lengths[i] = x[i] * x[i];
+            }
+        }
+        for (std::size_t k = 1; k < N; ++k) {
+            const T* x = self.lane(k).data() + first;
+            for (std::size_t i = 0; i < count; ++i) {
+                lengths[i] = multiply_add(x[i], x[i], lengths[i]);
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[first + i] = squared(lengths[i], T{1});
+        }
+    }
+}
+
+/**
+ * The linear interpolation `out[i] = lhs[i] + t * (rhs[i] - lhs[i])`.
+ */
+template <std::size_t N, Number T, typename A>
+void lerp(const VectorArray<N, T, A>& lhs, const VectorArray<N, T, A>& rhs, T const& t, VectorArray<N, T, A>& out) noexcept {
+    assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+    for (std::size_t k = 0; k < N; ++k) {
+        const T* x = lhs.lane(k).data();
+        const T* y = rhs.lane(k).data();
+        T* o = out.lane(k).data();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            o[i] = x[i] + t * (y[i] - x[i]);
+        }
+    }
+}
+
+} // namespace
+
+#endif // guard
@@ -0,0 +1,60 @@
+// -*- c++, utf-8 -*-
+
+/*
+ * The seeded random data shared by the tests.
+ */
+
+#pragma once
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace gof::test {
+
+/**
+ * The `count` vectors with the components uniform in `[-range, range)`.
+ *
+ * The same seed gives the same vectors, so the failures are reproducible.
+ */
+template <std::size_t N, typename T>
+std::vector<Vector<N, T>> random_vectors(std::size_t count, unsigned seed, T range) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T> dist(-range, range);
+    std::vector<Vector<N, T>> result(count);
+    for (auto& v : result) {
+        for (std::size_t k = 0; k < N; ++k) {
+            v.data()[k] = dist(rng);
+        }
+    }
+    return result;
+}
+
+/**
+ * The `count` rays from the origins uniform in the cube `[-range, range)`
+ * towards the targets in the cube scaled by `target_scale`, so most rays
+ * pass near the centre.
+ */
+template <typename T>
+std::vector<Ray<T>> random_rays(std::size_t count, unsigned seed, T range, T target_scale) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T> dist(-range, range);
+    std::vector<Ray<T>> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Vector<3, T> origin;
+        Vector<3, T> target;
+        for (std::size_t k = 0; k < 3; ++k) {
+            origin.data()[k] = dist(rng);
+        }
+        for (std::size_t k = 0; k < 3; ++k) {
+            target.data()[k] = target_scale * dist(rng);
+        }
+        result.emplace_back(origin, target - origin);
+    }
+    return result;
+}
+
+} // namespace gof::test
@@ -0,0 +1,112 @@
+/*
+ * AABB TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+#include <gof/math/execution.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * The box computed by `min()` and `max()` of the vectors.
+ */
+template <std::size_t N, typename T>
+Aabb<N, T> reference_box(const std::vector<Vector<N, T>>& points) {
+    Aabb<N, T> box;
+    for (const auto& p : points) {
+        box = box.merge(p);
+    }
+    return box;
+}
+
+} // namespace
+
+TEST_CASE("The default box is empty", "[aabb]") {
+    const Aabb3f empty;
+    const Aabb3f unit(Vector3f::zero(), Vector3f::ones());
+
+    REQUIRE(empty.is_empty());
+    REQUIRE_FALSE(unit.is_empty());
+    REQUIRE(empty.volume() == 0.0f);
+    REQUIRE(empty.merge(unit) == unit);
+    REQUIRE(unit.contains(empty));
+    REQUIRE_FALSE(empty.contains(Vector3f::zero()));
+    REQUIRE_FALSE(empty.intersects(unit));
+    REQUIRE(Aabb3f(Vector3f(1.0f, 2.0f, 3.0f)).volume() == 0.0f);
+}
+
+TEST_CASE("Aabb queries work", "[aabb]") {
+    constexpr Aabb3f a(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(2.0f, 4.0f, 6.0f));
+    constexpr Aabb3f b(Vector3f(1.0f, 1.0f, 1.0f), Vector3f(3.0f, 3.0f, 3.0f));
+    constexpr Aabb3f c(Vector3f(2.0f, 5.0f, 0.0f), Vector3f(3.0f, 6.0f, 1.0f));
+
+    static_assert(a.center() == Vector3f(1.0f, 2.0f, 3.0f));
+    static_assert(a.extent() == Vector3f(2.0f, 4.0f, 6.0f));
+    static_assert(a.volume() == 48.0f);
+    static_assert(a.surface_area() == 88.0f);
+    static_assert(a.contains(Vector3f(2.0f, 0.0f, 3.0f)));
+    static_assert(!a.contains(Vector3f(2.0f, -0.1f, 3.0f)));
+    static_assert(a.intersects(b) && b.intersects(a));
+    static_assert(!a.intersects(c) && !c.intersects(a));
+    static_assert(a.intersection(b) == Aabb3f(Vector3f(1.0f, 1.0f, 1.0f), Vector3f(2.0f, 3.0f, 3.0f)));
+    static_assert(a.intersection(c).is_empty());
+    static_assert(a.merge(c) == Aabb3f(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(3.0f, 6.0f, 6.0f)));
+    static_assert(a.merge(c).contains(a) && a.merge(c).contains(c));
+    static_assert(!a.contains(b));
+
+    const auto [lower, upper] = b;
+    REQUIRE(lower == Vector3f::ones());
+    REQUIRE(upper == Vector3f(3.0f, 3.0f, 3.0f));
+
+    constexpr Aabb<2, int> grid(Vector<2, int>(0, 0), Vector<2, int>(3, 2));
+    static_assert(grid.volume() == 6);
+    static_assert(grid.contains(Vector<2, int>(3, 0)));
+}
+
+TEST_CASE("bounding_box() matches the merge of the points", "[aabb]") {
+    for (std::size_t count : {0, 1, 7, 8, 9, 1000, 1003}) {
+        const auto points3 = test::random_vectors<3, float>(count, 11, 50.0f);
+        REQUIRE(bounding_box(std::span<const Vector3f>(points3)) == reference_box(points3));
+        const auto points2 = test::random_vectors<2, float>(count, 11, 50.0f);
+        REQUIRE(bounding_box(std::span<const Vector2f>(points2)) == reference_box(points2));
+        const auto points4 = test::random_vectors<4, double>(count, 11, 50.0);
+        REQUIRE(bounding_box(std::span<const Vector4d>(points4)) == reference_box(points4));
+    }
+    static_assert(bounding_box(std::span<const Vector2d>()).is_empty());
+}
+
+TEST_CASE("bounding_box() ignores NaN", "[aabb]") {
+    auto points = test::random_vectors<3, float>(100, 11, 50.0f);
+    points[13] = Vector3f(std::nanf(""), 1000.0f, -1000.0f);
+    points[99] = Vector3f(-1000.0f, std::nanf(""), 1000.0f);
+
+    const auto box = bounding_box(std::span<const Vector3f>(points));
+
+    REQUIRE(box.lower().x() == -1000.0f);
+    REQUIRE(box.upper().y() == 1000.0f);
+    REQUIRE(box.lower().z() == -1000.0f);
+    REQUIRE(box.upper().z() == 1000.0f);
+}
+
+TEST_CASE("The parallel bounding_box() matches the sequential one", "[aabb]") {
+    const auto points = test::random_vectors<3, float>(100000, 11, 50.0f);
+    const std::span<const Vector3f> span(points);
+    ThreadPool pool(3);
+
+    const auto expected = bounding_box(span);
+    REQUIRE(bounding_box(execution::seq, span) == expected);
+    REQUIRE(bounding_box(execution::parallel_policy{&pool}, span) == expected);
+    REQUIRE(bounding_box(execution::parallel_policy{&pool, 1000}, span) == expected);
+}
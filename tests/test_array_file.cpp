@@ -0,0 +1,266 @@
+/*
+ * ARRAY FILE TESTS
+ *
+ * The files are written into the temporary directory and removed at the end
+ * of each test. The checksums are compared with the digests of the reference
+ * XXH64 implementation.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/io/ArrayFile.hpp>
+#include <gof/math/scalar/Fixed.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * The path in the temporary directory removed by the destructor.
+ */
+struct TemporaryFile
+{
+    std::filesystem::path path;
+
+    explicit TemporaryFile(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / ("gof_test_" + name + ".gof")) { }
+
+    ~TemporaryFile() {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+};
+
+/**
+ * Overwrite the bytes of the file at the specified offset.
+ */
+void patch(const std::filesystem::path& path, std::size_t offset, const void* data, std::size_t size) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(std::streamoff(offset));
+    file.write(static_cast<const char*>(data), std::streamsize(size));
+}
+
+std::vector<Vector3f> make_points(std::size_t count) {
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.emplace_back(float(i), 0.5f * float(i), -float(i % 7));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Only the scalars of the format are array elements", "[array_file]") {
+    STATIC_REQUIRE(io::ArrayElement<Vector3f>);
+    STATIC_REQUIRE(io::ArrayElement<Vector<4, Half>>);
+    STATIC_REQUIRE(io::ArrayElement<Matrix<3, 3, std::int16_t>>);
+    STATIC_REQUIRE(!io::ArrayElement<Vector<3, Fixed<16>>>);
+    STATIC_REQUIRE(!io::ArrayElement<Vector<2, std::complex<float>>>);
+    STATIC_REQUIRE(!io::ArrayElement<Vector<3, bool>>);
+    STATIC_REQUIRE(!io::ArrayElement<float>);
+}
+
+TEST_CASE("The checksum is XXH64", "[array_file]") {
+    REQUIRE(io::detail::xxh64("", 0) == 0xEF46DB3751D8E999ull);
+    REQUIRE(io::detail::xxh64("abc", 3) == 0x44BC2CF5AD770999ull);
+
+    std::vector<std::uint8_t> bytes(1000);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = std::uint8_t(i * 7 + 3);
+    }
+    REQUIRE(io::detail::xxh64(bytes.data(), bytes.size()) == 0x5F235FA033F1A3FBull);
+    REQUIRE(io::detail::xxh64(bytes.data(), bytes.size(), 5) == 0x208BE8CAF3F789AFull);
+
+    SECTION("the digest does not depend on the chunks") {
+        io::detail::Xxh64 hash;
+        for (std::size_t first = 0, size = 1; first < bytes.size(); first += size, size = size * 3 % 41 + 1) {
+            hash.update(bytes.data() + first, std::min(size, bytes.size() - first));
+        }
+        REQUIRE(hash.digest() == 0x5F235FA033F1A3FBull);
+    }
+}
+
+TEST_CASE("The row-major file is mapped as the elements", "[array_file]") {
+    const TemporaryFile file("row_major");
+    const auto points = make_points(40000);
+    REQUIRE(io::save<Vector3f>(file.path, points) == io::Status::ok);
+    REQUIRE(std::filesystem::file_size(file.path) == 64 + points.size() * 3 * sizeof(float));
+
+    const io::MappedArray<Vector3f> mapped(file.path);
+    REQUIRE(mapped);
+    REQUIRE(mapped.size() == points.size());
+    REQUIRE(mapped.layout() == Layout::row_major);
+    REQUIRE(mapped.header().rows == 3);
+    REQUIRE(mapped.header().columns == 1);
+    REQUIRE(mapped.header().scalar == std::uint8_t(io::ScalarType::float32));
+    REQUIRE(mapped.verify() == io::Status::ok);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(mapped.values().data()) % cache_line_size == 0);
+    for (std::size_t i = 0; i < points.size(); i += 97) {
+        REQUIRE(mapped[i] == points[i]);
+        REQUIRE(mapped.values()[3 * i + 1] == points[i][1]);
+    }
+#ifndef GOF_MATH_SIMD
+    REQUIRE(mapped.elements()[12345] == points[12345]);
+#endif
+
+    SECTION("the checksum detects the corrupted payload") {
+        const float corrupted = 42.0f;
+        patch(file.path, 64 + 4000, &corrupted, sizeof(corrupted));
+        const io::MappedArray<Vector3f> again(file.path);
+        REQUIRE(again);
+        REQUIRE(again.verify() == io::Status::checksum_mismatch);
+    }
+}
+
+TEST_CASE("The column-major file is mapped as the lanes", "[array_file]") {
+    const TemporaryFile file("column_major");
+    VectorArray<3, double> vectors;
+    for (std::size_t i = 0; i < 50000; ++i) {
+        vectors.push_back(Vector3d(double(i), -double(i), 1.0 / double(i + 1)));
+    }
+
+    SECTION("from the vector array") {
+        REQUIRE(io::save(file.path, vectors) == io::Status::ok);
+        const io::MappedArray<Vector3d> mapped(file.path);
+        REQUIRE(mapped);
+        REQUIRE(mapped.layout() == Layout::column_major);
+        REQUIRE(mapped.size() == vectors.size());
+        REQUIRE(mapped.verify() == io::Status::ok);
+        for (std::size_t k = 0; k < 3; ++k) {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(mapped.lane(k).data()) % cache_line_size == 0);
+            REQUIRE(std::memcmp(mapped.lane(k).data(), vectors.lane(k).data(), vectors.size() * sizeof(double)) == 0);
+        }
+        REQUIRE(mapped[31337] == vectors[31337]);
+    }
+
+    SECTION("streamed with fewer elements than the capacity") {
+        io::ArrayWriter<Vector3d> writer(file.path, Layout::column_major, 70000);
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            writer.write(vectors[i]);
+        }
+        REQUIRE(writer.size() == vectors.size());
+        REQUIRE(writer.close() == io::Status::ok);
+
+        const io::MappedArray<Vector3d> mapped(file.path);
+        REQUIRE(mapped);
+        REQUIRE(mapped.size() == vectors.size());
+        REQUIRE(mapped.header().stride >= 70000);
+        REQUIRE(mapped.verify() == io::Status::ok);
+        REQUIRE(mapped.lane(2)[49999] == vectors[49999][2]);
+        REQUIRE(mapped[0] == vectors[0]);
+    }
+
+    SECTION("nothing streamed into the lanes") {
+        io::ArrayWriter<Vector3f> writer(file.path, Layout::column_major, 100);
+        REQUIRE(writer.close() == io::Status::ok);
+
+        const io::MappedArray<Vector3f> mapped(file.path);
+        REQUIRE(mapped);
+        REQUIRE(mapped.empty());
+        REQUIRE(mapped.layout() == Layout::column_major);
+        REQUIRE(mapped.verify() == io::Status::ok);
+        for (std::size_t k = 0; k < 3; ++k) {
+            REQUIRE(mapped.lane(k).empty());
+        }
+    }
+
+    SECTION("the capacity is exceeded") {
+        io::ArrayWriter<Vector3d> writer(file.path, Layout::column_major, 100);
+        writer.write(vectors);
+        REQUIRE(writer.status() == io::Status::capacity_exceeded);
+        REQUIRE(writer.close() == io::Status::capacity_exceeded);
+        REQUIRE(io::MappedArray<Vector3d>(file.path).status() == io::Status::not_an_array);
+    }
+}
+
+TEST_CASE("The matrices are stored in both layouts", "[array_file]") {
+    const TemporaryFile file("matrices");
+    using M = Matrix<2, 3, float, Layout::column_major>;
+    std::vector<M> matrices;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const float s = float(i);
+        matrices.push_back(M(s, s + 1.0f, s + 2.0f,
+                             -s, -s - 1.0f, -s - 2.0f));
+    }
+
+    for (const Layout layout : {Layout::row_major, Layout::column_major}) {
+        REQUIRE(io::save<M>(file.path, matrices, layout) == io::Status::ok);
+        const io::MappedArray<M> mapped(file.path);
+        REQUIRE(mapped);
+        REQUIRE(mapped.verify() == io::Status::ok);
+        REQUIRE(mapped[123] == matrices[123]);
+        if (layout == Layout::column_major) {
+            REQUIRE(mapped.lane(0, 2)[10] == 12.0f);
+            REQUIRE(mapped.lane(1, 0)[10] == -10.0f);
+        } else {
+            REQUIRE(mapped.elements()[999] == matrices[999]);
+        }
+        REQUIRE(io::MappedArray<Matrix<2, 3, float>>(file.path).status() == io::Status::type_mismatch);
+    }
+}
+
+TEST_CASE("The invalid files are refused", "[array_file]") {
+    const TemporaryFile file("invalid");
+    const auto points = make_points(1000);
+    const auto write = [&] { REQUIRE(io::save<Vector3f>(file.path, points) == io::Status::ok); };
+
+    REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::io_error);
+
+    write();
+    REQUIRE(io::MappedArray<Vector3d>(file.path).status() == io::Status::type_mismatch);
+    REQUIRE(io::MappedArray<Vector4f>(file.path).status() == io::Status::type_mismatch);
+    REQUIRE(io::MappedArray<Vector<3, std::int32_t>>(file.path).status() == io::Status::type_mismatch);
+
+    SECTION("the truncated payload") {
+        std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::truncated);
+    }
+
+    SECTION("the other byte order") {
+        const std::uint32_t swapped = 0x04030201;
+        patch(file.path, 12, &swapped, sizeof(swapped));
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::byte_order);
+    }
+
+    SECTION("the newer version") {
+        const std::uint32_t version = 2;
+        patch(file.path, 8, &version, sizeof(version));
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::unsupported_version);
+    }
+
+    SECTION("the zero version") {
+        const std::uint32_t version = 0;
+        patch(file.path, 8, &version, sizeof(version));
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::unsupported_version);
+    }
+
+    SECTION("the corrupted count") {
+        const std::uint64_t count = ~std::uint64_t{0} / 2;
+        patch(file.path, 32, &count, sizeof(count));
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::truncated);
+    }
+
+    SECTION("not an array") {
+        std::ofstream(file.path) << "x y z\n1 2 3\n";
+        REQUIRE(io::MappedArray<Vector3f>(file.path).status() == io::Status::not_an_array);
+    }
+
+    SECTION("the empty array") {
+        REQUIRE(io::save<Vector3f>(file.path, {}) == io::Status::ok);
+        const io::MappedArray<Vector3f> empty(file.path);
+        REQUIRE(empty);
+        REQUIRE(empty.empty());
+        REQUIRE(empty.verify() == io::Status::ok);
+    }
+}
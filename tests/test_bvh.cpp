@@ -0,0 +1,239 @@
+/*
+ * BVH TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+#include <gof/math/spatial/Bvh.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+/**
+ * The triangle soup of small random triangles in a cube.
+ */
+struct Soup
+{
+    std::vector<Vector3f> vertices;
+    std::vector<std::uint32_t> triangles;
+};
+
+Soup make_soup(std::size_t count) {
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    Soup result;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector3f center(position(rng), position(rng), position(rng));
+        for (std::size_t j = 0; j < 3; ++j) {
+            result.triangles.push_back(static_cast<std::uint32_t>(result.vertices.size()));
+            result.vertices.push_back(center + Vector3f(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+    return result;
+}
+
+/**
+ * The nearest hit by testing every triangle.
+ */
+std::pair<std::uint32_t, Hit<float>> brute_force(const Rayf& ray, const Soup& soup) {
+    std::pair<std::uint32_t, Hit<float>> result{Bvh<float>::npos, {}};
+    for (std::size_t i = 0; i < soup.triangles.size() / 3; ++i) {
+        const Hit<float> hit = intersect(ray, soup.vertices[soup.triangles[3 * i]],
+                                         soup.vertices[soup.triangles[3 * i + 1]],
+                                         soup.vertices[soup.triangles[3 * i + 2]]);
+        if (hit.distance < result.second.distance) {
+            result = {static_cast<std::uint32_t>(i), hit};
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The nodes of the BVH are compact", "[bvh]") {
+    STATIC_REQUIRE(sizeof(Bvh<float>::Node) == 32);
+}
+
+TEST_CASE("The empty BVH finds nothing", "[bvh]") {
+    const Bvh<float> bvh;
+    const Rayf ray(Vector3f::zero(), Vector3f::unit_x());
+
+    REQUIRE(bvh.empty());
+    REQUIRE(bvh.bounds().is_empty());
+    REQUIRE(bvh.intersect(ray, [](std::uint32_t, float) { return 0.0f; }).first == Bvh<float>::npos);
+    std::size_t calls = 0;
+    bvh.overlap(Aabb3f(Vector3f::zero(), Vector3f::ones()), [&](std::uint32_t) { ++calls; });
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("The BVH covers every primitive once", "[bvh]") {
+    const Soup soup = make_soup(5000);
+    const auto boxes = triangle_boxes(std::span<const Vector3f>(soup.vertices), std::span<const std::uint32_t>(soup.triangles));
+    const Bvh<float> bvh(std::span<const Aabb3f>(boxes), 4);
+
+    REQUIRE(bvh.size() == boxes.size());
+    std::vector<std::uint32_t> indices(bvh.indices().begin(), bvh.indices().end());
+    std::sort(indices.begin(), indices.end());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        REQUIRE(indices[i] == i);
+    }
+
+    // Every node bounds its primitives, the leaves are small.
+    const auto nodes = bvh.nodes();
+    std::size_t leaves = 0;
+    for (std::size_t n = 0; n < nodes.size(); ++n) {
+        const Aabb3f box({nodes[n].lower[0], nodes[n].lower[1], nodes[n].lower[2]},
+                         {nodes[n].upper[0], nodes[n].upper[1], nodes[n].upper[2]});
+        if (nodes[n].is_leaf()) {
+            ++leaves;
+            REQUIRE(nodes[n].count <= 4);
+            for (std::uint32_t i = nodes[n].first; i < nodes[n].first + nodes[n].count; ++i) {
+                REQUIRE(box.contains(boxes[bvh.indices()[i]]));
+            }
+        } else {
+            REQUIRE(nodes[n].first > n + 1);
+            REQUIRE(nodes[n].first < nodes.size());
+        }
+    }
+    REQUIRE(leaves == (nodes.size() + 1) / 2);
+    REQUIRE(bvh.bounds() == bounding_box(std::span<const Vector3f>(soup.vertices)));
+}
+
+TEST_CASE("The BVH finds the nearest triangle", "[bvh]") {
+    const Soup soup = make_soup(2000);
+    const auto boxes = triangle_boxes(std::span<const Vector3f>(soup.vertices), std::span<const std::uint32_t>(soup.triangles));
+    const Bvh<float> bvh{std::span<const Aabb3f>(boxes)};
+
+    std::size_t hits = 0;
+    for (const Rayf& ray : test::random_rays(500, 31, 15.0f, 0.5f)) {
+        const auto expected = brute_force(ray, soup);
+        const auto [index, hit] = bvh.intersect(ray, std::span<const Vector3f>(soup.vertices),
+                                                std::span<const std::uint32_t>(soup.triangles));
+        REQUIRE(index == expected.first);
+        REQUIRE(hit.distance == expected.second.distance);
+        hits += index != Bvh<float>::npos;
+    }
+    REQUIRE(hits > 100);
+
+    SECTION("within the range of the distances") {
+        const Vector3f target = (1.0f / 3.0f) * (soup.vertices[0] + soup.vertices[1] + soup.vertices[2]);
+        const Rayf ray(Vector3f(-20.0f, target.y(), target.z()), Vector3f::unit_x());
+        const auto all = bvh.intersect(ray, std::span<const Vector3f>(soup.vertices), std::span<const std::uint32_t>(soup.triangles));
+        REQUIRE(all.first != Bvh<float>::npos);
+        const auto none = bvh.intersect(ray, std::span<const Vector3f>(soup.vertices),
+                                        std::span<const std::uint32_t>(soup.triangles), 0.0f, 0.5f * all.second.distance);
+        REQUIRE(none.first == Bvh<float>::npos);
+        REQUIRE(none.second.distance == inf);
+    }
+}
+
+TEST_CASE("The BVH finds the overlapping boxes", "[bvh]") {
+    const Soup soup = make_soup(3000);
+    const auto boxes = triangle_boxes(std::span<const Vector3f>(soup.vertices), std::span<const std::uint32_t>(soup.triangles));
+    const Bvh<float> bvh(std::span<const Aabb3f>(boxes), 8);
+
+    std::mt19937 rng(37);
+    std::uniform_real_distribution<float> dist(-12.0f, 12.0f);
+    for (std::size_t q = 0; q < 100; ++q) {
+        const Vector3f p(dist(rng), dist(rng), dist(rng));
+        const Aabb3f query(p, p + Vector3f(2.0f, 3.0f, 1.0f));
+        std::vector<std::uint32_t> found;
+        bvh.overlap(query, [&](std::uint32_t i) { found.push_back(i); });
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::uint32_t> expected;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].intersects(query)) {
+                expected.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        REQUIRE(found == expected);
+    }
+}
+
+TEST_CASE("The parallel build gives the same tree", "[bvh][execution]") {
+    const Soup soup = make_soup(60000);
+    const auto boxes = triangle_boxes(std::span<const Vector3f>(soup.vertices), std::span<const std::uint32_t>(soup.triangles));
+    ThreadPool pool(3);
+    const Bvh<float> sequential{std::span<const Aabb3f>(boxes)};
+    const Bvh<float> parallel(execution::parallel_policy{&pool}, std::span<const Aabb3f>(boxes));
+
+    REQUIRE(parallel.nodes().size() == sequential.nodes().size());
+    REQUIRE(std::equal(parallel.indices().begin(), parallel.indices().end(), sequential.indices().begin()));
+    for (std::size_t n = 0; n < sequential.nodes().size(); ++n) {
+        const auto& a = sequential.nodes()[n];
+        const auto& b = parallel.nodes()[n];
+        REQUIRE(a.first == b.first);
+        REQUIRE(a.count == b.count);
+        REQUIRE(std::equal(a.lower, a.lower + 3, b.lower));
+        REQUIRE(std::equal(a.upper, a.upper + 3, b.upper));
+    }
+}
+
+TEST_CASE("The BVH handles the coincident primitives", "[bvh]") {
+    // The centroids cannot be split, so all boxes end in one leaf.
+    const std::vector<Aabb3f> boxes(100, Aabb3f(Vector3f::zero(), Vector3f::ones()));
+    const Bvh<float> bvh{std::span<const Aabb3f>(boxes)};
+    REQUIRE(bvh.nodes().size() == 1);
+
+    const Rayf ray(Vector3f(-1.0f, 0.5f, 0.5f), Vector3f::unit_x());
+    const auto [index, distance] = bvh.intersect(ray, [&](std::uint32_t i, float t_max) {
+        return intersect(ray, boxes[i], 0.0f, t_max);
+    });
+    REQUIRE(index == 0);
+    REQUIRE(distance == 1.0f);
+}
+
+TEST_CASE("The BVH handles the huge and infinite boxes", "[bvh]") {
+    // The surface areas overflow, so the SAH costs are not finite.
+    std::mt19937 rng(43);
+    std::uniform_real_distribution<float> dist(-1e19f, 1e19f);
+    std::vector<Aabb3f> boxes;
+    for (std::size_t i = 0; i < 100; ++i) {
+        const Vector3f p(dist(rng), dist(rng), dist(rng));
+        const Vector3f q(dist(rng), dist(rng), dist(rng));
+        boxes.emplace_back(min(p, q), max(p, q));
+    }
+
+    const auto check = [&](const Bvh<float>& bvh, std::size_t leaf_size) {
+        std::size_t found = 0;
+        bvh.overlap(Aabb3f(Vector3f(-inf, -inf, -inf), Vector3f(inf, inf, inf)), [&](std::uint32_t) { ++found; });
+        REQUIRE(found == boxes.size());
+        const auto nodes = bvh.nodes();
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            if (nodes[n].is_leaf()) {
+                REQUIRE(nodes[n].count <= leaf_size);
+            } else {
+                REQUIRE(nodes[n].first > n + 1);
+                REQUIRE(nodes[n].first < nodes.size());
+            }
+        }
+    };
+
+    SECTION("the huge boxes are split by the counts") {
+        const Bvh<float> bvh(std::span<const Aabb3f>(boxes), 4);
+        REQUIRE(bvh.nodes().size() > 1);
+        check(bvh, 4);
+    }
+
+    SECTION("the infinite boxes end in a leaf") {
+        boxes[17] = Aabb3f(Vector3f(-inf, 0.0f, 0.0f), Vector3f(inf, 1.0f, 1.0f));
+        boxes[42] = Aabb3f(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, 1.0f, inf));
+        check(Bvh<float>(std::span<const Aabb3f>(boxes), 4), boxes.size());
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * CONSTEXPR TESTS
+ *
+ * The operations evaluated at compile time, most checks are `static_assert`s,
+ * so this file fails to compile when an operation stops being `constexpr`.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/tables.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+
+using namespace gof;
+
+namespace {
+
+constexpr double pi = std::numbers::pi;
+
+constexpr double distance(double a, double b) {
+    return a < b ? b - a : a - b;
+}
+
+template <std::size_t N, typename T>
+constexpr bool is_close(const Vector<N, T>& a, const Vector<N, T>& b, T tolerance) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (distance(a[i], b[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, std::size_t Count>
+constexpr bool are_unit(const std::array<Vector<3, T>, Count>& vectors, T tolerance) {
+    for (const auto& v : vectors) {
+        if (distance(v.length(), T{1}) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The tables baked into the binary.
+constexpr auto sphere = fibonacci_sphere<256, float>();
+constexpr auto hemisphere = fibonacci_hemisphere<64, double>();
+constexpr auto rotations = rotation_table<8, double>(Vector3d::unit_z());
+
+} // namespace
+
+TEST_CASE("The elementary functions work at compile time", "[constexpr]") {
+    static_assert(cmath::sqrt(4.0) == 2.0);
+    static_assert(cmath::sqrt(0.0) == 0.0);
+    static_assert(cmath::sqrt(2.0f) * cmath::sqrt(2.0f) > 1.9999f);
+    static_assert(distance(cmath::sin(pi / 6), 0.5) < 1e-15);
+    static_assert(distance(cmath::cos(pi / 3), 0.5) < 1e-15);
+    static_assert(distance(cmath::acos(0.5), pi / 3) < 1e-15);
+    static_assert(cmath::acos(1.0) == 0.0);
+    static_assert(cmath::acos(-1.0) == pi);
+
+    // The compile-time values agree with <cmath> within one ulp.
+    constexpr double x[] = {1e-300, 0.3, 2.0, 12345.678, 1e300};
+    constexpr double roots[] = {cmath::sqrt(x[0]), cmath::sqrt(x[1]), cmath::sqrt(x[2]), cmath::sqrt(x[3]), cmath::sqrt(x[4])};
+    for (std::size_t i = 0; i < 5; ++i) {
+        REQUIRE(distance(roots[i], std::sqrt(x[i])) <= std::numeric_limits<double>::epsilon() * std::sqrt(x[i]));
+    }
+
+    constexpr float floats[] = {cmath::sqrt(0.3f), cmath::sqrt(2.0f), cmath::sqrt(7e-30f)};
+    REQUIRE(floats[0] == std::sqrt(0.3f));
+    REQUIRE(floats[1] == std::sqrt(2.0f));
+    REQUIRE(floats[2] == std::sqrt(7e-30f));
+
+    constexpr double angles[] = {cmath::sin(1.0), cmath::cos(1.0), cmath::sin(100.0), cmath::acos(-0.3)};
+    REQUIRE(distance(angles[0], std::sin(1.0)) < 1e-15);
+    REQUIRE(distance(angles[1], std::cos(1.0)) < 1e-15);
+    REQUIRE(distance(angles[2], std::sin(100.0)) < 1e-14);
+    REQUIRE(distance(angles[3], std::acos(-0.3)) < 1e-15);
+}
+
+TEST_CASE("Vector operations work at compile time", "[constexpr]") {
+    constexpr Vector3f u(3.0f, 4.0f, 0.0f);
+    constexpr Vector3f v(-1.0f, 2.0f, 5.0f);
+
+    static_assert(u.length() == 5.0f);
+    static_assert(u.magnitude() == 5.0f);
+    static_assert(u.length_squared() == 25.0f);
+    static_assert(u.max_value() == 4.0f);
+    static_assert(u.min_value() == 0.0f);
+    static_assert(v.min_value() == -1.0f);
+    static_assert(u + v == Vector3f(2.0f, 6.0f, 5.0f));
+    static_assert(u - v == Vector3f(4.0f, 2.0f, -5.0f));
+    static_assert(-u == Vector3f(-3.0f, -4.0f, 0.0f));
+    static_assert(u.scale(2.0f) == Vector3f(6.0f, 8.0f, 0.0f));
+    static_assert(scalar_product(u, v) == 5.0f);
+    static_assert(vector_product(u, v) == Vector3f(20.0f, -15.0f, 10.0f));
+    static_assert(min(u, v) == Vector3f(-1.0f, 2.0f, 0.0f));
+    static_assert(max(u, v) == Vector3f(3.0f, 4.0f, 5.0f));
+    static_assert(Vector3f::unit_x().is_unit());
+    static_assert(Vector4d::zero().is_zero());
+    static_assert(u.is_opposite(-u));
+    static_assert(Vector3f(0.6f, 0.0f, 0.8f).is_unit());
+    static_assert(u.is_close(u + Vector3f(0.0f, 1e-6f, 0.0f)));
+    static_assert(tolerance::Ulps<float>{1}(1.0f, 1.0f + std::numeric_limits<float>::epsilon()));
+    static_assert(eval(lazy(u) + 2.0f * lazy(v)) == Vector3f(1.0f, 8.0f, 10.0f));
+    SUCCEED();
+}
+
+TEST_CASE("Matrix operations work at compile time", "[constexpr]") {
+    constexpr Matrix3d A(1.0, 2.0, 0.0,
+                         0.0, 1.0, 0.0,
+                         0.0, 0.0, 2.0);
+    constexpr Matrix4f I = Matrix4f::identity();
+
+    static_assert(A * Matrix3d::identity() == A);
+    static_assert(I * I == I);
+    static_assert(A * Vector3d(1.0, 1.0, 1.0) == Vector3d(3.0, 1.0, 2.0));
+    static_assert(I * Vector4f(1.0f, 2.0f, 3.0f, 4.0f) == Vector4f(1.0f, 2.0f, 3.0f, 4.0f));
+    static_assert(A.row(0) == Vector3d(1.0, 2.0, 0.0));
+    static_assert(A.column(1) == Vector3d(2.0, 1.0, 0.0));
+    SUCCEED();
+}
+
+TEST_CASE("Quaternion operations work at compile time", "[constexpr]") {
+    constexpr auto q = Quaterniond::from_axis_angle(Vector3d::unit_z(), pi / 2);
+    static_assert(is_close(q.rotate(Vector3d::unit_x()), Vector3d::unit_y(), 1e-15));
+    static_assert(distance(q.angle(), pi / 2) < 1e-15);
+    static_assert(distance(q.norm(), 1.0) < 1e-15);
+    static_assert(is_close(q.axis(), Vector3d::unit_z(), 1e-15));
+    static_assert(distance(scalar_product(Quaterniond::from_matrix(q.to_matrix3()), q), 1.0) < 1e-15);
+    static_assert(distance(slerp(Quaterniond::identity(), q, 0.5).angle(), pi / 4) < 1e-15);
+    SUCCEED();
+}
+
+TEST_CASE("The tables are generated at compile time", "[constexpr]") {
+    static_assert(are_unit(sphere, 1e-6f));
+    static_assert(are_unit(hemisphere, 1e-15));
+    static_assert(is_close(rotations[2] * Vector3d::unit_x(), Vector3d::unit_y(), 1e-15));
+    static_assert(rotations[0] == Matrix3d::identity());
+
+    constexpr auto basis = orthonormal_basis(Vector3d(0.0, 0.6, -0.8));
+    static_assert(distance(scalar_product(basis.row(0), basis.row(1)), 0.0) < 1e-15);
+    static_assert(distance(scalar_product(basis.row(0), basis.row(2)), 0.0) < 1e-15);
+    static_assert(distance(basis.row(0).length(), 1.0) < 1e-15);
+    static_assert(is_close(vector_product(basis.row(0), basis.row(1)), basis.row(2), 1e-15));
+
+    // The samples cover the sphere: their mean is close to the centre.
+    Vector3f sum;
+    for (const auto& v : sphere) {
+        sum = sum + v;
+        REQUIRE(v.length() > 0.999f);
+    }
+    REQUIRE((1.0f / 256.0f * sum).length() < 0.01f);
+    for (const auto& v : hemisphere) {
+        REQUIRE(v.z() > 0.0);
+    }
+}
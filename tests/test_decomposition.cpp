@@ -0,0 +1,305 @@
+/*
+ * DECOMPOSITION TESTS
+ *
+ * The solutions are checked by their residuals relative to the norms of the
+ * system (the backward error), which is small for the stable decompositions
+ * whatever the condition of the random matrix.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/matrix/Decomposition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+template <std::size_t N, std::size_t M, typename T>
+Matrix<N, M, T> random_matrix(std::mt19937& rng) {
+    std::uniform_real_distribution<T> dist(T(-1), T(1));
+    Matrix<N, M, T> result;
+    for (auto& e : std::span(result.data(), N * M)) {
+        e = dist(rng);
+    }
+    return result;
+}
+
+template <std::size_t N, typename T>
+Vector<N, T> random_vector(std::mt19937& rng) {
+    std::uniform_real_distribution<T> dist(T(-1), T(1));
+    Vector<N, T> result;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.data()[i] = dist(rng);
+    }
+    return result;
+}
+
+/**
+ * The symmetric positive definite matrix `B^T * B + I`.
+ */
+template <std::size_t N, typename T>
+Matrix<N, N, T> random_spd(std::mt19937& rng) {
+    const auto b = random_matrix<N, N, T>(rng);
+    Matrix<N, N, T> result = transpose(b) * b;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.data()[i * N + i] += T(1);
+    }
+    return result;
+}
+
+template <typename T>
+T max_norm(std::span<const T> values) {
+    T result = T(0);
+    for (const T& v : values) {
+        result = std::max(result, std::abs(v));
+    }
+    return result;
+}
+
+/**
+ * The backward error `|A * x - b| / (|A| * |x| + |b|)` in the max norm.
+ */
+template <std::size_t N, std::size_t M, typename T>
+T residual(const Matrix<N, M, T>& a, const Vector<M, T>& x, const Vector<N, T>& b) {
+    const Vector<N, T> r = a * x - b;
+    return max_norm<T>(std::span(r.data(), N)) /
+           (T(M) * max_norm<T>(a.values()) * max_norm<T>(std::span(x.data(), M)) + max_norm<T>(std::span(b.data(), N)));
+}
+
+template <std::size_t N, std::size_t M, typename T>
+T distance(const Matrix<N, M, T>& a, const Matrix<N, M, T>& b) {
+    T result = T(0);
+    for (std::size_t i = 0; i < N * M; ++i) {
+        result = std::max(result, std::abs(a.data()[i] - b.data()[i]));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The transpose swaps the rows and the columns", "[decomposition]") {
+    constexpr Matrix<2, 3, float> a(1.0f, 2.0f, 3.0f,
+                                    4.0f, 5.0f, 6.0f);
+    STATIC_REQUIRE(transpose(a) == Matrix<3, 2, float>(1.0f, 4.0f,
+                                                       2.0f, 5.0f,
+                                                       3.0f, 6.0f));
+    const Matrix<2, 3, float, Layout::column_major> b(1.0f, 2.0f, 3.0f,
+                                                      4.0f, 5.0f, 6.0f);
+    REQUIRE(transpose(b).row(1) == Vector2f(2.0f, 5.0f));
+}
+
+TEST_CASE("The determinant and the inverse work at compile time", "[decomposition][constexpr]") {
+    constexpr Matrix3d a(2.0, 1.0, 1.0,
+                         1.0, 3.0, 2.0,
+                         1.0, 0.0, 0.0);
+    STATIC_REQUIRE(determinant(a) == -1.0);
+    STATIC_REQUIRE(inverse(a) * a == Matrix3d::identity());
+
+    // The pivots and the multipliers are exact in the binary.
+    constexpr Matrix3d b(4.0, 0.0, 2.0,
+                         2.0, 2.0, 1.0,
+                         1.0, 1.0, 4.0);
+    STATIC_REQUIRE(Lu<3, double>(b).determinant() == 28.0);
+    STATIC_REQUIRE(Lu<3, double>(b).solve(Vector3d(6.0, 5.0, 6.0)) == Vector3d(1.0, 1.0, 1.0));
+
+    constexpr Matrix2d spd(4.0, 2.0,
+                           2.0, 5.0);
+    STATIC_REQUIRE(Cholesky<2, double>(spd).lower() == Matrix2d(2.0, 0.0,
+                                                                1.0, 2.0));
+    STATIC_REQUIRE(determinant(Matrix4d::identity()) == 1.0);
+}
+
+TEST_CASE("The closed forms agree with the LU decomposition", "[decomposition]") {
+    std::mt19937 rng(71);
+    const auto check = [&]<std::size_t N>() {
+        for (int i = 0; i < 200; ++i) {
+            const auto a = random_matrix<N, N, double>(rng);
+            const Lu<N, double> lu(a);
+            REQUIRE(std::abs(determinant(a) - lu.determinant()) < 1e-12);
+            REQUIRE(distance(inverse(a), lu.inverse()) < 1e-9 * std::max(1.0, max_norm<double>(lu.inverse().values())));
+            REQUIRE(distance(inverse(a) * a, Matrix<N, N, double>::identity()) < 1e-9 * max_norm<double>(inverse(a).values()));
+        }
+    };
+    check.template operator()<2>();
+    check.template operator()<3>();
+    check.template operator()<4>();
+
+    SECTION("in the column-major layout") {
+        const auto a = random_matrix<4, 4, float>(rng);
+        Matrix<4, 4, float, Layout::column_major> b;
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = 0; j < 4; ++j) {
+                b.data()[b.index(i, j)] = a(i, j);
+            }
+        }
+        REQUIRE(determinant(b) == determinant(a));
+        REQUIRE(inverse(b)(1, 3) == inverse(a)(1, 3));
+    }
+
+    SECTION("the singular matrix") {
+        const Matrix3f a(1.0f, 2.0f, 3.0f,
+                         2.0f, 4.0f, 6.0f,
+                         0.0f, 1.0f, 5.0f);
+        REQUIRE(determinant(a) == 0.0f);
+        REQUIRE(!std::isfinite(inverse(a)(0, 0)));
+        REQUIRE(Lu<3, float>(a).is_singular());
+    }
+
+    SECTION("the repeated rows of the products that are not representable") {
+        const Matrix2f a(0.1f, 0.7f,
+                         0.1f, 0.7f);
+        REQUIRE(determinant(a) == 0.0f);
+        REQUIRE(!std::isfinite(inverse(a)(0, 0)));
+        const Matrix3f b(1.3f, -2.9f, 0.3f,
+                         0.1f, 0.7f, 0.11f,
+                         0.1f, 0.7f, 0.11f);
+        REQUIRE(determinant(b) == 0.0f);
+        REQUIRE(!std::isfinite(inverse(b)(0, 0)));
+        const Matrix4f c(0.1f, 0.7f, 0.3f, -1.9f,
+                         0.1f, 0.7f, 0.3f, -1.9f,
+                         2.3f, 0.17f, -0.6f, 0.9f,
+                         0.5f, 1.1f, 0.13f, 0.7f);
+        REQUIRE(determinant(c) == 0.0f);
+        REQUIRE(!std::isfinite(inverse(c)(0, 0)));
+    }
+}
+
+TEST_CASE("The LU decomposition solves the systems", "[decomposition]") {
+    std::mt19937 rng(73);
+    for (int i = 0; i < 100; ++i) {
+        const auto a = random_matrix<6, 6, double>(rng);
+        const auto b = random_vector<6, double>(rng);
+        const Lu<6, double> lu(a);
+        REQUIRE(!lu.is_singular());
+        REQUIRE(residual(a, lu.solve(b), b) < 1e-15);
+
+        // P * A = L * U
+        Matrix<6, 6, double> pa;
+        for (std::size_t r = 0; r < 6; ++r) {
+            for (std::size_t c = 0; c < 6; ++c) {
+                pa.data()[r * 6 + c] = a(lu.permutation()[r], c);
+            }
+        }
+        REQUIRE(distance(pa, lu.lower() * lu.upper()) < 1e-14);
+        REQUIRE(std::abs(determinant(a) - lu.determinant()) < 1e-14);
+    }
+
+    SECTION("the pivots are swapped") {
+        const Matrix3f a(0.0f, 1.0f, 0.0f,
+                         0.0f, 0.0f, 1.0f,
+                         1.0f, 0.0f, 0.0f);
+        const Lu<3, float> lu(a);
+        REQUIRE(lu.determinant() == 1.0f);
+        REQUIRE(lu.solve(Vector3f(1.0f, 2.0f, 3.0f)) == Vector3f(3.0f, 1.0f, 2.0f));
+    }
+}
+
+TEST_CASE("The Cholesky decomposition solves the positive definite systems", "[decomposition]") {
+    std::mt19937 rng(79);
+    for (int i = 0; i < 100; ++i) {
+        const auto a = random_spd<6, double>(rng);
+        const auto b = random_vector<6, double>(rng);
+        const Cholesky<6, double> cholesky(a);
+        REQUIRE(cholesky.is_positive_definite());
+        REQUIRE(distance(cholesky.lower() * transpose(cholesky.lower()), a) < 1e-14);
+        REQUIRE(residual(a, cholesky.solve(b), b) < 1e-15);
+        REQUIRE(std::abs(cholesky.determinant() - determinant(a)) < 1e-12 * std::abs(determinant(a)));
+        REQUIRE(distance(cholesky.inverse() * a, Matrix<6, 6, double>::identity()) < 1e-12);
+    }
+
+    SECTION("the indefinite matrix") {
+        const Matrix2f a(1.0f, 2.0f,
+                         2.0f, 1.0f);
+        REQUIRE(!Cholesky<2, float>(a).is_positive_definite());
+    }
+}
+
+TEST_CASE("The QR decomposition finds the least squares solution", "[decomposition]") {
+    std::mt19937 rng(83);
+    for (int i = 0; i < 100; ++i) {
+        const auto a = random_matrix<8, 3, double>(rng);
+        const auto b = random_vector<8, double>(rng);
+        const Qr<8, 3, double> qr(a);
+        REQUIRE(qr.is_full_rank());
+
+        // The residual is orthogonal to the columns: A^T * (A * x - b) = 0.
+        const Vector3d x = qr.solve(b);
+        const Vector3d normal = transpose(a) * (a * x - b);
+        REQUIRE(max_norm<double>(std::span(normal.data(), 3)) < 1e-14);
+        // R^T * R = A^T * A
+        REQUIRE(distance(transpose(qr.r()) * qr.r(), transpose(a) * a) < 1e-13);
+    }
+
+    SECTION("the square system") {
+        const auto a = random_matrix<4, 4, double>(rng);
+        const auto b = random_vector<4, double>(rng);
+        REQUIRE(residual(a, Qr<4, 4, double>(a).solve(b), b) < 1e-15);
+    }
+
+    SECTION("the dependent columns") {
+        const Matrix<3, 2, float> a(1.0f, 2.0f,
+                                    2.0f, 4.0f,
+                                    3.0f, 6.0f);
+        REQUIRE(!Qr<3, 2, float>(a).is_full_rank());
+    }
+}
+
+TEST_CASE("The batched solves agree with the single ones", "[decomposition]") {
+    std::mt19937 rng(89);
+    const auto check = [&]<std::size_t N, typename T>(T tolerance) {
+        constexpr std::size_t count = 1000;
+        std::vector<Matrix<N, N, T>> general(count);
+        std::vector<Matrix<N, N, T>> spd(count);
+        std::vector<Vector<N, T>> rhs(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            general[i] = random_matrix<N, N, T>(rng);
+            // The zero pivot must be swapped away.
+            general[i].data()[0] = T(0);
+            spd[i] = random_spd<N, T>(rng);
+            rhs[i] = random_vector<N, T>(rng);
+        }
+        const MatrixArray<N, N, T> a{std::span<const Matrix<N, N, T>>(general)};
+        const MatrixArray<N, N, T> s{std::span<const Matrix<N, N, T>>(spd)};
+        const VectorArray<N, T> b{std::span<const Vector<N, T>>(rhs)};
+        VectorArray<N, T> x(count);
+
+        lu_solve(a, b, x);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(residual(general[i], x[i], rhs[i]) < tolerance);
+        }
+        ThreadPool pool(3);
+        VectorArray<N, T> y(count);
+        lu_solve(execution::parallel_policy{&pool, 64}, a, b, y);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(x[i] == y[i]);
+        }
+
+        cholesky_solve(s, b, x);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(residual(spd[i], x[i], rhs[i]) < tolerance);
+            REQUIRE((x[i] - Cholesky<N, T>(spd[i]).solve(rhs[i])).length() < 1e3 * tolerance * x[i].length());
+        }
+    };
+    check.template operator()<3, float>(1e-5f);
+    check.template operator()<4, float>(1e-5f);
+    check.template operator()<6, double>(1e-14);
+
+    SECTION("the output may be the right-hand side") {
+        const Matrix3f m(2.0f, 0.0f, 0.0f,
+                         0.0f, 4.0f, 0.0f,
+                         0.0f, 0.0f, 8.0f);
+        const MatrixArray<3, 3, float> a(std::span<const Matrix3f>(&m, 1));
+        const Vector3f v(2.0f, 2.0f, 2.0f);
+        VectorArray<3, float> b(std::span<const Vector3f>(&v, 1));
+        lu_solve(a, b, b);
+        REQUIRE(b[0] == Vector3f(1.0f, 0.5f, 0.25f));
+    }
+}
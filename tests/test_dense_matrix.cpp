@@ -0,0 +1,171 @@
+/*
+ * DENSE MATRIX TESTS
+ *
+ * The blocked product is compared with the naive triple loop accumulated in
+ * `long double`. The sizes are chosen to leave the partial tiles and blocks
+ * at the edges.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/matrix/DenseMatrix.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+using namespace gof;
+
+namespace {
+
+template <typename T, Layout L>
+DenseMatrix<T, L> random_matrix(std::size_t rows, std::size_t columns, std::mt19937& rng) {
+    std::uniform_real_distribution<T> dist(T(-1), T(1));
+    DenseMatrix<T, L> result(rows, columns);
+    for (T& e : result.values()) {
+        e = dist(rng);
+    }
+    return result;
+}
+
+/**
+ * Check `c == alpha * a * b + beta * c0` up to the rounding errors of the
+ * sums of `k` products.
+ */
+template <typename T, Layout LA, Layout LB, Layout LC>
+bool matches(T alpha, const DenseMatrix<T, LA>& a, const DenseMatrix<T, LB>& b, T beta,
+             const DenseMatrix<T, LC>& c0, const DenseMatrix<T, LC>& c) {
+    const T tolerance = T(4) * T(a.columns() + 1) * std::numeric_limits<T>::epsilon();
+    for (std::size_t i = 0; i < c.rows(); ++i) {
+        for (std::size_t j = 0; j < c.columns(); ++j) {
+            long double sum = 0.0L;
+            long double magnitude = 0.0L;
+            for (std::size_t p = 0; p < a.columns(); ++p) {
+                sum += static_cast<long double>(a(i, p)) * b(p, j);
+                magnitude += std::abs(static_cast<long double>(a(i, p)) * b(p, j));
+            }
+            const long double expected = alpha * sum + (beta == T(0) ? 0.0L : beta * static_cast<long double>(c0(i, j)));
+            const long double bound = tolerance * (std::abs(alpha) * magnitude + std::abs(beta * c0(i, j)) + 1e-30L);
+            if (!(std::abs(c(i, j) - expected) <= bound)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("The dense matrix stores the elements in its layout", "[dense_matrix]") {
+    DenseMatrix<float> a(2, 3);
+    DenseMatrix<float, Layout::column_major> b(2, 3);
+    REQUIRE(a.rows() == 2);
+    REQUIRE(a.columns() == 3);
+    REQUIRE(a.size() == 6);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(a.data()) % cache_line_size == 0);
+
+    a(1, 0) = 5.0f;
+    b(1, 0) = 5.0f;
+    REQUIRE(a.data()[3] == 5.0f);
+    REQUIRE(b.data()[1] == 5.0f);
+    REQUIRE(a.index(1, 2) == 5);
+    REQUIRE(b.index(1, 2) == 5);
+    REQUIRE(b.index(0, 2) == 4);
+
+    const DenseMatrix<float> m(Matrix<2, 3, float>(1.0f, 2.0f, 3.0f,
+                                                   4.0f, 5.0f, 6.0f));
+    REQUIRE(m(1, 2) == 6.0f);
+    REQUIRE(DenseMatrix<double>::identity(3)(1, 1) == 1.0);
+    REQUIRE(DenseMatrix<double>::identity(3)(1, 2) == 0.0);
+    REQUIRE(DenseMatrix<float>(2, 2, 1.5f) == DenseMatrix<float>(2, 2, 1.5f));
+    REQUIRE(!(DenseMatrix<float>(2, 2) == DenseMatrix<float>(2, 3)));
+}
+
+TEST_CASE("The product agrees with the naive product", "[dense_matrix]") {
+    std::mt19937 rng(97);
+
+    SECTION("the small matrices") {
+        const auto a = DenseMatrix<float>(Matrix<2, 3, float>(1.0f, 2.0f, 3.0f,
+                                                              4.0f, 5.0f, 6.0f));
+        const auto b = DenseMatrix<float>(Matrix<3, 2, float>(7.0f, 8.0f,
+                                                              9.0f, 10.0f,
+                                                              11.0f, 12.0f));
+        REQUIRE(a * b == DenseMatrix<float>(Matrix2f(58.0f, 64.0f,
+                                                     139.0f, 154.0f)));
+        const auto one = DenseMatrix<double>(1, 1, 3.0);
+        REQUIRE((one * one)(0, 0) == 9.0);
+    }
+
+    SECTION("the blocks with the edges") {
+        const auto a = random_matrix<float, Layout::row_major>(300, 700, rng);
+        const auto b = random_matrix<float, Layout::row_major>(700, 257, rng);
+        const auto c0 = random_matrix<float, Layout::row_major>(300, 257, rng);
+        auto c = c0;
+        gemm(0.5f, a, b, -2.0f, c);
+        REQUIRE(matches(0.5f, a, b, -2.0f, c0, c));
+    }
+
+    SECTION("the wide product over several column blocks") {
+        const auto a = random_matrix<double, Layout::row_major>(7, 3, rng);
+        const auto b = random_matrix<double, Layout::row_major>(3, 5000, rng);
+        DenseMatrix<double> c(7, 5000);
+        gemm(1.0, a, b, 0.0, c);
+        REQUIRE(matches(1.0, a, b, 0.0, c, c));
+    }
+
+    SECTION("all layouts") {
+        const auto check = [&]<Layout LA, Layout LB, Layout LC>() {
+            const auto a = random_matrix<double, LA>(45, 530, rng);
+            const auto b = random_matrix<double, LB>(530, 33, rng);
+            const auto c0 = random_matrix<double, LC>(45, 33, rng);
+            auto c = c0;
+            gemm(-1.0, a, b, 1.0, c);
+            REQUIRE(matches(-1.0, a, b, 1.0, c0, c));
+        };
+        constexpr auto row = Layout::row_major;
+        constexpr auto column = Layout::column_major;
+        check.template operator()<row, row, row>();
+        check.template operator()<row, row, column>();
+        check.template operator()<row, column, row>();
+        check.template operator()<row, column, column>();
+        check.template operator()<column, row, row>();
+        check.template operator()<column, row, column>();
+        check.template operator()<column, column, row>();
+        check.template operator()<column, column, column>();
+    }
+}
+
+TEST_CASE("The product follows the BLAS conventions", "[dense_matrix]") {
+    std::mt19937 rng(101);
+    const auto a = random_matrix<float, Layout::row_major>(9, 4, rng);
+    const auto b = random_matrix<float, Layout::row_major>(4, 11, rng);
+
+    SECTION("c is not read when beta is zero") {
+        DenseMatrix<float> c(9, 11, std::numeric_limits<float>::quiet_NaN());
+        gemm(1.0f, a, b, 0.0f, c);
+        REQUIRE(matches(1.0f, a, b, 0.0f, c, c));
+    }
+
+    SECTION("the empty inner dimension scales c") {
+        const DenseMatrix<float> empty_a(9, 0);
+        const DenseMatrix<float> empty_b(0, 11);
+        DenseMatrix<float> c(9, 11, 2.0f);
+        gemm(1.0f, empty_a, empty_b, 3.0f, c);
+        REQUIRE(c == DenseMatrix<float>(9, 11, 6.0f));
+    }
+}
+
+TEST_CASE("The parallel product equals the sequential one", "[dense_matrix][execution]") {
+    std::mt19937 rng(103);
+    const auto a = random_matrix<float, Layout::row_major>(513, 300, rng);
+    const auto b = random_matrix<float, Layout::column_major>(300, 129, rng);
+    DenseMatrix<float> c(513, 129);
+    DenseMatrix<float> d(513, 129);
+    gemm(1.0f, a, b, 0.0f, c);
+    ThreadPool pool(3);
+    gemm(execution::parallel_policy{&pool}, 1.0f, a, b, 0.0f, d);
+    REQUIRE(c == d);
+}
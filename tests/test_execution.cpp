@@ -0,0 +1,167 @@
+/*
+ * EXECUTION TESTS
+ *
+ * Every policy must give the same results as the sequential one (bit-identical
+ * for the element-wise operations, min and max) and the deterministic parallel
+ * reductions must not depend on the number of threads.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+#include <gof/math/execution.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+const Matrix4f projective(1.2f, 0.0f, 0.3f, 0.0f,
+                          0.0f, 1.7f, 0.0f, 0.1f,
+                          0.0f, 0.2f, -1.01f, -0.2f,
+                          0.0f, 0.0f, -1.0f, 0.0f);
+
+} // namespace
+
+TEST_CASE("The thread pool visits every element exactly once", "[execution]") {
+    for (std::size_t workers : {0, 1, 3}) {
+        ThreadPool pool(workers);
+        REQUIRE(pool.concurrency() == workers + 1);
+
+        for (std::size_t count : {0, 1, 100, 10007}) {
+            std::vector<std::atomic<int>> visits(count);
+            pool.parallel_for(count, 64, [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    visits[i].fetch_add(1);
+                }
+            });
+            for (const auto& v : visits) {
+                REQUIRE(v.load() == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("The nested parallel loops do not deadlock", "[execution]") {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> total{0};
+    pool.parallel_for(8, 1, [&](std::size_t, std::size_t) {
+        pool.parallel_for(100, 10, [&](std::size_t first, std::size_t last) { total += last - first; });
+    });
+    REQUIRE(total == 800);
+}
+
+TEST_CASE("The element-wise operations do not depend on the policy", "[execution]") {
+    ThreadPool pool(3);
+    const execution::parallel_policy par{&pool, 100};
+
+    auto in = test::random_vectors<3, float>(5000, 7, 100.0f);
+    const std::span<const Vector3f> input(in);
+    std::vector<Vector3f> expected(in.size()), actual(in.size());
+
+    transform_points(execution::seq, projective, input, std::span(expected));
+    transform_points(par, projective, input, std::span(actual));
+    REQUIRE(actual == expected);
+
+    transform_directions(execution::seq, projective, input, std::span(expected));
+    transform_directions(par, projective, input, std::span(actual));
+    REQUIRE(actual == expected);
+
+    in[10] = Vector3f::zero();
+    normalize(execution::seq, input, std::span(expected));
+    normalize(execution::unseq, input, std::span(actual));
+    REQUIRE(actual == expected);
+    normalize(par, input, std::span(actual));
+    REQUIRE(actual == expected);
+    REQUIRE(actual[10] == Vector3f::zero());
+}
+
+TEST_CASE("The homogeneous transform does not depend on the policy", "[execution]") {
+    ThreadPool pool(2);
+    std::vector<Vector4f> in(3000), expected(3000), actual(3000);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = Vector4f(float(i), 1.0f, -float(i) * 0.5f, 1.0f);
+    }
+    transform(execution::seq, projective, std::span<const Vector4f>(in), std::span(expected));
+    transform(execution::parallel_policy{&pool, 64}, projective, std::span<const Vector4f>(in), std::span(actual),
+              Store::streaming);
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("The min, max and bounding box do not depend on the policy", "[execution]") {
+    ThreadPool pool(3);
+    const auto data = test::random_vectors<3, float>(10000, 7, 100.0f);
+    const std::span<const Vector3f> vectors(data);
+
+    const auto lo = minimum(execution::seq, vectors);
+    const auto hi = maximum(execution::seq, vectors);
+    for (const auto& v : data) {
+        REQUIRE(min(lo, v) == lo);
+        REQUIRE(max(hi, v) == hi);
+    }
+
+    REQUIRE(minimum(execution::unseq, vectors) == lo);
+    REQUIRE(maximum(execution::unseq, vectors) == hi);
+    REQUIRE(minimum(execution::parallel_policy{&pool}, vectors) == lo);
+    REQUIRE(maximum(execution::parallel_policy{&pool}, vectors) == hi);
+
+    const auto [first, second] = bounding_box(execution::parallel_policy{&pool, 100}, vectors);
+    REQUIRE(first == lo);
+    REQUIRE(second == hi);
+}
+
+TEST_CASE("The reductions of the empty span give the identity", "[execution]") {
+    const std::span<const Vector3f> empty;
+    const float inf = std::numeric_limits<float>::infinity();
+    REQUIRE(sum(execution::par, empty) == Vector3f::zero());
+    REQUIRE(minimum(execution::par, empty) == Vector3f(inf, inf, inf));
+    REQUIRE(maximum(execution::seq, empty) == Vector3f(-inf, -inf, -inf));
+    const auto box = bounding_box(execution::unseq, empty);
+    REQUIRE(box.lower() == Vector3f(inf, inf, inf));
+    REQUIRE(box.upper() == Vector3f(-inf, -inf, -inf));
+    REQUIRE(bounding_box(execution::par, empty).is_empty());
+}
+
+TEST_CASE("The deterministic sum does not depend on the number of threads", "[execution]") {
+    const auto data = test::random_vectors<3, float>(100000, 7, 100.0f);
+    const std::span<const Vector3f> vectors(data);
+
+    ThreadPool single(0);
+    const auto expected = sum(execution::parallel_policy{&single, 0, true}, vectors);
+
+    for (std::size_t workers : {1, 2, 5}) {
+        ThreadPool pool(workers);
+        for (int run = 0; run < 5; ++run) {
+            REQUIRE(sum(execution::parallel_policy{&pool, 0, true}, vectors) == expected);
+        }
+    }
+
+    // The order differs from the sequential sum, so it agrees only closely.
+    const auto reference = sum(execution::seq, vectors);
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE(std::abs(expected.data()[k] - reference.data()[k]) < 1.0f);
+    }
+}
+
+TEST_CASE("The integer sum is exact for every policy", "[execution]") {
+    std::vector<Vector<2, long>> data(20000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = Vector<2, long>(long(i), -2 * long(i));
+    }
+    const std::span<const Vector<2, long>> vectors(data);
+    const long n = long(data.size());
+    const Vector<2, long> expected(n * (n - 1) / 2, -n * (n - 1));
+
+    ThreadPool pool(3);
+    REQUIRE(sum(execution::seq, vectors) == expected);
+    REQUIRE(sum(execution::unseq, vectors) == expected);
+    REQUIRE(sum(execution::parallel_policy{&pool, 128}, vectors) == expected);
+}
@@ -0,0 +1,109 @@
+/*
+ * EXPRESSION TEMPLATE TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * The leaf counting how many times each component is read.
+ */
+struct CountingLeaf : expression_tag
+{
+    using scalar_type = float;
+    static constexpr std::size_t dimension = 3;
+
+    const Vector3f& vector;
+    std::size_t* reads;
+
+    float at(std::size_t k, std::size_t) const noexcept {
+        ++reads[k];
+        return vector.data()[k];
+    }
+    std::size_t count() const noexcept { return 0; }
+};
+
+} // namespace
+
+SCENARIO("Lazy vector expressions", "[expression]")
+{
+    GIVEN("Three vectors and a scalar")
+    {
+        const Vector3f a(1.0f, 2.0f, 3.0f);
+        const Vector3f b(4.0f, 5.0f, 6.0f);
+        const Vector3f c(-1.0f, 0.5f, 2.0f);
+        const float s = 2.0f;
+
+        WHEN("the expression starts with `lazy()`")
+        {
+            auto e = lazy(a) + s * lazy(b) - c;
+
+            THEN("it is not evaluated until it is assigned")
+            {
+                STATIC_REQUIRE(Expression<decltype(e)>);
+                STATIC_REQUIRE_FALSE(std::is_same_v<decltype(e), Vector3f>);
+                STATIC_REQUIRE(decltype(e)::dimension == 3);
+            }
+            THEN("the result equals the eager evaluation")
+            {
+                const Vector3f r = e;
+                REQUIRE(r == a + s * b - c);
+            }
+        }
+
+        WHEN("the chain has eight operations")
+        {
+            const Vector3f r = -(lazy(a) + b - c + s * lazy(a) - lazy(b) * s + lazy(c) / s - a + b);
+            THEN("the result equals the eager evaluation")
+            {
+                const Vector3f expected = -(a + b - c + s * a - s * b + (1.0f / s) * c - a + b);
+                REQUIRE(r.x() == expected.x());
+                REQUIRE(r.y() == expected.y());
+                REQUIRE(r.z() == expected.z());
+            }
+        }
+    }
+}
+
+TEST_CASE("Lazy expression reads every operand component once", "[expression]") {
+    const Vector3f a(1.0f, 2.0f, 3.0f);
+    const Vector3f b(4.0f, 5.0f, 6.0f);
+    std::size_t reads_a[3] = {};
+    std::size_t reads_b[3] = {};
+
+    const Vector3f r = CountingLeaf{{}, a, reads_a} + 2.0f * CountingLeaf{{}, b, reads_b} - lazy(a);
+
+    REQUIRE(r == Vector3f(8.0f, 10.0f, 12.0f));
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE(reads_a[k] == 1);
+        REQUIRE(reads_b[k] == 1);
+    }
+}
+
+TEST_CASE("Lazy expressions over vector arrays are fused", "[expression]") {
+    std::vector<Vector3f> positions;
+    std::vector<Vector3f> velocities;
+    for (int i = 0; i < 50; ++i) {
+        positions.emplace_back(float(i), 1.0f, -float(i));
+        velocities.emplace_back(1.0f, float(i), 0.5f);
+    }
+    VectorArray3f p(positions);
+    const VectorArray3f v(velocities);
+    const Vector3f gravity(0.0f, -9.81f, 0.0f);
+    const float dt = 0.1f;
+
+    p.assign(lazy(p) + dt * (lazy(v) + dt * lazy(gravity)));
+
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        REQUIRE(p[i] == positions[i] + dt * (velocities[i] + dt * gravity));
+    }
+}
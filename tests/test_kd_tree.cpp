@@ -0,0 +1,135 @@
+/*
+ * K-D TREE TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+#include <gof/math/spatial/KdTree.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * All points sorted by their distance to the query.
+ */
+template <std::size_t N, typename T>
+std::vector<Neighbour<T>> brute_force(const std::vector<Vector<N, T>>& points, const Vector<N, T>& query) {
+    std::vector<Neighbour<T>> result;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        result.push_back({static_cast<std::uint32_t>(i), (query - points[i]).length_squared()});
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The empty k-d tree finds nothing", "[kd_tree]") {
+    const KdTree<3, float> tree;
+    Neighbour<float> out[2];
+
+    REQUIRE(tree.empty());
+    REQUIRE(tree.nearest(Vector3f::zero()).index == KdTree<3, float>::npos);
+    REQUIRE(tree.knn(Vector3f::zero(), std::span(out)) == 0);
+    REQUIRE(out[1].distance_squared == std::numeric_limits<float>::infinity());
+}
+
+TEST_CASE("The k-d tree finds the nearest neighbours", "[kd_tree]") {
+    const auto points = test::random_vectors<3, float>(5000, 41, 10.0f);
+    const auto queries = test::random_vectors<3, float>(200, 43, 10.0f);
+    const KdTree<3, float> tree{std::span<const Vector3f>(points)};
+    REQUIRE(tree.size() == points.size());
+
+    for (const auto& query : queries) {
+        const auto expected = brute_force(points, query);
+        REQUIRE(tree.nearest(query) == expected[0]);
+
+        std::vector<Neighbour<float>> found(16);
+        REQUIRE(tree.knn(query, std::span(found)) == 16);
+        REQUIRE(std::equal(found.begin(), found.end(), expected.begin()));
+    }
+
+    SECTION("more neighbours than points") {
+        const std::vector<Vector3f> few = {Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 2.0f, 0.0f)};
+        const KdTree<3, float> small{std::span<const Vector3f>(few)};
+        std::vector<Neighbour<float>> found(4);
+        REQUIRE(small.knn(Vector3f::zero(), std::span(found)) == 2);
+        REQUIRE(found[0] == Neighbour<float>{0, 1.0f});
+        REQUIRE(found[1] == Neighbour<float>{1, 4.0f});
+        REQUIRE(found[2].index == KdTree<3, float>::npos);
+    }
+}
+
+TEST_CASE("The k-d tree finds the points within the radius", "[kd_tree]") {
+    const auto points = test::random_vectors<2, double>(4000, 47, 10.0);
+    const auto queries = test::random_vectors<2, double>(100, 53, 10.0);
+    const KdTree<2, double> tree{std::span<const Vector2d>(points)};
+
+    for (const auto& query : queries) {
+        std::vector<Neighbour<double>> found;
+        tree.radius_search(query, 1.5, [&](const Neighbour<double>& n) { found.push_back(n); });
+        std::sort(found.begin(), found.end());
+
+        auto expected = brute_force(points, query);
+        expected.erase(std::find_if(expected.begin(), expected.end(),
+                                    [](const Neighbour<double>& n) { return n.distance_squared > 2.25; }),
+                       expected.end());
+        REQUIRE(found == expected);
+    }
+}
+
+TEST_CASE("The k-d tree handles the duplicate points", "[kd_tree]") {
+    std::vector<Vector3f> points(100, Vector3f(1.0f, 1.0f, 1.0f));
+    points.push_back(Vector3f::zero());
+    const KdTree<3, float> tree{std::span<const Vector3f>(points)};
+
+    std::vector<Neighbour<float>> found(3);
+    tree.knn(Vector3f(0.9f, 0.9f, 0.9f), std::span(found));
+    REQUIRE(found[0].index == 0);
+    REQUIRE(found[1].index == 1);
+    REQUIRE(found[2].index == 2);
+    REQUIRE(tree.nearest(Vector3f(0.1f, 0.0f, 0.0f)).index == 100);
+}
+
+TEST_CASE("The batched queries agree with the single ones", "[kd_tree][execution]") {
+    const auto points = test::random_vectors<3, float>(40000, 59, 10.0f);
+    const auto queries = test::random_vectors<3, float>(3000, 61, 10.0f);
+    ThreadPool pool(3);
+    const execution::parallel_policy policy{&pool, 64};
+    const KdTree<3, float> tree{std::span<const Vector3f>(points)};
+    const KdTree<3, float> parallel(policy, std::span<const Vector3f>(points));
+
+    constexpr std::size_t k = 5;
+    std::vector<Neighbour<float>> sequential_knn(queries.size() * k);
+    std::vector<Neighbour<float>> parallel_knn(queries.size() * k);
+    tree.knn(execution::seq, std::span<const Vector3f>(queries), k, std::span(sequential_knn));
+    parallel.knn(policy, std::span<const Vector3f>(queries), k, std::span(parallel_knn));
+    REQUIRE(sequential_knn == parallel_knn);
+    for (std::size_t i = 0; i < queries.size(); i += 97) {
+        std::vector<Neighbour<float>> found(k);
+        tree.knn(queries[i], std::span(found));
+        REQUIRE(std::equal(found.begin(), found.end(), sequential_knn.begin() + i * k));
+    }
+
+    const auto sequential_within = tree.radius_search(execution::seq, std::span<const Vector3f>(queries), 1.0f);
+    const auto parallel_within = parallel.radius_search(policy, std::span<const Vector3f>(queries), 1.0f);
+    REQUIRE(sequential_within.offsets == parallel_within.offsets);
+    REQUIRE(sequential_within.neighbours == parallel_within.neighbours);
+    for (std::size_t i = 0; i < queries.size(); i += 97) {
+        std::size_t count = 0;
+        tree.radius_search(queries[i], 1.0f, [&](const Neighbour<float>&) { ++count; });
+        REQUIRE(sequential_within[i].size() == count);
+        REQUIRE(std::is_sorted(sequential_within[i].begin(), sequential_within[i].end()));
+    }
+}
@@ -6,18 +6,204 @@
 
 #include <gof/math/types>
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 
 using namespace gof;
 
 TEST_CASE("Matrix constructor works", "[matrix]") {
     Matrix<2, 2, float> A(1.0f, 2.0f, 3.0f, 4.0f);
     const std::array<float, 4> b({1.0f, 2.0f, 3.0f, 4.0f});
-    REQUIRE( A.values() == b );
+    REQUIRE( std::ranges::equal(A.values(), b) );
+    REQUIRE( A.to_array() == b );
 }
 
 TEST_CASE("Matrix get row works", "[matrix]") {
     Matrix<2, 2, float> A(1.0f, 2.0f, 3.0f, 4.0f);
-    Vector<2, float>  r1{0.0f, 0.0f}; // FIXME Should return 1st row.
+    Vector<2, float>  r0{1.0f, 2.0f};
+    Vector<2, float>  r1{3.0f, 4.0f};
+    REQUIRE(A.row(0) == r0);
     REQUIRE(A.row(1) == r1);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Matrix get column works", "[matrix]") {
+    Matrix<2, 3, float> A(1.0f, 2.0f, 3.0f,
+                          4.0f, 5.0f, 6.0f);
+    REQUIRE(A.column(0) == Vector2f(1.0f, 4.0f));
+    REQUIRE(A.column(2) == Vector2f(3.0f, 6.0f));
+    REQUIRE(A(1, 2) == 6.0f);
+}
+
+TEST_CASE("Matrix layouts store the same matrix", "[matrix]") {
+    Matrix<2, 3, float, Layout::row_major> A(1.0f, 2.0f, 3.0f,
+                                             4.0f, 5.0f, 6.0f);
+    Matrix<2, 3, float, Layout::column_major> B(1.0f, 2.0f, 3.0f,
+                                                4.0f, 5.0f, 6.0f);
+    const std::array<float, 6> b({1.0f, 4.0f, 2.0f, 5.0f, 3.0f, 6.0f});
+    REQUIRE(std::ranges::equal(B.values(), b));
+    for (std::size_t i = 0; i < 2; ++i) {
+        REQUIRE(A.row(i) == B.row(i));
+    }
+}
+
+SCENARIO("Matrix products works", "[matrix]")
+{
+    GIVEN("Two non-square matrices")
+    {
+        constexpr Matrix<2, 3, float> A(1.0f, 2.0f, 3.0f,
+                                        4.0f, 5.0f, 6.0f);
+        constexpr Matrix<3, 2, float> B(7.0f,  8.0f,
+                                        9.0f,  10.0f,
+                                        11.0f, 12.0f);
+        WHEN("they are multiplied")
+        {
+            THEN("we get the matrix product")
+            {
+                STATIC_REQUIRE(A * B == Matrix<2, 2, float>(58.0f, 64.0f, 139.0f, 154.0f));
+                REQUIRE(A * B == Matrix<2, 2, float>(58.0f, 64.0f, 139.0f, 154.0f));
+            }
+        }
+        WHEN("the matrix is multiplied by the vector")
+        {
+            THEN("we get the vector")
+            {
+                STATIC_REQUIRE(A * Vector3f(1.0f, 0.0f, -1.0f) == Vector2f(-2.0f, -2.0f));
+            }
+        }
+    }
+
+    GIVEN("A 4x4 matrix")
+    {
+        const Matrix4f A(1.5f, -2.0f, 3.25f, 4.0f,
+                         0.1f, 0.2f, 0.3f, 0.4f,
+                         -7.0f, 8.0f, 9.0f, -10.0f,
+                         11.0f, 0.5f, -13.0f, 14.0f);
+        const Matrix4f B(0.3f, 1.0f, -2.0f, 5.0f,
+                         6.0f, -0.7f, 8.0f, 9.0f,
+                         1.0f, 2.0f, 3.0f, 4.0f,
+                         -5.0f, 6.0f, 0.25f, 8.0f);
+
+        WHEN("it is multiplied by the identity")
+        {
+            THEN("we get the same matrix")
+            {
+                REQUIRE(A * Matrix4f::identity() == A);
+                REQUIRE(Matrix4f::identity() * A == A);
+            }
+        }
+        WHEN("the SIMD kernel is used")
+        {
+            THEN("the result is identical to the scalar kernel")
+            {
+                Matrix4f expected;
+                detail::multiply_row_major<4, 4, 4>(A.data(), B.data(), expected.data());
+                REQUIRE(A * B == expected);
+
+                const Vector4f v(1.0f, -2.0f, 0.5f, 3.0f);
+                Vector4f r;
+                for (std::size_t i = 0; i < 4; ++i) {
+                    r.data()[i] = multiply_add(A(i, 3), v.w(), multiply_add(A(i, 2), v.z(), multiply_add(A(i, 1), v.y(), A(i, 0) * v.x())));
+                }
+                REQUIRE(A * v == r);
+            }
+        }
+        WHEN("it is stored in the column-major order")
+        {
+            const auto a = A.values();
+            const auto b = B.values();
+            Matrix<4, 4, float, Layout::column_major> C;
+            Matrix<4, 4, float, Layout::column_major> D;
+            C = {a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15]};
+            D = {b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b[8], b[9], b[10], b[11], b[12], b[13], b[14], b[15]};
+
+            THEN("the products are the same")
+            {
+                const auto P = A * B;
+                const auto Q = C * D;
+                for (std::size_t i = 0; i < 4; ++i) {
+                    REQUIRE(P.row(i) == Q.row(i));
+                }
+                const Vector4f v(1.0f, -2.0f, 0.5f, 3.0f);
+                REQUIRE(A * v == C * v);
+            }
+        }
+    }
+
+    GIVEN("A 4x4 matrix of doubles")
+    {
+        const Matrix4d A(1.5, -2.0, 3.25, 4.0, 0.1, 0.2, 0.3, 0.4, -7.0, 8.0, 9.0, -10.0, 11.0, 0.5, -13.0, 14.0);
+        const Matrix4d B(0.3, 1.0, -2.0, 5.0, 6.0, -0.7, 8.0, 9.0, 1.0, 2.0, 3.0, 4.0, -5.0, 6.0, 0.25, 8.0);
+        THEN("the SIMD kernel is identical to the scalar kernel")
+        {
+            Matrix4d expected;
+            detail::multiply_row_major<4, 4, 4>(A.data(), B.data(), expected.data());
+            REQUIRE(A * B == expected);
+        }
+    }
+}
+
+TEST_CASE("Matrix row and column views refer to the elements", "[matrix]") {
+    static_assert(std::random_access_iterator<StridedView<const float, 3>::iterator>);
+    static_assert(std::ranges::random_access_range<StridedView<const float, 3>>);
+
+    const Matrix<2, 3, float, Layout::row_major> A(1.0f, 2.0f, 3.0f,
+                                                   4.0f, 5.0f, 6.0f);
+    const Matrix<2, 3, float, Layout::column_major> B(1.0f, 2.0f, 3.0f,
+                                                      4.0f, 5.0f, 6.0f);
+
+    const std::array<float, 3> r1{4.0f, 5.0f, 6.0f};
+    const std::array<float, 2> c2{3.0f, 6.0f};
+    REQUIRE(std::ranges::equal(A.row_view(1), r1));
+    REQUIRE(std::ranges::equal(B.row_view(1), r1));
+    REQUIRE(std::ranges::equal(A.column_view(2), c2));
+    REQUIRE(std::ranges::equal(B.column_view(2), c2));
+
+    REQUIRE(&A.row_view(1)[2] == &A.data()[5]);
+    REQUIRE(&B.column_view(2)[1] == &B.data()[5]);
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            REQUIRE(A[i][j] == A(i, j));
+            REQUIRE(B[i][j] == B(i, j));
+        }
+    }
+
+    float sum = 0.0f;
+    for (float e : B.column_view(1)) {
+        sum += e;
+    }
+    REQUIRE(sum == 7.0f);
+    REQUIRE(A.column_view(0).end() - A.column_view(0).begin() == 2);
+}
+
+TEST_CASE("Matrix views work at compile time", "[matrix]") {
+    constexpr Matrix<3, 3, double> A(1.0, 2.0, 3.0,
+                                     4.0, 5.0, 6.0,
+                                     7.0, 8.0, 9.0);
+    static_assert(A[2][1] == 8.0);
+    static_assert(A.column_view(2)[0] == 3.0);
+    static_assert(A.values()[4] == 5.0);
+    static_assert(*(A.row_view(1).end() - 1) == 6.0);
+}
+
+TEST_CASE("Matrix is_close() compares with tolerance", "[matrix]") {
+    const Matrix2f A(1.0f, 2.0f,
+                     3.0f, 4.0f);
+    const Matrix2f B(1.0f, 2.0f,
+                     3.0f, 4.0f + 4e-7f);
+
+    REQUIRE(A != B);
+    REQUIRE(A.is_close(B));
+    REQUIRE_FALSE(A.is_close(B, tolerance::Exact{}));
+    REQUIRE_FALSE(A.is_close(Matrix2f::identity()));
+    static_assert(Matrix3d::identity().is_close(Matrix3d::identity(), tolerance::Ulps<double>{0}));
+}
+
+TEST_CASE("Matrix hash is consistent with ==", "[matrix]") {
+    const std::hash<Matrix2f> hash;
+
+    REQUIRE(hash(Matrix2f(1.0f, 2.0f, 3.0f, 4.0f)) == hash(Matrix2f(1.0f, 2.0f, 3.0f, 4.0f)));
+    REQUIRE(hash(Matrix2f(-0.0f, 2.0f, 3.0f, 4.0f)) == hash(Matrix2f(0.0f, 2.0f, 3.0f, 4.0f)));
+    REQUIRE(hash(Matrix2f(1.0f, 2.0f, 3.0f, 4.0f)) != hash(Matrix2f(1.0f, 3.0f, 2.0f, 4.0f)));
+}
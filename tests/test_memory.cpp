@@ -0,0 +1,166 @@
+/*
+ * MEMORY TESTS
+ *
+ * The global `operator new` is replaced by the counting one, so the tests can
+ * require that a frame built on the `FrameArena` does not touch the heap. The
+ * replacement affects the whole program, the tests have their own executable.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+#include <gof/math/memory.hpp>
+#include <gof/math/transform.hpp>
+#include <gof/math/spatial/Bvh.hpp>
+#include <gof/math/spatial/KdTree.hpp>
+#include <gof/math/spatial/SpatialHash.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace gof::test {
+
+/**
+ * The number of the calls of the global `operator new`, replaced in
+ * `counting_new.cpp`.
+ */
+std::size_t heap_allocations() noexcept;
+
+} // namespace gof::test
+
+using namespace gof;
+
+namespace {
+
+bool is_aligned(const void* p, std::size_t alignment) noexcept {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("The arena bumps the aligned memory and resets it", "[memory]") {
+    FrameArena arena(1024);
+    REQUIRE(arena.capacity() == 1024);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(100, 16);
+    REQUIRE(is_aligned(a, cache_line_size));
+    REQUIRE(is_aligned(b, cache_line_size));
+    REQUIRE(static_cast<std::byte*>(b) - static_cast<std::byte*>(a) == 64);
+    REQUIRE(arena.used() == 164);
+    REQUIRE(is_aligned(arena.allocate(8, 256), 256));
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.allocate(3, 1) == a);
+
+    SECTION("it grows by the blocks kept over the reset") {
+        const std::byte* big = static_cast<std::byte*>(arena.allocate(4096, 64));
+        REQUIRE(arena.capacity() > 4096);
+        const std::size_t capacity = arena.capacity();
+        arena.reset();
+        REQUIRE(arena.allocate(3, 1) == a);
+        REQUIRE(arena.allocate(4096, 64) == big);
+        REQUIRE(arena.capacity() == capacity);
+    }
+}
+
+TEST_CASE("The arena serves the threads of the pool", "[memory][execution]") {
+    FrameArena arena(4096);
+    ThreadPool pool(3);
+    std::vector<std::byte*> blocks(2000);
+    pool.parallel_for(blocks.size(), 16, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            blocks[i] = static_cast<std::byte*>(arena.allocate(40, 8));
+        }
+    });
+    std::sort(blocks.begin(), blocks.end());
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        REQUIRE(is_aligned(blocks[i], cache_line_size));
+        REQUIRE((i == 0 || blocks[i] - blocks[i - 1] >= 40));
+    }
+}
+
+TEST_CASE("The polymorphic allocator keeps the alignment", "[memory]") {
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    static_cast<void>(resource.allocate(1, 1));
+
+    pmr::VectorArray<3, float> array(10, &resource);
+    REQUIRE(array.get_allocator().resource() == &resource);
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE(is_aligned(array.lane(k).data(), cache_line_size));
+    }
+
+    SECTION("the copy uses the default resource") {
+        const pmr::VectorArray<3, float> copy = array;
+        REQUIRE(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+}
+
+TEST_CASE("The heap allocations are counted", "[memory]") {
+    const std::size_t before = test::heap_allocations();
+    const auto p = std::make_unique<Vector3f>();
+    REQUIRE(test::heap_allocations() == before + 1);
+}
+
+TEST_CASE("The frame on the arena does not allocate from the heap", "[memory][execution]") {
+    const auto points = test::random_vectors<3, float>(1 << 15, 67, 50.0f);
+    std::vector<Aabb3f> boxes;
+    for (const auto& p : points) {
+        boxes.emplace_back(p, p + Vector3f(0.5f, 0.5f, 0.5f));
+    }
+    const Matrix4f m(0.5f, -0.2f, 0.1f, 10.0f,
+                     0.3f, 0.9f, -0.4f, -2.0f,
+                     0.0f, 0.7f, 1.1f, 3.5f,
+                     0.0f, 0.0f, 0.0f, 1.0f);
+    ThreadPool pool(2);
+    const execution::parallel_policy policy{&pool, 1024};
+    FrameArena arena(1 << 16);
+
+    // The first frame grows the arena and warms up the pool, the rest must
+    // be served by the arena alone.
+    std::size_t heap = 0;
+    std::size_t capacity = 0;
+    float checksum = 0.0f;
+    for (std::size_t frame = 0; frame < 4; ++frame) {
+        arena.reset();
+        const std::size_t before = test::heap_allocations();
+        {
+            pmr::VectorArray<3, float> in(std::span<const Vector3f>(points), &arena);
+            pmr::VectorArray<3, float> out(in.size(), &arena);
+            transform_points(m, in, out);
+
+            pmr::SpatialHash<3, float> unique(0.01f, points.size(), &arena);
+            for (const auto& p : points) {
+                unique.insert(p);
+            }
+
+            const pmr::KdTree<3, float> tree(policy, std::span<const Vector3f>(points), &arena);
+            const auto queries = std::span<const Vector3f>(points).first(256);
+            std::pmr::vector<Neighbour<float>> nearest(queries.size() * 4, &arena);
+            tree.knn(policy, queries, 4, std::span(nearest));
+            const auto within = tree.radius_search(policy, queries, 5.0f);
+
+            const pmr::Bvh<float> bvh(policy, std::span<const Aabb3f>(boxes), 4, &arena);
+
+            checksum += out[7].x() + float(unique.size()) + nearest[5].distance_squared +
+                        float(within.neighbours.size()) + float(bvh.nodes().size());
+        }
+        if (frame == 0) {
+            capacity = arena.capacity();
+        } else {
+            heap += test::heap_allocations() - before;
+        }
+    }
+    REQUIRE(heap == 0);
+    REQUIRE(arena.capacity() == capacity);
+    REQUIRE(checksum > 0.0f);
+}
@@ -0,0 +1,270 @@
+/*
+ * PACKING TESTS
+ *
+ * The storage scalars (`Half`, `BFloat16`, `Fixed`) and the compact encodings
+ * of the vectors.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/packing.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+using Fixed16 = Fixed<16>;
+using Fixed8 = Fixed<8, std::int16_t>;
+
+std::vector<Vector3f> unit_vectors() {
+    std::vector<Vector3f> result;
+    for (int i = 0; i < 997; ++i) {
+        const float z = 1.0f - float(2 * i + 1) / 997.0f;
+        const float r = std::sqrt(1.0f - z * z);
+        const float phi = 2.39996323f * float(i);
+        result.emplace_back(r * std::cos(phi), r * std::sin(phi), z);
+    }
+    // The poles and the folds of the octahedron.
+    result.emplace_back(0.0f, 0.0f, 1.0f);
+    result.emplace_back(0.0f, 0.0f, -1.0f);
+    result.emplace_back(1.0f, 0.0f, 0.0f);
+    result.emplace_back(0.0f, -1.0f, 0.0f);
+    result.emplace_back(0.6f, -0.8f, 0.0f);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Half rounds to the nearest binary16", "[packing]") {
+    static_assert(Half(1.0f).bits() == 0x3c00);
+    static_assert(Half(-2.0f).bits() == 0xc000);
+    static_assert(Half(65504.0f).bits() == 0x7bff);
+    static_assert(Half(65520.0f).bits() == 0x7c00);
+    static_assert(Half(0x1p-24f).bits() == 0x0001);
+    static_assert(Half(0x1p-25f).bits() == 0x0000);
+    static_assert(static_cast<float>(Half::from_bits(0x3555)) == 0.333251953125f);
+    static_assert(Half(1.0f) + Half(2.0f) == Half(3.0f));
+    static_assert(-Half(0.0f) == Half(0.0f));
+    static_assert(std::numeric_limits<Half>::max() == Half(65504.0f));
+
+    // The ties go to the even significand.
+    REQUIRE(Half(1.0f + 0x1p-11f).bits() == 0x3c00);
+    REQUIRE(Half(1.0f + 3 * 0x1p-11f).bits() == 0x3c02);
+
+    REQUIRE(std::isinf(static_cast<float>(Half(1e10f))));
+    REQUIRE(std::isnan(static_cast<float>(Half(std::numeric_limits<float>::quiet_NaN()))));
+    REQUIRE(Half(std::numeric_limits<float>::quiet_NaN()) != Half(std::numeric_limits<float>::quiet_NaN()));
+
+    // Every binary16 converts to `float` and back unchanged.
+    for (std::uint32_t bits = 0; bits < 0x10000u; ++bits) {
+        const auto h = Half::from_bits(static_cast<std::uint16_t>(bits));
+        const float f = static_cast<float>(h);
+        if (std::isnan(f)) {
+            continue;
+        }
+        REQUIRE(Half(f).bits() == h.bits());
+    }
+}
+
+TEST_CASE("BFloat16 keeps the upper half of float", "[packing]") {
+    static_assert(BFloat16(1.0f).bits() == 0x3f80);
+    static_assert(static_cast<float>(BFloat16(3.0f)) == 3.0f);
+    static_assert(BFloat16(1e38f) * BFloat16(0.5f) == BFloat16(5e37f));
+
+    REQUIRE(BFloat16(1.0f + 0x1p-8f).bits() == 0x3f80);
+    REQUIRE(BFloat16(1.0f + 3 * 0x1p-8f).bits() == 0x3f82);
+    REQUIRE(std::isnan(static_cast<float>(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    REQUIRE(std::abs(static_cast<float>(BFloat16(3.14159f)) - 3.14159f) < 0.01f);
+}
+
+TEST_CASE("Fixed is the scaled integer", "[packing]") {
+    static_assert(Fixed16(1.5).raw() == 0x18000);
+    static_assert(Fixed16(1.5) * Fixed16(2) == Fixed16(3));
+    static_assert(Fixed16(1) / Fixed16(4) == Fixed16(0.25));
+    static_assert(Fixed16(-1.25) + Fixed16(0.25) == Fixed16(-1));
+    static_assert(-Fixed16(2) < Fixed16(1));
+    static_assert(abs(Fixed16(-3)) == Fixed16(3));
+
+    // Saturated to the range of the storage.
+    REQUIRE(Fixed8(1000.0).raw() == std::numeric_limits<std::int16_t>::max());
+    REQUIRE(Fixed8(-1000.0).raw() == std::numeric_limits<std::int16_t>::min());
+    REQUIRE(static_cast<double>(Fixed8(0.1)) == 26.0 / 256.0);
+}
+
+TEST_CASE("Vector holds the storage scalars", "[packing]") {
+    static_assert(sizeof(Vector3h) == 6);
+    static_assert(sizeof(Vector<3, Fixed8>) == 6);
+
+    constexpr Vector3h u(1.0f, 2.0f, 2.0f);
+    constexpr Vector3h v(0.5f, -1.0f, 0.0f);
+    static_assert(u + v == Vector3h(1.5f, 1.0f, 2.0f));
+    static_assert(scalar_product(u, v) == Half(-1.5f));
+    static_assert(u.length() == Half(3.0f));
+    static_assert(min(u, v) == Vector3h(0.5f, -1.0f, 0.0f));
+
+    constexpr Vector<3, Fixed8> p(1.0, 2.0, 2.0);
+    static_assert(p.length() == Fixed8(3));
+    static_assert(Fixed8(2) * p == Vector<3, Fixed8>(2.0, 4.0, 4.0));
+    REQUIRE(Vector<2, BFloat16>(3.0f, 4.0f).length() == BFloat16(5.0f));
+}
+
+TEST_CASE("Bulk conversion equals the scalar conversion", "[packing]") {
+    for (std::size_t count : {0u, 1u, 3u, 8u, 9u, 100u}) {
+        std::vector<Vector3f> in;
+        std::vector<Vector4f> in4;
+        for (std::size_t i = 0; i < count; ++i) {
+            const float f = float(i) * 0.731f - 20.0f;
+            in.emplace_back(f, 1.0f / (f + 0.5f), f * 1e-6f);
+            in4.emplace_back(f, -f, 3.0f * f, 1e6f * f);
+        }
+
+        std::vector<Vector3h> half(count);
+        convert(std::span<const Vector3f>(in), std::span(half));
+        std::vector<Vector3f> back(count);
+        convert(std::span<const Vector3h>(half), std::span(back));
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                REQUIRE(half[i][k].bits() == Half(in[i][k]).bits());
+                REQUIRE(back[i][k] == static_cast<float>(half[i][k]));
+            }
+        }
+
+        std::vector<Vector4h> half4(count);
+        convert(std::span<const Vector4f>(in4), std::span(half4));
+        std::vector<Vector4f> back4(count);
+        convert(std::span<const Vector4h>(half4), std::span(back4));
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                REQUIRE(half4[i][k].bits() == Half(in4[i][k]).bits());
+                REQUIRE(std::bit_cast<std::uint32_t>(back4[i][k]) == std::bit_cast<std::uint32_t>(static_cast<float>(half4[i][k])));
+            }
+        }
+
+        std::vector<Vector<3, BFloat16>> brain(count);
+        convert(std::span<const Vector3f>(in), std::span(brain));
+        std::vector<Vector<3, Fixed16>> fixed(count);
+        convert(std::span<const Vector3f>(in), std::span(fixed));
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(brain[i] == Vector<3, BFloat16>(in[i].x(), in[i].y(), in[i].z()));
+            REQUIRE(fixed[i] == Vector<3, Fixed16>(in[i].x(), in[i].y(), in[i].z()));
+        }
+    }
+}
+
+TEST_CASE("Bulk Half conversion handles the special values", "[packing]") {
+    // Every binary16, including the subnormals, infinities and NaNs.
+    std::vector<Vector4h> all;
+    for (std::uint32_t bits = 0; bits < 0x10000u; bits += 4) {
+        all.emplace_back(Half::from_bits(std::uint16_t(bits)), Half::from_bits(std::uint16_t(bits + 1)),
+                         Half::from_bits(std::uint16_t(bits + 2)), Half::from_bits(std::uint16_t(bits + 3)));
+    }
+    std::vector<Vector4f> wide(all.size());
+    convert(std::span<const Vector4h>(all), std::span(wide));
+    std::vector<Vector4h> narrow(all.size());
+    convert(std::span<const Vector4f>(wide), std::span(narrow));
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            REQUIRE(std::bit_cast<std::uint32_t>(wide[i][k]) == std::bit_cast<std::uint32_t>(static_cast<float>(all[i][k])));
+            // The signalling NaNs come back quiet, everything else bit exact.
+            REQUIRE(narrow[i][k].bits() == Half(static_cast<float>(all[i][k])).bits());
+            if (!(all[i][k] != all[i][k])) {
+                REQUIRE(narrow[i][k].bits() == all[i][k].bits());
+            }
+        }
+    }
+
+    const float inf = std::numeric_limits<float>::infinity();
+    const std::vector<Vector4f> in = {
+        {inf, -inf, std::numeric_limits<float>::quiet_NaN(), 65519.0f},
+        {65520.0f, -1e30f, 0x1p-25f, 0x1.8p-25f},
+        {-0x1p-24f, 1e-40f, -0.0f, 6.1e-5f},
+        {1.0f + 0x1p-11f, 1.0f + 3 * 0x1p-11f, 2049.0f, -2051.0f},
+    };
+    std::vector<Vector4h> out(in.size());
+    convert(std::span<const Vector4f>(in), std::span(out));
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            REQUIRE(out[i][k].bits() == Half(in[i][k]).bits());
+        }
+    }
+}
+
+TEST_CASE("Octahedral encoding keeps the unit vectors", "[packing]") {
+    static_assert(decode_octahedral(encode_octahedral(Vector3f(0.0f, 0.0f, -1.0f))) == Vector3f(0.0f, 0.0f, -1.0f));
+    static_assert(decode_octahedral(encode_octahedral(Vector3f(0.0f, 0.0f, 1.0f))) == Vector3f(0.0f, 0.0f, 1.0f));
+    static_assert(decode_octahedral(encode_octahedral(Vector3f())) == Vector3f(0.0f, 0.0f, 1.0f));
+
+    const auto in = unit_vectors();
+    std::vector<std::uint32_t> bits(in.size());
+    encode_octahedral(std::span<const Vector3f>(in), std::span(bits));
+    std::vector<Vector3f> out(in.size());
+    decode_octahedral(std::span<const std::uint32_t>(bits), std::span(out));
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(bits[i] == encode_octahedral(in[i]));
+        REQUIRE(std::abs(out[i].length() - 1.0f) < 1e-6f);
+        // The sine of the angle between the vectors, `acos()` is inaccurate
+        // for the small angles.
+        REQUIRE(vector_product(in[i], out[i]).length() < 1e-4f);
+    }
+}
+
+TEST_CASE("10:10:10:2 packing quantizes the components", "[packing]") {
+    static_assert(pack_unorm_1010102(Vector4f(1.0f, 0.0f, 1.0f, 1.0f)) == 0xfff003ffu);
+    static_assert(unpack_unorm_1010102(0xfff003ffu) == Vector4f(1.0f, 0.0f, 1.0f, 1.0f));
+    static_assert(unpack_snorm_1010102(pack_snorm_1010102(Vector4f(-1.0f, 1.0f, 0.0f, -1.0f))) == Vector4f(-1.0f, 1.0f, 0.0f, -1.0f));
+
+    // The most negative integer decodes to -1 as well.
+    REQUIRE(unpack_snorm_1010102(0x200u).x() == -1.0f);
+    // The out of range values are clamped.
+    REQUIRE(unpack_unorm_1010102(pack_unorm_1010102(Vector4f(2.0f, -1.0f, 0.5f, 0.4f))) ==
+            Vector4f(1.0f, 0.0f, 512.0f / 1023.0f, 1.0f / 3.0f));
+
+    std::vector<Vector4f> in;
+    for (int i = 0; i < 301; ++i) {
+        const float f = float(i) / 300.0f;
+        in.emplace_back(f, 1.0f - f, 0.5f * f, f > 0.5f ? 1.0f : 0.0f);
+    }
+    std::vector<std::uint32_t> unorm(in.size());
+    std::vector<std::uint32_t> snorm(in.size());
+    pack_unorm_1010102(std::span<const Vector4f>(in), std::span(unorm));
+    pack_snorm_1010102(std::span<const Vector4f>(in), std::span(snorm));
+    std::vector<Vector4f> a(in.size());
+    std::vector<Vector4f> b(in.size());
+    unpack_unorm_1010102(std::span<const std::uint32_t>(unorm), std::span(a));
+    unpack_snorm_1010102(std::span<const std::uint32_t>(snorm), std::span(b));
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(unorm[i] == pack_unorm_1010102(in[i]));
+        REQUIRE(snorm[i] == pack_snorm_1010102(in[i]));
+        for (std::size_t k = 0; k < 3; ++k) {
+            REQUIRE(std::abs(a[i][k] - in[i][k]) <= 0.5f / 1023.0f + 1e-6f);
+            REQUIRE(std::abs(b[i][k] - in[i][k]) <= 0.5f / 511.0f + 1e-6f);
+        }
+        REQUIRE(a[i].w() == in[i].w());
+        REQUIRE(b[i].w() == in[i].w());
+    }
+
+    SECTION("NaN is clamped to the lower bound") {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const std::vector<Vector4f> nans(5, Vector4f(nan, 0.5f, nan, nan));
+        REQUIRE(unpack_unorm_1010102(pack_unorm_1010102(nans[0])) == Vector4f(0.0f, 512.0f / 1023.0f, 0.0f, 0.0f));
+        REQUIRE(unpack_snorm_1010102(pack_snorm_1010102(nans[0])) == Vector4f(-1.0f, 256.0f / 511.0f, -1.0f, -1.0f));
+
+        pack_unorm_1010102(std::span<const Vector4f>(nans), std::span(unorm).first(nans.size()));
+        pack_snorm_1010102(std::span<const Vector4f>(nans), std::span(snorm).first(nans.size()));
+        for (std::size_t i = 0; i < nans.size(); ++i) {
+            REQUIRE(unorm[i] == pack_unorm_1010102(nans[i]));
+            REQUIRE(snorm[i] == pack_snorm_1010102(nans[i]));
+        }
+    }
+}
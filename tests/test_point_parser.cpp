@@ -0,0 +1,204 @@
+/*
+ * POINT PARSER TESTS
+ *
+ * The small blocks split the generated inputs into many windows, so the
+ * lines carried between the windows and the block boundaries are exercised.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/io/PointParser.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+template <typename T, execution::Policy P = execution::sequenced_policy>
+io::ParseResult parse(const std::string& text, std::vector<Vector<3, T>>& points, const io::ParseOptions& options = {},
+                      const P& policy = {}) {
+    std::istringstream input(text);
+    points.clear();
+    return io::parse_points<T>(policy, input, [&](std::span<const Vector<3, T>> batch) {
+        points.insert(points.end(), batch.begin(), batch.end());
+    }, options);
+}
+
+std::string generate_xyz(std::size_t count) {
+    std::string result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result += std::to_string(double(i) * 0.25) + " " + std::to_string(-double(i)) + "\t" +
+                  std::to_string(i % 17) + (i % 3 == 0 ? " 255 0 0" : "") + (i % 5 == 0 ? "\r\n" : "\n");
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The XYZ lines are parsed", "[point_parser]") {
+    std::vector<Vector3d> points;
+    const auto result = parse<double>("# comment\n"
+                                      "\n"
+                                      "1 2 3\n"
+                                      "  -1.5e2\t+0.25   7 1 1 1\r\n"
+                                      "# another comment\n"
+                                      "4 5 6", points);
+    REQUIRE(result.status == io::Status::ok);
+    REQUIRE(result.points == 3);
+    REQUIRE(points.size() == 3);
+    REQUIRE(points[0] == Vector3d(1.0, 2.0, 3.0));
+    REQUIRE(points[1] == Vector3d(-150.0, 0.25, 7.0));
+    REQUIRE(points[2] == Vector3d(4.0, 5.0, 6.0));
+
+    SECTION("the other columns") {
+        io::ParseOptions options;
+        options.columns = {3, 0, 1};
+        REQUIRE(parse<double>("1 2 3 4\n5 6 7 8\n", points, options).status == io::Status::ok);
+        REQUIRE(points[1] == Vector3d(8.0, 5.0, 6.0));
+    }
+
+    SECTION("the syntax error") {
+        const auto error = parse<double>("1 2 3\n4 5 6\n\n7 8 x9\n10 11 12\n", points);
+        REQUIRE(error.status == io::Status::syntax_error);
+        REQUIRE(error.line == 4);
+        REQUIRE(points.size() == 2);
+        REQUIRE(parse<double>("1 2 3\n1 2\n", points).status == io::Status::syntax_error);
+        REQUIRE(parse<double>("1 2 3\n1 2 3.5.5\n", points).status == io::Status::syntax_error);
+    }
+
+    SECTION("the empty input") {
+        REQUIRE(parse<double>("", points).status == io::Status::ok);
+        REQUIRE(parse<double>("\n# nothing\n", points).points == 0);
+    }
+}
+
+TEST_CASE("The blocks are parsed in parallel", "[point_parser][execution]") {
+    const auto text = generate_xyz(20000);
+    io::ParseOptions options;
+    options.block_size = 1000;
+    options.blocks = 4;
+
+    std::vector<Vector3f> expected;
+    const auto sequential = parse<float>(text, expected, options);
+    REQUIRE(sequential.status == io::Status::ok);
+    REQUIRE(sequential.points == 20000);
+    REQUIRE(sequential.bytes == text.size());
+    REQUIRE(expected[12345] == Vector3f(12345.0f * 0.25f, -12345.0f, float(12345 % 17)));
+
+    ThreadPool pool(3);
+    std::vector<Vector3f> points;
+    REQUIRE(parse<float>(text, points, options, execution::parallel_policy{&pool}).points == 20000);
+    REQUIRE(points == expected);
+
+    SECTION("the batches do not grow with the input") {
+        std::istringstream input(text);
+        std::size_t batches = 0;
+        std::size_t largest = 0;
+        io::parse_points<float>(execution::parallel_policy{&pool}, input, [&](std::span<const Vector3f> batch) {
+            ++batches;
+            largest = std::max(largest, batch.size());
+        }, options);
+        REQUIRE(batches > 100);
+        // The block ends at the first line end after its nominal size.
+        REQUIRE(largest * 6 <= options.block_size + 64);
+    }
+
+    SECTION("the error line in the later window") {
+        auto broken = text;
+        broken.insert(broken.find('\n', text.size() / 2) + 1, "1 2 three\n");
+        std::vector<Vector3f> partial;
+        const auto result = parse<float>(broken, partial, options, execution::parallel_policy{&pool});
+        REQUIRE(result.status == io::Status::syntax_error);
+        REQUIRE(result.line == partial.size() + 1);
+        REQUIRE(partial.size() > 9000);
+    }
+
+    SECTION("the line longer than the window") {
+        io::ParseOptions small;
+        small.block_size = 16;
+        small.blocks = 2;
+        REQUIRE(parse<float>("1 2 3\n" + std::string(100, '1') + " 2 3\n", points, small).status ==
+                io::Status::line_too_long);
+    }
+}
+
+TEST_CASE("The CSV columns are taken from the header", "[point_parser]") {
+    std::vector<Vector3d> points;
+    REQUIRE(parse<double>("id, Z ,y,X\n"
+                          "0, 3.0 ,2.0,1.0\n"
+                          "1,6,5,4\n", points).status == io::Status::ok);
+    REQUIRE(points == std::vector<Vector3d>{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}});
+
+    SECTION("the header without the coordinates is skipped") {
+        REQUIRE(parse<double>("a,b,c\n1,2,3\n", points).points == 1);
+        REQUIRE(points[0] == Vector3d(1.0, 2.0, 3.0));
+    }
+
+    SECTION("the other separator") {
+        io::ParseOptions options;
+        options.format = io::PointFormat::csv;
+        options.separator = ';';
+        REQUIRE(parse<double>("1;2;3\n4; 5 ;6\n", points, options).points == 2);
+        REQUIRE(points[1] == Vector3d(4.0, 5.0, 6.0));
+    }
+
+    SECTION("the missing field") {
+        const auto result = parse<double>("1,2,3\n4,,6\n", points);
+        REQUIRE(result.status == io::Status::syntax_error);
+        REQUIRE(result.line == 2);
+    }
+}
+
+TEST_CASE("The vertices of the ASCII PLY are parsed", "[point_parser]") {
+    const std::string header = "ply\r\n"
+                               "format ascii 1.0\n"
+                               "comment generated\n"
+                               "element vertex 3\n"
+                               "property float nx\n"
+                               "property float z\n"
+                               "property float y\n"
+                               "property float x\n"
+                               "element face 1\n"
+                               "property list uchar int vertex_indices\n"
+                               "end_header\n";
+    std::vector<Vector3f> points;
+    const auto result = parse<float>(header +
+                                     "0 3 2 1\n"
+                                     "0 6 5 4\n"
+                                     "0 9 8 7\n"
+                                     "3 0 1 2\n", points);
+    REQUIRE(result.status == io::Status::ok);
+    REQUIRE(points == std::vector<Vector3f>{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}});
+
+    SECTION("the missing vertices") {
+        REQUIRE(parse<float>(header + "0 3 2 1\n", points).status == io::Status::truncated);
+    }
+
+    SECTION("the binary PLY") {
+        REQUIRE(parse<float>("ply\nformat binary_little_endian 1.0\nelement vertex 1\nproperty float x\n"
+                             "end_header\n", points).status == io::Status::unsupported_format);
+    }
+}
+
+TEST_CASE("The points are read from the file", "[point_parser]") {
+    const auto path = std::filesystem::temp_directory_path() / "gof_test_points.xyz";
+    std::ofstream(path) << generate_xyz(5000);
+
+    VectorArray3d points;
+    points.push_back(Vector3d(-1.0, -1.0, -1.0));
+    const auto result = io::read_points(execution::par, path, points);
+    REQUIRE(result.status == io::Status::ok);
+    REQUIRE(points.size() == 5001);
+    REQUIRE(points[4001] == Vector3d(1000.0, -4000.0, double(4000 % 17)));
+
+    std::filesystem::remove(path);
+    REQUIRE(io::read_points(execution::seq, path, points).status == io::Status::io_error);
+}
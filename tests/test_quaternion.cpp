@@ -0,0 +1,169 @@
+/*
+ * QUATERNION TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr double pi = std::numbers::pi;
+
+template <std::size_t N, typename T>
+bool is_close(const Vector<N, T>& a, const Vector<N, T>& b, T tolerance = T(1e-5)) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (std::abs(a[i] - b[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The quaternions `q` and `-q` are the same rotation.
+ */
+template <typename T>
+bool is_same_rotation(const Quaternion<T>& a, const Quaternion<T>& b, T tolerance = T(1e-5)) {
+    return std::abs(std::abs(scalar_product(a, b)) - T{1}) < tolerance;
+}
+
+std::vector<Quaterniond> rotations() {
+    std::vector<Quaterniond> result;
+    for (int i = 0; i < 64; ++i) {
+        const Vector3d axis = (1.0 / Vector3d(std::sin(i), std::cos(3.0 * i), 0.5).length()) *
+                              Vector3d(std::sin(i), std::cos(3.0 * i), 0.5);
+        result.push_back(Quaterniond::from_axis_angle(axis, 0.1 * i * pi));
+    }
+    return result;
+}
+
+} // namespace
+
+SCENARIO("Quaternion rotates vectors", "[quaternion]")
+{
+    GIVEN("The rotation by 90 degrees around the z axis")
+    {
+        const auto q = Quaterniond::from_axis_angle(Vector3d::unit_z(), pi / 2);
+
+        THEN("x goes to y and y goes to -x") {
+            REQUIRE(is_close(q.rotate(Vector3d::unit_x()), Vector3d::unit_y()));
+            REQUIRE(is_close(q.rotate(Vector3d::unit_y()), -Vector3d::unit_x()));
+            REQUIRE(is_close(q.rotate(Vector3d::unit_z()), Vector3d::unit_z()));
+        }
+        THEN("the axis and the angle are recovered") {
+            REQUIRE(is_close(q.axis(), Vector3d::unit_z()));
+            REQUIRE(std::abs(q.angle() - pi / 2) < 1e-12);
+        }
+        THEN("the inverse rotates back") {
+            const Vector3d v(1.0, 2.0, 3.0);
+            REQUIRE(is_close(q.inverse().rotate(q.rotate(v)), v));
+            REQUIRE(is_close(q.conjugate().rotate(q.rotate(v)), v));
+        }
+        THEN("the free function rotates the same way") {
+            const Vector3d v(1.0, 2.0, 3.0);
+            REQUIRE(is_close(rotate(v, Vector3d::unit_z(), pi / 2), q.rotate(v)));
+        }
+    }
+
+    GIVEN("The identity")
+    {
+        constexpr auto q = Quaternionf::identity();
+        static_assert(q.rotate(Vector3f(1.0f, 2.0f, 3.0f)) == Vector3f(1.0f, 2.0f, 3.0f));
+        static_assert(q * q == q);
+        REQUIRE(q.norm() == 1.0f);
+    }
+}
+
+TEST_CASE("Quaternion keeps the vectors parallel to the axis", "[quaternion]") {
+    for (int i = 1; i < 2000; ++i) {
+        const float angle = 0.0031f * float(i);
+        const Vector3f d(0.1f * float(i % 7) + 0.3f, 0.7f - 0.01f * float(i % 13), 0.11f * float(i % 5) - 0.2f);
+        const Vector3f axis = (1.0f / d.length()) * d;
+        const auto q = Quaternionf::from_axis_angle(axis, angle);
+        const Vector3f u = q.vector();
+        REQUIRE(q.rotate(u) == u);
+        REQUIRE(q.rotate(-2.0f * u) == -2.0f * u);
+    }
+}
+
+TEST_CASE("Quaternion product composes the rotations", "[quaternion]") {
+    const auto all = rotations();
+    const Vector3d v(0.3, -1.2, 2.5);
+    for (std::size_t i = 0; i + 1 < all.size(); ++i) {
+        const auto& a = all[i];
+        const auto& b = all[i + 1];
+        REQUIRE(is_close((a * b).rotate(v), a.rotate(b.rotate(v)), 1e-12));
+        REQUIRE(std::abs((a * b).norm() - 1.0) < 1e-12);
+    }
+}
+
+TEST_CASE("Quaternion converts to and from the matrices", "[quaternion]") {
+    const Vector3d v(0.3, -1.2, 2.5);
+    for (const auto& q : rotations()) {
+        const auto m3 = q.to_matrix3();
+        const auto m4 = q.to_matrix4<Layout::column_major>();
+
+        REQUIRE(is_close(m3 * v, q.rotate(v), 1e-12));
+        const auto r = m4 * Vector4d(v.x(), v.y(), v.z(), 1.0);
+        REQUIRE(is_close(Vector3d(r.x(), r.y(), r.z()), q.rotate(v), 1e-12));
+        REQUIRE(r.w() == 1.0);
+
+        REQUIRE(is_same_rotation(Quaterniond::from_matrix(m3), q, 1e-12));
+        REQUIRE(is_same_rotation(Quaterniond::from_matrix(m4), q, 1e-12));
+    }
+}
+
+TEST_CASE("Quaternion interpolation follows the shorter arc", "[quaternion]") {
+    const auto a = Quaterniond::identity();
+    const auto b = Quaterniond::from_axis_angle(Vector3d::unit_z(), pi / 2);
+
+    REQUIRE(is_same_rotation(slerp(a, b, 0.0), a));
+    REQUIRE(is_same_rotation(slerp(a, b, 1.0), b));
+    REQUIRE(is_same_rotation(nlerp(a, b, 0.0), a));
+    REQUIRE(is_same_rotation(nlerp(a, b, 1.0), b));
+
+    // The constant angular velocity.
+    for (double t : {0.25, 0.5, 0.75}) {
+        const auto q = slerp(a, b, t);
+        REQUIRE(std::abs(q.angle() - t * pi / 2) < 1e-12);
+        REQUIRE(std::abs(nlerp(a, b, t).norm() - 1.0) < 1e-12);
+    }
+    REQUIRE(is_same_rotation(nlerp(a, b, 0.5), slerp(a, b, 0.5), 1e-12));
+
+    // The opposite sign is the same rotation, the result must not take the
+    // longer way around.
+    const auto q = slerp(a, -b, 0.5);
+    REQUIRE(std::abs(q.angle() - pi / 4) < 1e-12);
+
+    // The nearly equal rotations do not divide by zero.
+    const auto c = Quaterniond::from_axis_angle(Vector3d::unit_z(), 1e-12);
+    REQUIRE(std::abs(slerp(a, c, 0.5).norm() - 1.0) < 1e-12);
+}
+
+TEST_CASE("Batched rotation equals the single rotations", "[quaternion]") {
+    const auto q = Quaternionf::from_axis_angle(Vector3f(0.0f, 0.6f, 0.8f), 1.1f);
+
+    std::vector<Vector3f> in;
+    for (int i = 0; i < 103; ++i) {
+        in.emplace_back(float(i) * 0.1f, 1.0f - float(i) * 0.05f, float(i % 7));
+    }
+    std::vector<Vector3f> out(in.size());
+    rotate(q, std::span<const Vector3f>(in), std::span(out));
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(is_close(out[i], q.rotate(in[i]), 1e-4f));
+    }
+
+    VectorArray3f lanes{std::span<const Vector3f>(in)};
+    rotate(q, lanes, lanes);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(lanes[i] == out[i]);
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * RAY TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "random.hpp"
+
+#include <gof/math/types>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+std::vector<Aabb3f> make_boxes(std::size_t count) {
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<Aabb3f> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector3f p(dist(rng), dist(rng), dist(rng));
+        const Vector3f q(dist(rng), dist(rng), dist(rng));
+        result.emplace_back(min(p, q), max(p, q));
+    }
+    return result;
+}
+
+std::vector<Vector3f> make_triangles(std::size_t count) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < 3 * count; ++i) {
+        result.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The ray precomputes the inverse direction", "[ray]") {
+    const Rayf ray(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(2.0f, -4.0f, 0.0f));
+
+    REQUIRE(ray.inverse_direction().x() == 0.5f);
+    REQUIRE(ray.inverse_direction().y() == -0.25f);
+    REQUIRE(ray.inverse_direction().z() == inf);
+    REQUIRE(ray.at(0.5f) == Vector3f(2.0f, 0.0f, 3.0f));
+    REQUIRE(Rayf() == Rayf(Vector3f::zero(), Vector3f::unit_x()));
+}
+
+TEST_CASE("The ray intersects the box", "[ray]") {
+    const Aabb3f box(Vector3f(-1.0f, -1.0f, -1.0f), Vector3f(1.0f, 1.0f, 1.0f));
+
+    SECTION("from outside") {
+        const Rayf ray(Vector3f(-3.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(intersect(ray, box) == 2.0f);
+        REQUIRE(intersect(ray, box, 0.0f, 1.0f) == inf);
+    }
+
+    SECTION("from inside") {
+        const Rayf ray(Vector3f::zero(), Vector3f(0.0f, 0.0f, -1.0f));
+        REQUIRE(intersect(ray, box) == 0.0f);
+    }
+
+    SECTION("behind the origin") {
+        const Rayf ray(Vector3f(3.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(intersect(ray, box) == inf);
+    }
+
+    SECTION("in the plane of the face") {
+        // The zero component of the direction times the infinite inverse is NaN.
+        const Rayf ray(Vector3f(-3.0f, 1.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(intersect(ray, box) == 2.0f);
+    }
+
+    SECTION("parallel outside") {
+        const Rayf ray(Vector3f(-3.0f, 2.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(intersect(ray, box) == inf);
+    }
+
+    SECTION("the empty box") {
+        const Rayf ray(Vector3f(-3.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(intersect(ray, Aabb3f()) == inf);
+    }
+}
+
+TEST_CASE("The ray intersects the triangle", "[ray]") {
+    const Vector3f a(0.0f, 0.0f, 0.0f);
+    const Vector3f b(1.0f, 0.0f, 0.0f);
+    const Vector3f c(0.0f, 1.0f, 0.0f);
+
+    SECTION("from both sides") {
+        const Rayf front(Vector3f(0.25f, 0.5f, 2.0f), Vector3f(0.0f, 0.0f, -1.0f));
+        const Rayf back(Vector3f(0.25f, 0.5f, -2.0f), Vector3f(0.0f, 0.0f, 2.0f));
+
+        const Hit<float> hit = intersect(front, a, b, c);
+        REQUIRE(hit);
+        REQUIRE(std::abs(hit.distance - 2.0f) < 1e-6f);
+        REQUIRE(std::abs(hit.u - 0.25f) < 1e-6f);
+        REQUIRE(std::abs(hit.v - 0.5f) < 1e-6f);
+        REQUIRE(std::abs(intersect(back, a, b, c).distance - 1.0f) < 1e-6f);
+    }
+
+    SECTION("miss") {
+        REQUIRE_FALSE(intersect(Rayf(Vector3f(0.75f, 0.5f, 1.0f), Vector3f(0.0f, 0.0f, -1.0f)), a, b, c));
+        REQUIRE_FALSE(intersect(Rayf(Vector3f(0.25f, 0.25f, 1.0f), Vector3f(0.0f, 0.0f, 1.0f)), a, b, c));
+        REQUIRE_FALSE(intersect(Rayf(Vector3f(0.25f, 0.25f, 1.0f), Vector3f(0.0f, 0.0f, -1.0f)), a, b, c, 0.0f, 0.5f));
+    }
+
+    SECTION("parallel and degenerate") {
+        REQUIRE_FALSE(intersect(Rayf(Vector3f(-1.0f, 0.25f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f)), a, b, c));
+        REQUIRE_FALSE(intersect(Rayf(Vector3f(0.0f, 0.0f, 1.0f), Vector3f(0.0f, 0.0f, -1.0f)), a, b, b));
+    }
+}
+
+TEST_CASE("The packets agree with the single rays", "[ray]") {
+    constexpr std::size_t W = 8;
+    const auto rays = test::random_rays(64, 17, 4.0f, 0.25f);
+    const auto boxes = make_boxes(W);
+    const auto triangles = make_triangles(W);
+    const BoxPacket<float, W> box_packet{std::span<const Aabb3f>(boxes)};
+    const TrianglePacket<float, W> triangle_packet{std::span<const Vector3f>(triangles)};
+
+    std::size_t hits = 0;
+    for (std::size_t r = 0; r < rays.size(); r += W) {
+        const RayPacket<float, W> packet(std::span<const Rayf, W>(rays.data() + r, W));
+        for (std::size_t i = 0; i < W; ++i) {
+            REQUIRE(packet[i] == rays[r + i]);
+        }
+
+        // The SoA rays against one primitive.
+        for (std::size_t j = 0; j < W; ++j) {
+            const auto distances = intersect(packet, boxes[j]);
+            const auto triangle_hits = intersect(packet, triangles[3 * j], triangles[3 * j + 1], triangles[3 * j + 2]);
+            for (std::size_t i = 0; i < W; ++i) {
+                REQUIRE(distances[i] == intersect(rays[r + i], boxes[j]));
+                const Hit<float> hit = intersect(rays[r + i], triangles[3 * j], triangles[3 * j + 1], triangles[3 * j + 2]);
+                REQUIRE(bool(triangle_hits[i]) == bool(hit));
+                if (hit) {
+                    REQUIRE(std::abs(triangle_hits[i].distance - hit.distance) < 1e-4f);
+                    REQUIRE(std::abs(triangle_hits[i].u - hit.u) < 1e-4f);
+                    REQUIRE(std::abs(triangle_hits[i].v - hit.v) < 1e-4f);
+                    ++hits;
+                }
+            }
+        }
+
+        // One ray against the SoA primitives.
+        for (std::size_t i = 0; i < W; ++i) {
+            const auto distances = intersect(rays[r + i], box_packet);
+            const auto triangle_hits = intersect(rays[r + i], triangle_packet);
+            for (std::size_t j = 0; j < W; ++j) {
+                REQUIRE(distances[j] == intersect(rays[r + i], boxes[j]));
+                const Hit<float> hit = intersect(rays[r + i], triangles[3 * j], triangles[3 * j + 1], triangles[3 * j + 2]);
+                REQUIRE(bool(triangle_hits[j]) == bool(hit));
+            }
+        }
+    }
+    REQUIRE(hits > 0);
+}
+
+TEST_CASE("The unused lanes of the packets are never hit", "[ray]") {
+    const std::vector<Aabb3f> boxes = {Aabb3f(Vector3f(-1.0f, -1.0f, -1.0f), Vector3f::ones())};
+    const std::vector<Vector3f> triangles = {Vector3f(-1.0f, -1.0f, 0.0f), Vector3f(1.0f, -1.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f)};
+    const Rayf ray(Vector3f(0.0f, 0.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f));
+
+    const auto box_hits = intersect(ray, BoxPacket<float, 4>(std::span<const Aabb3f>(boxes)));
+    const auto triangle_hits = intersect(ray, TrianglePacket<float, 4>(std::span<const Vector3f>(triangles)));
+    REQUIRE(box_hits[0] == 2.0f);
+    REQUIRE(triangle_hits[0].distance == 3.0f);
+    for (std::size_t i = 1; i < 4; ++i) {
+        REQUIRE(box_hits[i] == inf);
+        REQUIRE(triangle_hits[i].distance == inf);
+    }
+}
+
+TEST_CASE("The ray is usable in constant expressions", "[ray][constexpr]") {
+    constexpr Rayd ray(Vector3d(-3.0, 0.5, 0.5), Vector3d(1.0, 0.0, 0.0));
+    constexpr Aabb3d box(Vector3d::zero(), Vector3d::ones());
+    static_assert(intersect(ray, box) == 3.0);
+    static_assert(intersect(ray, Vector3d(0.0, 0.0, -1.0), Vector3d(0.0, 2.0, 1.0), Vector3d(0.0, 0.0, 1.0)).distance == 3.0);
+    SUCCEED();
+}
@@ -0,0 +1,157 @@
+/*
+ * SIMD TESTS
+ *
+ * The SIMD kernels must produce results bit-identical to the scalar path.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+using Lanes = std::array<float, 4>;
+
+bool is_identical(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+template <std::size_t N>
+bool is_identical(const float* a, const float* b) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!is_identical(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Random lanes mixed with the special values.
+ */
+std::vector<Lanes> samples() {
+    const float specials[] = {
+        0.0f, -0.0f, 1.0f, -1.0f,
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(),
+    };
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    std::uniform_int_distribution<int> pick(0, 15);
+
+    std::vector<Lanes> result(1024);
+    for (auto& lanes : result) {
+        for (auto& e : lanes) {
+            const int i = pick(rng);
+            e = i < 8 ? specials[i] : dist(rng);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+#if GOF_MATH_HAS_SSE
+
+TEST_CASE("SIMD arithmetic kernels are bit-identical to the scalar path", "[simd]") {
+    const auto data = samples();
+
+    for (std::size_t k = 0; k + 1 < data.size(); ++k) {
+        alignas(16) Lanes a = data[k];
+        alignas(16) Lanes b = data[k + 1];
+        alignas(16) Lanes out{};
+        Lanes expected{};
+
+        simd::add(a.data(), b.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = a[i] + b[i];
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        simd::sub(a.data(), b.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = a[i] - b[i];
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        simd::scale(b[0], a.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = b[0] * a[i];
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        simd::negate(a.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = -a[i];
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        simd::min(a.data(), b.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = std::min(a[i], b[i]);
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        simd::max(a.data(), b.data(), out.data());
+        for (int i = 0; i < 4; ++i) expected[i] = std::max(a[i], b[i]);
+        REQUIRE(is_identical<4>(out.data(), expected.data()));
+
+        REQUIRE(simd::equal<4>(a.data(), a.data()) == (a == a));
+        REQUIRE(simd::equal<4>(a.data(), b.data()) == (a == b));
+    }
+}
+
+TEST_CASE("SIMD length is bit-identical to the scalar path", "[simd]") {
+    for (const auto& lanes : samples()) {
+        alignas(16) Lanes a = lanes;
+
+        const float sum3 = multiply_add(a[2], a[2], multiply_add(a[1], a[1], a[0] * a[0]));
+        const float length3 = std::sqrt(sum3);
+        const float length4 = std::sqrt(multiply_add(a[3], a[3], sum3));
+
+        REQUIRE(is_identical(simd::length<3>(a.data()), length3));
+        REQUIRE(is_identical(simd::length<4>(a.data()), length4));
+    }
+}
+
+TEST_CASE("SIMD equality ignores the padding lane", "[simd]") {
+    alignas(16) Lanes a{1.0f, 2.0f, 3.0f, 0.0f};
+    alignas(16) Lanes b{1.0f, 2.0f, 3.0f, std::numeric_limits<float>::quiet_NaN()};
+    REQUIRE(simd::equal<3>(a.data(), b.data()));
+    REQUIRE_FALSE(simd::equal<4>(a.data(), b.data()));
+}
+
+#endif // GOF_MATH_HAS_SSE
+
+TEST_CASE("Vector operators agree with the scalar reference", "[simd]") {
+    const auto data = samples();
+
+    for (std::size_t k = 0; k + 1 < data.size(); ++k) {
+        const auto& a = data[k];
+        const auto& b = data[k + 1];
+
+        const Vector4f u(a[0], a[1], a[2], a[3]);
+        const Vector4f v(b[0], b[1], b[2], b[3]);
+        const Vector3f p(a[0], a[1], a[2]);
+        const Vector3f q(b[0], b[1], b[2]);
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(is_identical((u + v).data()[i], a[i] + b[i]));
+            REQUIRE(is_identical((u - v).data()[i], a[i] - b[i]));
+            REQUIRE(is_identical((b[0] * u).data()[i], b[0] * a[i]));
+            REQUIRE(is_identical((-u).data()[i], -a[i]));
+            REQUIRE(is_identical(min(u, v).data()[i], std::min(a[i], b[i])));
+            REQUIRE(is_identical(max(u, v).data()[i], std::max(a[i], b[i])));
+        }
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(is_identical((p + q).data()[i], a[i] + b[i]));
+            REQUIRE(is_identical((p - q).data()[i], a[i] - b[i]));
+        }
+
+        REQUIRE(is_identical(p.length(), std::sqrt(multiply_add(a[2], a[2], multiply_add(a[1], a[1], a[0] * a[0])))));
+        REQUIRE((u == v) == (a == b));
+    }
+}
@@ -0,0 +1,223 @@
+/*
+ * SPARSE MATRIX TESTS
+ *
+ * The solvers are checked on the 5-point Laplacian of the grid (symmetric
+ * positive definite) and on the upwinded convection-diffusion operator (not
+ * symmetric), the residuals are recomputed independently of the solvers.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/matrix/SparseMatrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * The operator of the `n x n` grid with the Dirichlet boundary, the neighbour
+ * on the left has the weight `-1 - convection` and on the right
+ * `-1 + convection`.
+ */
+template <typename T>
+std::vector<Triplet<T>> grid_operator(std::size_t n, T convection = T{0}) {
+    std::vector<Triplet<T>> result;
+    for (std::size_t y = 0; y < n; ++y) {
+        for (std::size_t x = 0; x < n; ++x) {
+            const std::size_t i = y * n + x;
+            result.push_back({i, i, T(4)});
+            if (x > 0) result.push_back({i, i - 1, T(-1) - convection});
+            if (x + 1 < n) result.push_back({i, i + 1, T(-1) + convection});
+            if (y > 0) result.push_back({i, i - n, T(-1)});
+            if (y + 1 < n) result.push_back({i, i + n, T(-1)});
+        }
+    }
+    return result;
+}
+
+template <typename T, Layout L>
+T relative_residual(const SparseMatrix<T, L>& a, std::span<const T> b, std::span<const T> x) {
+    std::vector<T> r(b.size());
+    multiply(a, x, r);
+    T rr = T{0};
+    T bb = T{0};
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        rr += (b[i] - r[i]) * (b[i] - r[i]);
+        bb += b[i] * b[i];
+    }
+    return std::sqrt(rr / bb);
+}
+
+} // namespace
+
+TEST_CASE("The sparse matrix is built from the triplets", "[sparse_matrix]") {
+    // [ 1 0 2 ]
+    // [ 0 0 3 ]
+    // [ 4 5 0 ]
+    const std::vector<Triplet<double>> triplets = {
+        {2, 1, 5.0}, {0, 2, 2.0}, {1, 2, 1.0}, {2, 0, 4.0}, {0, 0, 1.0}, {1, 2, 2.0},
+    };
+    const SparseMatrix<double> csr(3, 3, triplets);
+    REQUIRE(csr.non_zeros() == 5);
+    REQUIRE(std::vector<std::size_t>(csr.offsets().begin(), csr.offsets().end()) == std::vector<std::size_t>{0, 2, 3, 5});
+    REQUIRE(std::vector<std::uint32_t>(csr.indices().begin(), csr.indices().end()) == std::vector<std::uint32_t>{0, 2, 2, 0, 1});
+    REQUIRE(csr(1, 2) == 3.0);
+    REQUIRE(csr(1, 1) == 0.0);
+    REQUIRE(csr(2, 1) == 5.0);
+    REQUIRE(csr.memory_footprint() == 4 * sizeof(std::size_t) + 5 * sizeof(std::uint32_t) + 5 * sizeof(double));
+
+    const SparseMatrix<double, Layout::column_major> csc(3, 3, triplets);
+    REQUIRE(std::vector<std::size_t>(csc.offsets().begin(), csc.offsets().end()) == std::vector<std::size_t>{0, 2, 3, 5});
+    REQUIRE(std::vector<std::uint32_t>(csc.indices().begin(), csc.indices().end()) == std::vector<std::uint32_t>{0, 2, 2, 0, 1});
+    REQUIRE(csc(0, 2) == 2.0);
+
+    SECTION("the conversion between the layouts") {
+        const SparseMatrix<double, Layout::column_major> converted(csr);
+        REQUIRE(std::vector<double>(converted.values().begin(), converted.values().end()) ==
+                std::vector<double>(csc.values().begin(), csc.values().end()));
+        REQUIRE(std::vector<std::uint32_t>(converted.indices().begin(), converted.indices().end()) ==
+                std::vector<std::uint32_t>(csc.indices().begin(), csc.indices().end()));
+        const SparseMatrix<double> back(converted);
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                REQUIRE(back(i, j) == csr(i, j));
+            }
+        }
+    }
+
+    SECTION("the empty rows and the empty matrix") {
+        const SparseMatrix<float> empty(4, 2, std::span<const Triplet<float>>());
+        REQUIRE(empty.non_zeros() == 0);
+        REQUIRE(empty.offsets().size() == 5);
+        REQUIRE(SparseMatrix<float>().rows() == 0);
+    }
+}
+
+TEST_CASE("The sparse product agrees with the dense one", "[sparse_matrix]") {
+    std::mt19937 rng(107);
+    std::uniform_int_distribution<std::size_t> index(0, 199);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::vector<Triplet<double>> triplets;
+    std::vector<double> dense(200 * 150, 0.0);
+    for (int k = 0; k < 3000; ++k) {
+        const Triplet<double> t{index(rng), index(rng) % 150, value(rng)};
+        triplets.push_back(t);
+        dense[t.row * 150 + t.column] += t.value;
+    }
+    std::vector<double> x(150);
+    for (auto& e : x) {
+        e = value(rng);
+    }
+    std::vector<double> expected(200, 0.0);
+    for (std::size_t i = 0; i < 200; ++i) {
+        for (std::size_t j = 0; j < 150; ++j) {
+            expected[i] += dense[i * 150 + j] * x[j];
+        }
+    }
+
+    const SparseMatrix<double> csr(200, 150, triplets);
+    const SparseMatrix<double, Layout::column_major> csc(200, 150, triplets);
+    std::vector<double> y(200);
+    std::vector<double> z(200);
+    std::vector<double> w(200);
+    multiply(csr, x, y);
+    multiply(csc, x, z);
+    ThreadPool pool(3);
+    multiply(execution::parallel_policy{&pool, 16}, csr, x, w);
+    for (std::size_t i = 0; i < 200; ++i) {
+        REQUIRE(std::abs(y[i] - expected[i]) < 1e-12);
+        REQUIRE(std::abs(z[i] - expected[i]) < 1e-12);
+        REQUIRE(w[i] == y[i]);
+    }
+}
+
+TEST_CASE("The conjugate gradient solves the Poisson problem", "[sparse_matrix][solver]") {
+    constexpr std::size_t n = 40;
+    const SparseMatrix<double> a(n * n, n * n, grid_operator<double>(n));
+    std::vector<double> b(n * n, 1.0);
+    std::vector<double> x(n * n, 0.0);
+
+    const auto result = conjugate_gradient(a, b, x);
+    REQUIRE(result.converged);
+    REQUIRE(result.iterations < n * n / 4);
+    REQUIRE(relative_residual<double>(a, b, x) < 1e-9);
+
+    SECTION("the parallel solve takes the same iterations") {
+        ThreadPool pool(3);
+        std::vector<double> y(n * n, 0.0);
+        const auto parallel = conjugate_gradient(execution::parallel_policy{&pool, 64, true}, a, b, y);
+        REQUIRE(parallel.converged);
+        REQUIRE(parallel.iterations == result.iterations);
+        REQUIRE(relative_residual<double>(a, b, y) < 1e-9);
+    }
+
+    SECTION("the initial guess is the solution") {
+        const auto again = conjugate_gradient(a, b, x);
+        REQUIRE(again.converged);
+        REQUIRE(again.iterations == 0);
+    }
+
+    SECTION("the lanes of the vector array") {
+        VectorArray<3, float> rhs(n * n);
+        VectorArray<3, float> solution(n * n);
+        for (std::size_t i = 0; i < n * n; ++i) {
+            rhs.set(i, Vector3f(1.0f, float(i % n), -2.0f));
+        }
+        const SparseMatrix<float> af(n * n, n * n, grid_operator<float>(n));
+        const auto results = conjugate_gradient(execution::seq, af, rhs, solution);
+        for (std::size_t k = 0; k < 3; ++k) {
+            REQUIRE(results[k].converged);
+            REQUIRE(relative_residual<float>(af, rhs.lane(k), solution.lane(k)) < 1e-4f);
+        }
+    }
+
+    SECTION("the zero right-hand side") {
+        std::fill(b.begin(), b.end(), 0.0);
+        REQUIRE(conjugate_gradient(a, b, x).converged);
+        REQUIRE(x[17] == 0.0);
+    }
+}
+
+TEST_CASE("The BiCGSTAB solves the convection-diffusion problem", "[sparse_matrix][solver]") {
+    constexpr std::size_t n = 40;
+    const auto triplets = grid_operator<double>(n, 0.6);
+    const SparseMatrix<double> a(n * n, n * n, triplets);
+    REQUIRE(a(5, 4) != a(4, 5));
+    std::vector<double> b(n * n);
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        b[i] = std::sin(double(i));
+    }
+    std::vector<double> x(n * n, 0.0);
+    const auto result = bicgstab(a, b, x);
+    REQUIRE(result.converged);
+    REQUIRE(relative_residual<double>(a, b, x) < 1e-9);
+
+    SECTION("in the CSC layout without the preconditioner") {
+        const SparseMatrix<double, Layout::column_major> csc(n * n, n * n, triplets);
+        std::vector<double> y(n * n, 0.0);
+        SolverOptions<double> options;
+        options.jacobi = false;
+        const auto plain = bicgstab(csc, b, y, options);
+        REQUIRE(plain.converged);
+        REQUIRE(relative_residual<double>(a, b, y) < 1e-9);
+    }
+
+    SECTION("the iterations are limited") {
+        std::vector<double> y(n * n, 0.0);
+        SolverOptions<double> options;
+        options.max_iterations = 3;
+        const auto limited = bicgstab(a, b, y, options);
+        REQUIRE(!limited.converged);
+        REQUIRE(limited.iterations == 3);
+        REQUIRE(limited.residual > options.tolerance);
+    }
+}
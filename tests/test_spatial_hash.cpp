@@ -0,0 +1,108 @@
+/*
+ * SPATIAL HASH TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/spatial/SpatialHash.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+/**
+ * The grid of points and their copies moved by less than `jitter`.
+ */
+std::vector<Vector3f> make_mesh(std::size_t side, float spacing, float jitter) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> offset(-jitter, jitter);
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            for (std::size_t k = 0; k < side; ++k) {
+                const Vector3f p(float(i) * spacing, float(j) * spacing, float(k) * spacing);
+                result.push_back(p);
+                result.push_back(p + Vector3f(offset(random), offset(random), offset(random)));
+            }
+        }
+    }
+    std::shuffle(result.begin(), result.end(), random);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("SpatialHash finds the points within the tolerance", "[spatial_hash]") {
+    SpatialHash<3, float> set(0.1f);
+
+    REQUIRE(set.find(Vector3f::zero()) == set.npos);
+    REQUIRE(set.insert(Vector3f(1.0f, 1.0f, 1.0f)) == std::pair<std::uint32_t, bool>(0, true));
+    REQUIRE(set.insert(Vector3f(1.05f, 1.0f, 0.95f)) == std::pair<std::uint32_t, bool>(0, false));
+    REQUIRE(set.insert(Vector3f(1.2f, 1.0f, 1.0f)) == std::pair<std::uint32_t, bool>(1, true));
+    REQUIRE(set.find(Vector3f(1.09f, 1.0f, 1.0f)) == 0);
+    REQUIRE(set.find(Vector3f(1.16f, 1.0f, 1.0f)) == 1);
+    REQUIRE(set.find(Vector3f(-1.0f, 1.0f, 1.0f)) == set.npos);
+    REQUIRE(set.size() == 2);
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.find(Vector3f(1.0f, 1.0f, 1.0f)) == set.npos);
+}
+
+TEST_CASE("SpatialHash with zero tolerance keeps the distinct points", "[spatial_hash]") {
+    SpatialHash<2, double> set(0.0);
+
+    REQUIRE(set.insert(Vector2d(0.5, 0.25)).second);
+    REQUIRE(set.insert(Vector2d(0.0, -0.0)).second);
+    REQUIRE_FALSE(set.insert(Vector2d(-0.0, 0.0)).second);
+    REQUIRE(set.insert(Vector2d(0.5, std::nextafter(0.25, 1.0))).second);
+    REQUIRE(set.find(Vector2d(0.5, 0.25)) == 0);
+}
+
+TEST_CASE("weld() matches the brute force", "[spatial_hash]") {
+    const float tolerance = 0.01f;
+    const auto vertices = make_mesh(12, 0.1f, 0.004f);
+    std::vector<std::uint32_t> remap(vertices.size());
+
+    const auto unique = weld(std::span<const Vector3f>(vertices), tolerance, std::span(remap));
+
+    REQUIRE(unique.size() == 12 * 12 * 12);
+    // The first unique vertex within the tolerance, found by the linear search.
+    std::vector<Vector3f> expected;
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        std::uint32_t index = SpatialHash<3, float>::npos;
+        for (std::uint32_t j = 0; j < expected.size() && index == SpatialHash<3, float>::npos; ++j) {
+            if ((vertices[i] - expected[j]).length_squared() <= tolerance * tolerance) {
+                index = j;
+            }
+        }
+        if (index == SpatialHash<3, float>::npos) {
+            index = std::uint32_t(expected.size());
+            expected.push_back(vertices[i]);
+        }
+        REQUIRE(remap[i] == index);
+    }
+    REQUIRE(unique == expected);
+}
+
+TEST_CASE("weld() handles the points far from the origin", "[spatial_hash]") {
+    const float inf = std::numeric_limits<float>::infinity();
+    const std::vector<Vector3f> vertices = {
+        {1e30f, 0.0f, 0.0f}, {-1e30f, 0.0f, 0.0f}, {inf, 0.0f, 0.0f}, {1e30f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f},
+    };
+    std::vector<std::uint32_t> remap(vertices.size());
+
+    const auto unique = weld(std::span<const Vector3f>(vertices), 1e-3f, std::span(remap));
+
+    REQUIRE(unique.size() == 4);
+    REQUIRE(remap == std::vector<std::uint32_t>{0, 1, 2, 0, 3});
+}
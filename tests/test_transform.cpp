@@ -0,0 +1,122 @@
+/*
+ * TRANSFORM TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+#include <gof/math/transform.hpp>
+
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+std::vector<Vector3f> make_points(std::size_t count) {
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = float(i) * 0.37f - 5.0f;
+        result.emplace_back(f, 1.0f - f * 0.5f, f * f * 0.01f);
+    }
+    return result;
+}
+
+const Matrix4f affine(0.5f, -0.2f, 0.1f, 10.0f,
+                      0.3f, 0.9f, -0.4f, -2.0f,
+                      0.0f, 0.7f, 1.1f, 3.5f,
+                      0.0f, 0.0f, 0.0f, 1.0f);
+
+const Matrix4f projective(1.2f, 0.0f, 0.3f, 0.0f,
+                          0.0f, 1.7f, -0.2f, 0.0f,
+                          0.0f, 0.1f, -1.01f, -0.2f,
+                          0.05f, 0.0f, -1.0f, 4.0f);
+
+Vector3f reference_point(const Matrix4f& m, const Vector3f& p) {
+    const auto r = m * Vector4f(p.x(), p.y(), p.z(), 1.0f);
+    if (m.row(3) == Vector4f::unit_w()) {
+        return {r.x(), r.y(), r.z()};
+    }
+    return {r.x() / r.w(), r.y() / r.w(), r.z() / r.w()};
+}
+
+} // namespace
+
+TEST_CASE("Transforming points equals the single products", "[transform]") {
+    const auto points = make_points(103);
+    std::vector<Vector3f> out(points.size());
+
+    for (const auto& m : {affine, projective}) {
+        transform_points(m, std::span<const Vector3f>(points), std::span<Vector3f>(out));
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            REQUIRE(out[i] == reference_point(m, points[i]));
+        }
+    }
+}
+
+TEST_CASE("Transforming points stored in lanes", "[transform]") {
+    const auto points = make_points(103);
+
+    for (const auto& m : {affine, projective}) {
+        VectorArray3f in(points);
+        VectorArray3f result(points.size());
+
+        for (auto store : {Store::cached, Store::streaming}) {
+            transform_points(m, in, result, store);
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                REQUIRE(result[i] == reference_point(m, points[i]));
+            }
+        }
+
+        // In place.
+        transform_points(m, in, in);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            REQUIRE(in[i] == reference_point(m, points[i]));
+        }
+    }
+}
+
+TEST_CASE("Transforming directions ignores the translation", "[transform]") {
+    const auto directions = make_points(17);
+    std::vector<Vector3f> out(directions.size());
+    VectorArray3f lanes(directions);
+    VectorArray3f streamed(directions);
+
+    transform_directions(affine, std::span<const Vector3f>(directions), std::span<Vector3f>(out));
+    transform_directions(affine, lanes, lanes);
+    transform_directions(affine, streamed, streamed, Store::streaming);
+    VectorArray3f copied(directions.size());
+    transform_directions(affine, VectorArray3f(directions), copied, Store::streaming);
+
+    for (std::size_t i = 0; i < directions.size(); ++i) {
+        const auto& d = directions[i];
+        const Vector3f expected(
+            multiply_add(affine(0, 2), d.z(), multiply_add(affine(0, 1), d.y(), affine(0, 0) * d.x())),
+            multiply_add(affine(1, 2), d.z(), multiply_add(affine(1, 1), d.y(), affine(1, 0) * d.x())),
+            multiply_add(affine(2, 2), d.z(), multiply_add(affine(2, 1), d.y(), affine(2, 0) * d.x())));
+        REQUIRE(out[i] == expected);
+        REQUIRE(lanes[i] == expected);
+        REQUIRE(streamed[i] == expected);
+        REQUIRE(copied[i] == expected);
+    }
+}
+
+TEST_CASE("Transforming homogeneous vectors", "[transform]") {
+    std::vector<Vector4f> in;
+    for (const auto& p : make_points(33)) {
+        in.emplace_back(p.x(), p.y(), p.z(), 1.0f);
+    }
+    std::vector<Vector4f> out(in.size());
+    std::vector<Vector4d> in_d(in.size(), Vector4d(1.0, 2.0, 3.0, 1.0));
+    std::vector<Vector4d> out_d(in.size());
+
+    for (auto store : {Store::cached, Store::streaming}) {
+        transform(projective, std::span<const Vector4f>(in), std::span<Vector4f>(out), store);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            REQUIRE(out[i] == projective * in[i]);
+        }
+    }
+
+    transform(Matrix4d::identity(), std::span<const Vector4d>(in_d), std::span<Vector4d>(out_d));
+    REQUIRE(out_d == in_d);
+}
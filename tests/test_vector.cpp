@@ -8,7 +8,13 @@
 // #include <gof/math/vector/Vector.hpp>
 
 #include <array>
-#
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 using namespace gof;
 
@@ -56,6 +62,12 @@ SCENARIO("Vector constructors works", "[vector]")
     }
 }
 
+TEST_CASE("Vector refuses more values than components", "[vector]") {
+    STATIC_REQUIRE(std::is_constructible_v<Vector3f, float, float, float>);
+    STATIC_REQUIRE(!std::is_constructible_v<Vector3f, float, float, float, float>);
+    STATIC_REQUIRE(!std::is_constructible_v<Vector2d, double, double, double>);
+}
+
 SCENARIO("Vector accessors works", "[vector]")
 {
     GIVEN("A vectors with N = 2 components")
@@ -113,6 +125,36 @@ SCENARIO("Vector accessors works", "[vector]")
     }
 }
 
+SCENARIO("Vector component views works", "[vector]")
+{
+    GIVEN("A vector with N = 3 components")
+    {
+        const Vector3f v(1.0f, 2.0f, 3.0f);
+
+        THEN("the values are a view of the components") {
+            const std::span<const float, 3> values = v.values();
+            REQUIRE(values.data() == v.data());
+            REQUIRE(values[2] == 3.0f);
+        }
+        THEN("the components are accessible with the index operator") {
+            REQUIRE(v[0] == 1.0f);
+            REQUIRE(v[1] == 2.0f);
+            REQUIRE(v[2] == 3.0f);
+        }
+        THEN("we can iterate over the components") {
+            float sum = 0.0f;
+            for (float e : v) {
+                sum += e;
+            }
+            REQUIRE(sum == 6.0f);
+            REQUIRE(v.end() - v.begin() == 3);
+        }
+        THEN("we can copy the components") {
+            REQUIRE(v.to_array() == std::array<float, 3>{1.0f, 2.0f, 3.0f});
+        }
+    }
+}
+
 SCENARIO("Vector factories works", "[vector]")
 {
     GIVEN("A vectors with N = 2 components")
@@ -335,8 +377,141 @@ TEST_CASE("is_opposite() works") {
     REQUIRE(u.is_opposite(v));
 }
 
+TEST_CASE("The predicates compare with tolerance") {
+    const float eps = std::numeric_limits<float>::epsilon();
+    const auto n = Vector3f(0.6f, 0.0f, 0.8f + eps);
+
+    REQUIRE(n.is_unit());
+    REQUIRE_FALSE(n.is_unit(tolerance::Exact{}));
+    REQUIRE_FALSE(Vector3f(0.6f, 0.0f, 0.81f).is_unit());
+    REQUIRE(Vector3f(1e-7f, -1e-7f, 0.0f).is_zero());
+    REQUIRE_FALSE(Vector3f(1e-7f, -1e-7f, 0.0f).is_zero(tolerance::Exact{}));
+    REQUIRE(Vector2f(1.0f, 2.0f).is_opposite(Vector2f(-1.0f, -2.0f - eps)));
+    REQUIRE(Vector<2, int>(1, 2).is_opposite(Vector<2, int>(-1, -2)));
+    REQUIRE_FALSE(Vector<2, int>(1, 2).is_opposite(Vector<2, int>(-1, -3)));
+}
+
+TEST_CASE("is_close() works with all strategies") {
+    const auto u = Vector3f(1000.0f, 1.0f, 0.0f);
+    const auto v = Vector3f(1000.0f + 1e-3f, 1.0f, 1e-7f);
+
+    REQUIRE_FALSE(u.is_close(v));
+    REQUIRE(u.is_close(v, tolerance::Relative<float>{1e-6f, 1e-6f}));
+    REQUIRE_FALSE(u.is_close(v, tolerance::Relative<float>{1e-6f, 1e-8f}));
+    REQUIRE(u.is_close(v, tolerance::Absolute<float>{1e-3f}));
+    REQUIRE_FALSE(u.is_close(v, tolerance::Absolute<float>{1e-4f}));
+
+    const float one = 1.0f;
+    const float next = std::nextafter(std::nextafter(one, 2.0f), 2.0f);
+    REQUIRE(tolerance::Ulps<float>{2}(one, next));
+    REQUIRE_FALSE(tolerance::Ulps<float>{1}(one, next));
+    REQUIRE(tolerance::Ulps<double>{0}(0.0, -0.0));
+    REQUIRE(tolerance::Ulps<float>{2}(-std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::denorm_min()));
+    REQUIRE_FALSE(tolerance::Ulps<float>{1000}(std::nanf(""), std::nanf("")));
+    REQUIRE(Vector2d(1.0, 2.0).is_close(Vector2d(1.0, std::nextafter(2.0, 3.0)), tolerance::Ulps<double>{1}));
+
+    const float inf = std::numeric_limits<float>::infinity();
+    REQUIRE(Vector3f(inf, 0.0f, 0.0f).is_close(Vector3f(inf, 0.0f, 0.0f)));
+    REQUIRE_FALSE(Vector3f(inf, 0.0f, 0.0f).is_close(Vector3f(-inf, 0.0f, 0.0f)));
+    REQUIRE_FALSE(Vector4f(std::nanf(""), 0.0f, 0.0f, 0.0f).is_close(Vector4f(std::nanf(""), 0.0f, 0.0f, 0.0f)));
+}
+
+TEST_CASE("Batched is_close() matches the single vectors") {
+    std::vector<Vector3f> u, v;
+    for (int i = 0; i < 64; ++i) {
+        const float x = float(i) * 0.37f;
+        u.emplace_back(x, -x, 1.0f);
+        v.emplace_back(x + (i % 3 == 0 ? 1e-3f : 0.0f), -x, 1.0f);
+    }
+    bool out[64];
+    is_close(std::span<const Vector3f>(u), std::span<const Vector3f>(v), std::span<bool>(out));
+    for (std::size_t i = 0; i < u.size(); ++i) {
+        REQUIRE(out[i] == u[i].is_close(v[i]));
+        REQUIRE(out[i] == (i % 3 != 0));
+    }
+}
+
+TEST_CASE("Vector hash is consistent with ==") {
+    const std::hash<Vector3f> hash;
+
+    REQUIRE(hash(Vector3f(1.0f, 2.0f, 3.0f)) == hash(Vector3f(1.0f, 2.0f, 3.0f)));
+    REQUIRE(hash(Vector3f(0.0f, -0.0f, 1.0f)) == hash(Vector3f(-0.0f, 0.0f, 1.0f)));
+    REQUIRE(hash(Vector3f(1.0f, 2.0f, 3.0f)) != hash(Vector3f(3.0f, 2.0f, 1.0f)));
+
+    std::unordered_set<Vector3f> set;
+    for (int i = 0; i < 1000; ++i) {
+        set.insert(Vector3f(float(i % 100), 0.0f, 1.0f));
+    }
+    REQUIRE(set.size() == 100);
+    REQUIRE(set.contains(Vector3f(42.0f, 0.0f, 1.0f)));
+    REQUIRE(std::hash<Vector<2, int>>()(Vector<2, int>(1, 2)) != std::hash<Vector<2, int>>()(Vector<2, int>(2, 1)));
+}
+
+TEST_CASE("Vector is trivially copyable and assignable") {
+    STATIC_REQUIRE(std::is_trivially_copyable_v<Vector3f>);
+    STATIC_REQUIRE(std::is_standard_layout_v<Vector3f>);
+    STATIC_REQUIRE(sizeof(Vector3f) == simd::lanes<3, float> * sizeof(float));
+
+    auto u = Vector3f(1.0f, 2.0f, 3.0f);
+    auto v = Vector3f::zero();
+    v = u;
+    REQUIRE(v == u);
+
+    std::vector<Vector3f> src{u, -u, Vector3f::ones()};
+    std::vector<Vector3f> dst(src.size());
+    REQUIRE(dst[0] == Vector3f::zero());
+    std::memcpy(dst.data(), src.data(), src.size() * sizeof(Vector3f));
+    REQUIRE(dst == src);
+}
+
+TEST_CASE("scalar_product() works") {
+    constexpr Vector3f u(1.0f, 2.0f, 3.0f);
+    constexpr Vector3f v(4.0f, -5.0f, 6.0f);
+
+    STATIC_REQUIRE(scalar_product(u, v) == 12.0f);
+    STATIC_REQUIRE(scalar_product(Vector2d(1.0, 2.0), Vector2d(3.0, 4.0)) == 11.0);
+    STATIC_REQUIRE(scalar_product(Vector4f::unit_x(), Vector4f::unit_w()) == 0.0f);
+    REQUIRE(scalar_product(u, v) == 12.0f);
+
+    STATIC_REQUIRE(u.length_squared() == 14.0f);
+    REQUIRE(Vector2f(3.0f, 4.0f).length() == 5.0f);
+}
+
+TEST_CASE("vector_product() works") {
+    constexpr auto x = Vector3f::unit_x();
+    constexpr auto y = Vector3f::unit_y();
+    constexpr auto z = Vector3f::unit_z();
+
+    STATIC_REQUIRE(vector_product(x, y) == z);
+    STATIC_REQUIRE(vector_product(y, z) == x);
+    STATIC_REQUIRE(vector_product(z, x) == y);
+    REQUIRE(vector_product(y, x) == -z);
+    REQUIRE(vector_product(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(4.0f, 5.0f, 6.0f)) == Vector3f(-3.0f, 6.0f, -3.0f));
+
+    SECTION("the products that are not representable") {
+        const Vector3f u(0.1f, 0.7f, 1.3f);
+        const Vector3f v(-2.9f, 0.3f, 0.11f);
+        REQUIRE(vector_product(u, u) == Vector3f(0.0f, 0.0f, 0.0f));
+        REQUIRE(vector_product(v, v) == Vector3f(0.0f, 0.0f, 0.0f));
+        REQUIRE(vector_product(u, v) == -vector_product(v, u));
+    }
+}
+
+TEST_CASE("Batched products work") {
+    const std::vector<Vector3f> u{Vector3f::unit_x(), Vector3f::unit_y(), Vector3f(1.0f, 2.0f, 3.0f)};
+    const std::vector<Vector3f> v{Vector3f::unit_y(), Vector3f::unit_z(), Vector3f(4.0f, 5.0f, 6.0f)};
+    std::vector<float> dots(u.size());
+    std::vector<Vector3f> crosses(u.size());
+
+    scalar_product(std::span<const Vector3f>(u), std::span<const Vector3f>(v), std::span<float>(dots));
+    vector_product(std::span<const Vector3f>(u), std::span<const Vector3f>(v), std::span<Vector3f>(crosses));
+
+    for (std::size_t i = 0; i < u.size(); ++i) {
+        REQUIRE(dots[i] == scalar_product(u[i], v[i]));
+        REQUIRE(crosses[i] == vector_product(u[i], v[i]));
+    }
+}
+
 // is_parallel_to()
 
 // is_perpendicular_to()
-
-// TODO Vector hash function works
@@ -0,0 +1,156 @@
+/*
+ * VECTOR ARRAY TESTS
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <gof/math/types>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace gof;
+
+namespace {
+
+std::vector<Vector3f> make_vectors(std::size_t count, float seed) {
+    std::vector<Vector3f> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = seed + float(i);
+        result.emplace_back(f, 2.0f * f, -f);
+    }
+    return result;
+}
+
+} // namespace
+
+SCENARIO("VectorArray converts between AoS and SoA", "[vector_array]")
+{
+    GIVEN("An array of vectors")
+    {
+        const auto vectors = make_vectors(100, 1.0f);
+
+        WHEN("it is converted to the lanes")
+        {
+            VectorArray3f a(vectors);
+
+            THEN("each component has its own lane")
+            {
+                REQUIRE(a.size() == 100);
+                REQUIRE(a.lane(0)[10] == vectors[10].x());
+                REQUIRE(a.lane(1)[10] == vectors[10].y());
+                REQUIRE(a.lane(2)[10] == vectors[10].z());
+                REQUIRE(a[42] == vectors[42]);
+            }
+            THEN("the lanes are aligned to the cache line")
+            {
+                for (std::size_t k = 0; k < 3; ++k) {
+                    REQUIRE(reinterpret_cast<std::uintptr_t>(a.lane(k).data()) % cache_line_size == 0);
+                }
+            }
+            THEN("it converts back to the same vectors")
+            {
+                REQUIRE(a.to_vectors() == vectors);
+            }
+        }
+    }
+
+    GIVEN("An empty array")
+    {
+        VectorArray3f a;
+
+        WHEN("the vectors are appended")
+        {
+            for (const auto& v : make_vectors(40, 0.0f)) {
+                a.push_back(v);
+            }
+            THEN("the array grows and keeps the values")
+            {
+                REQUIRE(a.size() == 40);
+                REQUIRE(a.capacity() >= 40);
+                REQUIRE(a[0] == Vector3f(0.0f, 0.0f, -0.0f));
+                REQUIRE(a[39] == Vector3f(39.0f, 78.0f, -39.0f));
+            }
+        }
+    }
+}
+
+TEST_CASE("VectorArray batched kernels match the Vector operators", "[vector_array]") {
+    const auto u = make_vectors(37, 1.0f);
+    const auto v = make_vectors(37, -5.0f);
+    const VectorArray3f a(u);
+    const VectorArray3f b(v);
+    VectorArray3f out(u.size());
+    std::vector<float> scalars(u.size());
+
+    add(a, b, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == u[i] + v[i]);
+
+    sub(a, b, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == u[i] - v[i]);
+
+    scale(3.0f, a, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == 3.0f * u[i]);
+
+    lerp(a, b, 0.5f, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == u[i] + 0.5f * (v[i] - u[i]));
+
+    dot(a, b, std::span<float>(scalars));
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(scalars[i] == scalar_product(u[i], v[i]));
+
+    length(a, std::span<float>(scalars));
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(scalars[i] == u[i].length());
+
+    cross(a, b, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == vector_product(u[i], v[i]));
+
+}
+
+TEST_CASE("VectorArray cross is anti-commutative", "[vector_array]") {
+    VectorArray3f a;
+    VectorArray3f b;
+    for (std::size_t i = 0; i < 37; ++i) {
+        const float f = float(i);
+        a.push_back(Vector3f(0.1f + 0.37f * f, 0.7f - 0.13f * f, 1.3f * f));
+        b.push_back(Vector3f(-2.9f * f, 0.3f + 0.11f * f, 0.11f));
+    }
+    VectorArray3f out(a.size());
+    VectorArray3f reversed(a.size());
+
+    cross(a, b, out);
+    cross(b, a, reversed);
+    for (std::size_t i = 0; i < a.size(); ++i) REQUIRE(reversed[i] == -out[i]);
+
+    cross(a, a, out);
+    for (std::size_t i = 0; i < a.size(); ++i) REQUIRE(out[i] == Vector3f(0.0f, 0.0f, 0.0f));
+}
+
+TEST_CASE("VectorArray normalize keeps zero vectors", "[vector_array]") {
+    VectorArray3f a(2);
+    a.set(1, Vector3f(3.0f, 0.0f, 4.0f));
+
+    normalize(a, a);
+
+    REQUIRE(a[0] == Vector3f::zero());
+    REQUIRE(a[1] == Vector3f(0.6f, 0.0f, 0.8f));
+}
+
+TEST_CASE("VectorArray compares with tolerance", "[vector_array]") {
+    std::vector<Vector3f> u, v;
+    for (int i = 0; i < 300; ++i) {
+        const float angle = float(i) * 0.1f;
+        u.emplace_back(std::cos(angle), std::sin(angle), 0.0f);
+        v.emplace_back(std::cos(angle), std::sin(angle), i % 7 == 0 ? 1e-2f : 1e-9f);
+    }
+    const VectorArray3f a(u), b(v);
+    bool flags[300];
+    std::span<bool> out(flags);
+
+    is_close(a, b, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == u[i].is_close(v[i]));
+
+    is_unit(b, out);
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == v[i].is_unit());
+    for (std::size_t i = 0; i < u.size(); ++i) REQUIRE(out[i] == (i % 7 != 0));
+}